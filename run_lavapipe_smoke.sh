@@ -0,0 +1,99 @@
+#!/usr/bin/env bash
+
+set -euo pipefail
+
+config="Debug"
+exe_name="game"
+frames=600
+
+usage() {
+    echo "Usage: $0 [--debug|--release] [--exe-name <name>] [--frames <count>]" >&2
+    exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --release|Release)
+            config="Release"
+            shift
+            ;;
+        --debug|Debug)
+            config="Debug"
+            shift
+            ;;
+        --exe-name)
+            [[ $# -ge 2 ]] || usage
+            exe_name="$2"
+            shift 2
+            ;;
+        --frames)
+            [[ $# -ge 2 ]] || usage
+            frames="$2"
+            shift 2
+            ;;
+        *)
+            usage
+            ;;
+    esac
+done
+
+if [[ "${config}" != "Debug" ]]; then
+    echo "Warning: validation layers are only enabled in Debug builds." >&2
+fi
+
+repo_root="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+runtime_dir="${repo_root}/bin/${config}"
+exe_path="${runtime_dir}/${exe_name}"
+
+if [[ ! -x "${exe_path}" ]]; then
+    echo "Executable not found: ${exe_path} (run ./build_and_sync.sh first)" >&2
+    exit 1
+fi
+
+icd_file=""
+for dir in /usr/share/vulkan/icd.d /usr/local/share/vulkan/icd.d /etc/vulkan/icd.d; do
+    for candidate in "${dir}"/lvp_icd.*.json; do
+        if [[ -f "${candidate}" ]]; then
+            icd_file="${candidate}"
+            break 2
+        fi
+    done
+done
+
+if [[ -z "${icd_file}" ]]; then
+    echo "Lavapipe ICD (lvp_icd.*.json) not found; install Mesa's Vulkan drivers." >&2
+    exit 1
+fi
+
+runner=()
+if [[ -z "${DISPLAY:-}" && -z "${WAYLAND_DISPLAY:-}" ]]; then
+    if ! command -v xvfb-run >/dev/null 2>&1; then
+        echo "No display and xvfb-run is not installed." >&2
+        exit 1
+    fi
+    runner=(xvfb-run -a)
+fi
+
+log_file="$(mktemp)"
+trap 'rm -f "${log_file}"' EXIT
+
+echo "Running ${frames} frames of '${exe_path}' on ${icd_file}..."
+status=0
+(
+    cd "${runtime_dir}"
+    VK_ICD_FILENAMES="${icd_file}" "${runner[@]}" "${exe_path}" --frames "${frames}"
+) 2>&1 | tee "${log_file}" || status=$?
+
+if [[ ${status} -ne 0 ]]; then
+    echo "Smoke run failed with exit code ${status}." >&2
+    exit "${status}"
+fi
+
+# vk-bootstrap's default messenger tags messages as "[<severity>: <type>]".
+if grep -Eq "\[(ERROR|WARNING): (Validation|Performance)\]" "${log_file}"; then
+    echo "Smoke run logged validation messages:" >&2
+    grep -E "\[(ERROR|WARNING): (Validation|Performance)\]" "${log_file}" >&2
+    exit 1
+fi
+
+echo "Smoke run complete: ${frames} frames, no validation errors or warnings."
@@ -0,0 +1,47 @@
+#version 450
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec3 vNormal;
+layout (location = 2) in vec3 vColor;
+layout (location = 3) in vec2 vLighting;
+layout (location = 4) in vec3 vLocalLight;
+
+layout (location = 0) out vec3 outColor;
+layout (location = 1) out vec3 outNormal;
+layout (location = 2) out vec3 outWorldPosition;
+layout (location = 3) out vec2 outLighting;
+layout (location = 4) out vec3 outLocalLight;
+layout (location = 5) out vec4 outSampledLocalLightAndSunlight;
+layout (location = 6) out vec4 outSampledDynamicLightAndMode;
+
+layout(set = 0, binding = 0) uniform CameraUBO {
+    mat4 projection;
+    mat4 view;
+    mat4 viewproject;
+} ubo;
+
+// Same layout as the tri_mesh push constants; firstInstance of each indirect command selects the entry.
+struct DrawData {
+    mat4 modelMatrix;
+    vec4 sampledLocalLightAndSunlight;
+    vec4 sampledDynamicLightAndMode;
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer DrawDataBuffer {
+    DrawData draws[];
+} drawBuffer;
+
+
+void main()
+{
+    DrawData draw = drawBuffer.draws[gl_InstanceIndex];
+    vec3 worldPosition = vec3(draw.modelMatrix * vec4(vPosition, 1.0f));
+	gl_Position = ubo.viewproject * vec4(worldPosition, 1.0f);
+	outColor = vColor;
+    outNormal = normalize(mat3(draw.modelMatrix) * vNormal);
+    outWorldPosition = worldPosition;
+    outLighting = vLighting;
+    outLocalLight = vLocalLight;
+    outSampledLocalLightAndSunlight = draw.sampledLocalLightAndSunlight;
+    outSampledDynamicLightAndMode = draw.sampledDynamicLightAndMode;
+}
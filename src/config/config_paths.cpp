@@ -21,4 +21,9 @@ namespace config
     {
         return root() / "world_geometry.json";
     }
+
+    std::filesystem::path ConfigPaths::pipeline_cache()
+    {
+        return root() / "pipeline_cache.bin";
+    }
 }
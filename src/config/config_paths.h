@@ -11,5 +11,6 @@ namespace config
         [[nodiscard]] static std::filesystem::path game_settings();
         [[nodiscard]] static std::filesystem::path world_gen();
         [[nodiscard]] static std::filesystem::path world_geometry();
+        [[nodiscard]] static std::filesystem::path pipeline_cache();
     };
 }
@@ -37,6 +37,7 @@ namespace config
                 { "version", GameSettingsConfigVersion },
                 { "world", {
                     { "viewDistance", settings.world.viewDistance },
+                    { "horizonDistance", settings.world.horizonDistance },
                     { "ambientOcclusionEnabled", settings.world.ambientOcclusionEnabled }
                 } },
                 { "debug", {
@@ -103,6 +104,7 @@ namespace config
             {
                 const auto& world = document.at("world");
                 settings.world.viewDistance = world.value("viewDistance", settings.world.viewDistance);
+                settings.world.horizonDistance = world.value("horizonDistance", settings.world.horizonDistance);
                 settings.world.ambientOcclusionEnabled = world.value("ambientOcclusionEnabled", settings.world.ambientOcclusionEnabled);
             }
 
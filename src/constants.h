@@ -13,6 +13,8 @@ constexpr unsigned int TOTAL_BLOCKS_IN_CHUNK = CHUNK_SIZE * CHUNK_SIZE * CHUNK_H
 namespace GameConfig
 {
     constexpr int DEFAULT_VIEW_DISTANCE = 12;
+    constexpr int DEFAULT_HORIZON_DISTANCE = 32;
+    constexpr int HORIZON_TILE_CHUNKS = 4;
     constexpr float DEFAULT_MOVE_SPEED = 40.0f;
     constexpr float DEFAULT_ROTATION_SPEED = 180.0f;
     constexpr float BLOCK_INTERACTION_DISTANCE = 8.0f;
@@ -23,9 +25,44 @@ namespace GameConfig
     constexpr auto DEFAULT_POSITION = glm::vec3(0.0f, 120.0f, 0.0f);
 }
 
+// Chunks stay resident inside a disc of radius viewDistance + 0.5 around the player's chunk. The corners
+// of the surrounding square lie past the fog and are never generated.
+constexpr bool is_chunk_offset_resident(const int offsetX, const int offsetZ, const int viewDistance)
+{
+    return (offsetX * offsetX) + (offsetZ * offsetZ) <= (viewDistance * viewDistance) + viewDistance;
+}
+
+// A chunk meshes once its eight neighbours are resident; the diagonal one furthest out decides.
+constexpr bool is_chunk_offset_meshable(const int offsetX, const int offsetZ, const int viewDistance)
+{
+    return is_chunk_offset_resident(
+        (offsetX < 0 ? -offsetX : offsetX) + 1,
+        (offsetZ < 0 ? -offsetZ : offsetZ) + 1,
+        viewDistance);
+}
+
 constexpr int maximum_chunks_for_view_distance(const int viewDistance)
 {
-    return (2 * viewDistance + 1) * (2 * viewDistance + 1);
+    int chunks = 0;
+    for (int x = -viewDistance; x <= viewDistance; ++x)
+    {
+        for (int z = -viewDistance; z <= viewDistance; ++z)
+        {
+            chunks += is_chunk_offset_resident(x, z, viewDistance) ? 1 : 0;
+        }
+    }
+    return chunks;
+}
+
+// Upper bound on the heightfield tiles covering the horizon band around the resident chunks.
+constexpr int maximum_horizon_tiles(const int viewDistance, const int horizonDistance)
+{
+    if (horizonDistance <= 0)
+    {
+        return 0;
+    }
+    const int tilesPerSide = ((2 * (viewDistance + horizonDistance) + 1) + GameConfig::HORIZON_TILE_CHUNKS - 1) / GameConfig::HORIZON_TILE_CHUNKS + 1;
+    return tilesPerSide * tilesPerSide;
 }
 
 #ifdef NDEBUG
@@ -39,4 +76,4 @@ constexpr int MAX_COMPONENTS = 8;
 constexpr int DEFAULT_WINDOW_WIDTH = 2000;
 constexpr int DEFAULT_WINDOW_HEIGHT = 1000;
 
-constexpr unsigned int FRAME_OVERLAP = 1;
+constexpr unsigned int FRAME_OVERLAP = 2;
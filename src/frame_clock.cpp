@@ -1,5 +1,17 @@
 #include "frame_clock.h"
 
+#include <cmath>
+
+namespace
+{
+    constexpr float TimingSmoothing = 0.1f;
+
+    void accumulate(float& smoothedMs, const float seconds)
+    {
+        smoothedMs = std::lerp(smoothedMs, seconds * 1000.0f, TimingSmoothing);
+    }
+}
+
 FrameClock::FrameClock()
     : _lastFrameTime(Clock::now()),
       _lastFpsTime(Clock::now())
@@ -11,6 +23,7 @@ float FrameClock::tick_frame()
     const TimePoint now = Clock::now();
     const std::chrono::duration<float> elapsed = now - _lastFrameTime;
     _lastFrameTime = now;
+    accumulate(_timings.frameMs, elapsed.count());
     return elapsed.count();
 }
 
@@ -29,3 +42,13 @@ void FrameClock::report_frame_rendered()
     _framesSinceReport = 0;
     _lastFpsTime = Clock::now();
 }
+
+void FrameClock::report_fence_wait(const float seconds)
+{
+    accumulate(_timings.fenceWaitMs, seconds);
+}
+
+void FrameClock::report_record(const float seconds)
+{
+    accumulate(_timings.recordMs, seconds);
+}
@@ -2,6 +2,15 @@
 
 #include <vk_types.h>
 
+struct FrameTimings
+{
+    // Smoothed milliseconds. fenceWait is the CPU blocked on the render fence of the frame slot being
+    // reused; record is the CPU from acquiring that slot to submitting its command buffer.
+    float frameMs{0.0f};
+    float fenceWaitMs{0.0f};
+    float recordMs{0.0f};
+};
+
 class FrameClock
 {
 public:
@@ -9,9 +18,14 @@ public:
 
     float tick_frame();
     void report_frame_rendered();
+    void report_fence_wait(float seconds);
+    void report_record(float seconds);
+
+    [[nodiscard]] const FrameTimings& timings() const noexcept { return _timings; }
 
 private:
     TimePoint _lastFrameTime;
     TimePoint _lastFpsTime;
     int _framesSinceReport{0};
+    FrameTimings _timings{};
 };
@@ -1,7 +1,10 @@
 #include "chunk.h"
+
+#include <algorithm>
+
 #include <world/terrain_gen.h>
 #include <tracy/Tracy.hpp>
-#include <render/mesh_release_queue.h>
+#include <render/mesh_content_hash.h>
 
 ChunkData::ChunkData(const ChunkData& other) :
     coord(other.coord),
@@ -11,6 +14,7 @@ ChunkData::ChunkData(const ChunkData& other) :
     blocks(other.blocks),
     terrainAppearance(other.terrainAppearance),
     voxelDecorations(other.voxelDecorations),
+    heightmap(other.heightmap),
     emissivePresence(other.emissivePresence.load(std::memory_order_relaxed))
 {
 }
@@ -29,6 +33,7 @@ ChunkData& ChunkData::operator=(const ChunkData& other)
     blocks = other.blocks;
     terrainAppearance = other.terrainAppearance;
     voxelDecorations = other.voxelDecorations;
+    heightmap = other.heightmap;
     emissivePresence.store(other.emissivePresence.load(std::memory_order_relaxed), std::memory_order_relaxed);
     return *this;
 }
@@ -63,6 +68,7 @@ void ChunkData::generate()
         ZoneScopedN("ChunkData::RasterizeChunkTerrain");
         terrainGenerator.RasterizeChunkTerrain(generation, *this);
     }
+    rebuild_heightmap();
 
     StructureGenerationContext structureContext{
         .chunkCoord = {coord.x, coord.z},
@@ -125,6 +131,7 @@ void ChunkData::apply_structure_edits(const std::span<const StructureBlockEdit>
         const Block& previousBlock = blocks[localPos.x][localPos.y][localPos.z];
         const bool removedEmitter = get_block_emission(previousBlock._type).emits && !get_block_emission(edit.block._type).emits;
         blocks[localPos.x][localPos.y][localPos.z] = edit.block;
+        update_heightmap(localPos);
         if (get_block_emission(edit.block._type).emits)
         {
             mark_emissive_blocks_present();
@@ -136,6 +143,117 @@ void ChunkData::apply_structure_edits(const std::span<const StructureBlockEdit>
     }
 }
 
+void ChunkData::rebuild_heightmap()
+{
+    ZoneScopedN("ChunkData::RebuildHeightmap");
+    if (!has_block_storage())
+    {
+        heightmap = {};
+        return;
+    }
+
+    const size_t columnCount = static_cast<size_t>(voxelWidth) * static_cast<size_t>(voxelWidth);
+    heightmap.highestSolidY.assign(columnCount, -1);
+    heightmap.lowestNonSolidY.assign(columnCount, static_cast<int16_t>(voxelHeight));
+    heightmap.minOccupiedY = voxelHeight;
+    heightmap.maxOccupiedY = -1;
+
+    for (int x = 0; x < voxelWidth; ++x)
+    {
+        for (int z = 0; z < voxelWidth; ++z)
+        {
+            const size_t column = (static_cast<size_t>(x) * static_cast<size_t>(voxelWidth)) + static_cast<size_t>(z);
+            for (int y = 0; y < voxelHeight; ++y)
+            {
+                const Block& block = blocks[x][y][z];
+                if (block._solid)
+                {
+                    heightmap.highestSolidY[column] = static_cast<int16_t>(y);
+                }
+                else if (heightmap.lowestNonSolidY[column] == voxelHeight)
+                {
+                    heightmap.lowestNonSolidY[column] = static_cast<int16_t>(y);
+                }
+
+                if (block._type != BlockType::AIR)
+                {
+                    heightmap.minOccupiedY = std::min(heightmap.minOccupiedY, y);
+                    heightmap.maxOccupiedY = std::max(heightmap.maxOccupiedY, y);
+                }
+            }
+        }
+    }
+}
+
+void ChunkData::update_heightmap(const glm::ivec3& localPos)
+{
+    if (!heightmap.valid())
+    {
+        return;
+    }
+
+    const int x = localPos.x;
+    const int y = localPos.y;
+    const int z = localPos.z;
+    const size_t column = (static_cast<size_t>(x) * static_cast<size_t>(voxelWidth)) + static_cast<size_t>(z);
+    int16_t& highestSolid = heightmap.highestSolidY[column];
+    int16_t& lowestNonSolid = heightmap.lowestNonSolidY[column];
+    const Block& block = blocks[x][y][z];
+
+    if (block._solid)
+    {
+        highestSolid = std::max<int16_t>(highestSolid, static_cast<int16_t>(y));
+        if (lowestNonSolid == y)
+        {
+            int nextNonSolid = y + 1;
+            while (nextNonSolid < voxelHeight && blocks[x][nextNonSolid][z]._solid)
+            {
+                ++nextNonSolid;
+            }
+            lowestNonSolid = static_cast<int16_t>(nextNonSolid);
+        }
+    }
+    else
+    {
+        lowestNonSolid = std::min<int16_t>(lowestNonSolid, static_cast<int16_t>(y));
+        if (highestSolid == y)
+        {
+            int nextSolid = y - 1;
+            while (nextSolid >= 0 && !blocks[x][nextSolid][z]._solid)
+            {
+                --nextSolid;
+            }
+            highestSolid = static_cast<int16_t>(nextSolid);
+        }
+    }
+
+    if (block._type != BlockType::AIR)
+    {
+        heightmap.minOccupiedY = std::min(heightmap.minOccupiedY, y);
+        heightmap.maxOccupiedY = std::max(heightmap.maxOccupiedY, y);
+    }
+}
+
+int ChunkData::highest_solid_y(const int x, const int z) const noexcept
+{
+    if (!heightmap.valid())
+    {
+        return voxelHeight - 1;
+    }
+
+    return heightmap.highestSolidY[(static_cast<size_t>(x) * static_cast<size_t>(voxelWidth)) + static_cast<size_t>(z)];
+}
+
+int ChunkData::lowest_non_solid_y(const int x, const int z) const noexcept
+{
+    if (!heightmap.valid())
+    {
+        return 0;
+    }
+
+    return heightmap.lowestNonSolidY[(static_cast<size_t>(x) * static_cast<size_t>(voxelWidth)) + static_cast<size_t>(z)];
+}
+
 void ChunkData::mark_emissive_blocks_present() noexcept
 {
     emissivePresence.store(CachedPresenceState::Yes, std::memory_order_relaxed);
@@ -213,11 +331,22 @@ glm::ivec3 ChunkData::to_local_position(const glm::ivec3& worldPos) const
     };
 }
 
-ChunkMeshData::~ChunkMeshData()
+void ChunkMeshData::hash_contents()
+{
+    for (const std::shared_ptr<Mesh>& part : { mesh, waterMesh, glowMesh })
+    {
+        if (part != nullptr)
+        {
+            part->_contentHash = render::hash_mesh_content(*part);
+        }
+    }
+}
+
+bool ChunkMeshData::same_content(const ChunkMeshData& other) const noexcept
 {
-    render::enqueue_mesh_release(std::move(mesh));
-    render::enqueue_mesh_release(std::move(waterMesh));
-    render::enqueue_mesh_release(std::move(glowMesh));
+    return render::same_mesh_content(mesh.get(), other.mesh.get()) &&
+        render::same_mesh_content(waterMesh.get(), other.waterMesh.get()) &&
+        render::same_mesh_content(glowMesh.get(), other.glowMesh.get());
 }
 
 Chunk::Chunk(const ChunkCoord coord, const int chunkVoxelWidth, const int chunkVoxelHeight) :
@@ -235,6 +235,27 @@ enum class ChunkState : uint8_t
     Rendered = 2
 };
 
+// Per-column vertical extents indexed by x * width + z. Left empty when blocks are written
+// outside generate(), in which case consumers fall back to scanning whole columns.
+struct ChunkHeightmap
+{
+    std::vector<int16_t> highestSolidY{};
+    std::vector<int16_t> lowestNonSolidY{};
+    // Conservative range of non-air rows; edits only widen it, regeneration tightens it.
+    int minOccupiedY{0};
+    int maxOccupiedY{-1};
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return !highestSolidY.empty();
+    }
+
+    [[nodiscard]] bool has_occupied_rows() const noexcept
+    {
+        return maxOccupiedY >= minOccupiedY;
+    }
+};
+
 struct ChunkData
 {
     enum class CachedPresenceState : int8_t
@@ -250,7 +271,8 @@ struct ChunkData
     int voxelHeight{static_cast<int>(CHUNK_HEIGHT)};
     ChunkBlocks blocks{};
     std::shared_ptr<AppearanceBuffer> terrainAppearance{};
-    std::vector<VoxelDecorationPlacement> voxelDecorations{};
+    VoxelDecorationPlacements voxelDecorations{};
+    ChunkHeightmap heightmap{};
     mutable std::atomic<CachedPresenceState> emissivePresence{CachedPresenceState::Unknown};
 
     ChunkData() = default;
@@ -275,6 +297,10 @@ struct ChunkData
 
     void generate();
     void apply_structure_edits(std::span<const StructureBlockEdit> edits);
+    void rebuild_heightmap();
+    void update_heightmap(const glm::ivec3& localPos);
+    [[nodiscard]] int highest_solid_y(int x, int z) const noexcept;
+    [[nodiscard]] int lowest_non_solid_y(int x, int z) const noexcept;
     void mark_emissive_blocks_present() noexcept;
     void invalidate_cached_properties() noexcept;
     [[nodiscard]] bool has_emissive_blocks() const;
@@ -285,13 +311,19 @@ struct ChunkData
     [[nodiscard]] int voxel_depth() const noexcept { return voxelWidth; }
 };
 
+struct ChunkConnectivity;
+
 struct ChunkMeshData
 {
-    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
-    std::shared_ptr<Mesh> waterMesh = std::make_shared<Mesh>();
-    std::shared_ptr<Mesh> glowMesh = std::make_shared<Mesh>();
-
-    ~ChunkMeshData();
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    std::shared_ptr<Mesh> waterMesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    std::shared_ptr<Mesh> glowMesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    // Section connectivity for cave culling, built with the mesh. Reset when an edit changes the
+    // chunk's opacity, after which the chunk counts as open until it is remeshed.
+    std::shared_ptr<const ChunkConnectivity> connectivity{};
+
+    void hash_contents();
+    [[nodiscard]] bool same_content(const ChunkMeshData& other) const noexcept;
 };
 
 class Chunk {
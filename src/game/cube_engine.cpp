@@ -63,7 +63,7 @@ void CubeEngine::update(const float deltaTime)
     }
     _player->simulate(deltaTime, _worldCollision);
 
-    _chunkManager.update_player_position(_player->_position);
+    _chunkManager.update_player_position(_player->_position, _player->movement().velocity);
     _current_chunk = _world.get_chunk(_player->_position);
     _current_block = _world.get_block(_player->_position);
 
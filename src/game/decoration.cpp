@@ -2,6 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include <glm/ext/quaternion_trigonometric.hpp>
 #include <tracy/Tracy.hpp>
@@ -17,6 +20,20 @@ namespace
     constexpr float FlowerClearanceHeightWorld = 2.0f;
     constexpr std::string_view FlowerAssetId = "flower";
 
+    struct DecorationNameTable
+    {
+        std::shared_mutex mutex{};
+        // A deque keeps names in place as it grows, so the map's views and asset_id() references stay valid.
+        std::deque<std::string> names{ std::string{} };
+        std::unordered_map<std::string_view, DecorationAssetHandle> handles{ { std::string_view{}, NoDecorationAsset } };
+    };
+
+    DecorationNameTable& decoration_name_table()
+    {
+        static DecorationNameTable table;
+        return table;
+    }
+
     [[nodiscard]] int world_units_to_voxels_round(const float worldUnits, const float blockWorldSize)
     {
         return std::max(1, static_cast<int>(std::lround(worldUnits / blockWorldSize)));
@@ -42,8 +59,10 @@ namespace
             return "ForestFlowers";
         }
 
-        void collect_placements(const DecorationGenerationContext& context, std::vector<VoxelDecorationPlacement>& placements) const override
+        void collect_placements(const DecorationGenerationContext& context, VoxelDecorationPlacements& placements) const override
         {
+            static const DecorationAssetHandle flowerAsset = decoration::intern_asset_id(FlowerAssetId);
+
             if (context.terrainGenerator == nullptr || context.chunkData == nullptr)
             {
                 return;
@@ -104,7 +123,7 @@ namespace
                     const float scale = static_cast<float>(Random::generate_from_seed(cellSeed, 90, 120)) / 100.0f;
 
                     placements.push_back(VoxelDecorationPlacement{
-                        .assetId = std::string(FlowerAssetId),
+                        .asset = flowerAsset,
                         .worldPosition = glm::vec3(
                             (static_cast<float>(worldX) + 0.5f) * blockWorldSize,
                             static_cast<float>(column.surfaceHeight + 1) * blockWorldSize,
@@ -125,10 +144,42 @@ DecorationRegistry& DecorationRegistry::instance()
     return instance;
 }
 
-std::vector<VoxelDecorationPlacement> DecorationRegistry::generate_for_chunk(const DecorationGenerationContext& context) const
+void VoxelDecorationPlacements::reserve(const size_t count)
+{
+    assets.reserve(count);
+    worldPositions.reserve(count);
+    rotations.reserve(count);
+    scales.reserve(count);
+    placementPolicies.reserve(count);
+    placementAttachments.reserve(count);
+}
+
+void VoxelDecorationPlacements::push_back(const VoxelDecorationPlacement& placement)
+{
+    assets.push_back(placement.asset);
+    worldPositions.push_back(placement.worldPosition);
+    rotations.push_back(placement.rotation);
+    scales.push_back(placement.scale);
+    placementPolicies.push_back(placement.placementPolicy);
+    placementAttachments.push_back(placement.placementAttachment);
+}
+
+VoxelDecorationPlacement VoxelDecorationPlacements::operator[](const size_t index) const
+{
+    return VoxelDecorationPlacement{
+        .asset = assets[index],
+        .worldPosition = worldPositions[index],
+        .rotation = rotations[index],
+        .scale = scales[index],
+        .placementPolicy = placementPolicies[index],
+        .placementAttachment = placementAttachments[index]
+    };
+}
+
+VoxelDecorationPlacements DecorationRegistry::generate_for_chunk(const DecorationGenerationContext& context) const
 {
     ZoneScopedN("DecorationRegistry::GenerateForChunk");
-    std::vector<VoxelDecorationPlacement> placements{};
+    VoxelDecorationPlacements placements{};
     for (const auto& strategy : _placementStrategies)
     {
         if (strategy == nullptr)
@@ -152,6 +203,41 @@ DecorationRegistry::DecorationRegistry()
     _placementStrategies.push_back(std::make_unique<ForestFlowerPlacementStrategy>());
 }
 
+DecorationAssetHandle decoration::intern_asset_id(const std::string_view assetId)
+{
+    if (assetId.empty())
+    {
+        return NoDecorationAsset;
+    }
+
+    DecorationNameTable& table = decoration_name_table();
+    {
+        std::shared_lock lock(table.mutex);
+        if (const auto it = table.handles.find(assetId); it != table.handles.end())
+        {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(table.mutex);
+    if (const auto it = table.handles.find(assetId); it != table.handles.end())
+    {
+        return it->second;
+    }
+
+    const auto handle = static_cast<DecorationAssetHandle>(table.names.size());
+    const std::string& name = table.names.emplace_back(assetId);
+    table.handles.emplace(name, handle);
+    return handle;
+}
+
+const std::string& decoration::asset_id(const DecorationAssetHandle handle)
+{
+    DecorationNameTable& table = decoration_name_table();
+    std::shared_lock lock(table.mutex);
+    return handle < table.names.size() ? table.names[handle] : table.names.front();
+}
+
 bool decoration::is_forest_flower_biome(const BiomeType biome) noexcept
 {
     return biome == BiomeType::Forest;
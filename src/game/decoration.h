@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -15,14 +16,36 @@
 class TerrainGenerator;
 struct ChunkData;
 
+// Index into the process-wide decoration name table; asset ids and attachment names share it.
+using DecorationAssetHandle = uint32_t;
+inline constexpr DecorationAssetHandle NoDecorationAsset = 0;
+
 struct VoxelDecorationPlacement
 {
-    std::string assetId{};
+    DecorationAssetHandle asset{NoDecorationAsset};
     glm::vec3 worldPosition{0.0f};
     glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
     float scale{1.0f};
     VoxelPlacementPolicy placementPolicy{VoxelPlacementPolicy::Pivot};
-    std::string placementAttachmentName{};
+    DecorationAssetHandle placementAttachment{NoDecorationAsset};
+};
+
+// A chunk's decorations in structure-of-arrays form. Renderers walk positions and handles in bulk
+// and never touch the rarely used placement fields.
+struct VoxelDecorationPlacements
+{
+    std::vector<DecorationAssetHandle> assets{};
+    std::vector<glm::vec3> worldPositions{};
+    std::vector<glm::quat> rotations{};
+    std::vector<float> scales{};
+    std::vector<VoxelPlacementPolicy> placementPolicies{};
+    std::vector<DecorationAssetHandle> placementAttachments{};
+
+    [[nodiscard]] size_t size() const noexcept { return assets.size(); }
+    [[nodiscard]] bool empty() const noexcept { return assets.empty(); }
+    void reserve(size_t count);
+    void push_back(const VoxelDecorationPlacement& placement);
+    [[nodiscard]] VoxelDecorationPlacement operator[](size_t index) const;
 };
 
 struct DecorationGenerationContext
@@ -40,7 +63,7 @@ public:
     virtual ~IWorldDecorationPlacementStrategy() = default;
 
     [[nodiscard]] virtual std::string_view name() const noexcept = 0;
-    virtual void collect_placements(const DecorationGenerationContext& context, std::vector<VoxelDecorationPlacement>& placements) const = 0;
+    virtual void collect_placements(const DecorationGenerationContext& context, VoxelDecorationPlacements& placements) const = 0;
 };
 
 class DecorationRegistry
@@ -48,7 +71,7 @@ class DecorationRegistry
 public:
     static DecorationRegistry& instance();
 
-    [[nodiscard]] std::vector<VoxelDecorationPlacement> generate_for_chunk(const DecorationGenerationContext& context) const;
+    [[nodiscard]] VoxelDecorationPlacements generate_for_chunk(const DecorationGenerationContext& context) const;
 
 private:
     DecorationRegistry();
@@ -58,6 +81,10 @@ private:
 
 namespace decoration
 {
+    // Thread-safe; chunk generation interns from worker threads. The empty name maps to NoDecorationAsset.
+    [[nodiscard]] DecorationAssetHandle intern_asset_id(std::string_view assetId);
+    [[nodiscard]] const std::string& asset_id(DecorationAssetHandle handle);
+
     [[nodiscard]] bool is_forest_flower_biome(BiomeType biome) noexcept;
     [[nodiscard]] bool has_vertical_clearance(const ChunkData& chunkData, const glm::ivec3& baseWorldPos, int clearanceHeight);
     [[nodiscard]] bool can_place_surface_decoration(
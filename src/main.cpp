@@ -1,6 +1,10 @@
 #include <csignal>
+#include <string>
+#include <string_view>
 #include <vk_engine.h>
 #include <FastNoise/FastNoise.h>
+#include <config/json_document_store.h>
+#include <voxel/voxel_model_repository.h>
 
 #define TRACY_MEM_ENABLE 0
 
@@ -40,13 +44,47 @@ void  operator delete[](void* p, std::size_t, std::align_val_t) noexcept { if(p)
 #endif
 #endif
 
+namespace
+{
+	// game --convert-voxel-assets <binary|json> [root]: converts every voxel model under root
+	// (default models/voxels) between the JSON authoring format and the binary runtime format.
+	int run_voxel_asset_converter(const int argc, char* argv[])
+	{
+		const std::string_view target = argc > 2 ? std::string_view(argv[2]) : std::string_view("binary");
+		if (target != "binary" && target != "json")
+		{
+			std::println("Usage: {} --convert-voxel-assets <binary|json> [root]", argv[0]);
+			return 1;
+		}
+
+		const config::JsonFileDocumentStore documentStore;
+		const VoxelModelRepository repository = argc > 3
+			? VoxelModelRepository(documentStore, argv[3])
+			: VoxelModelRepository(documentStore);
+		const size_t converted = target == "binary" ? repository.convert_to_binary() : repository.convert_to_json();
+		std::println("Converted {} voxel assets in {} to {}", converted, repository.root_path().string(), target);
+		return 0;
+	}
+}
+
 int main(int argc, char* argv[])
 {
 	try
 	{
+		if (argc > 1 && std::string_view(argv[1]) == "--convert-voxel-assets")
+		{
+			return run_voxel_asset_converter(argc, argv);
+		}
+
 		//std::raise(SIGTRAP);
 		VulkanEngine& engine = VulkanEngine::instance();
 
+		// game --frames <count>: quits after a fixed number of frames, for smoke runs (see run_lavapipe_smoke.sh).
+		if (argc > 2 && std::string_view(argv[1]) == "--frames")
+		{
+			engine._frameLimit = std::stoi(argv[2]);
+		}
+
 		engine.init();
 		engine.run();
 		engine.cleanup();
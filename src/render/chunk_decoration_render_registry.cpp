@@ -1,11 +1,37 @@
 #include "chunk_decoration_render_registry.h"
 
+#include <algorithm>
 #include <unordered_set>
 
-#include "components/voxel_model_component.h"
 #include "game/chunk.h"
-#include "voxel/voxel_model_component_adapter.h"
+#include "render/material_manager.h"
+#include "render/mesh_manager.h"
+#include "voxel/voxel_placement.h"
+#include "voxel/voxel_spatial_bounds.h"
 #include "world/chunk_manager.h"
+#include "world/world_light_sampler.h"
+
+namespace
+{
+    constexpr size_t NoGroup = SIZE_MAX;
+
+    void expand_bounds(RenderBounds& bounds, const VoxelSpatialBounds& instanceBounds)
+    {
+        if (!instanceBounds.valid)
+        {
+            return;
+        }
+
+        if (!bounds.valid)
+        {
+            bounds = RenderBounds{ .valid = true, .min = instanceBounds.min, .max = instanceBounds.max };
+            return;
+        }
+
+        bounds.min = glm::min(bounds.min, instanceBounds.min);
+        bounds.max = glm::max(bounds.max, instanceBounds.max);
+    }
+}
 
 void ChunkDecorationRenderRegistry::sync(
     const ChunkManager& chunkManager,
@@ -18,6 +44,7 @@ void ChunkDecorationRenderRegistry::sync(
     const world_lighting::WorldLightSampler* const worldLightSampler,
     SceneRenderState& renderState)
 {
+    const std::shared_ptr<Material> instancedMaterial = materialManager.get_material(materialScope, "decorationmesh_instanced");
     std::unordered_set<ChunkCoord> visibleChunks{};
     visibleChunks.reserve(static_cast<size_t>((viewDistance * 2 + 1) * (viewDistance * 2 + 1)));
 
@@ -50,9 +77,10 @@ void ChunkDecorationRenderRegistry::sync(
                 })
                 : std::nullopt;
 
-            if (requires_rebuild(entryState.has_value() ? &entryState.value() : nullptr, *chunk))
+            if (requires_rebuild(entryState.has_value() ? &entryState.value() : nullptr, *chunk) ||
+                (it != _entriesByChunk.end() && pending_assets_settled(it->second, assetManager)))
             {
-                rebuild_chunk(coord, *chunk, assetManager, renderState);
+                rebuild_chunk(coord, *chunk, assetManager, instancedMaterial, renderState);
             }
         }
     }
@@ -73,7 +101,15 @@ void ChunkDecorationRenderRegistry::sync(
         remove_chunk(coord, renderState);
     }
 
-    _voxelRenderRegistry.sync(meshManager, materialManager, materialScope, renderState, worldLightSampler);
+    _queuedMeshes.clear();
+    for (auto& [coord, entry] : _entriesByChunk)
+    {
+        (void)coord;
+        for (DecorationGroup& group : entry.groups)
+        {
+            update_group(group, meshManager, worldLightSampler, renderState);
+        }
+    }
 }
 
 void ChunkDecorationRenderRegistry::clear(SceneRenderState& renderState)
@@ -81,14 +117,14 @@ void ChunkDecorationRenderRegistry::clear(SceneRenderState& renderState)
     for (const auto& [coord, entry] : _entriesByChunk)
     {
         (void)coord;
-        for (const auto instanceId : entry.instanceIds)
+        for (const DecorationGroup& group : entry.groups)
         {
-            _voxelRenderRegistry.remove_instance(instanceId, renderState);
+            renderState.instanceGroups.remove(group.renderHandle);
         }
     }
 
     _entriesByChunk.clear();
-    _voxelRenderRegistry.clear(renderState);
+    _instanceCount = 0;
 }
 
 size_t ChunkDecorationRenderRegistry::active_chunk_count() const noexcept
@@ -98,13 +134,14 @@ size_t ChunkDecorationRenderRegistry::active_chunk_count() const noexcept
 
 size_t ChunkDecorationRenderRegistry::active_instance_count() const noexcept
 {
-    return _voxelRenderRegistry.instance_count();
+    return _instanceCount;
 }
 
 void ChunkDecorationRenderRegistry::rebuild_chunk(
     const ChunkCoord& coord,
     Chunk& chunk,
     VoxelAssetManager& assetManager,
+    const std::shared_ptr<Material>& material,
     SceneRenderState& renderState)
 {
     remove_chunk(coord, renderState);
@@ -113,31 +150,124 @@ void ChunkDecorationRenderRegistry::rebuild_chunk(
     entry.chunk = &chunk;
     entry.data = chunk._data.get();
     entry.generationId = chunk._gen.load(std::memory_order::acquire);
-    entry.instanceIds.reserve(chunk._data->voxelDecorations.size());
 
-    for (const VoxelDecorationPlacement& placement : chunk._data->voxelDecorations)
+    const VoxelDecorationPlacements& placements = chunk._data->voxelDecorations;
+    // A chunk holds a handful of distinct assets, so a linear map beats hashing.
+    std::vector<std::pair<DecorationAssetHandle, size_t>> groupByAsset{};
+    std::vector<render::InstanceGroup> renderGroups{};
+    std::vector<VoxelSpatialBounds> localBounds{};
+
+    for (size_t index = 0; index < placements.size(); ++index)
     {
-        VoxelModelComponent component{};
-        component.assetId = placement.assetId;
-        component.position = placement.worldPosition;
-        component.rotation = placement.rotation;
-        component.scale = placement.scale;
-        component.placementPolicy = placement.placementPolicy;
-        component.placementAttachmentName = placement.placementAttachmentName;
-        component.visible = true;
-
-        const std::optional<VoxelRenderInstance> renderInstance = build_voxel_render_instance(component, assetManager);
-        if (!renderInstance.has_value())
+        const DecorationAssetHandle assetHandle = placements.assets[index];
+        auto groupIt = std::ranges::find(groupByAsset, assetHandle, &std::pair<DecorationAssetHandle, size_t>::first);
+        if (groupIt == groupByAsset.end())
+        {
+            const std::string& assetId = decoration::asset_id(assetHandle);
+            std::shared_ptr<VoxelRuntimeAsset> asset = assetManager.acquire(assetId, VoxelAssetLoadMode::Async);
+            size_t groupIndex = NoGroup;
+            if (asset != nullptr && asset->mesh != nullptr)
+            {
+                groupIndex = entry.groups.size();
+                localBounds.push_back(evaluate_voxel_asset_local_bounds(*asset));
+                renderGroups.push_back(render::InstanceGroup{
+                    .mesh = asset->mesh,
+                    .material = material
+                });
+                entry.groups.push_back(DecorationGroup{ .asset = std::move(asset) });
+            }
+            else if (assetManager.is_loading(assetId))
+            {
+                entry.pendingAssets.push_back(assetHandle);
+            }
+            groupIt = groupByAsset.insert(groupByAsset.end(), { assetHandle, groupIndex });
+        }
+
+        if (groupIt->second == NoGroup)
         {
             continue;
         }
 
-        entry.instanceIds.push_back(_voxelRenderRegistry.add_instance(renderInstance.value()));
+        DecorationGroup& group = entry.groups[groupIt->second];
+        render::InstanceGroup& renderGroup = renderGroups[groupIt->second];
+        const VoxelRenderInstance instance{
+            .asset = group.asset,
+            .position = placements.worldPositions[index],
+            .rotation = placements.rotations[index],
+            .scale = placements.scales[index],
+            .renderAnchorOffset = resolve_voxel_model_placement_anchor(
+                group.asset->model,
+                placements.placementPolicies[index],
+                decoration::asset_id(placements.placementAttachments[index]))
+        };
+
+        const glm::mat4 modelMatrix = instance.model_matrix();
+        renderGroup.instances.push_back(make_object_push_constants(RenderObject{
+            .transform = modelMatrix,
+            .lightingMode = instance.lightingMode,
+            .sampledLight = instance.sampledLight
+        }));
+        expand_bounds(renderGroup.bounds, transform_bounds(localBounds[groupIt->second], modelMatrix));
+        group.lightSamplePositions.push_back(instance.light_sample_world_position());
+    }
+
+    for (size_t groupIndex = 0; groupIndex < entry.groups.size(); ++groupIndex)
+    {
+        _instanceCount += renderGroups[groupIndex].instances.size();
+        entry.groups[groupIndex].renderHandle = renderState.instanceGroups.insert(std::move(renderGroups[groupIndex]));
     }
 
     _entriesByChunk.insert_or_assign(coord, std::move(entry));
 }
 
+void ChunkDecorationRenderRegistry::update_group(
+    DecorationGroup& group,
+    MeshManager& meshManager,
+    const world_lighting::WorldLightSampler* const worldLightSampler,
+    SceneRenderState& renderState)
+{
+    const std::shared_ptr<Mesh>& mesh = group.asset->mesh;
+    if (!group.uploadRequested && meshManager.accepts_uploads())
+    {
+        // Every chunk's group of an asset shares its mesh; it only needs to be queued once.
+        if (!mesh->_isActive.load(std::memory_order::acquire) && _queuedMeshes.insert(mesh.get()).second)
+        {
+            meshManager.UploadQueue.enqueue(mesh);
+        }
+        group.uploadRequested = true;
+    }
+
+    if (worldLightSampler == nullptr)
+    {
+        return;
+    }
+
+    render::InstanceGroup* const renderGroup = renderState.instanceGroups.get(group.renderHandle);
+    if (renderGroup == nullptr)
+    {
+        return;
+    }
+
+    for (size_t index = 0; index < group.lightSamplePositions.size(); ++index)
+    {
+        const world_lighting::SampledWorldLight sampledLight = worldLightSampler->sample(group.lightSamplePositions[index], 0xFFFFFFFFu);
+        ObjectPushConstants& instance = renderGroup->instances[index];
+        instance.sampledLocalLightAndSunlight = glm::vec4(sampledLight.bakedLocalLight, sampledLight.bakedSunlight);
+        instance.sampledDynamicLightAndMode = glm::vec4(sampledLight.dynamicLight, instance.sampledDynamicLightAndMode.w);
+    }
+}
+
+bool ChunkDecorationRenderRegistry::pending_assets_settled(
+    const ChunkDecorationEntry& entry,
+    const VoxelAssetManager& assetManager)
+{
+    return !entry.pendingAssets.empty() &&
+        std::ranges::none_of(entry.pendingAssets, [&](const DecorationAssetHandle assetHandle)
+        {
+            return assetManager.is_loading(decoration::asset_id(assetHandle));
+        });
+}
+
 void ChunkDecorationRenderRegistry::remove_chunk(const ChunkCoord& coord, SceneRenderState& renderState)
 {
     const auto it = _entriesByChunk.find(coord);
@@ -146,9 +276,10 @@ void ChunkDecorationRenderRegistry::remove_chunk(const ChunkCoord& coord, SceneR
         return;
     }
 
-    for (const auto instanceId : it->second.instanceIds)
+    for (const DecorationGroup& group : it->second.groups)
     {
-        _voxelRenderRegistry.remove_instance(instanceId, renderState);
+        _instanceCount -= group.lightSamplePositions.size();
+        renderState.instanceGroups.remove(group.renderHandle);
     }
 
     _entriesByChunk.erase(it);
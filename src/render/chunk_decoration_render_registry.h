@@ -2,17 +2,20 @@
 
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "game/chunk.h"
+#include "render/scene_render_state.h"
 #include "voxel/voxel_asset_manager.h"
-#include "voxel/voxel_render_registry.h"
 
 class ChunkManager;
 class MaterialManager;
 class MeshManager;
 namespace world_lighting { class WorldLightSampler; }
 
+// Turns chunk decoration placements into instance groups, one per asset mesh per chunk, so the
+// renderer draws every copy of a decoration mesh with a single instanced draw.
 class ChunkDecorationRenderRegistry
 {
 public:
@@ -60,21 +63,42 @@ public:
     }
 
 private:
+    struct DecorationGroup
+    {
+        std::shared_ptr<VoxelRuntimeAsset> asset{};
+        dev_collections::sparse_set<render::InstanceGroup>::Handle renderHandle{};
+        // Parallel to the render group's instances; resampled every sync for runtime lighting.
+        std::vector<glm::vec3> lightSamplePositions{};
+        bool uploadRequested{false};
+    };
+
     struct ChunkDecorationEntry
     {
         Chunk* chunk{nullptr};
         const ChunkData* data{nullptr};
         uint32_t generationId{0};
-        std::vector<VoxelRenderRegistry::InstanceId> instanceIds{};
+        std::vector<DecorationGroup> groups{};
+        // Decoration assets that were still loading at build time; the chunk is rebuilt once they settle.
+        std::vector<DecorationAssetHandle> pendingAssets{};
     };
 
     void rebuild_chunk(
         const ChunkCoord& coord,
         Chunk& chunk,
         VoxelAssetManager& assetManager,
+        const std::shared_ptr<Material>& material,
         SceneRenderState& renderState);
     void remove_chunk(const ChunkCoord& coord, SceneRenderState& renderState);
+    void update_group(
+        DecorationGroup& group,
+        MeshManager& meshManager,
+        const world_lighting::WorldLightSampler* worldLightSampler,
+        SceneRenderState& renderState);
+    [[nodiscard]] static bool pending_assets_settled(
+        const ChunkDecorationEntry& entry,
+        const VoxelAssetManager& assetManager);
 
     std::unordered_map<ChunkCoord, ChunkDecorationEntry> _entriesByChunk{};
-    VoxelRenderRegistry _voxelRenderRegistry{};
+    std::unordered_set<Mesh*> _queuedMeshes{};
+    size_t _instanceCount{0};
 };
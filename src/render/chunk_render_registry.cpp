@@ -1,12 +1,74 @@
 #include "chunk_render_registry.h"
 
+#include <algorithm>
+#include <optional>
 #include <vector>
 
 #include <glm/ext/matrix_transform.hpp>
+#include <tracy/Tracy.hpp>
 
 #include "material_manager.h"
 #include "mesh_manager.h"
 
+namespace
+{
+    // Chunk meshes only cover occupied rows, so the box is the chunk footprint clamped to that Y range.
+    RenderBounds chunk_world_bounds(const WorldGeometry& geometry, const ChunkData& data)
+    {
+        const ChunkHeightmap& heightmap = data.heightmap;
+        const bool hasOccupiedRange = heightmap.has_occupied_rows();
+        const int minY = hasOccupiedRange ? heightmap.minOccupiedY : 0;
+        const int maxY = hasOccupiedRange ? heightmap.maxOccupiedY + 1 : data.voxelHeight;
+
+        return RenderBounds{
+            .valid = true,
+            .min = geometry.voxel_to_world(glm::vec3(
+                static_cast<float>(data.position.x),
+                static_cast<float>(minY),
+                static_cast<float>(data.position.y))),
+            .max = geometry.voxel_to_world(glm::vec3(
+                static_cast<float>(data.position.x + data.voxelWidth),
+                static_cast<float>(maxY),
+                static_cast<float>(data.position.y + data.voxelWidth)))
+        };
+    }
+
+    // Rows below every column's lowest non-solid block are solid across the whole footprint, which
+    // makes them a box that hides whatever is behind it.
+    std::optional<render::OccluderBox> chunk_occluder(const WorldGeometry& geometry, const ChunkData& data)
+    {
+        const ChunkHeightmap& heightmap = data.heightmap;
+        if (!heightmap.valid())
+        {
+            return std::nullopt;
+        }
+
+        const int solidRows = *std::ranges::min_element(heightmap.lowestNonSolidY);
+        if (solidRows <= 0)
+        {
+            return std::nullopt;
+        }
+
+        return render::OccluderBox{
+            .min = geometry.voxel_to_world(glm::vec3(
+                static_cast<float>(data.position.x),
+                0.0f,
+                static_cast<float>(data.position.y))),
+            .max = geometry.voxel_to_world(glm::vec3(
+                static_cast<float>(data.position.x + data.voxelWidth),
+                static_cast<float>(solidRows),
+                static_cast<float>(data.position.y + data.voxelWidth)))
+        };
+    }
+
+    uint32_t chunk_upload_priority(const ChunkCoord coord, const ChunkCoord playerChunk)
+    {
+        const int64_t dx = coord.x - playerChunk.x;
+        const int64_t dz = coord.z - playerChunk.z;
+        return static_cast<uint32_t>(std::min<int64_t>(dx * dx + dz * dz, UINT32_MAX));
+    }
+}
+
 void ChunkRenderRegistry::sync(
     ChunkManager& chunkManager,
     MeshManager& meshManager,
@@ -14,6 +76,8 @@ void ChunkRenderRegistry::sync(
     const std::string_view materialScope,
     SceneRenderState& renderState)
 {
+    _lastSyncStats = {};
+
     ChunkManager::ChunkRenderResetEvent resetEvent;
     while (chunkManager.try_dequeue_render_reset(resetEvent))
     {
@@ -34,6 +98,22 @@ void ChunkRenderRegistry::sync(
             continue;
         }
 
+        if (matches_uploaded_mesh(readyEvent.chunk, readyEvent))
+        {
+            // Nothing visible changed (e.g. a neighbor edit that did not touch this chunk's faces);
+            // keep the live GPU mesh and drop the rebuilt copy instead of churning the allocator.
+            _pendingByChunk.erase(readyEvent.chunk);
+            // Interior air does not always show up in the faces, so keep the fresh connectivity.
+            _handlesByChunk.at(readyEvent.chunk).meshData->connectivity = readyEvent.meshData->connectivity;
+            chunkManager.notify_chunk_upload_skipped(
+                readyEvent.chunk,
+                readyEvent.generationId,
+                readyEvent.neighborhoodSignature,
+                _handlesByChunk.at(readyEvent.chunk).meshData);
+            ++_lastSyncStats.uploadsSkipped;
+            continue;
+        }
+
         _pendingByChunk[readyEvent.chunk] = PendingChunkRender{
             .chunk = readyEvent.chunk,
             .generationId = readyEvent.generationId,
@@ -51,6 +131,25 @@ void ChunkRenderRegistry::sync(
     }
 
     finalize_pending_renders(chunkManager, meshManager, materialManager, materialScope, renderState);
+
+    TracyPlot("ChunkRender Uploads Requested", static_cast<int64_t>(_lastSyncStats.uploadsRequested));
+    TracyPlot("ChunkRender Uploads Skipped", static_cast<int64_t>(_lastSyncStats.uploadsSkipped));
+}
+
+bool ChunkRenderRegistry::matches_uploaded_mesh(
+    Chunk* chunk,
+    const ChunkManager::ChunkRenderReadyEvent& readyEvent) const
+{
+    const auto it = _handlesByChunk.find(chunk);
+    if (it == _handlesByChunk.end() || it->second.meshData == nullptr ||
+        readyEvent.meshData == nullptr || readyEvent.data == nullptr)
+    {
+        return false;
+    }
+
+    // Vertices are chunk-local, so identical content only means an identical draw at the same coord.
+    return it->second.coord == readyEvent.data->coord &&
+        it->second.meshData->same_content(*readyEvent.meshData);
 }
 
 void ChunkRenderRegistry::finalize_pending_renders(
@@ -84,17 +183,22 @@ void ChunkRenderRegistry::finalize_pending_renders(
                 continue;
             }
 
+            const uint32_t uploadPriority = chunk_upload_priority(pending.data->coord, chunkManager.player_chunk());
+            pending.meshData->mesh->_uploadPriority = uploadPriority;
             meshManager.UploadQueue.enqueue(pending.meshData->mesh);
             if (pending.hasWaterTransparentMesh)
             {
+                pending.meshData->waterMesh->_uploadPriority = uploadPriority;
                 meshManager.UploadQueue.enqueue(pending.meshData->waterMesh);
             }
             if (pending.hasGlowTransparentMesh)
             {
+                pending.meshData->glowMesh->_uploadPriority = uploadPriority;
                 meshManager.UploadQueue.enqueue(pending.meshData->glowMesh);
             }
 
             pending.uploadRequested = true;
+            ++_lastSyncStats.uploadsRequested;
         }
 
         const bool opaqueReady = pending.meshData != nullptr &&
@@ -115,6 +219,7 @@ void ChunkRenderRegistry::finalize_pending_renders(
         remove_chunk(chunk, renderState);
 
         const glm::vec3 chunkWorldOrigin = chunkManager.geometry().chunk_world_origin(pending.data->coord);
+        const RenderBounds chunkBounds = chunk_world_bounds(chunkManager.geometry(), *pending.data);
 
         ChunkRenderHandles handles{};
         handles.opaque = renderState.opaqueObjects.insert(RenderObject{
@@ -122,7 +227,9 @@ void ChunkRenderRegistry::finalize_pending_renders(
             .material = materialManager.get_material(materialScope, "defaultmesh"),
             .transform = glm::translate(glm::mat4(1.0f), chunkWorldOrigin),
             .layer = RenderLayer::Opaque,
-            .lightingMode = LightingMode::BakedPlusDynamic
+            .lightingMode = LightingMode::BakedPlusDynamic,
+            .bounds = chunkBounds,
+            .indirectMaterial = materialManager.get_material(materialScope, "defaultmesh_indirect")
         });
         handles.hasOpaque = true;
 
@@ -133,7 +240,9 @@ void ChunkRenderRegistry::finalize_pending_renders(
                 .material = materialManager.get_material(materialScope, "watermesh"),
                 .transform = glm::translate(glm::mat4(1.0f), chunkWorldOrigin),
                 .layer = RenderLayer::Transparent,
-                .lightingMode = LightingMode::BakedChunk
+                .lightingMode = LightingMode::BakedChunk,
+                .bounds = chunkBounds,
+                .indirectMaterial = materialManager.get_material(materialScope, "watermesh_indirect")
             });
             handles.hasWaterTransparent = true;
         }
@@ -145,13 +254,22 @@ void ChunkRenderRegistry::finalize_pending_renders(
                 .material = materialManager.get_material(materialScope, "glowmesh"),
                 .transform = glm::translate(glm::mat4(1.0f), chunkWorldOrigin),
                 .layer = RenderLayer::Transparent,
-                .lightingMode = LightingMode::Unlit
+                .lightingMode = LightingMode::Unlit,
+                .bounds = chunkBounds
             });
             handles.hasGlowTransparent = true;
         }
 
+        if (const std::optional<render::OccluderBox> occluder = chunk_occluder(chunkManager.geometry(), *pending.data))
+        {
+            handles.occluder = renderState.occluders.insert(occluder.value());
+            handles.hasOccluder = true;
+        }
+
+        handles.coord = pending.data->coord;
+        handles.meshData = pending.meshData;
         _handlesByChunk[chunk] = handles;
-        chunkManager.notify_chunk_uploaded(chunk, pending.generationId, pending.neighborhoodSignature);
+        chunkManager.notify_chunk_uploaded(chunk, pending.generationId, pending.neighborhoodSignature, pending.meshData);
         completedChunks.push_back(chunk);
     }
 
@@ -161,6 +279,62 @@ void ChunkRenderRegistry::finalize_pending_renders(
     }
 }
 
+void ChunkRenderRegistry::update_section_visibility(
+    const WorldGeometry& geometry,
+    const glm::vec3& cameraPosition,
+    const std::optional<render::Frustum>& frustum,
+    const int chunkRadius,
+    const bool enabled,
+    SceneRenderState& renderState)
+{
+    ZoneScopedN("ChunkRenderRegistry::UpdateSectionVisibility");
+    _lastSectionVisibilityStats = {};
+    if (enabled)
+    {
+        _sectionVisibilityChunks.clear();
+        _sectionVisibilityChunks.reserve(_handlesByChunk.size());
+        for (const auto& [chunk, handles] : _handlesByChunk)
+        {
+            _sectionVisibilityChunks.push_back(SectionVisibilityChunk{
+                .coord = handles.coord,
+                .connectivity = handles.meshData != nullptr ? handles.meshData->connectivity.get() : nullptr
+            });
+        }
+        _lastSectionVisibilityStats = _sectionVisibility.update(geometry, cameraPosition, frustum, chunkRadius, _sectionVisibilityChunks);
+    }
+
+    for (const auto& [chunk, handles] : _handlesByChunk)
+    {
+        set_chunk_hidden(handles, enabled && !_sectionVisibility.is_chunk_visible(handles.coord), renderState);
+    }
+
+    TracyPlot("ChunkRender Hidden By Sections", static_cast<int64_t>(_lastSectionVisibilityStats.hiddenChunks));
+}
+
+void ChunkRenderRegistry::set_chunk_hidden(const ChunkRenderHandles& handles, const bool hidden, SceneRenderState& renderState)
+{
+    const auto apply = [hidden](RenderObject* object)
+    {
+        if (object != nullptr)
+        {
+            object->hidden = hidden;
+        }
+    };
+
+    if (handles.hasOpaque)
+    {
+        apply(renderState.opaqueObjects.get(handles.opaque));
+    }
+    if (handles.hasWaterTransparent)
+    {
+        apply(renderState.transparentObjects.get(handles.waterTransparent));
+    }
+    if (handles.hasGlowTransparent)
+    {
+        apply(renderState.transparentObjects.get(handles.glowTransparent));
+    }
+}
+
 void ChunkRenderRegistry::clear(SceneRenderState& renderState)
 {
     _pendingByChunk.clear();
@@ -208,5 +382,10 @@ void ChunkRenderRegistry::remove_chunk(Chunk* chunk, SceneRenderState& renderSta
         renderState.transparentObjects.remove(it->second.glowTransparent);
     }
 
+    if (it->second.hasOccluder)
+    {
+        renderState.occluders.remove(it->second.occluder);
+    }
+
     _handlesByChunk.erase(it);
 }
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <optional>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "collections/spare_set.h"
 #include "game/chunk.h"
 #include "render_primitives.h"
 #include "scene_render_state.h"
 #include "world/chunk_manager.h"
+#include "world/section_visibility.h"
 
 class MaterialManager;
 class MeshManager;
@@ -15,6 +18,13 @@ class MeshManager;
 class ChunkRenderRegistry
 {
 public:
+    struct SyncStats
+    {
+        uint32_t uploadsRequested{0};
+        // Ready meshes whose content hash matched the uploaded mesh and were not re-uploaded.
+        uint32_t uploadsSkipped{0};
+    };
+
     void sync(
         ChunkManager& chunkManager,
         MeshManager& meshManager,
@@ -22,7 +32,19 @@ public:
         std::string_view materialScope,
         SceneRenderState& renderState);
 
+    // Hides the objects of chunks the camera cannot see into through open sections (cave culling).
+    // With enabled false every chunk is shown again.
+    void update_section_visibility(
+        const WorldGeometry& geometry,
+        const glm::vec3& cameraPosition,
+        const std::optional<render::Frustum>& frustum,
+        int chunkRadius,
+        bool enabled,
+        SceneRenderState& renderState);
+
     void clear(SceneRenderState& renderState);
+    [[nodiscard]] const SyncStats& last_sync_stats() const noexcept { return _lastSyncStats; }
+    [[nodiscard]] const SectionVisibilityStats& last_section_visibility_stats() const noexcept { return _lastSectionVisibilityStats; }
 
 private:
     struct ChunkRenderHandles
@@ -33,6 +55,10 @@ private:
         bool hasOpaque{false};
         bool hasWaterTransparent{false};
         bool hasGlowTransparent{false};
+        dev_collections::sparse_set<render::OccluderBox>::Handle occluder{};
+        bool hasOccluder{false};
+        ChunkCoord coord{};
+        std::shared_ptr<ChunkMeshData> meshData{};
     };
 
     struct PendingChunkRender
@@ -49,8 +75,15 @@ private:
 
     std::unordered_map<Chunk*, ChunkRenderHandles> _handlesByChunk;
     std::unordered_map<Chunk*, PendingChunkRender> _pendingByChunk;
+    SyncStats _lastSyncStats{};
+    SectionVisibilityGraph _sectionVisibility{};
+    std::vector<SectionVisibilityChunk> _sectionVisibilityChunks{};
+    SectionVisibilityStats _lastSectionVisibilityStats{};
+
+    [[nodiscard]] bool matches_uploaded_mesh(Chunk* chunk, const ChunkManager::ChunkRenderReadyEvent& readyEvent) const;
 
     void remove_chunk(Chunk* chunk, SceneRenderState& renderState);
+    static void set_chunk_hidden(const ChunkRenderHandles& handles, bool hidden, SceneRenderState& renderState);
     void finalize_pending_renders(
         ChunkManager& chunkManager,
         MeshManager& meshManager,
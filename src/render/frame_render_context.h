@@ -22,6 +22,9 @@ struct FrameRenderContext
 
     ImageResource fullscreenImage{};
     ImageResource depthImage{};
+    VkBuffer quadIndexBuffer{VK_NULL_HANDLE};
+    uint32_t frameSlot{0};
+    bool multiDrawIndirect{false};
 
     MaterialManager* materialManager{};
 };
@@ -0,0 +1,184 @@
+#include "frustum_culling.h"
+
+#include <algorithm>
+
+#include <glm/geometric.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULLING_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FRUSTUM_CULLING_NEON 1
+#endif
+
+namespace render
+{
+    namespace
+    {
+        constexpr size_t BatchWidth = 4;
+
+        glm::vec4 matrix_row(const glm::mat4& matrix, const int row)
+        {
+            return glm::vec4(matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]);
+        }
+
+        struct BoundsBatch
+        {
+            const float* minX;
+            const float* minY;
+            const float* minZ;
+            const float* maxX;
+            const float* maxY;
+            const float* maxZ;
+        };
+
+        // Bit i is set when box i lies entirely behind at least one plane. Only the corner furthest
+        // along each plane normal is tested, so the choice of min/max is per plane rather than per lane.
+        uint32_t outside_mask(const Frustum& frustum, const BoundsBatch& batch)
+        {
+#if defined(FRUSTUM_CULLING_SSE2)
+            const __m128 zero = _mm_setzero_ps();
+            __m128 outside = zero;
+            for (const glm::vec4& plane : frustum.planes)
+            {
+                const __m128 px = _mm_loadu_ps(plane.x >= 0.0f ? batch.maxX : batch.minX);
+                const __m128 py = _mm_loadu_ps(plane.y >= 0.0f ? batch.maxY : batch.minY);
+                const __m128 pz = _mm_loadu_ps(plane.z >= 0.0f ? batch.maxZ : batch.minZ);
+                const __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), px), _mm_mul_ps(_mm_set1_ps(plane.y), py)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), pz), _mm_set1_ps(plane.w)));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+            }
+            return static_cast<uint32_t>(_mm_movemask_ps(outside));
+#elif defined(FRUSTUM_CULLING_NEON)
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            uint32x4_t outside = vdupq_n_u32(0);
+            for (const glm::vec4& plane : frustum.planes)
+            {
+                const float32x4_t px = vld1q_f32(plane.x >= 0.0f ? batch.maxX : batch.minX);
+                const float32x4_t py = vld1q_f32(plane.y >= 0.0f ? batch.maxY : batch.minY);
+                const float32x4_t pz = vld1q_f32(plane.z >= 0.0f ? batch.maxZ : batch.minZ);
+                float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(plane.w), px, plane.x);
+                distance = vmlaq_n_f32(distance, py, plane.y);
+                distance = vmlaq_n_f32(distance, pz, plane.z);
+                outside = vorrq_u32(outside, vcltq_f32(distance, zero));
+            }
+            const uint32x4_t laneBits = {1u, 2u, 4u, 8u};
+            return vaddvq_u32(vandq_u32(outside, laneBits));
+#else
+            uint32_t mask = 0;
+            for (size_t lane = 0; lane < BatchWidth; ++lane)
+            {
+                for (const glm::vec4& plane : frustum.planes)
+                {
+                    const float px = plane.x >= 0.0f ? batch.maxX[lane] : batch.minX[lane];
+                    const float py = plane.y >= 0.0f ? batch.maxY[lane] : batch.minY[lane];
+                    const float pz = plane.z >= 0.0f ? batch.maxZ[lane] : batch.minZ[lane];
+                    if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f)
+                    {
+                        mask |= 1u << lane;
+                        break;
+                    }
+                }
+            }
+            return mask;
+#endif
+        }
+    }
+
+    Frustum extract_frustum(const glm::mat4& viewProjection) noexcept
+    {
+        const glm::vec4 row0 = matrix_row(viewProjection, 0);
+        const glm::vec4 row1 = matrix_row(viewProjection, 1);
+        const glm::vec4 row2 = matrix_row(viewProjection, 2);
+        const glm::vec4 row3 = matrix_row(viewProjection, 3);
+
+        // The near plane uses the -w..w convention; with a 0..1 depth range that only admits a sliver
+        // behind the camera, which keeps the test conservative for either projection style.
+        return Frustum{
+            .planes = {
+                row3 + row0,
+                row3 - row0,
+                row3 + row1,
+                row3 - row1,
+                row3 + row2,
+                row3 - row2
+            }
+        };
+    }
+
+    bool intersects(const Frustum& frustum, const RenderBounds& bounds) noexcept
+    {
+        if (!bounds.valid)
+        {
+            return true;
+        }
+
+        for (const glm::vec4& plane : frustum.planes)
+        {
+            const glm::vec3 positive(
+                plane.x >= 0.0f ? bounds.max.x : bounds.min.x,
+                plane.y >= 0.0f ? bounds.max.y : bounds.min.y,
+                plane.z >= 0.0f ? bounds.max.z : bounds.min.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    CullStats FrustumCuller::cull(const Frustum& frustum, const std::span<const RenderObject> objects, std::vector<uint32_t>& visibleIndices)
+    {
+        visibleIndices.clear();
+        visibleIndices.reserve(objects.size());
+
+        const size_t paddedCount = (objects.size() + BatchWidth - 1) / BatchWidth * BatchWidth;
+        for (std::vector<float>* lane : {&m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ})
+        {
+            lane->resize(paddedCount);
+        }
+
+        for (size_t index = 0; index < paddedCount; ++index)
+        {
+            const RenderBounds bounds = index < objects.size() ? objects[index].bounds : RenderBounds{};
+            m_minX[index] = bounds.min.x;
+            m_minY[index] = bounds.min.y;
+            m_minZ[index] = bounds.min.z;
+            m_maxX[index] = bounds.max.x;
+            m_maxY[index] = bounds.max.y;
+            m_maxZ[index] = bounds.max.z;
+        }
+
+        CullStats stats{};
+        for (size_t base = 0; base < paddedCount; base += BatchWidth)
+        {
+            const uint32_t outside = outside_mask(frustum, BoundsBatch{
+                .minX = m_minX.data() + base,
+                .minY = m_minY.data() + base,
+                .minZ = m_minZ.data() + base,
+                .maxX = m_maxX.data() + base,
+                .maxY = m_maxY.data() + base,
+                .maxZ = m_maxZ.data() + base
+            });
+
+            const size_t laneCount = std::min(BatchWidth, objects.size() - base);
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                const size_t index = base + lane;
+                if (objects[index].hidden || ((outside & (1u << lane)) != 0 && objects[index].bounds.valid))
+                {
+                    ++stats.culled;
+                    continue;
+                }
+
+                visibleIndices.push_back(static_cast<uint32_t>(index));
+                ++stats.visible;
+            }
+        }
+
+        return stats;
+    }
+}
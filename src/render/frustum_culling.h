@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "render_primitives.h"
+
+namespace render
+{
+    struct Frustum
+    {
+        // Left, right, bottom, top, near, far as (a, b, c, d); a point is inside when dot(abc, p) + d >= 0.
+        std::array<glm::vec4, 6> planes{};
+    };
+
+    struct CullStats
+    {
+        uint32_t visible{0};
+        uint32_t culled{0};
+    };
+
+    [[nodiscard]] Frustum extract_frustum(const glm::mat4& viewProjection) noexcept;
+    [[nodiscard]] bool intersects(const Frustum& frustum, const RenderBounds& bounds) noexcept;
+
+    // Tests object bounds four at a time and writes the indices of surviving objects in draw order.
+    // Objects without bounds are always kept unless hidden.
+    class FrustumCuller
+    {
+    public:
+        CullStats cull(const Frustum& frustum, std::span<const RenderObject> objects, std::vector<uint32_t>& visibleIndices);
+
+    private:
+        std::vector<float> m_minX{};
+        std::vector<float> m_minY{};
+        std::vector<float> m_minZ{};
+        std::vector<float> m_maxX{};
+        std::vector<float> m_maxY{};
+        std::vector<float> m_maxZ{};
+    };
+}
@@ -0,0 +1,103 @@
+#include "horizon_render_registry.h"
+
+#include <glm/ext/matrix_transform.hpp>
+#include <tracy/Tracy.hpp>
+
+#include "material_manager.h"
+#include "mesh_manager.h"
+#include "world/chunk_manager.h"
+
+void HorizonRenderRegistry::sync(
+    ChunkManager& chunkManager,
+    MeshManager& meshManager,
+    MaterialManager& materialManager,
+    const std::string_view materialScope,
+    SceneRenderState& renderState)
+{
+    ZoneScopedN("HorizonRenderRegistry::Sync");
+
+    HorizonTileEvent event;
+    while (chunkManager.try_dequeue_horizon_tile(event))
+    {
+        if (event.mesh == nullptr || event.mesh->_vertices.empty())
+        {
+            if (const auto it = _tiles.find(event.coord); it != _tiles.end())
+            {
+                release_tile(it->second, renderState);
+                _tiles.erase(it);
+            }
+            continue;
+        }
+
+        TileRender& tile = _tiles[event.coord];
+        tile.pendingMesh = std::move(event.mesh);
+        tile.pendingWorldOrigin = event.worldOrigin;
+        tile.pendingBounds = event.bounds;
+        tile.uploadRequested = false;
+    }
+
+    uint32_t uploadsRequested = 0;
+    for (auto& [coord, tile] : _tiles)
+    {
+        if (tile.pendingMesh == nullptr)
+        {
+            continue;
+        }
+
+        if (!tile.uploadRequested)
+        {
+            if (!meshManager.accepts_uploads())
+            {
+                continue;
+            }
+
+            meshManager.UploadQueue.enqueue(tile.pendingMesh);
+            tile.uploadRequested = true;
+            ++uploadsRequested;
+        }
+
+        if (!tile.pendingMesh->_isActive.load(std::memory_order::acquire))
+        {
+            continue;
+        }
+
+        if (tile.hasObject)
+        {
+            renderState.opaqueObjects.remove(tile.object);
+        }
+
+        tile.mesh = std::move(tile.pendingMesh);
+        tile.object = renderState.opaqueObjects.insert(RenderObject{
+            .mesh = tile.mesh,
+            .material = materialManager.get_material(materialScope, "defaultmesh"),
+            .transform = glm::translate(glm::mat4(1.0f), tile.pendingWorldOrigin),
+            .layer = RenderLayer::Opaque,
+            .lightingMode = LightingMode::BakedChunk,
+            .bounds = tile.pendingBounds,
+            .indirectMaterial = materialManager.get_material(materialScope, "defaultmesh_indirect")
+        });
+        tile.hasObject = true;
+    }
+
+    TracyPlot("Horizon Uploads Requested", static_cast<int64_t>(uploadsRequested));
+}
+
+void HorizonRenderRegistry::clear(SceneRenderState& renderState)
+{
+    for (auto& [coord, tile] : _tiles)
+    {
+        release_tile(tile, renderState);
+    }
+    _tiles.clear();
+}
+
+void HorizonRenderRegistry::release_tile(TileRender& tile, SceneRenderState& renderState)
+{
+    if (tile.hasObject)
+    {
+        renderState.opaqueObjects.remove(tile.object);
+        tile.hasObject = false;
+    }
+    tile.mesh.reset();
+    tile.pendingMesh.reset();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+#include "collections/spare_set.h"
+#include "render_primitives.h"
+#include "scene_render_state.h"
+#include "world/horizon_terrain.h"
+
+class ChunkManager;
+class MaterialManager;
+class MeshManager;
+
+// Mirrors the chunk manager's horizon tiles into the opaque draw list. A rebuilt tile keeps drawing its
+// previous mesh until the replacement has finished uploading.
+class HorizonRenderRegistry
+{
+public:
+    void sync(
+        ChunkManager& chunkManager,
+        MeshManager& meshManager,
+        MaterialManager& materialManager,
+        std::string_view materialScope,
+        SceneRenderState& renderState);
+
+    void clear(SceneRenderState& renderState);
+    [[nodiscard]] size_t tile_count() const noexcept { return _tiles.size(); }
+
+private:
+    struct TileRender
+    {
+        dev_collections::sparse_set<RenderObject>::Handle object{};
+        bool hasObject{false};
+        std::shared_ptr<Mesh> mesh{};
+        std::shared_ptr<Mesh> pendingMesh{};
+        glm::vec3 pendingWorldOrigin{0.0f};
+        RenderBounds pendingBounds{};
+        bool uploadRequested{false};
+    };
+
+    std::unordered_map<HorizonTileCoord, TileRender, HorizonTileCoordHash> _tiles;
+
+    static void release_tile(TileRender& tile, SceneRenderState& renderState);
+};
@@ -0,0 +1,74 @@
+#include "indirect_draw_buffers.h"
+
+#include <cstring>
+
+#include "constants.h"
+#include "vk_util.h"
+
+namespace render
+{
+    namespace
+    {
+        void copy_to_buffer(const VmaAllocator allocator, const AllocatedBuffer& buffer, const VkDeviceSize offset, const void* source, const size_t size)
+        {
+            if (size == 0)
+            {
+                return;
+            }
+
+            void* data;
+            vmaMapMemory(allocator, buffer._allocation, &data);
+            std::memcpy(static_cast<std::byte*>(data) + offset, source, size);
+            vmaUnmapMemory(allocator, buffer._allocation);
+        }
+    }
+
+    IndirectDrawBuffers::IndirectDrawBuffers(const ResourceBackendContext backend, const uint32_t drawCapacity, const uint32_t commandCapacity) :
+        m_backend(backend),
+        m_drawCapacity(drawCapacity),
+        m_commandCapacity(commandCapacity)
+    {
+        const AllocatedBuffer drawDataBuffer = vkutil::create_buffer(
+            backend.allocator,
+            static_cast<size_t>(drawCapacity) * FRAME_OVERLAP * sizeof(ObjectPushConstants),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU);
+        const AllocatedBuffer commandBuffer = vkutil::create_buffer(
+            backend.allocator,
+            static_cast<size_t>(commandCapacity) * FRAME_OVERLAP * sizeof(VkDrawIndexedIndirectCommand),
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU);
+        m_drawData = std::make_shared<Resource>(backend, Resource::BUFFER, Resource::ResourceValue(drawDataBuffer));
+        m_commands = std::make_shared<Resource>(backend, Resource::BUFFER, Resource::ResourceValue(commandBuffer));
+    }
+
+    IndirectDrawLimits IndirectDrawBuffers::limits_for_slot(const uint32_t slot) const noexcept
+    {
+        return IndirectDrawLimits{
+            .maxDraws = m_drawCapacity,
+            .maxCommands = m_commandCapacity,
+            .firstDrawIndex = slot * m_drawCapacity
+        };
+    }
+
+    VkDeviceSize IndirectDrawBuffers::command_offset(const uint32_t slot, const uint32_t firstCommand) const noexcept
+    {
+        return (static_cast<VkDeviceSize>(slot) * m_commandCapacity + firstCommand) * sizeof(VkDrawIndexedIndirectCommand);
+    }
+
+    void IndirectDrawBuffers::write(const uint32_t slot, const IndirectDrawList& list) const
+    {
+        copy_to_buffer(
+            m_backend.allocator,
+            m_drawData->value.buffer,
+            static_cast<VkDeviceSize>(slot) * m_drawCapacity * sizeof(ObjectPushConstants),
+            list.drawData.data(),
+            list.drawData.size() * sizeof(ObjectPushConstants));
+        copy_to_buffer(
+            m_backend.allocator,
+            m_commands->value.buffer,
+            command_offset(slot, 0),
+            list.commands.data(),
+            list.commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
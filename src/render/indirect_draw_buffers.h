@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+
+#include "indirect_draw_builder.h"
+#include "resource.h"
+
+namespace render
+{
+    // Host-visible draw-data (storage) and indirect command buffers, split into one slice per frame in flight.
+    // The draw-data resource is bound once in the indirect material; slices are addressed through firstInstance.
+    class IndirectDrawBuffers
+    {
+    public:
+        IndirectDrawBuffers(ResourceBackendContext backend, uint32_t drawCapacity, uint32_t commandCapacity);
+
+        [[nodiscard]] const std::shared_ptr<Resource>& draw_data_resource() const noexcept { return m_drawData; }
+        [[nodiscard]] VkBuffer command_buffer() const noexcept { return m_commands->value.buffer._buffer; }
+        [[nodiscard]] IndirectDrawLimits limits_for_slot(uint32_t slot) const noexcept;
+        [[nodiscard]] VkDeviceSize command_offset(uint32_t slot, uint32_t firstCommand) const noexcept;
+
+        void write(uint32_t slot, const IndirectDrawList& list) const;
+
+    private:
+        ResourceBackendContext m_backend{};
+        uint32_t m_drawCapacity{0};
+        uint32_t m_commandCapacity{0};
+        std::shared_ptr<Resource> m_drawData{};
+        std::shared_ptr<Resource> m_commands{};
+    };
+}
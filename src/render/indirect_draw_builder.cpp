@@ -0,0 +1,150 @@
+#include "indirect_draw_builder.h"
+
+#include <algorithm>
+
+#include "mesh.h"
+
+namespace render
+{
+    namespace
+    {
+        enum class Eligibility : uint8_t
+        {
+            Skip,
+            Fallback,
+            Batch
+        };
+
+        Eligibility classify(const RenderObject& object, const VkBuffer vertexBuffer)
+        {
+            if (object.mesh == nullptr || !object.mesh->_isActive.load(std::memory_order::acquire))
+            {
+                return Eligibility::Skip;
+            }
+
+            const MeshAllocation& allocation = object.mesh->_allocation;
+            if (object.indirectMaterial == nullptr ||
+                !object.mesh->uses_shared_quad_indices() ||
+                allocation.allocator == nullptr ||
+                allocation.vertexOffset % sizeof(Vertex) != 0)
+            {
+                return Eligibility::Fallback;
+            }
+
+            if (vertexBuffer != VK_NULL_HANDLE && allocation.vertexBuffer != vertexBuffer)
+            {
+                return Eligibility::Fallback;
+            }
+
+            return Eligibility::Batch;
+        }
+    }
+
+    void IndirectDrawList::clear()
+    {
+        vertexBuffer = VK_NULL_HANDLE;
+        commands.clear();
+        drawData.clear();
+        runs.clear();
+        fallbackIndices.clear();
+    }
+
+    IndirectDrawStats IndirectDrawList::stats() const noexcept
+    {
+        return IndirectDrawStats{
+            .batchedObjects = static_cast<uint32_t>(drawData.size()),
+            .commands = static_cast<uint32_t>(commands.size()),
+            .indirectCalls = static_cast<uint32_t>(runs.size()),
+            .fallbackObjects = static_cast<uint32_t>(fallbackIndices.size())
+        };
+    }
+
+    void IndirectDrawBuilder::build(
+        const std::span<const RenderObject> objects,
+        const std::span<const uint32_t> visibleIndices,
+        const IndirectDrawLimits& limits,
+        IndirectDrawList& list)
+    {
+        list.clear();
+        m_pending.clear();
+
+        // First pass: route objects and assign each batched object to its material's run.
+        for (const uint32_t objectIndex : visibleIndices)
+        {
+            const RenderObject& object = objects[objectIndex];
+            switch (classify(object, list.vertexBuffer))
+            {
+            case Eligibility::Skip:
+                continue;
+            case Eligibility::Fallback:
+                list.fallbackIndices.push_back(objectIndex);
+                continue;
+            case Eligibility::Batch:
+                break;
+            }
+
+            list.vertexBuffer = object.mesh->_allocation.vertexBuffer;
+            const auto runIt = std::ranges::find_if(list.runs, [&object](const IndirectDrawRun& run)
+            {
+                return run.material == object.indirectMaterial;
+            });
+            const auto runIndex = static_cast<uint32_t>(std::distance(list.runs.begin(), runIt));
+            if (runIt == list.runs.end())
+            {
+                list.runs.push_back(IndirectDrawRun{ .material = object.indirectMaterial });
+            }
+
+            m_pending.push_back(PendingDraw{
+                .runIndex = runIndex,
+                .objectIndex = objectIndex
+            });
+        }
+
+        // Second pass: emit commands so every run occupies one contiguous range of the command array.
+        std::ranges::stable_sort(m_pending, {}, &PendingDraw::runIndex);
+        for (const PendingDraw& pending : m_pending)
+        {
+            const RenderObject& object = objects[pending.objectIndex];
+            const MeshAllocation& allocation = object.mesh->_allocation;
+            const uint32_t quadCount = allocation.indicesSize / IndicesPerQuad;
+            const uint32_t batchCount = quad_draw_batch_count(quadCount);
+            if (batchCount == 0)
+            {
+                continue;
+            }
+
+            if (list.drawData.size() + 1 > limits.maxDraws || list.commands.size() + batchCount > limits.maxCommands)
+            {
+                list.fallbackIndices.push_back(pending.objectIndex);
+                continue;
+            }
+
+            IndirectDrawRun& run = list.runs[pending.runIndex];
+            if (run.commandCount == 0)
+            {
+                run.firstCommand = static_cast<uint32_t>(list.commands.size());
+            }
+
+            const uint32_t drawIndex = static_cast<uint32_t>(list.drawData.size());
+            const int32_t baseVertex = static_cast<int32_t>(allocation.vertexOffset / sizeof(Vertex));
+            list.drawData.push_back(make_object_push_constants(object));
+            for (uint32_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+            {
+                const QuadDrawBatch batch = quad_draw_batch(quadCount, batchIndex);
+                list.commands.push_back(VkDrawIndexedIndirectCommand{
+                    .indexCount = batch.indexCount,
+                    .instanceCount = 1,
+                    .firstIndex = 0,
+                    .vertexOffset = baseVertex + batch.vertexOffset,
+                    .firstInstance = limits.firstDrawIndex + drawIndex
+                });
+            }
+            run.commandCount += batchCount;
+        }
+
+        std::erase_if(list.runs, [](const IndirectDrawRun& run)
+        {
+            return run.commandCount == 0;
+        });
+    }
+}
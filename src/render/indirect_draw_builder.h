@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "render_primitives.h"
+
+namespace render
+{
+    struct IndirectDrawLimits
+    {
+        uint32_t maxDraws{0};
+        uint32_t maxCommands{0};
+        // Offset added to every firstInstance so each frame slice of the draw-data buffer is addressed directly.
+        uint32_t firstDrawIndex{0};
+    };
+
+    // Commands for one material; recorded as a single vkCmdDrawIndexedIndirect.
+    struct IndirectDrawRun
+    {
+        std::shared_ptr<Material> material{};
+        uint32_t firstCommand{0};
+        uint32_t commandCount{0};
+    };
+
+    struct IndirectDrawStats
+    {
+        uint32_t batchedObjects{0};
+        uint32_t commands{0};
+        uint32_t indirectCalls{0};
+        uint32_t fallbackObjects{0};
+    };
+
+    struct IndirectDrawList
+    {
+        VkBuffer vertexBuffer{VK_NULL_HANDLE};
+        std::vector<VkDrawIndexedIndirectCommand> commands{};
+        // One entry per batched object, indexed in the shader by gl_InstanceIndex - firstDrawIndex.
+        std::vector<ObjectPushConstants> drawData{};
+        std::vector<IndirectDrawRun> runs{};
+        // Visible objects that still need the per-object path.
+        std::vector<uint32_t> fallbackIndices{};
+
+        void clear();
+        [[nodiscard]] IndirectDrawStats stats() const noexcept;
+    };
+
+    // Turns a visible list into indirect commands grouped by material. Objects join a batch when they
+    // have an indirect material, draw from the shared quad indices and live in the same vertex buffer
+    // at a vertex-aligned offset; everything else is routed to fallbackIndices.
+    class IndirectDrawBuilder
+    {
+    public:
+        void build(
+            std::span<const RenderObject> objects,
+            std::span<const uint32_t> visibleIndices,
+            const IndirectDrawLimits& limits,
+            IndirectDrawList& list);
+
+    private:
+        struct PendingDraw
+        {
+            uint32_t runIndex{0};
+            uint32_t objectIndex{0};
+        };
+
+        std::vector<PendingDraw> m_pending{};
+    };
+}
@@ -0,0 +1,37 @@
+#include "instance_data_buffer.h"
+
+#include <cstring>
+
+#include "constants.h"
+#include "vk_util.h"
+
+namespace render
+{
+    InstanceDataBuffer::InstanceDataBuffer(const ResourceBackendContext backend, const uint32_t capacity) :
+        m_backend(backend),
+        m_capacity(capacity)
+    {
+        const AllocatedBuffer buffer = vkutil::create_buffer(
+            backend.allocator,
+            static_cast<size_t>(capacity) * FRAME_OVERLAP * sizeof(ObjectPushConstants),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU);
+        m_instanceData = std::make_shared<Resource>(backend, Resource::BUFFER, Resource::ResourceValue(buffer));
+    }
+
+    void InstanceDataBuffer::write(const uint32_t slot, const InstancedDrawList& list) const
+    {
+        if (list.instanceData.empty())
+        {
+            return;
+        }
+
+        void* data;
+        vmaMapMemory(m_backend.allocator, m_instanceData->value.buffer._allocation, &data);
+        std::memcpy(
+            static_cast<std::byte*>(data) + static_cast<size_t>(first_instance_for_slot(slot)) * sizeof(ObjectPushConstants),
+            list.instanceData.data(),
+            list.instanceData.size() * sizeof(ObjectPushConstants));
+        vmaUnmapMemory(m_backend.allocator, m_instanceData->value.buffer._allocation);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+
+#include "instanced_draw_builder.h"
+#include "resource.h"
+
+namespace render
+{
+    // Host-visible per-instance storage buffer with one slice per frame in flight. The resource is bound
+    // once in the instanced material; draws select their slice through firstInstance.
+    class InstanceDataBuffer
+    {
+    public:
+        InstanceDataBuffer(ResourceBackendContext backend, uint32_t capacity);
+
+        [[nodiscard]] const std::shared_ptr<Resource>& resource() const noexcept { return m_instanceData; }
+        [[nodiscard]] uint32_t capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] uint32_t first_instance_for_slot(const uint32_t slot) const noexcept { return slot * m_capacity; }
+
+        void write(uint32_t slot, const InstancedDrawList& list) const;
+
+    private:
+        ResourceBackendContext m_backend{};
+        uint32_t m_capacity{0};
+        std::shared_ptr<Resource> m_instanceData{};
+    };
+}
@@ -0,0 +1,82 @@
+#include "instanced_draw_builder.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "mesh.h"
+
+namespace render
+{
+    void InstancedDrawList::clear()
+    {
+        instanceData.clear();
+        batches.clear();
+        stats = {};
+    }
+
+    void InstancedDrawBuilder::build(
+        const std::span<const InstanceGroup> groups,
+        const std::optional<Frustum>& frustum,
+        const uint32_t maxInstances,
+        const uint32_t firstInstance,
+        InstancedDrawList& list)
+    {
+        list.clear();
+        m_visibleGroups.clear();
+
+        for (uint32_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+        {
+            const InstanceGroup& group = groups[groupIndex];
+            if (group.mesh == nullptr || group.material == nullptr || group.instances.empty() ||
+                !group.mesh->_isActive.load(std::memory_order::acquire))
+            {
+                continue;
+            }
+
+            if (frustum.has_value() && group.bounds.valid && !intersects(frustum.value(), group.bounds))
+            {
+                ++list.stats.culledGroups;
+                continue;
+            }
+
+            m_visibleGroups.push_back(groupIndex);
+        }
+        list.stats.visibleGroups = static_cast<uint32_t>(m_visibleGroups.size());
+
+        // Adjacent groups with the same mesh and material merge into one batch.
+        const auto batchKey = [&groups](const uint32_t groupIndex)
+        {
+            return std::pair{ groups[groupIndex].mesh.get(), groups[groupIndex].material.get() };
+        };
+        std::ranges::stable_sort(m_visibleGroups, std::less{}, batchKey);
+
+        for (const uint32_t groupIndex : m_visibleGroups)
+        {
+            const InstanceGroup& group = groups[groupIndex];
+            const auto available = static_cast<uint32_t>(maxInstances - list.instanceData.size());
+            const uint32_t count = std::min(static_cast<uint32_t>(group.instances.size()), available);
+            list.stats.droppedInstances += static_cast<uint32_t>(group.instances.size()) - count;
+            if (count == 0)
+            {
+                continue;
+            }
+
+            if (list.batches.empty() ||
+                list.batches.back().mesh != group.mesh ||
+                list.batches.back().material != group.material)
+            {
+                list.batches.push_back(InstancedDrawBatch{
+                    .mesh = group.mesh,
+                    .material = group.material,
+                    .firstInstance = firstInstance + static_cast<uint32_t>(list.instanceData.size())
+                });
+            }
+
+            list.instanceData.insert(list.instanceData.end(), group.instances.begin(), group.instances.begin() + count);
+            list.batches.back().instanceCount += count;
+        }
+
+        list.stats.instances = static_cast<uint32_t>(list.instanceData.size());
+        list.stats.batches = static_cast<uint32_t>(list.batches.size());
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "frustum_culling.h"
+#include "render_primitives.h"
+
+namespace render
+{
+    // Many copies of one mesh, such as the flowers of one chunk. The bounds cover every instance so the
+    // group is culled as a single box.
+    struct InstanceGroup
+    {
+        std::shared_ptr<Mesh> mesh{};
+        std::shared_ptr<Material> material{};
+        RenderBounds bounds{};
+        std::vector<ObjectPushConstants> instances{};
+    };
+
+    // Instances [firstInstance, firstInstance + instanceCount) of the per-instance buffer, drawn with one
+    // instanced draw of the mesh.
+    struct InstancedDrawBatch
+    {
+        std::shared_ptr<Mesh> mesh{};
+        std::shared_ptr<Material> material{};
+        uint32_t firstInstance{0};
+        uint32_t instanceCount{0};
+    };
+
+    struct InstancedDrawStats
+    {
+        uint32_t visibleGroups{0};
+        uint32_t culledGroups{0};
+        uint32_t instances{0};
+        uint32_t batches{0};
+        // Instances past the buffer capacity; they are skipped for the frame.
+        uint32_t droppedInstances{0};
+    };
+
+    struct InstancedDrawList
+    {
+        // Every batch's instances are contiguous, in batch order.
+        std::vector<ObjectPushConstants> instanceData{};
+        std::vector<InstancedDrawBatch> batches{};
+        InstancedDrawStats stats{};
+
+        void clear();
+    };
+
+    // Culls instance groups and concatenates the survivors that share a mesh and material, so a mesh
+    // scattered over many chunks still costs one draw.
+    class InstancedDrawBuilder
+    {
+    public:
+        // firstInstance offsets every batch so each frame slice of the instance buffer is addressed directly.
+        void build(
+            std::span<const InstanceGroup> groups,
+            const std::optional<Frustum>& frustum,
+            uint32_t maxInstances,
+            uint32_t firstInstance,
+            InstancedDrawList& list);
+
+    private:
+        std::vector<uint32_t> m_visibleGroups{};
+    };
+}
@@ -5,6 +5,9 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
+#include <array>
+
+#include "constants.h"
 #include "render_primitives.h"
 #include "resource.h"
 
@@ -50,7 +53,8 @@ struct Material {
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
 
-    std::vector<VkDescriptorSet> descriptorSets;
+    // One copy of the sets per frame slot; they differ only in which block of a per-frame uniform they bind.
+    std::array<std::vector<VkDescriptorSet>, FRAME_OVERLAP> descriptorSets;
     MaterialBindings bindings;
 
     std::vector<PushConstant> pushConstants;
@@ -11,7 +11,7 @@ namespace
     struct MaterialDescriptorState
     {
         std::vector<VkDescriptorSetLayout> layouts;
-        std::vector<VkDescriptorSet> descriptorSets;
+        std::array<std::vector<VkDescriptorSet>, FRAME_OVERLAP> descriptorSets;
     };
 
     void validate_descriptor_sets_are_contiguous(const std::vector<ReflectedDescriptorSet>& descriptorSets)
@@ -77,7 +77,7 @@ namespace
         }
     }
 
-    VkDescriptorBufferInfo resolve_buffer_info(const MaterialBinding& binding)
+    VkDescriptorBufferInfo resolve_buffer_info(const MaterialBinding& binding, const uint32_t frameSlot)
     {
         if (binding.bufferInfo.has_value())
         {
@@ -86,10 +86,11 @@ namespace
 
         if (binding.resource != nullptr && binding.resource->type == Resource::BUFFER)
         {
+            const VkDeviceSize frameStride = binding.resource->frameStride;
             return VkDescriptorBufferInfo{
                 .buffer = binding.resource->value.buffer._buffer,
-                .offset = 0,
-                .range = binding.resource->value.buffer._size
+                .offset = frameStride * frameSlot,
+                .range = frameStride > 0 ? frameStride : binding.resource->value.buffer._size
             };
         }
 
@@ -120,58 +121,65 @@ namespace
         const MaterialBindings& bindings,
         const VkDevice device,
         vkutil::DescriptorLayoutCache& layoutCache,
-        vkutil::DescriptorAllocator& allocator)
+        vkutil::DescriptorAllocator& allocator,
+        std::mutex& allocatorMutex)
     {
+        // The layout cache and descriptor pools are shared by every build, including background ones.
+        std::scoped_lock lock(allocatorMutex);
         MaterialDescriptorState state{
             .layouts = shaderProgram.create_descriptor_set_layouts(layoutCache)
         };
 
-        state.descriptorSets.reserve(state.layouts.size());
-
-        for (size_t setIndex = 0; setIndex < state.layouts.size(); ++setIndex)
+        for (uint32_t frameSlot = 0; frameSlot < FRAME_OVERLAP; ++frameSlot)
         {
-            const ReflectedDescriptorSet& reflectedSet = shaderProgram.descriptor_sets()[setIndex];
-            const VkDescriptorSet descriptorSet = allocate_descriptor_set(allocator, state.layouts[setIndex]);
-            std::vector<VkWriteDescriptorSet> writes;
-            std::vector<VkDescriptorBufferInfo> bufferInfos;
-            std::vector<VkDescriptorImageInfo> imageInfos;
-
-            writes.reserve(reflectedSet.bindings.size());
-            bufferInfos.reserve(reflectedSet.bindings.size());
-            imageInfos.reserve(reflectedSet.bindings.size());
+            std::vector<VkDescriptorSet>& frameSets = state.descriptorSets[frameSlot];
+            frameSets.reserve(state.layouts.size());
 
-            for (const ReflectedDescriptorBinding& reflectedBinding : reflectedSet.bindings)
+            for (size_t setIndex = 0; setIndex < state.layouts.size(); ++setIndex)
             {
-                const MaterialBinding& binding = find_binding(bindings, reflectedSet.set, reflectedBinding.binding);
+                const ReflectedDescriptorSet& reflectedSet = shaderProgram.descriptor_sets()[setIndex];
+                const VkDescriptorSet descriptorSet = allocate_descriptor_set(allocator, state.layouts[setIndex]);
+                std::vector<VkWriteDescriptorSet> writes;
+                std::vector<VkDescriptorBufferInfo> bufferInfos;
+                std::vector<VkDescriptorImageInfo> imageInfos;
 
-                if (reflectedBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
-                    reflectedBinding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                writes.reserve(reflectedSet.bindings.size());
+                bufferInfos.reserve(reflectedSet.bindings.size());
+                imageInfos.reserve(reflectedSet.bindings.size());
+
+                for (const ReflectedDescriptorBinding& reflectedBinding : reflectedSet.bindings)
                 {
-                    bufferInfos.push_back(resolve_buffer_info(binding));
+                    const MaterialBinding& binding = find_binding(bindings, reflectedSet.set, reflectedBinding.binding);
+
+                    if (reflectedBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+                        reflectedBinding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                    {
+                        bufferInfos.push_back(resolve_buffer_info(binding, frameSlot));
+                        writes.push_back(VkWriteDescriptorSet{
+                            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                            .dstSet = VK_NULL_HANDLE,
+                            .dstBinding = reflectedBinding.binding,
+                            .descriptorCount = 1,
+                            .descriptorType = reflectedBinding.descriptorType,
+                            .pBufferInfo = &bufferInfos.back()
+                        });
+                        continue;
+                    }
+
+                    imageInfos.push_back(resolve_image_info(binding));
                     writes.push_back(VkWriteDescriptorSet{
                         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
                         .dstSet = VK_NULL_HANDLE,
                         .dstBinding = reflectedBinding.binding,
                         .descriptorCount = 1,
                         .descriptorType = reflectedBinding.descriptorType,
-                        .pBufferInfo = &bufferInfos.back()
+                        .pImageInfo = &imageInfos.back()
                     });
-                    continue;
                 }
 
-                imageInfos.push_back(resolve_image_info(binding));
-                writes.push_back(VkWriteDescriptorSet{
-                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                    .dstSet = VK_NULL_HANDLE,
-                    .dstBinding = reflectedBinding.binding,
-                    .descriptorCount = 1,
-                    .descriptorType = reflectedBinding.descriptorType,
-                    .pImageInfo = &imageInfos.back()
-                });
+                update_descriptor_set(device, descriptorSet, writes);
+                frameSets.push_back(descriptorSet);
             }
-
-            update_descriptor_set(device, descriptorSet, writes);
-            state.descriptorSets.push_back(descriptorSet);
         }
 
         return state;
@@ -191,6 +199,7 @@ void MaterialManager::init(const MaterialBackendContext& context)
 
 std::shared_ptr<Material> MaterialManager::get_material_by_key(const std::string &name)
 {
+    std::scoped_lock lock(m_materialsMutex);
     //search for the object, and return nullptr if not found
     if (const auto it = m_materials.find(name); it != m_materials.end()) {
 		return it->second;
@@ -211,6 +220,7 @@ std::shared_ptr<Material> MaterialManager::get_material(const std::string_view s
 
 void MaterialManager::cleanup()
 {
+	std::scoped_lock lock(m_materialsMutex);
 	for(auto it = m_materials.begin(); it != m_materials.end();) {
 		auto& material = *it->second;
 		vkDestroyPipeline(_context.device, material.pipeline, nullptr);
@@ -238,7 +248,8 @@ void MaterialManager::build_graphics_pipeline(
         bindings,
         _context.device,
         *_context.descriptorLayoutCache,
-        *_context.descriptorAllocator);
+        *_context.descriptorAllocator,
+        m_descriptorMutex);
 
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = vkinit::pipeline_layout_create_info();
 	pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorState.layouts.size());
@@ -313,7 +324,9 @@ void MaterialManager::build_graphics_pipeline(
 
 	//finally build the pipeline
 	VkRenderPass render_pass = uses_blending(metadata.blendMode) ? *_context.renderPass : *_context.offscreenPass;
-	VkPipeline meshPipeline = pipelineBuilder.build_pipeline(_context.device, render_pass);
+	const auto compileStart = std::chrono::steady_clock::now();
+	VkPipeline meshPipeline = pipelineBuilder.build_pipeline(_context.device, render_pass, _context.pipelineCache);
+	record_pipeline_build(compileStart);
 
     const std::string materialKey = scoped_name(scope, name);
 
@@ -351,7 +364,8 @@ void MaterialManager::build_postprocess_pipeline(const std::string_view scope, s
         bindings,
         _context.device,
         *_context.descriptorLayoutCache,
-        *_context.descriptorAllocator);
+        *_context.descriptorAllocator,
+        m_descriptorMutex);
 
 	// Define pipeline layout (descriptor set layouts need to be set up based on your compute shader)
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = vkinit::pipeline_layout_create_info();
@@ -375,9 +389,11 @@ void MaterialManager::build_postprocess_pipeline(const std::string_view scope, s
 
 	VkPipeline computePipeline;
 
-	if (vkCreateComputePipelines(_context.device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+	const auto compileStart = std::chrono::steady_clock::now();
+	if (vkCreateComputePipelines(_context.device, _context.pipelineCache, 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create compute pipeline!");
 	}
+	record_pipeline_build(compileStart);
 
 	auto new_material = Material{
         .key = scoped_name(scope, "compute"),
@@ -406,12 +422,17 @@ void MaterialManager::build_present_pipeline(const std::string_view scope)
         bindings,
         _context.device,
         *_context.descriptorLayoutCache,
-        *_context.descriptorAllocator);
+        *_context.descriptorAllocator,
+        m_descriptorMutex);
 
 	VkPipelineLayoutCreateInfo pipeline_layout_info = vkinit::pipeline_layout_create_info();
 
 	const VkDescriptorSetLayout sampledImageSetLayout = descriptorState.layouts.front();
-	const VkDescriptorSet sampledImageSet = descriptorState.descriptorSets.front();
+	std::array<std::vector<VkDescriptorSet>, FRAME_OVERLAP> sampledImageSets{};
+	for (uint32_t frameSlot = 0; frameSlot < FRAME_OVERLAP; ++frameSlot)
+	{
+		sampledImageSets[frameSlot] = { descriptorState.descriptorSets[frameSlot].front() };
+	}
 
 	pipeline_layout_info.setLayoutCount = 1;
 	pipeline_layout_info.pSetLayouts = &sampledImageSetLayout;
@@ -475,7 +496,9 @@ void MaterialManager::build_present_pipeline(const std::string_view scope)
 	pipelineBuilder._shaderStages = shaderProgram.shader_stages();
 
 	//finally build the pipeline
-	const VkPipeline meshPipeline = pipelineBuilder.build_pipeline(_context.device, *_context.renderPass);
+	const auto compileStart = std::chrono::steady_clock::now();
+	const VkPipeline meshPipeline = pipelineBuilder.build_pipeline(_context.device, *_context.renderPass, _context.pipelineCache);
+	record_pipeline_build(compileStart);
 
 
 
@@ -484,13 +507,29 @@ void MaterialManager::build_present_pipeline(const std::string_view scope)
 		.key = scoped_name(scope, "present"),
 		.pipeline = meshPipeline,
 		.pipelineLayout = meshPipelineLayout,
-		.descriptorSets = { sampledImageSet },
+		.descriptorSets = sampledImageSets,
 		.bindings = bindings };
 	add_material(new_material.key, std::move(new_material));
 }
 
+PipelineBuildStats MaterialManager::pipeline_build_stats() const noexcept
+{
+	return PipelineBuildStats{
+		.pipelines = m_pipelinesBuilt.load(std::memory_order::relaxed),
+		.compileMs = static_cast<double>(m_pipelineCompileMicros.load(std::memory_order::relaxed)) / 1000.0
+	};
+}
+
+void MaterialManager::record_pipeline_build(const std::chrono::steady_clock::time_point start) noexcept
+{
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	m_pipelinesBuilt.fetch_add(1, std::memory_order::relaxed);
+	m_pipelineCompileMicros.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order::relaxed);
+}
+
 void MaterialManager::add_material(const std::string& name, Material&& material)
 {
+	std::scoped_lock lock(m_materialsMutex);
 	if (m_materials.contains(name))
 	{
 		auto& map = m_materials[name];
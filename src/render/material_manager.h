@@ -1,6 +1,8 @@
 #pragma once
 #include "material.h"
 #include "vk_util.h"
+#include <atomic>
+#include <mutex>
 #include <string_view>
 
 enum class BlendMode : uint8_t
@@ -29,8 +31,18 @@ struct MaterialBackendContext
 	ImageResource* depthImage{};
 	vkutil::DescriptorAllocator* descriptorAllocator{};
 	vkutil::DescriptorLayoutCache* descriptorLayoutCache{};
+	VkPipelineCache pipelineCache{VK_NULL_HANDLE};
 };
 
+struct PipelineBuildStats
+{
+	uint32_t pipelines{0};
+	double compileMs{0.0};
+};
+
+// Pipeline builds may run off the main thread (SceneRenderer prebuilds inactive scenes), so the
+// material map and the shared descriptor allocator are guarded; shader loading and pipeline
+// compilation run unlocked.
 class MaterialManager {
 public:
 	void init(const MaterialBackendContext& context);
@@ -51,11 +63,19 @@ public:
 
 	void build_postprocess_pipeline(std::string_view scope, std::shared_ptr<Resource> fogUboBuffer);
 	void build_present_pipeline(std::string_view scope);
+
+	// Time spent inside vkCreate*Pipelines, which is what the pipeline cache saves.
+	[[nodiscard]] PipelineBuildStats pipeline_build_stats() const noexcept;
 	
 private:
     [[nodiscard]] std::shared_ptr<Material> get_material_by_key(const std::string& name);
     std::unordered_map<std::string, std::shared_ptr<Material>> m_materials;
+	std::mutex m_materialsMutex;
+	std::mutex m_descriptorMutex;
+	std::atomic<uint32_t> m_pipelinesBuilt{0};
+	std::atomic<uint64_t> m_pipelineCompileMicros{0};
 	MaterialBackendContext _context{};
 
 	void add_material(const std::string& name, Material&& material);
+	void record_pipeline_build(std::chrono::steady_clock::time_point start) noexcept;
 };
@@ -5,13 +5,26 @@
 #ifndef MESH_H
 #define MESH_H
 #include "mesh_allocator.h"
+#include "mesh_release_queue.h"
+#include "quad_index_buffer.h"
 #include "vk_vertex.h"
 
+enum class MeshIndexMode : uint8_t
+{
+    Explicit = 0,
+    // Vertices are laid out as 4-vertex quads and drawn with the shared 16-bit quad index buffer.
+    SharedQuads = 1
+};
 
 struct Mesh {
     std::vector<Vertex> _vertices;
     std::vector<uint32_t> _indices;
     MeshAllocation _allocation{};
+    MeshIndexMode _indexMode{MeshIndexMode::Explicit};
+    // Set by the producer before upload; survives the upload clearing _vertices/_indices.
+    uint64_t _contentHash{0};
+    // Lower values upload first when a frame's upload budget is exceeded; chunk meshes use their squared chunk distance to the player.
+    uint32_t _uploadPriority{0};
 
     std::atomic_bool _isActive = false;
 
@@ -31,11 +44,28 @@ struct Mesh {
         //std::println("Mesh::Mesh()");
     }
 
-    ~Mesh()
+    explicit Mesh(const MeshIndexMode indexMode): _allocation(), _indexMode(indexMode)
+    {
+    }
+
+    [[nodiscard]] bool uses_shared_quad_indices() const noexcept
+    {
+        return _indexMode == MeshIndexMode::SharedQuads;
+    }
+
+    [[nodiscard]] uint32_t index_count() const noexcept
     {
-        //std::println("Mesh::~Mesh()");
+        return uses_shared_quad_indices()
+            ? render::quad_index_count_for_vertices(_vertices.size())
+            : static_cast<uint32_t>(_indices.size());
+    }
 
-    };
+    // The last owner letting go is what releases an uploaded mesh's GPU ranges; MeshManager frees
+    // them once the frames that may still draw this mesh have retired.
+    ~Mesh()
+    {
+        render::enqueue_mesh_release(_allocation);
+    }
 };
 
 
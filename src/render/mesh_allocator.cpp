@@ -1,18 +1,18 @@
 #include "mesh_allocator.h"
 
 #include <algorithm>
-#include <format>
-#include <ranges>
 #include <stdexcept>
 
 #include <tracy/Tracy.hpp>
 
+#include "constants.h"
 #include "mesh.h"
 #include "vk_util.h"
 
 namespace
 {
-    constexpr VkDeviceSize VertexAlignment = alignof(Vertex);
+    // Whole-vertex offsets let indirect draws address a mesh through vertexOffset with the buffer bound at 0.
+    constexpr VkDeviceSize VertexAlignment = sizeof(Vertex);
     constexpr VkDeviceSize IndexAlignment = alignof(uint32_t);
 
     MeshAllocatorConfig normalized_config(MeshAllocatorConfig config)
@@ -23,9 +23,13 @@ namespace
         }
 
         config.vertexSlabSize = std::max<VkDeviceSize>(config.vertexSlabSize, 256 * 1024);
+        config.vertexSlabSize -= config.vertexSlabSize % sizeof(Vertex);
         config.indexSlabSize = std::max<VkDeviceSize>(config.indexSlabSize, 64 * 1024);
         config.vertexBufferSize = std::max<VkDeviceSize>(config.vertexBufferSize, config.vertexSlabSize * config.slotCapacity);
         config.indexBufferSize = std::max<VkDeviceSize>(config.indexBufferSize, config.indexSlabSize * config.slotCapacity);
+        config.vertexPageSize = std::max<VkDeviceSize>(config.vertexPageSize, 1024 * 1024);
+        config.vertexPageSize -= config.vertexPageSize % sizeof(Vertex);
+        config.indexPageSize = std::max<VkDeviceSize>(config.indexPageSize, 64 * 1024);
         return config;
     }
 }
@@ -59,7 +63,9 @@ MeshAllocation ArenaMeshAllocator::acquire(const VkDeviceSize vertexSize, const
         .vertexSize = vertexSize,
         .indexSize = indexSize,
         .handle = freeIndex,
-        .allocator = this
+        .allocator = this,
+        .vertexBuffer = m_vertexBuffer._buffer,
+        .indexBuffer = m_indexBuffer._buffer
     };
 }
 
@@ -100,19 +106,42 @@ bool ArenaMeshAllocator::can_reconfigure() const noexcept
     return m_free_list.size() == m_config.slotCapacity;
 }
 
-const MeshAllocatorConfig& ArenaMeshAllocator::config() const noexcept
+bool ArenaMeshAllocator::resize(const size_t slotCapacity)
 {
-    return m_config;
+    // Slots are fixed offsets into one buffer pair, so the arena can only be rebuilt while empty.
+    if (!can_reconfigure())
+    {
+        return false;
+    }
+
+    MeshAllocatorConfig config = m_config;
+    config.slotCapacity = slotCapacity;
+    config.vertexBufferSize = 0;
+    config.indexBufferSize = 0;
+    reconfigure(std::move(config));
+    return true;
 }
 
-VkBuffer ArenaMeshAllocator::vertex_buffer_handle() const noexcept
+const MeshAllocatorConfig& ArenaMeshAllocator::config() const noexcept
 {
-    return m_vertexBuffer._buffer;
+    return m_config;
 }
 
-VkBuffer ArenaMeshAllocator::index_buffer_handle() const noexcept
+MeshAllocatorStats ArenaMeshAllocator::stats() const noexcept
 {
-    return m_indexBuffer._buffer;
+    const auto liveSlots = static_cast<VkDeviceSize>(m_config.slotCapacity - m_free_list.size());
+    const bool hasFreeSlot = !m_free_list.empty();
+    return MeshAllocatorStats{
+        .liveAllocations = static_cast<uint32_t>(liveSlots),
+        .vertexPages = 1,
+        .indexPages = 1,
+        .vertexCapacity = m_config.vertexSlabSize * m_config.slotCapacity,
+        .vertexUsed = m_config.vertexSlabSize * liveSlots,
+        .vertexLargestFree = hasFreeSlot ? m_config.vertexSlabSize : 0,
+        .indexCapacity = m_config.indexSlabSize * m_config.slotCapacity,
+        .indexUsed = m_config.indexSlabSize * liveSlots,
+        .indexLargestFree = hasFreeSlot ? m_config.indexSlabSize : 0
+    };
 }
 
 ArenaMeshAllocator::MeshSlot ArenaMeshAllocator::get_slot(const size_t index) const
@@ -165,253 +194,187 @@ void ArenaMeshAllocator::create_buffers()
 VariableMeshAllocator::VariableMeshAllocator(VmaAllocator allocator, MeshAllocatorConfig config) :
     m_allocator(allocator)
 {
+    // Relocation copies read from these buffers as well as write to them.
+    m_vertexBuffers.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    m_indexBuffers.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
     reconfigure(std::move(config));
 }
 
 VariableMeshAllocator::~VariableMeshAllocator()
 {
-    destroy_buffers();
+    destroy_page_buffers(m_vertexBuffers);
+    destroy_page_buffers(m_indexBuffers);
 }
 
 MeshAllocation VariableMeshAllocator::acquire(const VkDeviceSize vertexSize, const VkDeviceSize indexSize)
 {
     ZoneScopedN("VariableMeshAllocator::Acquire");
-    const VkDeviceSize vertexOffset = allocate_range(m_freeVertexRanges, vertexSize, VertexAlignment);
-    try
-    {
-        const VkDeviceSize indexOffset = allocate_range(m_freeIndexRanges, indexSize, IndexAlignment);
-
-        int32_t handle = -1;
-        if (!m_freeHandles.empty())
-        {
-            handle = m_freeHandles.back();
-            m_freeHandles.pop_back();
-            m_records[handle] = AllocationRecord{
-                .vertexOffset = vertexOffset,
-                .vertexSize = vertexSize,
-                .indexOffset = indexOffset,
-                .indexSize = indexSize,
-                .live = true
-            };
-        }
-        else
-        {
-            handle = static_cast<int32_t>(m_records.size());
-            m_records.push_back(AllocationRecord{
-                .vertexOffset = vertexOffset,
-                .vertexSize = vertexSize,
-                .indexOffset = indexOffset,
-                .indexSize = indexSize,
-                .live = true
-            });
-        }
-
-        ++m_liveAllocations;
-        TracyPlot("VariableMeshAllocator LiveAllocations", static_cast<int64_t>(m_liveAllocations));
-        TracyPlot("VariableMeshAllocator FreeVertexRanges", static_cast<int64_t>(m_freeVertexRanges.size()));
-        TracyPlot("VariableMeshAllocator FreeIndexRanges", static_cast<int64_t>(m_freeIndexRanges.size()));
-        return MeshAllocation{
-            .vertexOffset = vertexOffset,
-            .indexOffset = indexOffset,
-            .vertexSize = vertexSize,
-            .indexSize = indexSize,
-            .handle = handle,
-            .allocator = this
-        };
-    }
-    catch (...)
-    {
-        free_range(m_freeVertexRanges, vertexOffset, vertexSize);
-        throw;
-    }
+    const render::MeshPageAllocation allocation = m_pages.acquire(vertexSize, indexSize);
+    sync_page_buffers();
+    plot_stats();
+    return make_allocation(allocation);
 }
 
 void VariableMeshAllocator::free(const MeshAllocation allocation)
 {
     ZoneScopedN("VariableMeshAllocator::Free");
-    if (allocation.handle < 0 || allocation.handle >= static_cast<int32_t>(m_records.size()))
-    {
-        return;
-    }
-
-    AllocationRecord& record = m_records[allocation.handle];
-    if (!record.live)
-    {
-        return;
-    }
-
-    free_range(m_freeVertexRanges, record.vertexOffset, record.vertexSize);
-    free_range(m_freeIndexRanges, record.indexOffset, record.indexSize);
-    record.live = false;
-    m_freeHandles.push_back(allocation.handle);
-    if (m_liveAllocations > 0)
-    {
-        --m_liveAllocations;
-    }
-    TracyPlot("VariableMeshAllocator LiveAllocations", static_cast<int64_t>(m_liveAllocations));
-    TracyPlot("VariableMeshAllocator FreeVertexRanges", static_cast<int64_t>(m_freeVertexRanges.size()));
-    TracyPlot("VariableMeshAllocator FreeIndexRanges", static_cast<int64_t>(m_freeIndexRanges.size()));
+    m_pages.free(allocation.handle);
+    plot_stats();
 }
 
 void VariableMeshAllocator::reconfigure(MeshAllocatorConfig config)
 {
     ZoneScopedN("VariableMeshAllocator::Reconfigure");
-    if (!can_reconfigure() && (m_vertexBuffer._buffer != VK_NULL_HANDLE || m_indexBuffer._buffer != VK_NULL_HANDLE))
+    if (!can_reconfigure() && !m_vertexBuffers.buffers.empty())
     {
         throw std::runtime_error("VariableMeshAllocator::reconfigure: allocator still has live mesh allocations");
     }
 
     m_config = normalized_config(std::move(config));
-    destroy_buffers();
-    create_buffers();
-
-    m_freeVertexRanges = { FreeRange{0, m_config.vertexBufferSize} };
-    m_freeIndexRanges = { FreeRange{0, m_config.indexBufferSize} };
-    m_records.clear();
-    m_freeHandles.clear();
-    m_liveAllocations = 0;
-    TracyPlot("VariableMeshAllocator LiveAllocations", static_cast<int64_t>(m_liveAllocations));
-    TracyPlot("VariableMeshAllocator FreeVertexRanges", static_cast<int64_t>(m_freeVertexRanges.size()));
-    TracyPlot("VariableMeshAllocator FreeIndexRanges", static_cast<int64_t>(m_freeIndexRanges.size()));
+    destroy_page_buffers(m_vertexBuffers);
+    destroy_page_buffers(m_indexBuffers);
+    m_pages.reset(
+        render::MeshPagePoolConfig{ .pageSize = m_config.vertexPageSize, .alignment = VertexAlignment },
+        render::MeshPagePoolConfig{ .pageSize = m_config.indexPageSize, .alignment = IndexAlignment });
+    sync_page_buffers();
+    plot_stats();
 }
 
 bool VariableMeshAllocator::can_reconfigure() const noexcept
 {
-    return m_liveAllocations == 0;
+    return m_pages.live_allocations() == 0 && !m_pages.has_retired_ranges();
 }
 
-const MeshAllocatorConfig& VariableMeshAllocator::config() const noexcept
+bool VariableMeshAllocator::resize(const size_t slotCapacity)
 {
-    return m_config;
+    // Pages are added on demand and trailing empty ones are collected, so the slot budget is only
+    // bookkeeping here and can change under live allocations.
+    MeshAllocatorConfig config = m_config;
+    config.slotCapacity = slotCapacity;
+    config.vertexBufferSize = 0;
+    config.indexBufferSize = 0;
+    m_config = normalized_config(std::move(config));
+    return true;
 }
 
-VkBuffer VariableMeshAllocator::vertex_buffer_handle() const noexcept
+const MeshAllocatorConfig& VariableMeshAllocator::config() const noexcept
 {
-    return m_vertexBuffer._buffer;
+    return m_config;
 }
 
-VkBuffer VariableMeshAllocator::index_buffer_handle() const noexcept
+MeshAllocatorStats VariableMeshAllocator::stats() const noexcept
 {
-    return m_indexBuffer._buffer;
+    const render::RangeAllocatorStats vertex = m_pages.pool_stats(render::MeshPagePool::Vertex);
+    const render::RangeAllocatorStats index = m_pages.pool_stats(render::MeshPagePool::Index);
+    return MeshAllocatorStats{
+        .liveAllocations = static_cast<uint32_t>(m_pages.live_allocations()),
+        .vertexPages = static_cast<uint32_t>(m_pages.page_count(render::MeshPagePool::Vertex)),
+        .indexPages = static_cast<uint32_t>(m_pages.page_count(render::MeshPagePool::Index)),
+        .vertexCapacity = vertex.capacity,
+        .vertexUsed = vertex.usedBytes,
+        .vertexLargestFree = vertex.largestFreeBlock,
+        .indexCapacity = index.capacity,
+        .indexUsed = index.usedBytes,
+        .indexLargestFree = index.largestFreeBlock,
+        .vertexFragmentation = vertex.fragmentation(),
+        .indexFragmentation = index.fragmentation(),
+        .relocationsInFlight = m_pages.relocations_in_flight(),
+        .relocatedBytes = m_pages.relocated_bytes()
+    };
 }
 
-VkDeviceSize VariableMeshAllocator::align_up(const VkDeviceSize value, const VkDeviceSize alignment) noexcept
+std::vector<MeshRelocation> VariableMeshAllocator::plan_relocations(const VkDeviceSize byteBudget)
 {
-    if (alignment <= 1)
+    ZoneScopedN("VariableMeshAllocator::PlanRelocations");
+    std::vector<MeshRelocation> relocations{};
+    for (const render::MeshPageRelocation& planned : m_pages.plan_relocations(byteBudget))
     {
-        return value;
+        relocations.push_back(MeshRelocation{
+            .handle = planned.source.handle,
+            .source = make_allocation(planned.source),
+            .destination = make_allocation(planned.destination)
+        });
     }
-
-    return (value + alignment - 1) & ~(alignment - 1);
+    return relocations;
 }
 
-VkDeviceSize VariableMeshAllocator::allocate_range(std::vector<FreeRange>& ranges, const VkDeviceSize size, const VkDeviceSize alignment)
+void VariableMeshAllocator::commit_relocation(const MeshRelocation& relocation, const uint64_t retireFrame)
 {
-    ZoneScopedN("VariableMeshAllocator::AllocateRange");
-    for (size_t i = 0; i < ranges.size(); ++i)
-    {
-        const VkDeviceSize alignedOffset = align_up(ranges[i].offset, alignment);
-        const VkDeviceSize padding = alignedOffset - ranges[i].offset;
-        if (ranges[i].size < padding + size)
-        {
-            continue;
-        }
-
-        const VkDeviceSize rangeEnd = ranges[i].offset + ranges[i].size;
-        const VkDeviceSize allocEnd = alignedOffset + size;
-        if (padding == 0 && allocEnd == rangeEnd)
-        {
-            ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(i));
-        }
-        else if (padding == 0)
-        {
-            ranges[i].offset = allocEnd;
-            ranges[i].size = rangeEnd - allocEnd;
-        }
-        else if (allocEnd == rangeEnd)
-        {
-            ranges[i].size = padding;
-        }
-        else
-        {
-            const FreeRange tail{allocEnd, rangeEnd - allocEnd};
-            ranges[i].size = padding;
-            ranges.insert(ranges.begin() + static_cast<std::ptrdiff_t>(i + 1), tail);
-        }
-
-        return alignedOffset;
-    }
-
-    throw std::runtime_error(std::format("VariableMeshAllocator::allocate_range: no contiguous range for {} bytes", size));
+    m_pages.commit_relocation(relocation.handle, retireFrame);
 }
 
-void VariableMeshAllocator::free_range(std::vector<FreeRange>& ranges, const VkDeviceSize offset, const VkDeviceSize size)
+void VariableMeshAllocator::cancel_relocation(const MeshRelocation& relocation)
 {
-    ZoneScopedN("VariableMeshAllocator::FreeRange");
-    if (size == 0)
-    {
-        return;
-    }
+    m_pages.cancel_relocation(relocation.handle);
+}
 
-    ranges.push_back(FreeRange{offset, size});
-    std::ranges::sort(ranges, [](const FreeRange& lhs, const FreeRange& rhs)
-    {
-        return lhs.offset < rhs.offset;
-    });
+void VariableMeshAllocator::collect_garbage(const uint64_t frame)
+{
+    ZoneScopedN("VariableMeshAllocator::CollectGarbage");
+    m_pages.collect_garbage(frame);
+    sync_page_buffers();
+    plot_stats();
+}
 
-    std::vector<FreeRange> merged{};
-    merged.reserve(ranges.size());
-    for (const FreeRange& range : ranges)
+void VariableMeshAllocator::sync_page_buffers()
+{
+    const auto sync = [this](PageBuffers& pageBuffers, const render::MeshPagePool pool)
     {
-        if (merged.empty())
+        // Pages only come and go at the back, so matching the count keeps every buffer on its page.
+        const size_t pageCount = m_pages.page_count(pool);
+        while (pageBuffers.buffers.size() > pageCount)
         {
-            merged.push_back(range);
-            continue;
+            AllocatedBuffer& buffer = pageBuffers.buffers.back();
+            vmaDestroyBuffer(m_allocator, buffer._buffer, buffer._allocation);
+            pageBuffers.buffers.pop_back();
         }
-
-        FreeRange& last = merged.back();
-        const VkDeviceSize lastEnd = last.offset + last.size;
-        if (range.offset <= lastEnd)
+        while (pageBuffers.buffers.size() < pageCount)
         {
-            last.size = std::max(lastEnd, range.offset + range.size) - last.offset;
-            continue;
+            ZoneScopedN("VariableMeshAllocator::AddPage");
+            const auto page = static_cast<uint32_t>(pageBuffers.buffers.size());
+            pageBuffers.buffers.push_back(vkutil::create_buffer(
+                m_allocator,
+                m_pages.page_capacity(pool, page),
+                pageBuffers.usage,
+                VMA_MEMORY_USAGE_GPU_ONLY));
         }
+    };
 
-        merged.push_back(range);
-    }
-
-    ranges = std::move(merged);
+    sync(m_vertexBuffers, render::MeshPagePool::Vertex);
+    sync(m_indexBuffers, render::MeshPagePool::Index);
 }
 
-void VariableMeshAllocator::destroy_buffers()
+void VariableMeshAllocator::destroy_page_buffers(PageBuffers& pageBuffers)
 {
-    ZoneScopedN("VariableMeshAllocator::DestroyBuffers");
-    if (m_vertexBuffer._buffer != VK_NULL_HANDLE)
+    ZoneScopedN("VariableMeshAllocator::DestroyPages");
+    for (AllocatedBuffer& buffer : pageBuffers.buffers)
     {
-        vmaDestroyBuffer(m_allocator, m_vertexBuffer._buffer, m_vertexBuffer._allocation);
-        m_vertexBuffer = {};
+        vmaDestroyBuffer(m_allocator, buffer._buffer, buffer._allocation);
     }
+    pageBuffers.buffers.clear();
+}
 
-    if (m_indexBuffer._buffer != VK_NULL_HANDLE)
-    {
-        vmaDestroyBuffer(m_allocator, m_indexBuffer._buffer, m_indexBuffer._allocation);
-        m_indexBuffer = {};
-    }
+MeshAllocation VariableMeshAllocator::make_allocation(const render::MeshPageAllocation& allocation) const
+{
+    return MeshAllocation{
+        .vertexOffset = allocation.vertex.range.offset,
+        .indexOffset = allocation.index.range.offset,
+        .vertexSize = allocation.vertex.range.size,
+        .indexSize = allocation.index.range.size,
+        .handle = allocation.handle,
+        .allocator = const_cast<VariableMeshAllocator*>(this),
+        .vertexBuffer = m_vertexBuffers.buffers[allocation.vertex.page]._buffer,
+        .indexBuffer = m_indexBuffers.buffers[allocation.index.page]._buffer
+    };
 }
 
-void VariableMeshAllocator::create_buffers()
+void VariableMeshAllocator::plot_stats() const
 {
-    ZoneScopedN("VariableMeshAllocator::CreateBuffers");
-    m_vertexBuffer = vkutil::create_buffer(
-        m_allocator,
-        m_config.vertexBufferSize,
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY);
-    m_indexBuffer = vkutil::create_buffer(
-        m_allocator,
-        m_config.indexBufferSize,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_GPU_ONLY);
+    const MeshAllocatorStats current = stats();
+    TracyPlot("VariableMeshAllocator LiveAllocations", static_cast<int64_t>(current.liveAllocations));
+    TracyPlot("VariableMeshAllocator VertexPages", static_cast<int64_t>(current.vertexPages));
+    TracyPlot("VariableMeshAllocator VertexFragmentation", current.vertexFragmentation);
+    TracyPlot("VariableMeshAllocator IndexFragmentation", current.indexFragmentation);
 }
 
 std::unique_ptr<IMeshAllocator> create_mesh_allocator(VmaAllocator allocator, const MeshAllocatorConfig& config)
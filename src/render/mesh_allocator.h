@@ -2,9 +2,11 @@
 #define MESH_ALLOCATOR_H
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "constants.h"
+#include "mesh_page_allocator.h"
 #include "vk_types.h"
 
 enum class MeshAllocationStrategy : uint8_t
@@ -20,9 +22,13 @@ struct MeshAllocatorConfig
     MeshAllocationStrategy strategy{MeshAllocationStrategy::VariableSuballocation};
     size_t slotCapacity{static_cast<size_t>((maximum_chunks_for_view_distance(GameConfig::DEFAULT_VIEW_DISTANCE) * 2) + 128)};
     VkDeviceSize vertexSlabSize{1048576};
-    VkDeviceSize indexSlabSize{262144};
+    // Chunk and voxel meshes draw from the shared quad index buffer; only explicit-index meshes use this pool.
+    VkDeviceSize indexSlabSize{65536};
     VkDeviceSize vertexBufferSize{vertexSlabSize * slotCapacity};
     VkDeviceSize indexBufferSize{indexSlabSize * slotCapacity};
+    // Variable suballocation grows in pages of these sizes; a mesh larger than a page gets a page of its own.
+    VkDeviceSize vertexPageSize{64ull * 1024 * 1024};
+    VkDeviceSize indexPageSize{4ull * 1024 * 1024};
 };
 
 struct MeshAllocation
@@ -34,6 +40,34 @@ struct MeshAllocation
     int32_t handle{-1};
     uint32_t indicesSize{0};
     IMeshAllocator* allocator{nullptr};
+    VkBuffer vertexBuffer{VK_NULL_HANDLE};
+    VkBuffer indexBuffer{VK_NULL_HANDLE};
+};
+
+struct MeshAllocatorStats
+{
+    uint32_t liveAllocations{0};
+    uint32_t vertexPages{0};
+    uint32_t indexPages{0};
+    VkDeviceSize vertexCapacity{0};
+    VkDeviceSize vertexUsed{0};
+    VkDeviceSize vertexLargestFree{0};
+    VkDeviceSize indexCapacity{0};
+    VkDeviceSize indexUsed{0};
+    VkDeviceSize indexLargestFree{0};
+    float vertexFragmentation{0.0f};
+    float indexFragmentation{0.0f};
+    uint32_t relocationsInFlight{0};
+    uint64_t relocatedBytes{0};
+};
+
+// Moves one live allocation to a better-placed range. The caller copies source to destination on the
+// GPU, then commits; the source stays reserved until collect_garbage sees the retire frame has passed.
+struct MeshRelocation
+{
+    int32_t handle{-1};
+    MeshAllocation source{};
+    MeshAllocation destination{};
 };
 
 class IMeshAllocator
@@ -45,9 +79,18 @@ public:
     virtual void free(MeshAllocation allocation) = 0;
     virtual void reconfigure(MeshAllocatorConfig config) = 0;
     [[nodiscard]] virtual bool can_reconfigure() const noexcept = 0;
+    // Changes the slot budget without disturbing live allocations; false when this allocator can only
+    // do that while empty, in which case the caller falls back to reconfigure.
+    [[nodiscard]] virtual bool resize(size_t slotCapacity) = 0;
     [[nodiscard]] virtual const MeshAllocatorConfig& config() const noexcept = 0;
-    [[nodiscard]] virtual VkBuffer vertex_buffer_handle() const noexcept = 0;
-    [[nodiscard]] virtual VkBuffer index_buffer_handle() const noexcept = 0;
+    [[nodiscard]] virtual MeshAllocatorStats stats() const noexcept { return {}; }
+
+    // Compaction hooks; allocators with fixed slots have nothing to move.
+    [[nodiscard]] virtual std::vector<MeshRelocation> plan_relocations(VkDeviceSize) { return {}; }
+    virtual void commit_relocation(const MeshRelocation&, uint64_t) {}
+    virtual void cancel_relocation(const MeshRelocation&) {}
+    // Frees relocation sources and empty pages no longer referenced by frames still on the GPU.
+    virtual void collect_garbage(uint64_t) {}
 };
 
 class ArenaMeshAllocator final : public IMeshAllocator
@@ -60,9 +103,9 @@ public:
     void free(MeshAllocation allocation) override;
     void reconfigure(MeshAllocatorConfig config) override;
     [[nodiscard]] bool can_reconfigure() const noexcept override;
+    [[nodiscard]] bool resize(size_t slotCapacity) override;
     [[nodiscard]] const MeshAllocatorConfig& config() const noexcept override;
-    [[nodiscard]] VkBuffer vertex_buffer_handle() const noexcept override;
-    [[nodiscard]] VkBuffer index_buffer_handle() const noexcept override;
+    [[nodiscard]] MeshAllocatorStats stats() const noexcept override;
 
 private:
     struct MeshSlot
@@ -92,41 +135,33 @@ public:
     void free(MeshAllocation allocation) override;
     void reconfigure(MeshAllocatorConfig config) override;
     [[nodiscard]] bool can_reconfigure() const noexcept override;
+    [[nodiscard]] bool resize(size_t slotCapacity) override;
     [[nodiscard]] const MeshAllocatorConfig& config() const noexcept override;
-    [[nodiscard]] VkBuffer vertex_buffer_handle() const noexcept override;
-    [[nodiscard]] VkBuffer index_buffer_handle() const noexcept override;
+    [[nodiscard]] MeshAllocatorStats stats() const noexcept override;
 
-private:
-    struct FreeRange
-    {
-        VkDeviceSize offset{0};
-        VkDeviceSize size{0};
-    };
+    [[nodiscard]] std::vector<MeshRelocation> plan_relocations(VkDeviceSize byteBudget) override;
+    void commit_relocation(const MeshRelocation& relocation, uint64_t retireFrame) override;
+    void cancel_relocation(const MeshRelocation& relocation) override;
+    void collect_garbage(uint64_t frame) override;
 
-    struct AllocationRecord
+private:
+    struct PageBuffers
     {
-        VkDeviceSize vertexOffset{0};
-        VkDeviceSize vertexSize{0};
-        VkDeviceSize indexOffset{0};
-        VkDeviceSize indexSize{0};
-        bool live{false};
+        VkBufferUsageFlags usage{0};
+        // One buffer per MeshPageAllocator page, in page order.
+        std::vector<AllocatedBuffer> buffers{};
     };
 
     VmaAllocator m_allocator{};
     MeshAllocatorConfig m_config{};
-    AllocatedBuffer m_indexBuffer{};
-    AllocatedBuffer m_vertexBuffer{};
-    std::vector<FreeRange> m_freeVertexRanges{};
-    std::vector<FreeRange> m_freeIndexRanges{};
-    std::vector<AllocationRecord> m_records{};
-    std::vector<int32_t> m_freeHandles{};
-    size_t m_liveAllocations{0};
-
-    [[nodiscard]] static VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment) noexcept;
-    [[nodiscard]] VkDeviceSize allocate_range(std::vector<FreeRange>& ranges, VkDeviceSize size, VkDeviceSize alignment);
-    static void free_range(std::vector<FreeRange>& ranges, VkDeviceSize offset, VkDeviceSize size);
-    void destroy_buffers();
-    void create_buffers();
+    render::MeshPageAllocator m_pages{};
+    PageBuffers m_vertexBuffers{};
+    PageBuffers m_indexBuffers{};
+
+    void sync_page_buffers();
+    void destroy_page_buffers(PageBuffers& pageBuffers);
+    [[nodiscard]] MeshAllocation make_allocation(const render::MeshPageAllocation& allocation) const;
+    void plot_stats() const;
 };
 
 [[nodiscard]] std::unique_ptr<IMeshAllocator> create_mesh_allocator(VmaAllocator allocator, const MeshAllocatorConfig& config);
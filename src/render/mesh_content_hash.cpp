@@ -0,0 +1,77 @@
+#include "mesh_content_hash.h"
+
+#include <bit>
+#include <cstring>
+
+#include "mesh.h"
+
+namespace
+{
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+
+    [[nodiscard]] constexpr uint64_t mix_word(uint64_t hash, const uint64_t word) noexcept
+    {
+        hash ^= std::rotl(word * Prime2, 31) * Prime1;
+        return std::rotl(hash, 27) * Prime1 + Prime3;
+    }
+
+    [[nodiscard]] constexpr uint64_t avalanche(uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
+
+namespace render
+{
+    uint64_t hash_bytes(const void* const data, const size_t size, const uint64_t seed) noexcept
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        uint64_t hash = seed + Prime3 + static_cast<uint64_t>(size) * Prime1;
+
+        size_t offset = 0;
+        for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + offset, sizeof(uint64_t));
+            hash = mix_word(hash, word);
+        }
+
+        if (offset < size)
+        {
+            uint64_t tail = 0;
+            std::memcpy(&tail, bytes + offset, size - offset);
+            hash = mix_word(hash, tail);
+        }
+
+        return avalanche(hash);
+    }
+
+    uint64_t hash_mesh_content(const Mesh& mesh) noexcept
+    {
+        uint64_t hash = hash_bytes(&mesh._indexMode, sizeof(mesh._indexMode));
+        hash = hash_bytes(mesh._vertices.data(), mesh._vertices.size() * sizeof(Vertex), hash);
+        if (!mesh.uses_shared_quad_indices())
+        {
+            hash = hash_bytes(mesh._indices.data(), mesh._indices.size() * sizeof(uint32_t), hash);
+        }
+
+        return hash == UnhashedMeshContent ? Prime1 : hash;
+    }
+
+    bool same_mesh_content(const Mesh* const lhs, const Mesh* const rhs) noexcept
+    {
+        if (lhs == nullptr || rhs == nullptr)
+        {
+            return lhs == rhs;
+        }
+
+        return lhs->_contentHash != UnhashedMeshContent && lhs->_contentHash == rhs->_contentHash;
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct Mesh;
+
+namespace render
+{
+    // Zero is reserved for "not hashed" so a fresh Mesh never compares equal to uploaded content.
+    inline constexpr uint64_t UnhashedMeshContent = 0;
+
+    [[nodiscard]] uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0) noexcept;
+
+    // Hashes the CPU-side geometry that would be uploaded: index mode, vertices and explicit indices.
+    [[nodiscard]] uint64_t hash_mesh_content(const Mesh& mesh) noexcept;
+
+    // True when both meshes carry a content hash and the hashes agree.
+    [[nodiscard]] bool same_mesh_content(const Mesh* lhs, const Mesh* rhs) noexcept;
+}
@@ -1,10 +1,14 @@
 #include "mesh_manager.h"
 #include <vk_initializers.h>
+#include <vk_util.h>
 #include <tracy/Tracy.hpp>
 #include <tiny_obj_loader.h>
 #include <algorithm>
+#include <cstring>
 
+#include "constants.h"
 #include "mesh_release_queue.h"
+#include "quad_index_buffer.h"
 
 namespace
 {
@@ -17,36 +21,33 @@ void MeshManager::init(VkDevice device, VmaAllocator allocator, const QueueFamil
 	m_allocator = allocator;
 	m_transferQueue = queue;
 
-	VkFenceCreateInfo uploadCreateInfo = vkinit::fence_create_info();
-
-	VK_CHECK(vkCreateFence(m_device, &uploadCreateInfo, nullptr, &m_uploadContext._uploadFence));
-
-	VkCommandPoolCreateInfo uploadCommandPoolInfo = vkinit::command_pool_create_info(m_transferQueue._queueFamily);
-	//create pool for upload context
-	VK_CHECK(vkCreateCommandPool(m_device, &uploadCommandPoolInfo, nullptr, &m_uploadContext._commandPool));
-
-
-	//allocate the default command buffer that we will use for the instant commands
-	VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::command_buffer_allocate_info(m_uploadContext._commandPool, 1);
-	VK_CHECK(vkAllocateCommandBuffers(m_device, &cmdAllocInfo, &m_uploadContext._commandBuffer));
+	create_upload_context(m_uploadContext);
+	for (UploadSlot& slot : m_uploadSlots)
+	{
+		create_upload_context(slot.context);
+	}
 
 	m_activeBudget = make_mesh_budget(settings::ViewDistanceRuntimeSettings{});
 	m_stagingBuffer = std::make_unique<StagingBuffer>(m_allocator, make_staging_buffer_config(m_activeBudget));
+	create_quad_index_buffer();
 
 	//Start transfer thread
 	//m_transferThread = std::thread(&MeshManager::handle_transfers, this);
 }
 
-void MeshManager::apply_view_distance_settings(const settings::ViewDistanceRuntimeSettings& settings)
+bool MeshManager::apply_view_distance_settings(const settings::ViewDistanceRuntimeSettings& settings)
 {
     const MeshBudget requested = make_mesh_budget(settings);
     if (requested.slotCapacity == m_activeBudget.slotCapacity)
     {
-        return;
+        m_activeBudget = requested;
+        m_pendingBudget.reset();
+        return true;
     }
 
     m_pendingBudget = requested;
     try_apply_pending_budget();
+    return !m_pendingBudget.has_value();
 }
 
 bool MeshManager::accepts_uploads() const noexcept
@@ -54,45 +55,91 @@ bool MeshManager::accepts_uploads() const noexcept
     return !m_pendingBudget.has_value();
 }
 
+VkBuffer MeshManager::quad_index_buffer() const noexcept
+{
+    return m_quadIndexBuffer._buffer;
+}
+
+
+uint32_t MeshManager::uploads_in_flight() const noexcept
+{
+    return static_cast<uint32_t>(std::ranges::count_if(m_uploadSlots, &UploadSlot::inFlight));
+}
+
+MeshAllocatorStats MeshManager::allocator_stats() const noexcept
+{
+    return m_stagingBuffer != nullptr ? m_stagingBuffer->mesh_allocator().stats() : MeshAllocatorStats{};
+}
+
 
 void MeshManager::cleanup()
 {
+	wait_for_uploads();
 	unload_garbage();
+	// The device is idle by now, so nothing retired is still being read.
+	for (const RetiredAllocation& retired : m_retiredAllocations)
+	{
+		free_allocation(retired.allocation);
+	}
+	m_retiredAllocations.clear();
+	m_retirementStats = {};
 	m_stagingBuffer.reset();
-    vkDestroyFence(m_device, m_uploadContext._uploadFence, nullptr);
-    vkDestroyCommandPool(m_device, m_uploadContext._commandPool, nullptr);
-    m_uploadContext = {};
+    if (m_quadIndexBuffer._buffer != VK_NULL_HANDLE)
+    {
+        vmaDestroyBuffer(m_allocator, m_quadIndexBuffer._buffer, m_quadIndexBuffer._allocation);
+        m_quadIndexBuffer = {};
+    }
+    destroy_upload_context(m_uploadContext);
+    for (UploadSlot& slot : m_uploadSlots)
+    {
+        destroy_upload_context(slot.context);
+    }
 }
 
 void MeshManager::unload_garbage()
 {
 	ZoneScopedN("Handle Unload Meshes");
-    std::vector<std::shared_ptr<Mesh>> deferredReleases{};
-	std::shared_ptr<Mesh> unloadMesh;
-	while(render::try_dequeue_mesh_release(unloadMesh))
+	// Runs before handle_transfers advances the counter, so this is the frame about to be recorded.
+	// A mesh whose last owner let go during this frame's scene update was last drawn by the previous
+	// frame, so retiring it here keeps the full FRAME_OVERLAP wait.
+	const uint64_t frame = m_transferFrame + 1;
+	MeshAllocation allocation{};
+	while (render::try_dequeue_mesh_release(allocation))
 	{
-        if (unloadMesh == nullptr)
-        {
-            continue;
-        }
+		const uint64_t bytes = allocation.vertexSize + allocation.indexSize;
+		m_retirementStats.pendingBytes += bytes;
+		m_retiredAllocations.push_back(RetiredAllocation{
+			.allocation = allocation,
+			.retireFrame = frame,
+			.bytes = bytes
+		});
+	}
 
-        // The release queue itself owns one reference. If other references still exist,
-        // the mesh is still live in render state and must not be freed yet.
-        if (unloadMesh.use_count() > 1)
-        {
-            deferredReleases.push_back(std::move(unloadMesh));
-            continue;
-        }
+	free_retired_allocations(frame);
+	try_apply_pending_budget();
+}
 
-		unload_mesh(std::move(unloadMesh));
-	}
+void MeshManager::free_retired_allocations(const uint64_t frame)
+{
+	ZoneScopedN("Free Retired Meshes");
+	m_retirementStats.freedMeshes = 0;
+	m_retirementStats.freedBytes = 0;
 
-    for (auto& mesh : deferredReleases)
-    {
-        render::enqueue_mesh_release(std::move(mesh));
-    }
+	// Frame N's fence has been waited on once frame N + FRAME_OVERLAP begins, and the deque is in
+	// retire order, so only its front can be due.
+	while (!m_retiredAllocations.empty() && m_retiredAllocations.front().retireFrame + FRAME_OVERLAP <= frame)
+	{
+		const RetiredAllocation retired = m_retiredAllocations.front();
+		m_retiredAllocations.pop_front();
+		m_retirementStats.pendingBytes -= retired.bytes;
+		++m_retirementStats.freedMeshes;
+		m_retirementStats.freedBytes += retired.bytes;
+		free_allocation(retired.allocation);
+	}
 
-    try_apply_pending_budget();
+	m_retirementStats.pendingMeshes = static_cast<uint32_t>(m_retiredAllocations.size());
+	TracyPlot("Mesh Retired Pending", static_cast<int64_t>(m_retirementStats.pendingMeshes));
+	TracyPlot("Mesh Retired Bytes Pending", static_cast<int64_t>(m_retirementStats.pendingBytes));
 }
 
 // void MeshManager::upload_mesh(std::shared_ptr<Mesh>&& mesh) const
@@ -136,13 +183,15 @@ void MeshManager::unload_garbage()
 // 	//std::println("MeshManager::upload_mesh()");
 // }
 
-void MeshManager::unload_mesh(std::shared_ptr<Mesh>&& mesh) const
+void MeshManager::free_allocation(const MeshAllocation& allocation)
 {
-	ZoneScopedN("unload_mesh()");
-	// vmaDestroyBuffer(m_allocator, mesh->_vertexBuffer._buffer, mesh->_vertexBuffer._allocation);
-	// vmaDestroyBuffer(m_allocator, mesh->_indexBuffer._buffer, mesh->_indexBuffer._allocation);
-	m_stagingBuffer->mesh_allocator().free(mesh->_allocation);
-	mesh->_isActive.store(false, std::memory_order::release);
+	ZoneScopedN("free_allocation()");
+	const int32_t handle = allocation.handle;
+	if (handle >= 0 && handle < static_cast<int32_t>(m_residentMeshes.size()))
+	{
+		m_residentMeshes[handle].reset();
+	}
+	m_stagingBuffer->mesh_allocator().free(allocation);
 }
 
 //TODO: Re-implement tiny-obj uploads?
@@ -207,6 +256,36 @@ void MeshManager::unload_mesh(std::shared_ptr<Mesh>&& mesh) const
 // 	return meshPtr;
 // }
 
+void MeshManager::create_quad_index_buffer()
+{
+    ZoneScopedN("MeshManager::CreateQuadIndexBuffer");
+    const std::vector<uint16_t> indices = render::build_shared_quad_indices();
+    const size_t size = indices.size() * sizeof(uint16_t);
+
+    AllocatedBuffer stagingBuffer = vkutil::create_buffer(m_allocator, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+    void* data = nullptr;
+    vmaMapMemory(m_allocator, stagingBuffer._allocation, &data);
+    std::memcpy(data, indices.data(), size);
+    vmaUnmapMemory(m_allocator, stagingBuffer._allocation);
+
+    m_quadIndexBuffer = vkutil::create_buffer(
+        m_allocator,
+        size,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VMA_MEMORY_USAGE_GPU_ONLY);
+
+    immediate_submit([&](VkCommandBuffer cmd)
+    {
+        VkBufferCopy copy{};
+        copy.srcOffset = 0;
+        copy.dstOffset = 0;
+        copy.size = size;
+        vkCmdCopyBuffer(cmd, stagingBuffer._buffer, m_quadIndexBuffer._buffer, 1, &copy);
+    });
+
+    vmaDestroyBuffer(m_allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+}
+
 void MeshManager::immediate_submit(std::function<void(VkCommandBuffer cmd)> &&function) const
 {
 
@@ -235,20 +314,270 @@ void MeshManager::immediate_submit(std::function<void(VkCommandBuffer cmd)> &&fu
 	vkResetCommandPool(m_device, m_uploadContext._commandPool, 0);
 }
 
+void MeshManager::create_upload_context(UploadContext& context) const
+{
+	VkFenceCreateInfo uploadCreateInfo = vkinit::fence_create_info();
+	VK_CHECK(vkCreateFence(m_device, &uploadCreateInfo, nullptr, &context._uploadFence));
+
+	VkCommandPoolCreateInfo uploadCommandPoolInfo = vkinit::command_pool_create_info(m_transferQueue._queueFamily);
+	VK_CHECK(vkCreateCommandPool(m_device, &uploadCommandPoolInfo, nullptr, &context._commandPool));
+
+	VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::command_buffer_allocate_info(context._commandPool, 1);
+	VK_CHECK(vkAllocateCommandBuffers(m_device, &cmdAllocInfo, &context._commandBuffer));
+}
+
+void MeshManager::destroy_upload_context(UploadContext& context) const
+{
+	vkDestroyFence(m_device, context._uploadFence, nullptr);
+	vkDestroyCommandPool(m_device, context._commandPool, nullptr);
+	context = {};
+}
+
+void MeshManager::retire_completed_uploads()
+{
+	ZoneScopedN("Retire Completed Uploads");
+	uint32_t retiredUploads = 0;
+	uint64_t totalLatency = 0;
+	m_uploadStats.maxLatencyFrames = 0;
+
+	// The staging ring frees in order, so stop at the first batch that is still copying.
+	while (m_uploadSlots[m_oldestUploadSlot].inFlight)
+	{
+		UploadSlot& slot = m_uploadSlots[m_oldestUploadSlot];
+		if (vkGetFenceStatus(m_device, slot.context._uploadFence) != VK_SUCCESS)
+		{
+			break;
+		}
+
+		for (const UploadHandle& handle : slot.batch.uploads)
+		{
+			const int32_t allocationHandle = handle.mesh->_allocation.handle;
+			if (allocationHandle >= 0)
+			{
+				if (allocationHandle >= static_cast<int32_t>(m_residentMeshes.size()))
+				{
+					m_residentMeshes.resize(allocationHandle + 1);
+				}
+				m_residentMeshes[allocationHandle] = handle.mesh;
+			}
+			handle.mesh->_isActive.store(true, std::memory_order::release);
+		}
+
+		// Frames recorded from here on read the new ranges; the allocator holds the old ones until
+		// every frame that may still reference them has retired.
+		for (PendingRelocation& pending : slot.relocations)
+		{
+			m_stagingBuffer->mesh_allocator().commit_relocation(pending.relocation, m_transferFrame);
+			const uint32_t indicesSize = pending.mesh->_allocation.indicesSize;
+			pending.mesh->_allocation = pending.relocation.destination;
+			pending.mesh->_allocation.indicesSize = indicesSize;
+		}
+		for (const uint64_t queuedFrame : slot.queuedFrames)
+		{
+			const auto latency = static_cast<uint32_t>(m_transferFrame - queuedFrame);
+			totalLatency += latency;
+			m_uploadStats.maxLatencyFrames = std::max(m_uploadStats.maxLatencyFrames, latency);
+			++retiredUploads;
+		}
+
+		m_stagingBuffer->release(slot.batch.region);
+		slot.batch = {};
+		slot.queuedFrames.clear();
+		slot.relocations.clear();
+		VK_CHECK(vkResetFences(m_device, 1, &slot.context._uploadFence));
+		VK_CHECK(vkResetCommandPool(m_device, slot.context._commandPool, 0));
+		slot.inFlight = false;
+		m_oldestUploadSlot = (m_oldestUploadSlot + 1) % UploadSlotCount;
+	}
+
+	m_uploadStats.averageLatencyFrames = retiredUploads > 0
+		? static_cast<float>(totalLatency) / static_cast<float>(retiredUploads)
+		: 0.0f;
+}
+
+void MeshManager::wait_for_uploads()
+{
+	for (const UploadSlot& slot : m_uploadSlots)
+	{
+		if (slot.inFlight)
+		{
+			VK_CHECK(vkWaitForFences(m_device, 1, &slot.context._uploadFence, VK_TRUE, UINT64_MAX));
+		}
+	}
+	retire_completed_uploads();
+}
+
 void MeshManager::handle_transfers()
 {
 	ZoneScopedN("Handle Upload meshes");
+	++m_transferFrame;
+	retire_completed_uploads();
     try_apply_pending_budget();
-	m_stagingBuffer->begin_recording();
+
 	std::shared_ptr<Mesh> uploadMesh;
 	while (UploadQueue.try_dequeue(uploadMesh))
 	{
-		m_stagingBuffer->upload_mesh(std::move(uploadMesh));
+		m_pendingUploads.push_back(PendingUpload{
+			.mesh = std::move(uploadMesh),
+			.queuedFrame = m_transferFrame
+		});
 	}
 
-	immediate_submit(m_stagingBuffer->build_submission());
+	submit_pending_uploads();
+	submit_compaction();
+	m_stagingBuffer->mesh_allocator().collect_garbage(m_transferFrame);
+
+	m_uploadStats.deferredUploads = static_cast<uint32_t>(m_pendingUploads.size());
+	m_uploadStats.queuedBytes = 0;
+	for (const PendingUpload& pending : m_pendingUploads)
+	{
+		m_uploadStats.queuedBytes += StagingBuffer::upload_size(*pending.mesh);
+	}
 
-	m_stagingBuffer->end_recording();
+	TracyPlot("Mesh Upload Slots In Flight", static_cast<int64_t>(uploads_in_flight()));
+	TracyPlot("Mesh Uploads Deferred", static_cast<int64_t>(m_uploadStats.deferredUploads));
+	TracyPlot("Mesh Upload Queued Bytes", static_cast<int64_t>(m_uploadStats.queuedBytes));
+	TracyPlot("Mesh Upload Max Latency Frames", static_cast<int64_t>(m_uploadStats.maxLatencyFrames));
+}
+
+void MeshManager::submit_pending_uploads()
+{
+	ZoneScopedN("Submit Pending Uploads");
+	m_uploadStats.submittedUploads = 0;
+	m_uploadStats.submittedBytes = 0;
+
+	// Nothing else references these meshes any more, so there is no point uploading them.
+	render::prune_released_uploads(m_pendingUploads);
+
+	// When every slot is still copying, the pending meshes simply wait for a later frame.
+	UploadSlot& slot = m_uploadSlots[m_nextUploadSlot];
+	if (slot.inFlight || m_pendingUploads.empty())
+	{
+		return;
+	}
+
+	std::ranges::stable_sort(m_pendingUploads, {}, [](const PendingUpload& pending)
+	{
+		return pending.mesh->_uploadPriority;
+	});
+
+	m_stagingBuffer->begin_recording();
+	size_t consumed = 0;
+	for (; consumed < m_pendingUploads.size(); ++consumed)
+	{
+		const PendingUpload& pending = m_pendingUploads[consumed];
+		const VkDeviceSize size = StagingBuffer::upload_size(*pending.mesh);
+		const StagingUploadResult result = m_stagingBuffer->upload_mesh(pending.mesh);
+		if (result == StagingUploadResult::Deferred)
+		{
+			break;
+		}
+
+		if (result == StagingUploadResult::Uploaded)
+		{
+			slot.queuedFrames.push_back(pending.queuedFrame);
+			++m_uploadStats.submittedUploads;
+			m_uploadStats.submittedBytes += size;
+		}
+	}
+	m_pendingUploads.erase(m_pendingUploads.begin(), m_pendingUploads.begin() + static_cast<std::ptrdiff_t>(consumed));
+
+	const VkCommandBuffer cmd = slot.context._commandBuffer;
+	if (m_uploadStats.submittedUploads > 0)
+	{
+		const VkCommandBufferBeginInfo cmdBeginInfo = vkinit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
+		m_stagingBuffer->record_copies(cmd);
+		VK_CHECK(vkEndCommandBuffer(cmd));
+	}
+
+	slot.batch = m_stagingBuffer->end_recording();
+	if (slot.batch.uploads.empty())
+	{
+		m_stagingBuffer->release(slot.batch.region);
+		slot.batch = {};
+		return;
+	}
+
+	const VkSubmitInfo submit = vkinit::submit_info(&cmd);
+	VK_CHECK(vkQueueSubmit(m_transferQueue._queue, 1, &submit, slot.context._uploadFence));
+	slot.inFlight = true;
+	m_nextUploadSlot = (m_nextUploadSlot + 1) % UploadSlotCount;
+}
+
+void MeshManager::submit_compaction()
+{
+	ZoneScopedN("Submit Mesh Compaction");
+	// Uploads always take precedence; compaction only uses transfer frames with nothing else to copy.
+	UploadSlot& slot = m_uploadSlots[m_nextUploadSlot];
+	if (slot.inFlight || !m_pendingUploads.empty() || m_pendingBudget.has_value() ||
+		m_transferFrame % CompactionIntervalFrames != 0)
+	{
+		return;
+	}
+
+	IMeshAllocator& allocator = m_stagingBuffer->mesh_allocator();
+	for (MeshRelocation& relocation : allocator.plan_relocations(CompactionBytesPerBatch))
+	{
+		std::shared_ptr<Mesh> mesh = relocation.handle < static_cast<int32_t>(m_residentMeshes.size())
+			? m_residentMeshes[relocation.handle].lock()
+			: nullptr;
+		const bool resident = mesh != nullptr &&
+			mesh->_isActive.load(std::memory_order::acquire) &&
+			mesh->_allocation.handle == relocation.handle &&
+			mesh->_allocation.vertexOffset == relocation.source.vertexOffset &&
+			mesh->_allocation.indexOffset == relocation.source.indexOffset;
+		if (!resident)
+		{
+			allocator.cancel_relocation(relocation);
+			continue;
+		}
+
+		slot.relocations.push_back(PendingRelocation{
+			.mesh = std::move(mesh),
+			.relocation = relocation
+		});
+	}
+
+	if (slot.relocations.empty())
+	{
+		return;
+	}
+
+	const VkCommandBuffer cmd = slot.context._commandBuffer;
+	const VkCommandBufferBeginInfo cmdBeginInfo = vkinit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
+	for (const PendingRelocation& pending : slot.relocations)
+	{
+		const MeshAllocation& source = pending.relocation.source;
+		const MeshAllocation& destination = pending.relocation.destination;
+		if (source.vertexSize > 0 &&
+			(source.vertexBuffer != destination.vertexBuffer || source.vertexOffset != destination.vertexOffset))
+		{
+			const VkBufferCopy copy{
+				.srcOffset = source.vertexOffset,
+				.dstOffset = destination.vertexOffset,
+				.size = source.vertexSize
+			};
+			vkCmdCopyBuffer(cmd, source.vertexBuffer, destination.vertexBuffer, 1, &copy);
+		}
+		if (source.indexSize > 0 &&
+			(source.indexBuffer != destination.indexBuffer || source.indexOffset != destination.indexOffset))
+		{
+			const VkBufferCopy copy{
+				.srcOffset = source.indexOffset,
+				.dstOffset = destination.indexOffset,
+				.size = source.indexSize
+			};
+			vkCmdCopyBuffer(cmd, source.indexBuffer, destination.indexBuffer, 1, &copy);
+		}
+	}
+	VK_CHECK(vkEndCommandBuffer(cmd));
+
+	const VkSubmitInfo submit = vkinit::submit_info(&cmd);
+	VK_CHECK(vkQueueSubmit(m_transferQueue._queue, 1, &submit, slot.context._uploadFence));
+	slot.inFlight = true;
+	m_nextUploadSlot = (m_nextUploadSlot + 1) % UploadSlotCount;
 }
 
 void MeshManager::try_apply_pending_budget()
@@ -258,12 +587,27 @@ void MeshManager::try_apply_pending_budget()
         return;
     }
 
-    if (!m_stagingBuffer->can_reconfigure())
+    // Only the mesh slot budget depends on the view distance. Allocators that can change it under live
+    // allocations take it at once, so uploaded meshes survive a view distance change.
+    const StagingBufferConfig requested = make_staging_buffer_config(m_pendingBudget.value());
+    const StagingBufferConfig& current = m_stagingBuffer->config();
+    if (requested.stagingBufferSize == current.stagingBufferSize &&
+        requested.frameUploadBudget == current.frameUploadBudget &&
+        requested.meshAllocatorConfig.strategy == current.meshAllocatorConfig.strategy &&
+        m_stagingBuffer->resize_mesh_allocator(requested.meshAllocatorConfig.slotCapacity))
+    {
+        m_activeBudget = m_pendingBudget.value();
+        m_pendingBudget.reset();
+        return;
+    }
+
+    // Reconfiguring recreates the staging buffer, which in-flight copies may still be reading.
+    if (uploads_in_flight() > 0 || !m_stagingBuffer->can_reconfigure())
     {
         return;
     }
 
-    m_stagingBuffer->reconfigure(make_staging_buffer_config(m_pendingBudget.value()));
+    m_stagingBuffer->reconfigure(requested);
     m_activeBudget = m_pendingBudget.value();
     m_pendingBudget.reset();
 }
@@ -272,17 +616,21 @@ MeshManager::MeshBudget MeshManager::make_mesh_budget(const settings::ViewDistan
 {
     constexpr size_t debugMeshHeadroom = 128;
     const size_t maximumResidentChunks = static_cast<size_t>(std::max(1, settings.maximumResidentChunks));
+    const size_t maximumHorizonTiles = static_cast<size_t>(std::max(0, settings.maximumHorizonTiles));
+    // Near horizon tiles carry several chunks' worth of vertices, so each is budgeted two slots.
     return MeshBudget{
         .viewDistance = settings.viewDistance,
         .maximumResidentChunks = maximumResidentChunks,
-        .slotCapacity = (maximumResidentChunks * 2) + debugMeshHeadroom
+        .maximumHorizonTiles = maximumHorizonTiles,
+        .slotCapacity = (maximumResidentChunks * 2) + (maximumHorizonTiles * 2) + debugMeshHeadroom
     };
 }
 
 StagingBufferConfig MeshManager::make_staging_buffer_config(const MeshBudget& budget)
 {
     return StagingBufferConfig{
-        .stagingBufferSize = approximate_staging_buffer_size(budget.viewDistance),
+        .stagingBufferSize = DefaultFrameUploadBudget * (UploadSlotCount + 1),
+        .frameUploadBudget = DefaultFrameUploadBudget,
         .meshAllocatorConfig = MeshAllocatorConfig{
             .strategy = DefaultMeshAllocationStrategy,
             .slotCapacity = budget.slotCapacity
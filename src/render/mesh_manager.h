@@ -1,47 +1,139 @@
 #pragma once
 
+#include <array>
+#include <deque>
 #include <optional>
 
 #include <utils/blockingconcurrentqueue.h>
 
 #include "mesh.h"
+#include "pending_uploads.h"
 #include "settings/game_settings.h"
 #include "staging_buffer.h"
 
 class MeshManager {
 public:
     void init(VkDevice device, VmaAllocator allocator, const QueueFamily& queue);
-    void apply_view_distance_settings(const settings::ViewDistanceRuntimeSettings& settings);
+    // Returns false when the new budget has to wait for every mesh to be released (see accepts_uploads).
+    bool apply_view_distance_settings(const settings::ViewDistanceRuntimeSettings& settings);
     [[nodiscard]] bool accepts_uploads() const noexcept;
+    [[nodiscard]] VkBuffer quad_index_buffer() const noexcept;
 
     void cleanup();
     moodycamel::BlockingConcurrentQueue<std::shared_ptr<Mesh>> UploadQueue;
 
     void unload_garbage();
     void handle_transfers();
+    [[nodiscard]] uint32_t uploads_in_flight() const noexcept;
+
+    struct UploadStats
+    {
+        // Meshes waiting for a later batch and the staging bytes they need.
+        uint32_t deferredUploads{0};
+        uint64_t queuedBytes{0};
+        uint32_t submittedUploads{0};
+        uint64_t submittedBytes{0};
+        // Frames from leaving UploadQueue to copy completion, over the uploads that completed this frame.
+        float averageLatencyFrames{0.0f};
+        uint32_t maxLatencyFrames{0};
+    };
+
+    [[nodiscard]] const UploadStats& upload_stats() const noexcept { return m_uploadStats; }
+    [[nodiscard]] MeshAllocatorStats allocator_stats() const noexcept;
+
+    struct RetirementStats
+    {
+        // Released meshes whose GPU memory waits for the frames that may still draw them.
+        uint32_t pendingMeshes{0};
+        uint64_t pendingBytes{0};
+        uint32_t freedMeshes{0};
+        uint64_t freedBytes{0};
+    };
+
+    [[nodiscard]] const RetirementStats& retirement_stats() const noexcept { return m_retirementStats; }
 
 private:
     struct MeshBudget
     {
         int viewDistance{GameConfig::DEFAULT_VIEW_DISTANCE};
         size_t maximumResidentChunks{static_cast<size_t>(maximum_chunks_for_view_distance(GameConfig::DEFAULT_VIEW_DISTANCE))};
-        size_t slotCapacity{static_cast<size_t>((maximum_chunks_for_view_distance(GameConfig::DEFAULT_VIEW_DISTANCE) * 2) + 128)};
+        size_t maximumHorizonTiles{static_cast<size_t>(maximum_horizon_tiles(GameConfig::DEFAULT_VIEW_DISTANCE, GameConfig::DEFAULT_HORIZON_DISTANCE))};
+        size_t slotCapacity{static_cast<size_t>(
+            (maximum_chunks_for_view_distance(GameConfig::DEFAULT_VIEW_DISTANCE) * 2) +
+            (maximum_horizon_tiles(GameConfig::DEFAULT_VIEW_DISTANCE, GameConfig::DEFAULT_HORIZON_DISTANCE) * 2) +
+            128)};
+    };
+
+    // Each slot owns a fence, a command buffer and the staging range of one batch. Slots retire in
+    // submission order once their fence has signalled, so the render thread polls instead of waiting.
+    static constexpr uint32_t UploadSlotCount = 3;
+    // Compaction only runs on idle transfer frames, at most this often and this many bytes at a time.
+    static constexpr uint64_t CompactionIntervalFrames = 30;
+    static constexpr VkDeviceSize CompactionBytesPerBatch = 4ull * 1024ull * 1024ull;
+
+    struct PendingRelocation
+    {
+        // Holding the mesh keeps ~Mesh from releasing its ranges while the copy is in flight.
+        std::shared_ptr<Mesh> mesh{};
+        MeshRelocation relocation{};
+    };
+
+    // The GPU ranges of a mesh whose last owner let go in retireFrame (see ~Mesh). The mesh itself is
+    // gone, so nothing can take a new reference and the range only has to outlive the frames in flight.
+    // Waiting FRAME_OVERLAP frames is only enough because of that: render objects, upload batches and
+    // relocations all hold the mesh, so a range never retires while a recorded frame can still read it.
+    struct RetiredAllocation
+    {
+        MeshAllocation allocation{};
+        uint64_t retireFrame{0};
+        uint64_t bytes{0};
+    };
+
+    struct UploadSlot
+    {
+        UploadContext context{};
+        StagingBatch batch{};
+        std::vector<uint64_t> queuedFrames{};
+        std::vector<PendingRelocation> relocations{};
+        bool inFlight{false};
     };
 
     VkDevice m_device{};
     VmaAllocator m_allocator{};
     QueueFamily m_transferQueue{};
+    // Blocking one-off submissions during init.
     UploadContext m_uploadContext{};
+    std::array<UploadSlot, UploadSlotCount> m_uploadSlots{};
+    uint32_t m_nextUploadSlot{0};
+    uint32_t m_oldestUploadSlot{0};
+    // Meshes drained from UploadQueue that did not fit a batch yet, kept in upload priority order.
+    std::vector<render::PendingUpload> m_pendingUploads{};
+    // Uploaded meshes indexed by allocation handle, so relocations planned by the allocator can find their owner.
+    std::vector<std::weak_ptr<Mesh>> m_residentMeshes{};
+    uint64_t m_transferFrame{0};
+    UploadStats m_uploadStats{};
+    // Released ranges in retire-frame order; each is freed once the fence of its retire frame has signalled.
+    std::deque<RetiredAllocation> m_retiredAllocations{};
+    RetirementStats m_retirementStats{};
 
     std::unique_ptr<StagingBuffer> m_stagingBuffer = nullptr;
+    AllocatedBuffer m_quadIndexBuffer{};
     MeshBudget m_activeBudget{};
     std::optional<MeshBudget> m_pendingBudget{};
 
+    void create_quad_index_buffer();
     void immediate_submit(std::function<void(VkCommandBuffer cmd)>&& function) const;
+    void create_upload_context(UploadContext& context) const;
+    void destroy_upload_context(UploadContext& context) const;
+    void retire_completed_uploads();
+    void submit_pending_uploads();
+    void submit_compaction();
+    void wait_for_uploads();
     void try_apply_pending_budget();
+    void free_retired_allocations(uint64_t frame);
     [[nodiscard]] static MeshBudget make_mesh_budget(const settings::ViewDistanceRuntimeSettings& settings);
     [[nodiscard]] static StagingBufferConfig make_staging_buffer_config(const MeshBudget& budget);
 
     // void upload_mesh(std::shared_ptr<Mesh>&& mesh) const;
-    void unload_mesh(std::shared_ptr<Mesh>&& mesh) const;
+    void free_allocation(const MeshAllocation& allocation);
 };
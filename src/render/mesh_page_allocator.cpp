@@ -0,0 +1,388 @@
+#include "mesh_page_allocator.h"
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <stdexcept>
+
+#include "constants.h"
+
+namespace render
+{
+    namespace
+    {
+        // Free space split into holes that leave the largest under 70% of the total triggers compaction.
+        constexpr float CompactionFragmentationThreshold = 0.3f;
+    }
+
+    MeshPageAllocator::MeshPageAllocator(const MeshPagePoolConfig vertex, const MeshPagePoolConfig index)
+    {
+        reset(vertex, index);
+    }
+
+    void MeshPageAllocator::reset(const MeshPagePoolConfig vertex, const MeshPagePoolConfig index)
+    {
+        m_pools = {
+            RangePool{ .config = vertex },
+            RangePool{ .config = index }
+        };
+        for (RangePool& rangePool : m_pools)
+        {
+            rangePool.config.alignment = std::max<uint64_t>(rangePool.config.alignment, 1);
+            add_page(rangePool, 0);
+        }
+
+        m_records.clear();
+        m_freeHandles.clear();
+        m_retiredRanges.clear();
+        m_liveAllocations = 0;
+        m_relocationsInFlight = 0;
+    }
+
+    MeshPageAllocation MeshPageAllocator::acquire(const uint64_t vertexSize, const uint64_t indexSize)
+    {
+        const MeshPageRange vertex = allocate_range(pool(MeshPagePool::Vertex), vertexSize);
+        const MeshPageRange index = allocate_range(pool(MeshPagePool::Index), indexSize);
+
+        int32_t handle = -1;
+        if (!m_freeHandles.empty())
+        {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<int32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+
+        m_records[handle] = AllocationRecord{
+            .vertex = vertex,
+            .index = index,
+            .live = true
+        };
+        ++m_liveAllocations;
+        return MeshPageAllocation{ .handle = handle, .vertex = vertex, .index = index };
+    }
+
+    void MeshPageAllocator::free(const int32_t handle)
+    {
+        if (live_record(handle) == nullptr)
+        {
+            return;
+        }
+
+        cancel_relocation(handle);
+
+        AllocationRecord& record = m_records[handle];
+        free_range(pool(MeshPagePool::Vertex), record.vertex);
+        free_range(pool(MeshPagePool::Index), record.index);
+        record = AllocationRecord{};
+        m_freeHandles.push_back(handle);
+        --m_liveAllocations;
+    }
+
+    std::vector<MeshPageRelocation> MeshPageAllocator::plan_relocations(const uint64_t byteBudget)
+    {
+        std::vector<MeshPageRelocation> relocations{};
+        const bool compactVertices = needs_compaction(pool(MeshPagePool::Vertex));
+        const bool compactIndices = needs_compaction(pool(MeshPagePool::Index));
+        if (!compactVertices && !compactIndices)
+        {
+            return relocations;
+        }
+
+        std::vector<int32_t> candidates{};
+        candidates.reserve(m_liveAllocations);
+        for (int32_t handle = 0; handle < static_cast<int32_t>(m_records.size()); ++handle)
+        {
+            const AllocationRecord& record = m_records[handle];
+            if (record.live && !record.relocatedVertex.has_value() && !record.relocatedIndex.has_value())
+            {
+                candidates.push_back(handle);
+            }
+        }
+
+        // Ranges furthest from the front move first, which drains trailing pages and packs the rest toward offset 0.
+        std::ranges::sort(candidates, std::greater{}, [this](const int32_t handle)
+        {
+            const MeshPageRange& vertex = m_records[handle].vertex;
+            return std::pair{vertex.page, vertex.range.offset};
+        });
+
+        uint64_t plannedBytes = 0;
+        for (const int32_t handle : candidates)
+        {
+            if (plannedBytes >= byteBudget)
+            {
+                break;
+            }
+
+            AllocationRecord& record = m_records[handle];
+            if (compactVertices && record.vertex.range.size > 0)
+            {
+                record.relocatedVertex = allocate_better_range(pool(MeshPagePool::Vertex), record.vertex);
+            }
+            if (compactIndices && record.index.range.size > 0)
+            {
+                record.relocatedIndex = allocate_better_range(pool(MeshPagePool::Index), record.index);
+            }
+            if (!record.relocatedVertex.has_value() && !record.relocatedIndex.has_value())
+            {
+                continue;
+            }
+
+            ++m_relocationsInFlight;
+            plannedBytes += record.relocatedVertex.has_value() ? record.vertex.range.size : 0;
+            plannedBytes += record.relocatedIndex.has_value() ? record.index.range.size : 0;
+            relocations.push_back(MeshPageRelocation{
+                .source = MeshPageAllocation{ .handle = handle, .vertex = record.vertex, .index = record.index },
+                .destination = MeshPageAllocation{
+                    .handle = handle,
+                    .vertex = record.relocatedVertex.value_or(record.vertex),
+                    .index = record.relocatedIndex.value_or(record.index)
+                }
+            });
+        }
+
+        return relocations;
+    }
+
+    void MeshPageAllocator::commit_relocation(const int32_t handle, const uint64_t retireFrame)
+    {
+        if (live_record(handle) == nullptr)
+        {
+            return;
+        }
+
+        AllocationRecord& record = m_records[handle];
+        if (!record.relocatedVertex.has_value() && !record.relocatedIndex.has_value())
+        {
+            return;
+        }
+
+        if (record.relocatedVertex.has_value())
+        {
+            m_retiredRanges.push_back(RetiredRange{ .pool = MeshPagePool::Vertex, .range = record.vertex, .retireFrame = retireFrame });
+            m_relocatedBytes += record.vertex.range.size;
+            record.vertex = record.relocatedVertex.value();
+            record.relocatedVertex.reset();
+        }
+        if (record.relocatedIndex.has_value())
+        {
+            m_retiredRanges.push_back(RetiredRange{ .pool = MeshPagePool::Index, .range = record.index, .retireFrame = retireFrame });
+            m_relocatedBytes += record.index.range.size;
+            record.index = record.relocatedIndex.value();
+            record.relocatedIndex.reset();
+        }
+        --m_relocationsInFlight;
+    }
+
+    void MeshPageAllocator::cancel_relocation(const int32_t handle)
+    {
+        if (handle < 0 || handle >= static_cast<int32_t>(m_records.size()))
+        {
+            return;
+        }
+
+        AllocationRecord& record = m_records[handle];
+        if (!record.relocatedVertex.has_value() && !record.relocatedIndex.has_value())
+        {
+            return;
+        }
+
+        if (record.relocatedVertex.has_value())
+        {
+            free_range(pool(MeshPagePool::Vertex), record.relocatedVertex.value());
+            record.relocatedVertex.reset();
+        }
+        if (record.relocatedIndex.has_value())
+        {
+            free_range(pool(MeshPagePool::Index), record.relocatedIndex.value());
+            record.relocatedIndex.reset();
+        }
+        --m_relocationsInFlight;
+    }
+
+    void MeshPageAllocator::collect_garbage(const uint64_t frame)
+    {
+        m_currentFrame = frame;
+        // A range may still be read by any frame recorded before its relocation committed.
+        std::erase_if(m_retiredRanges, [this, frame](const RetiredRange& retired)
+        {
+            if (retired.retireFrame + FRAME_OVERLAP > frame)
+            {
+                return false;
+            }
+
+            free_range(pool(retired.pool), retired.range);
+            return true;
+        });
+
+        // Only trailing pages are dropped so live records keep their page indices.
+        for (RangePool& rangePool : m_pools)
+        {
+            while (rangePool.pages.size() > 1 &&
+                rangePool.pages.back().ranges.empty() &&
+                rangePool.pages.back().emptySinceFrame + FRAME_OVERLAP <= frame)
+            {
+                rangePool.pages.pop_back();
+            }
+        }
+    }
+
+    bool MeshPageAllocator::needs_compaction(const MeshPagePool pool) const noexcept
+    {
+        return needs_compaction(this->pool(pool));
+    }
+
+    size_t MeshPageAllocator::page_count(const MeshPagePool pool) const noexcept
+    {
+        return this->pool(pool).pages.size();
+    }
+
+    uint64_t MeshPageAllocator::page_capacity(const MeshPagePool pool, const uint32_t page) const noexcept
+    {
+        const RangePool& rangePool = this->pool(pool);
+        return page < rangePool.pages.size() ? rangePool.pages[page].ranges.capacity() : 0;
+    }
+
+    RangeAllocatorStats MeshPageAllocator::pool_stats(const MeshPagePool pool) const noexcept
+    {
+        RangeAllocatorStats total{};
+        for (const Page& page : this->pool(pool).pages)
+        {
+            const RangeAllocatorStats pageStats = page.ranges.stats();
+            total.capacity += pageStats.capacity;
+            total.usedBytes += pageStats.usedBytes;
+            total.freeBytes += pageStats.freeBytes;
+            total.largestFreeBlock = std::max(total.largestFreeBlock, pageStats.largestFreeBlock);
+            total.freeBlocks += pageStats.freeBlocks;
+            total.liveAllocations += pageStats.liveAllocations;
+        }
+        return total;
+    }
+
+    std::optional<MeshPageAllocation> MeshPageAllocator::find(const int32_t handle) const noexcept
+    {
+        const AllocationRecord* record = live_record(handle);
+        if (record == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return MeshPageAllocation{ .handle = handle, .vertex = record->vertex, .index = record->index };
+    }
+
+    const MeshPageAllocator::AllocationRecord* MeshPageAllocator::live_record(const int32_t handle) const noexcept
+    {
+        if (handle < 0 || handle >= static_cast<int32_t>(m_records.size()) || !m_records[handle].live)
+        {
+            return nullptr;
+        }
+
+        return &m_records[handle];
+    }
+
+    MeshPageRange MeshPageAllocator::allocate_range(RangePool& pool, const uint64_t size)
+    {
+        if (size == 0)
+        {
+            return MeshPageRange{};
+        }
+
+        for (uint32_t page = 0; page < pool.pages.size(); ++page)
+        {
+            if (const std::optional<RangeAllocation> range = pool.pages[page].ranges.allocate(size, pool.config.alignment))
+            {
+                return MeshPageRange{ .page = page, .range = range.value() };
+            }
+        }
+
+        add_page(pool, size);
+        const std::optional<RangeAllocation> range = pool.pages.back().ranges.allocate(size, pool.config.alignment);
+        if (!range.has_value())
+        {
+            throw std::runtime_error(std::format("MeshPageAllocator::allocate_range: new page cannot hold {} bytes", size));
+        }
+
+        return MeshPageRange{ .page = static_cast<uint32_t>(pool.pages.size() - 1), .range = range.value() };
+    }
+
+    std::optional<MeshPageRange> MeshPageAllocator::allocate_better_range(RangePool& pool, const MeshPageRange& current)
+    {
+        for (uint32_t page = 0; page <= current.page && page < pool.pages.size(); ++page)
+        {
+            const std::optional<RangeAllocation> range = pool.pages[page].ranges.allocate(current.range.size, pool.config.alignment);
+            if (!range.has_value())
+            {
+                continue;
+            }
+
+            if (page < current.page || range->offset < current.range.offset)
+            {
+                return MeshPageRange{ .page = page, .range = range.value() };
+            }
+
+            pool.pages[page].ranges.free(range.value());
+            break;
+        }
+
+        return std::nullopt;
+    }
+
+    void MeshPageAllocator::free_range(RangePool& pool, const MeshPageRange& range)
+    {
+        if (range.range.block == TlsfRangeAllocator::InvalidBlock || range.page >= pool.pages.size())
+        {
+            return;
+        }
+
+        Page& page = pool.pages[range.page];
+        page.ranges.free(range.range);
+        if (page.ranges.empty())
+        {
+            page.emptySinceFrame = m_currentFrame;
+        }
+    }
+
+    void MeshPageAllocator::add_page(RangePool& pool, const uint64_t minimumSize)
+    {
+        const uint64_t alignment = pool.config.alignment;
+        const uint64_t alignedMinimum = (minimumSize + alignment - 1) / alignment * alignment;
+        const uint64_t size = std::max(pool.config.pageSize, alignedMinimum);
+        pool.pages.push_back(Page{
+            .ranges = TlsfRangeAllocator{size},
+            .emptySinceFrame = m_currentFrame
+        });
+    }
+
+    bool MeshPageAllocator::needs_compaction(const RangePool& pool) noexcept
+    {
+        if (pool.pages.empty())
+        {
+            return false;
+        }
+
+        // A trailing page is only worth draining when everything still in it fits the free space in front
+        // of it; a world that genuinely needs several pages stays put until it shrinks again.
+        uint64_t leadingFreeBytes = 0;
+        for (size_t page = 0; page + 1 < pool.pages.size(); ++page)
+        {
+            const RangeAllocatorStats pageStats = pool.pages[page].ranges.stats();
+            if (pageStats.fragmentation() > CompactionFragmentationThreshold)
+            {
+                return true;
+            }
+            leadingFreeBytes += pageStats.freeBytes;
+        }
+
+        const RangeAllocatorStats trailing = pool.pages.back().ranges.stats();
+        if (pool.pages.size() > 1 && trailing.usedBytes > 0 && trailing.usedBytes <= leadingFreeBytes)
+        {
+            return true;
+        }
+
+        return trailing.fragmentation() > CompactionFragmentationThreshold;
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "tlsf_range_allocator.h"
+
+namespace render
+{
+    enum class MeshPagePool : uint8_t
+    {
+        Vertex = 0,
+        Index = 1
+    };
+
+    struct MeshPagePoolConfig
+    {
+        // A range larger than this gets a page of its own, rounded up to the alignment.
+        uint64_t pageSize{0};
+        uint64_t alignment{1};
+    };
+
+    struct MeshPageRange
+    {
+        uint32_t page{0};
+        RangeAllocation range{};
+    };
+
+    struct MeshPageAllocation
+    {
+        int32_t handle{-1};
+        MeshPageRange vertex{};
+        MeshPageRange index{};
+    };
+
+    // Moves one live allocation to a better-placed range. Ranges that do not move are the same in both.
+    struct MeshPageRelocation
+    {
+        MeshPageAllocation source{};
+        MeshPageAllocation destination{};
+    };
+
+    // The bookkeeping half of VariableMeshAllocator: pages of TLSF ranges for vertices and indices,
+    // allocation handles, relocation planning and the frame-gated release of relocation sources and
+    // trailing empty pages. Pages are only added and removed at the back, so the owner of the matching
+    // GPU buffers keeps them in step by comparing page_count() after acquire and collect_garbage.
+    class MeshPageAllocator
+    {
+    public:
+        MeshPageAllocator() = default;
+        MeshPageAllocator(MeshPagePoolConfig vertex, MeshPagePoolConfig index);
+
+        // Drops every allocation and starts again from one page per pool.
+        void reset(MeshPagePoolConfig vertex, MeshPagePoolConfig index);
+
+        [[nodiscard]] MeshPageAllocation acquire(uint64_t vertexSize, uint64_t indexSize);
+        void free(int32_t handle);
+
+        // Ranges furthest from the front move first, up to byteBudget bytes. Each planned relocation
+        // stays reserved until it is committed or cancelled.
+        [[nodiscard]] std::vector<MeshPageRelocation> plan_relocations(uint64_t byteBudget);
+        // The source ranges stay reserved until collect_garbage sees retireFrame + FRAME_OVERLAP.
+        void commit_relocation(int32_t handle, uint64_t retireFrame);
+        void cancel_relocation(int32_t handle);
+        void collect_garbage(uint64_t frame);
+
+        [[nodiscard]] bool needs_compaction(MeshPagePool pool) const noexcept;
+        [[nodiscard]] size_t page_count(MeshPagePool pool) const noexcept;
+        [[nodiscard]] uint64_t page_capacity(MeshPagePool pool, uint32_t page) const noexcept;
+        [[nodiscard]] RangeAllocatorStats pool_stats(MeshPagePool pool) const noexcept;
+        [[nodiscard]] std::optional<MeshPageAllocation> find(int32_t handle) const noexcept;
+
+        [[nodiscard]] size_t live_allocations() const noexcept { return m_liveAllocations; }
+        [[nodiscard]] bool has_retired_ranges() const noexcept { return !m_retiredRanges.empty(); }
+        [[nodiscard]] uint32_t relocations_in_flight() const noexcept { return m_relocationsInFlight; }
+        [[nodiscard]] uint64_t relocated_bytes() const noexcept { return m_relocatedBytes; }
+
+    private:
+        struct Page
+        {
+            TlsfRangeAllocator ranges{};
+            // Frame at which the page last became empty; trailing empty pages are dropped once it has retired.
+            uint64_t emptySinceFrame{0};
+        };
+
+        struct RangePool
+        {
+            MeshPagePoolConfig config{};
+            std::vector<Page> pages{};
+        };
+
+        struct AllocationRecord
+        {
+            MeshPageRange vertex{};
+            MeshPageRange index{};
+            std::optional<MeshPageRange> relocatedVertex{};
+            std::optional<MeshPageRange> relocatedIndex{};
+            bool live{false};
+        };
+
+        struct RetiredRange
+        {
+            MeshPagePool pool{MeshPagePool::Vertex};
+            MeshPageRange range{};
+            uint64_t retireFrame{0};
+        };
+
+        std::array<RangePool, 2> m_pools{};
+        std::vector<AllocationRecord> m_records{};
+        std::vector<int32_t> m_freeHandles{};
+        std::vector<RetiredRange> m_retiredRanges{};
+        size_t m_liveAllocations{0};
+        uint32_t m_relocationsInFlight{0};
+        uint64_t m_relocatedBytes{0};
+        uint64_t m_currentFrame{0};
+
+        [[nodiscard]] RangePool& pool(MeshPagePool pool) noexcept { return m_pools[static_cast<size_t>(pool)]; }
+        [[nodiscard]] const RangePool& pool(MeshPagePool pool) const noexcept { return m_pools[static_cast<size_t>(pool)]; }
+        [[nodiscard]] const AllocationRecord* live_record(int32_t handle) const noexcept;
+        [[nodiscard]] MeshPageRange allocate_range(RangePool& pool, uint64_t size);
+        [[nodiscard]] std::optional<MeshPageRange> allocate_better_range(RangePool& pool, const MeshPageRange& current);
+        void free_range(RangePool& pool, const MeshPageRange& range);
+        void add_page(RangePool& pool, uint64_t minimumSize);
+        [[nodiscard]] static bool needs_compaction(const RangePool& pool) noexcept;
+    };
+}
@@ -2,24 +2,24 @@
 
 #include <utils/blockingconcurrentqueue.h>
 
-#include "mesh.h"
+#include "mesh_allocator.h"
 
 namespace
 {
-    moodycamel::BlockingConcurrentQueue<std::shared_ptr<Mesh>> g_meshReleaseQueue;
+    moodycamel::BlockingConcurrentQueue<MeshAllocation> g_meshReleaseQueue;
 }
 
-void render::enqueue_mesh_release(std::shared_ptr<Mesh> mesh)
+void render::enqueue_mesh_release(const MeshAllocation& allocation)
 {
-    if (mesh == nullptr)
+    if (allocation.handle < 0)
     {
         return;
     }
 
-    g_meshReleaseQueue.enqueue(std::move(mesh));
+    g_meshReleaseQueue.enqueue(allocation);
 }
 
-bool render::try_dequeue_mesh_release(std::shared_ptr<Mesh>& mesh)
+bool render::try_dequeue_mesh_release(MeshAllocation& allocation)
 {
-    return g_meshReleaseQueue.try_dequeue(mesh);
+    return g_meshReleaseQueue.try_dequeue(allocation);
 }
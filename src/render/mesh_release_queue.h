@@ -1,11 +1,11 @@
 #pragma once
 
-#include <memory>
-
-struct Mesh;
+struct MeshAllocation;
 
 namespace render
 {
-    void enqueue_mesh_release(std::shared_ptr<Mesh> mesh);
-    bool try_dequeue_mesh_release(std::shared_ptr<Mesh>& mesh);
+    // Called by ~Mesh when the last owner of an uploaded mesh lets go, from whichever thread that is.
+    // MeshManager drains the queue once per frame and frees each range after the frames in flight.
+    void enqueue_mesh_release(const MeshAllocation& allocation);
+    bool try_dequeue_mesh_release(MeshAllocation& allocation);
 }
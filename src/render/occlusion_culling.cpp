@@ -0,0 +1,383 @@
+#include "occlusion_culling.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <glm/vec4.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_CULLING_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define OCCLUSION_CULLING_NEON 1
+#endif
+
+namespace render
+{
+    namespace
+    {
+        constexpr uint32_t LaneCount = 4;
+        constexpr float ClearDepth = std::numeric_limits<float>::max();
+        // Corners closer to the camera plane than this are treated as crossing it.
+        constexpr float MinClipW = 1.0e-4f;
+
+        // Corner i takes max on x when bit 0 is set, on y for bit 1 and on z for bit 2.
+        constexpr std::array<std::array<uint8_t, 4>, 6> BoxFaces{{
+            {0, 2, 6, 4},
+            {1, 5, 7, 3},
+            {0, 4, 5, 1},
+            {2, 3, 7, 6},
+            {0, 1, 3, 2},
+            {4, 6, 7, 5}
+        }};
+
+        struct ProjectedBox
+        {
+            std::array<glm::vec3, 8> corners{};
+            glm::vec3 min{0.0f};
+            glm::vec3 max{0.0f};
+        };
+
+        // Screen x/y in pixels and clip z / w per corner; false when any corner is at or behind the camera.
+        bool project_box(const glm::mat4& viewProjection, const glm::vec3& boxMin, const glm::vec3& boxMax, ProjectedBox& projected)
+        {
+            projected.min = glm::vec3(std::numeric_limits<float>::max());
+            projected.max = glm::vec3(std::numeric_limits<float>::lowest());
+            for (uint32_t corner = 0; corner < projected.corners.size(); ++corner)
+            {
+                const glm::vec4 clip = viewProjection * glm::vec4(
+                    (corner & 1u) != 0 ? boxMax.x : boxMin.x,
+                    (corner & 2u) != 0 ? boxMax.y : boxMin.y,
+                    (corner & 4u) != 0 ? boxMax.z : boxMin.z,
+                    1.0f);
+                if (clip.w <= MinClipW)
+                {
+                    return false;
+                }
+
+                const float inverseW = 1.0f / clip.w;
+                const glm::vec3 screen(
+                    ((clip.x * inverseW * 0.5f) + 0.5f) * static_cast<float>(OcclusionCuller::Width),
+                    ((clip.y * inverseW * 0.5f) + 0.5f) * static_cast<float>(OcclusionCuller::Height),
+                    clip.z * inverseW);
+                projected.corners[corner] = screen;
+                projected.min = glm::min(projected.min, screen);
+                projected.max = glm::max(projected.max, screen);
+            }
+
+            return true;
+        }
+
+        bool off_screen(const ProjectedBox& projected)
+        {
+            return projected.max.x < 0.0f || projected.max.y < 0.0f ||
+                projected.min.x > static_cast<float>(OcclusionCuller::Width) ||
+                projected.min.y > static_cast<float>(OcclusionCuller::Height);
+        }
+
+        // One row of a triangle: three edge functions and the depth plane, each as a * x + row. The
+        // depth already includes the largest rise across a pixel and is capped at the deepest vertex.
+        struct TriangleRow
+        {
+            std::array<float, 3> edgeA{};
+            std::array<float, 3> edgeRow{};
+            float depthA{0.0f};
+            float depthRow{0.0f};
+            float depthMax{0.0f};
+        };
+
+        // Lowers pixels [firstX, endX) of one row, four at a time, wherever the pixel centre is inside
+        // the triangle. firstX is a multiple of four and the row width is too, so every group is in bounds.
+        void rasterize_row(float* row, const uint32_t firstX, const uint32_t endX, const TriangleRow& triangle)
+        {
+#if defined(OCCLUSION_CULLING_SSE2)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+            const __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+            const __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+            const __m128 edgeRow0 = _mm_set1_ps(triangle.edgeRow[0]);
+            const __m128 edgeRow1 = _mm_set1_ps(triangle.edgeRow[1]);
+            const __m128 edgeRow2 = _mm_set1_ps(triangle.edgeRow[2]);
+            const __m128 depthA = _mm_set1_ps(triangle.depthA);
+            const __m128 depthRow = _mm_set1_ps(triangle.depthRow);
+            const __m128 depthMax = _mm_set1_ps(triangle.depthMax);
+            for (uint32_t x = firstX; x < endX; x += LaneCount)
+            {
+                const __m128 centers = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+                __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA0, centers), edgeRow0), zero);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA1, centers), edgeRow1), zero));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA2, centers), edgeRow2), zero));
+                if (_mm_movemask_ps(inside) == 0)
+                {
+                    continue;
+                }
+
+                const __m128 depth = _mm_min_ps(_mm_add_ps(_mm_mul_ps(depthA, centers), depthRow), depthMax);
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 nearer = _mm_min_ps(current, depth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+            }
+#elif defined(OCCLUSION_CULLING_NEON)
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t laneOffsets = {0.5f, 1.5f, 2.5f, 3.5f};
+            const float32x4_t edgeRow0 = vdupq_n_f32(triangle.edgeRow[0]);
+            const float32x4_t edgeRow1 = vdupq_n_f32(triangle.edgeRow[1]);
+            const float32x4_t edgeRow2 = vdupq_n_f32(triangle.edgeRow[2]);
+            const float32x4_t depthRow = vdupq_n_f32(triangle.depthRow);
+            const float32x4_t depthMax = vdupq_n_f32(triangle.depthMax);
+            for (uint32_t x = firstX; x < endX; x += LaneCount)
+            {
+                const float32x4_t centers = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), laneOffsets);
+                uint32x4_t inside = vcgeq_f32(vmlaq_n_f32(edgeRow0, centers, triangle.edgeA[0]), zero);
+                inside = vandq_u32(inside, vcgeq_f32(vmlaq_n_f32(edgeRow1, centers, triangle.edgeA[1]), zero));
+                inside = vandq_u32(inside, vcgeq_f32(vmlaq_n_f32(edgeRow2, centers, triangle.edgeA[2]), zero));
+                if (vmaxvq_u32(inside) == 0)
+                {
+                    continue;
+                }
+
+                const float32x4_t depth = vminq_f32(vmlaq_n_f32(depthRow, centers, triangle.depthA), depthMax);
+                const float32x4_t current = vld1q_f32(row + x);
+                vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(current, depth), current));
+            }
+#else
+            for (uint32_t x = firstX; x < endX; ++x)
+            {
+                const float center = static_cast<float>(x) + 0.5f;
+                bool inside = true;
+                for (size_t edge = 0; edge < triangle.edgeA.size(); ++edge)
+                {
+                    inside = inside && (triangle.edgeA[edge] * center) + triangle.edgeRow[edge] >= 0.0f;
+                }
+
+                if (inside)
+                {
+                    const float depth = std::min((triangle.depthA * center) + triangle.depthRow, triangle.depthMax);
+                    row[x] = std::min(row[x], depth);
+                }
+            }
+#endif
+        }
+
+        // True when any of the count pixels is at or beyond depth, i.e. not in front of it.
+        bool any_at_or_beyond(const float* pixels, const uint32_t count, const float depth)
+        {
+            uint32_t x = 0;
+#if defined(OCCLUSION_CULLING_SSE2)
+            const __m128 threshold = _mm_set1_ps(depth);
+            for (; x + LaneCount <= count; x += LaneCount)
+            {
+                if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(pixels + x), threshold)) != 0)
+                {
+                    return true;
+                }
+            }
+#elif defined(OCCLUSION_CULLING_NEON)
+            const float32x4_t threshold = vdupq_n_f32(depth);
+            for (; x + LaneCount <= count; x += LaneCount)
+            {
+                if (vmaxvq_u32(vcgeq_f32(vld1q_f32(pixels + x), threshold)) != 0)
+                {
+                    return true;
+                }
+            }
+#endif
+            for (; x < count; ++x)
+            {
+                if (pixels[x] >= depth)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        float cross_2d(const glm::vec3& origin, const glm::vec3& a, const glm::vec3& b)
+        {
+            return ((a.x - origin.x) * (b.y - origin.y)) - ((a.y - origin.y) * (b.x - origin.x));
+        }
+    }
+
+    void OcclusionCuller::rasterize(const glm::mat4& viewProjection, const std::span<const OccluderBox> occluders)
+    {
+        m_viewProjection = viewProjection;
+        m_occluders = 0;
+        std::ranges::fill(m_depth, ClearDepth);
+
+        ProjectedBox projected{};
+        for (const OccluderBox& occluder : occluders)
+        {
+            // An occluder that crosses the camera plane would need clipping; skipping it only loses culling.
+            if (!project_box(viewProjection, occluder.min, occluder.max, projected) || off_screen(projected))
+            {
+                continue;
+            }
+
+            // Back faces lie behind front faces inside the same outline, so keeping the nearest depth
+            // makes drawing all six faces equivalent to drawing only the visible ones.
+            for (const std::array<uint8_t, 4>& face : BoxFaces)
+            {
+                rasterize_triangle(projected.corners[face[0]], projected.corners[face[1]], projected.corners[face[2]]);
+                rasterize_triangle(projected.corners[face[0]], projected.corners[face[2]], projected.corners[face[3]]);
+            }
+            ++m_occluders;
+        }
+
+        build_tile_depths();
+    }
+
+    void OcclusionCuller::rasterize_triangle(const glm::vec3& a, glm::vec3 b, glm::vec3 c)
+    {
+        float area = cross_2d(a, b, c);
+        if (std::abs(area) < 1.0e-6f)
+        {
+            return;
+        }
+        if (area < 0.0f)
+        {
+            std::swap(b, c);
+            area = -area;
+        }
+
+        const float minX = std::min({a.x, b.x, c.x});
+        const float maxX = std::max({a.x, b.x, c.x});
+        const float minY = std::min({a.y, b.y, c.y});
+        const float maxY = std::max({a.y, b.y, c.y});
+        // Pixels whose centre lies inside the triangle's bounding box.
+        const int firstX = std::max(0, static_cast<int>(std::ceil(minX - 0.5f)));
+        const int lastX = std::min(static_cast<int>(Width) - 1, static_cast<int>(std::floor(maxX - 0.5f)));
+        const int firstY = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+        const int lastY = std::min(static_cast<int>(Height) - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+        if (firstX > lastX || firstY > lastY)
+        {
+            return;
+        }
+
+        // Edge p -> q is non-negative on the triangle's side: A * x + B * y + C.
+        const std::array<glm::vec3, 3> vertices{a, b, c};
+        std::array<float, 3> edgeB{};
+        std::array<float, 3> edgeC{};
+        TriangleRow row{};
+        for (size_t edge = 0; edge < vertices.size(); ++edge)
+        {
+            const glm::vec3& p = vertices[edge];
+            const glm::vec3& q = vertices[(edge + 1) % vertices.size()];
+            row.edgeA[edge] = p.y - q.y;
+            edgeB[edge] = q.x - p.x;
+            edgeC[edge] = -(row.edgeA[edge] * p.x) - (edgeB[edge] * p.y);
+        }
+
+        // z / w is affine in screen space, so the face's depth is a plane; pad it by the largest rise
+        // within half a pixel so every stored depth is at or beyond the surface under that pixel.
+        const float depthDx = (((b.z - a.z) * (c.y - a.y)) - ((b.y - a.y) * (c.z - a.z))) / area;
+        const float depthDy = (((b.x - a.x) * (c.z - a.z)) - ((b.z - a.z) * (c.x - a.x))) / area;
+        const float depthPad = 0.5f * (std::abs(depthDx) + std::abs(depthDy));
+        row.depthA = depthDx;
+        row.depthMax = std::max({a.z, b.z, c.z});
+
+        const auto groupStart = static_cast<uint32_t>(firstX) / LaneCount * LaneCount;
+        const auto groupEnd = static_cast<uint32_t>(lastX + 1);
+        for (int y = firstY; y <= lastY; ++y)
+        {
+            const float center = static_cast<float>(y) + 0.5f;
+            for (size_t edge = 0; edge < vertices.size(); ++edge)
+            {
+                row.edgeRow[edge] = (edgeB[edge] * center) + edgeC[edge];
+            }
+            row.depthRow = a.z - (depthDx * a.x) + (depthDy * (center - a.y)) + depthPad;
+            rasterize_row(m_depth.data() + (static_cast<size_t>(y) * Width), groupStart, groupEnd, row);
+        }
+    }
+
+    void OcclusionCuller::build_tile_depths()
+    {
+        for (uint32_t tileY = 0; tileY < TilesY; ++tileY)
+        {
+            for (uint32_t tileX = 0; tileX < TilesX; ++tileX)
+            {
+                float deepest = std::numeric_limits<float>::lowest();
+                for (uint32_t y = tileY * TileSize; y < (tileY + 1) * TileSize; ++y)
+                {
+                    const float* row = m_depth.data() + (static_cast<size_t>(y) * Width) + (tileX * TileSize);
+                    deepest = std::max(deepest, *std::max_element(row, row + TileSize));
+                }
+                m_tileMaxDepth[(tileY * TilesX) + tileX] = deepest;
+            }
+        }
+    }
+
+    bool OcclusionCuller::is_occluded(const RenderBounds& bounds) const
+    {
+        ProjectedBox projected{};
+        if (!bounds.valid || m_occluders == 0 ||
+            !project_box(m_viewProjection, bounds.min, bounds.max, projected) || off_screen(projected))
+        {
+            return false;
+        }
+
+        // Occluders only cover pixels whose centre they contain, so widen the box by a pixel to keep it
+        // from being culled through a partly covered pixel on an occluder's edge.
+        const int firstX = std::max(0, static_cast<int>(std::floor(projected.min.x)) - 1);
+        const int lastX = std::min(static_cast<int>(Width) - 1, static_cast<int>(std::floor(projected.max.x)) + 1);
+        const int firstY = std::max(0, static_cast<int>(std::floor(projected.min.y)) - 1);
+        const int lastY = std::min(static_cast<int>(Height) - 1, static_cast<int>(std::floor(projected.max.y)) + 1);
+        const float nearest = projected.min.z;
+
+        for (int tileY = firstY / static_cast<int>(TileSize); tileY <= lastY / static_cast<int>(TileSize); ++tileY)
+        {
+            for (int tileX = firstX / static_cast<int>(TileSize); tileX <= lastX / static_cast<int>(TileSize); ++tileX)
+            {
+                if (m_tileMaxDepth[(static_cast<size_t>(tileY) * TilesX) + static_cast<size_t>(tileX)] < nearest)
+                {
+                    continue;
+                }
+
+                // Some pixel of the tile is open at this depth; check whether it is one the box covers.
+                const int spanFirstX = std::max(firstX, tileX * static_cast<int>(TileSize));
+                const int spanLastX = std::min(lastX, ((tileX + 1) * static_cast<int>(TileSize)) - 1);
+                const int spanFirstY = std::max(firstY, tileY * static_cast<int>(TileSize));
+                const int spanLastY = std::min(lastY, ((tileY + 1) * static_cast<int>(TileSize)) - 1);
+                for (int y = spanFirstY; y <= spanLastY; ++y)
+                {
+                    const float* row = m_depth.data() + (static_cast<size_t>(y) * Width) + static_cast<size_t>(spanFirstX);
+                    if (any_at_or_beyond(row, static_cast<uint32_t>(spanLastX - spanFirstX + 1), nearest))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    OcclusionStats OcclusionCuller::cull(const std::span<const RenderObject> objects, std::vector<uint32_t>& visibleIndices) const
+    {
+        OcclusionStats stats{ .occluders = m_occluders };
+        if (m_occluders == 0)
+        {
+            return stats;
+        }
+
+        std::erase_if(visibleIndices, [&](const uint32_t index)
+        {
+            const RenderBounds& bounds = objects[index].bounds;
+            if (!bounds.valid)
+            {
+                return false;
+            }
+
+            ++stats.tested;
+            const bool occluded = is_occluded(bounds);
+            stats.occluded += occluded ? 1u : 0u;
+            return occluded;
+        });
+
+        return stats;
+    }
+}
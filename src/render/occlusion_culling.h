@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "render_primitives.h"
+
+namespace render
+{
+    // A box known to be opaque all the way through, such as the rows of a chunk that are solid in
+    // every column. Anything entirely behind it from the camera's point of view is hidden.
+    struct OccluderBox
+    {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+    };
+
+    struct OcclusionStats
+    {
+        uint32_t occluders{0};
+        uint32_t tested{0};
+        uint32_t occluded{0};
+    };
+
+    // Software depth buffer for coarse occlusion culling on the CPU. Occluder boxes are rasterized
+    // four pixels at a time into a small buffer that only ever stores depths at or beyond the true
+    // surface, and a per-tile maximum lets most box tests finish without touching pixels.
+    class OcclusionCuller
+    {
+    public:
+        static constexpr uint32_t Width = 256;
+        static constexpr uint32_t Height = 128;
+        static constexpr uint32_t TileSize = 8;
+        static constexpr uint32_t TilesX = Width / TileSize;
+        static constexpr uint32_t TilesY = Height / TileSize;
+
+        // Clears the buffer and draws every occluder in front of the camera. Depth is clip z / w, so
+        // the same buffer works for either clip depth convention.
+        void rasterize(const glm::mat4& viewProjection, std::span<const OccluderBox> occluders);
+
+        // True when the box is hidden behind the rasterized occluders. Boxes that cross the camera
+        // plane, and invalid bounds, are never occluded.
+        [[nodiscard]] bool is_occluded(const RenderBounds& bounds) const;
+
+        // Drops occluded objects from visibleIndices, keeping the order of the rest.
+        OcclusionStats cull(std::span<const RenderObject> objects, std::vector<uint32_t>& visibleIndices) const;
+
+        [[nodiscard]] bool empty() const noexcept { return m_occluders == 0; }
+        [[nodiscard]] float depth_at(uint32_t x, uint32_t y) const noexcept { return m_depth[(y * Width) + x]; }
+
+    private:
+        glm::mat4 m_viewProjection{1.0f};
+        uint32_t m_occluders{0};
+        std::vector<float> m_depth = std::vector<float>(static_cast<size_t>(Width) * Height);
+        std::vector<float> m_tileMaxDepth = std::vector<float>(static_cast<size_t>(TilesX) * TilesY);
+
+        void rasterize_triangle(const glm::vec3& a, glm::vec3 b, glm::vec3 c);
+        void build_tile_depths();
+    };
+}
@@ -0,0 +1,9 @@
+#include "pending_uploads.h"
+
+size_t render::prune_released_uploads(std::vector<PendingUpload>& uploads)
+{
+    return std::erase_if(uploads, [](const PendingUpload& pending)
+    {
+        return pending.mesh.use_count() == 1;
+    });
+}
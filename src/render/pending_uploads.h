@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct Mesh;
+
+namespace render
+{
+    // A mesh drained from MeshManager::UploadQueue that has not fit a staging batch yet.
+    struct PendingUpload
+    {
+        std::shared_ptr<Mesh> mesh{};
+        uint64_t queuedFrame{0};
+    };
+
+    // Drops uploads whose mesh every other owner has let go of while it waited; copying them would
+    // only take staging space for a range that is freed again. Returns how many were dropped.
+    size_t prune_released_uploads(std::vector<PendingUpload>& uploads);
+}
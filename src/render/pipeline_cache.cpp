@@ -0,0 +1,95 @@
+#include "pipeline_cache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <utils/mapped_file.h>
+
+namespace render
+{
+    void PipelineCache::init(const VkDevice device, const VkPhysicalDeviceProperties& properties, std::filesystem::path path)
+    {
+        m_device = device;
+        m_path = std::move(path);
+        m_stats = {};
+
+        PipelineCacheIdentity identity{
+            .vendorId = properties.vendorID,
+            .deviceId = properties.deviceID
+        };
+        std::ranges::copy(properties.pipelineCacheUUID, identity.uuid.begin());
+
+        const std::optional<MappedFile> file = MappedFile::open(m_path);
+        const std::span<const std::byte> blob = file.has_value() ? file->bytes() : std::span<const std::byte>{};
+        m_stats.loadStatus = validate_pipeline_cache_blob(blob, identity);
+
+        VkPipelineCacheCreateInfo createInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO
+        };
+        if (warm())
+        {
+            createInfo.initialDataSize = blob.size();
+            createInfo.pInitialData = blob.data();
+            m_stats.loadedBytes = blob.size();
+        }
+
+        if (vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache) != VK_SUCCESS)
+        {
+            // A blob the driver still rejects is no better than none.
+            m_stats.loadStatus = PipelineCacheBlobStatus::UnsupportedHeader;
+            m_stats.loadedBytes = 0;
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            VK_CHECK(vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache));
+        }
+    }
+
+    void PipelineCache::save()
+    {
+        if (m_cache == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        size_t size = 0;
+        VK_CHECK(vkGetPipelineCacheData(m_device, m_cache, &size, nullptr));
+        std::vector<std::byte> data(size);
+        VK_CHECK(vkGetPipelineCacheData(m_device, m_cache, &size, data.data()));
+        data.resize(size);
+
+        std::error_code error;
+        std::filesystem::create_directories(m_path.parent_path(), error);
+        std::filesystem::path tempPath = m_path;
+        tempPath += ".tmp";
+        {
+            std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+            output.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!output)
+            {
+                std::println("Failed to write pipeline cache to {}", tempPath.string());
+                return;
+            }
+        }
+
+        std::filesystem::rename(tempPath, m_path, error);
+        if (error)
+        {
+            std::println("Failed to replace pipeline cache {}: {}", m_path.string(), error.message());
+            return;
+        }
+        m_stats.savedBytes = data.size();
+    }
+
+    void PipelineCache::cleanup()
+    {
+        if (m_cache == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        save();
+        vkDestroyPipelineCache(m_device, m_cache, nullptr);
+        m_cache = VK_NULL_HANDLE;
+    }
+}
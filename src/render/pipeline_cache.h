@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+
+#include <vk_types.h>
+
+#include "pipeline_cache_blob.h"
+
+namespace render
+{
+    struct PipelineCacheStats
+    {
+        PipelineCacheBlobStatus loadStatus{PipelineCacheBlobStatus::Empty};
+        size_t loadedBytes{0};
+        size_t savedBytes{0};
+    };
+
+    // VkPipelineCache persisted between runs. The file is only handed to the driver when its header
+    // matches this device; anything else starts an empty cache that overwrites the file on save.
+    class PipelineCache
+    {
+    public:
+        void init(VkDevice device, const VkPhysicalDeviceProperties& properties, std::filesystem::path path);
+        // Writes through a temporary file so a crash mid-save never leaves a torn cache behind.
+        void save();
+        void cleanup();
+
+        [[nodiscard]] VkPipelineCache handle() const noexcept { return m_cache; }
+        [[nodiscard]] bool warm() const noexcept { return m_stats.loadStatus == PipelineCacheBlobStatus::Valid; }
+        [[nodiscard]] const PipelineCacheStats& stats() const noexcept { return m_stats; }
+
+    private:
+        VkDevice m_device{VK_NULL_HANDLE};
+        VkPipelineCache m_cache{VK_NULL_HANDLE};
+        std::filesystem::path m_path{};
+        PipelineCacheStats m_stats{};
+    };
+}
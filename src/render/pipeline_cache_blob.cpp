@@ -0,0 +1,72 @@
+#include "pipeline_cache_blob.h"
+
+#include <cstring>
+
+namespace render
+{
+    namespace
+    {
+        // VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID, pipelineCacheUUID.
+        constexpr size_t HeaderSize = 4 * sizeof(uint32_t) + 16;
+        constexpr uint32_t HeaderVersionOne = 1;
+
+        uint32_t read_u32(const std::span<const std::byte> blob, const size_t offset) noexcept
+        {
+            uint32_t value = 0;
+            std::memcpy(&value, blob.data() + offset, sizeof(value));
+            return value;
+        }
+    }
+
+    PipelineCacheBlobStatus validate_pipeline_cache_blob(
+        const std::span<const std::byte> blob,
+        const PipelineCacheIdentity& identity) noexcept
+    {
+        if (blob.empty())
+        {
+            return PipelineCacheBlobStatus::Empty;
+        }
+        if (blob.size() < HeaderSize)
+        {
+            return PipelineCacheBlobStatus::Truncated;
+        }
+
+        const uint32_t headerSize = read_u32(blob, 0);
+        if (headerSize < HeaderSize || read_u32(blob, 4) != HeaderVersionOne)
+        {
+            return PipelineCacheBlobStatus::UnsupportedHeader;
+        }
+        if (headerSize > blob.size())
+        {
+            return PipelineCacheBlobStatus::Truncated;
+        }
+
+        if (read_u32(blob, 8) != identity.vendorId ||
+            read_u32(blob, 12) != identity.deviceId ||
+            std::memcmp(blob.data() + 16, identity.uuid.data(), identity.uuid.size()) != 0)
+        {
+            return PipelineCacheBlobStatus::DeviceMismatch;
+        }
+
+        return PipelineCacheBlobStatus::Valid;
+    }
+
+    const char* pipeline_cache_blob_status_name(const PipelineCacheBlobStatus status) noexcept
+    {
+        switch (status)
+        {
+        case PipelineCacheBlobStatus::Valid:
+            return "valid";
+        case PipelineCacheBlobStatus::Empty:
+            return "empty";
+        case PipelineCacheBlobStatus::Truncated:
+            return "truncated";
+        case PipelineCacheBlobStatus::UnsupportedHeader:
+            return "unsupported header";
+        case PipelineCacheBlobStatus::DeviceMismatch:
+            return "device mismatch";
+        }
+
+        return "unknown";
+    }
+}
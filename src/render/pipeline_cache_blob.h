@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace render
+{
+    // The fields of VkPhysicalDeviceProperties a driver stamps into every pipeline cache it writes.
+    struct PipelineCacheIdentity
+    {
+        uint32_t vendorId{0};
+        uint32_t deviceId{0};
+        std::array<uint8_t, 16> uuid{};
+    };
+
+    enum class PipelineCacheBlobStatus : uint8_t
+    {
+        Valid,
+        Empty,
+        Truncated,
+        UnsupportedHeader,
+        DeviceMismatch
+    };
+
+    // Checks the VkPipelineCacheHeaderVersionOne prefix so a cache written by another GPU or driver
+    // build is dropped before it reaches vkCreatePipelineCache, which some drivers do not validate.
+    [[nodiscard]] PipelineCacheBlobStatus validate_pipeline_cache_blob(
+        std::span<const std::byte> blob,
+        const PipelineCacheIdentity& identity) noexcept;
+
+    [[nodiscard]] const char* pipeline_cache_blob_status_name(PipelineCacheBlobStatus status) noexcept;
+}
@@ -0,0 +1,22 @@
+#include "quad_index_buffer.h"
+
+namespace render
+{
+    std::vector<uint16_t> build_shared_quad_indices()
+    {
+        constexpr uint16_t quadPattern[IndicesPerQuad] = { 0, 1, 2, 2, 3, 0 };
+
+        std::vector<uint16_t> indices{};
+        indices.reserve(SharedQuadIndexCount);
+        for (uint32_t quad = 0; quad < MaxQuadsPerIndexBatch; ++quad)
+        {
+            const uint32_t baseVertex = quad * VerticesPerQuad;
+            for (const uint16_t corner : quadPattern)
+            {
+                indices.push_back(static_cast<uint16_t>(baseVertex + corner));
+            }
+        }
+
+        return indices;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace render
+{
+    inline constexpr uint32_t VerticesPerQuad = 4;
+    inline constexpr uint32_t IndicesPerQuad = 6;
+    // A 16-bit index can address 65536 vertices, so one batch of the shared buffer covers 16384 quads.
+    inline constexpr uint32_t MaxQuadsPerIndexBatch = (UINT16_MAX + 1) / VerticesPerQuad;
+    inline constexpr uint32_t SharedQuadIndexCount = MaxQuadsPerIndexBatch * IndicesPerQuad;
+    inline constexpr size_t SharedQuadIndexBufferSize = SharedQuadIndexCount * sizeof(uint16_t);
+
+    struct QuadDrawBatch
+    {
+        uint32_t indexCount{0};
+        int32_t vertexOffset{0};
+    };
+
+    [[nodiscard]] constexpr uint32_t quad_count_for_vertices(const size_t vertexCount) noexcept
+    {
+        return static_cast<uint32_t>(vertexCount / VerticesPerQuad);
+    }
+
+    [[nodiscard]] constexpr uint32_t quad_index_count_for_vertices(const size_t vertexCount) noexcept
+    {
+        return quad_count_for_vertices(vertexCount) * IndicesPerQuad;
+    }
+
+    [[nodiscard]] constexpr uint32_t quad_draw_batch_count(const uint32_t quadCount) noexcept
+    {
+        return (quadCount + MaxQuadsPerIndexBatch - 1) / MaxQuadsPerIndexBatch;
+    }
+
+    [[nodiscard]] constexpr QuadDrawBatch quad_draw_batch(const uint32_t quadCount, const uint32_t batchIndex) noexcept
+    {
+        const uint32_t firstQuad = batchIndex * MaxQuadsPerIndexBatch;
+        const uint32_t remainingQuads = quadCount > firstQuad ? quadCount - firstQuad : 0;
+        const uint32_t batchQuads = remainingQuads < MaxQuadsPerIndexBatch ? remainingQuads : MaxQuadsPerIndexBatch;
+        return QuadDrawBatch{
+            .indexCount = batchQuads * IndicesPerQuad,
+            .vertexOffset = static_cast<int32_t>(firstQuad * VerticesPerQuad)
+        };
+    }
+
+    [[nodiscard]] std::vector<uint16_t> build_shared_quad_indices();
+}
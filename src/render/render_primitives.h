@@ -32,6 +32,14 @@ struct ObjectPushConstants {
     glm::vec4 sampledDynamicLightAndMode{0.0f};
 };
 
+// World-space box used for visibility tests; objects without bounds are never culled.
+struct RenderBounds
+{
+    bool valid{false};
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+};
+
 struct RenderObject {
     std::shared_ptr<Mesh> mesh;
     std::shared_ptr<Material> material;
@@ -39,11 +47,26 @@ struct RenderObject {
     RenderLayer layer{RenderLayer::Opaque};
     LightingMode lightingMode{LightingMode::BakedChunk};
     SampledLightPayload sampledLight{};
+    RenderBounds bounds{};
+    // Pipeline that reads per-draw data from a storage buffer; set when the object can join an indirect batch.
+    std::shared_ptr<Material> indirectMaterial{};
+    // Set by scene-side visibility (cave culling) to skip the object for the frame; counted as culled.
+    bool hidden{false};
     //dev_collections::sparse_set<RenderObject>::Handle handle;
 };
 
+[[nodiscard]] inline ObjectPushConstants make_object_push_constants(const RenderObject& object)
+{
+    return ObjectPushConstants{
+        .modelMatrix = object.transform,
+        .sampledLocalLightAndSunlight = glm::vec4(object.sampledLight.localLight, object.sampledLight.sunlight),
+        .sampledDynamicLightAndMode = glm::vec4(object.sampledLight.dynamicLight, static_cast<float>(object.lightingMode))
+    };
+}
+
+// A push-constant range of a material; the block itself is always ObjectPushConstants,
+// precomputed per object by the render queue.
 struct PushConstant {
     VkShaderStageFlags stageFlags;
     uint32_t size;
-    std::function<ObjectPushConstants(const RenderObject&)> build_constant;
 };
@@ -0,0 +1,86 @@
+#include "render_queue.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "material.h"
+#include "mesh.h"
+
+namespace render
+{
+    namespace
+    {
+        template <typename Handle>
+        uint64_t handle_bits(const Handle handle)
+        {
+            if constexpr (std::is_pointer_v<Handle>)
+            {
+                return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+            }
+            else
+            {
+                return static_cast<uint64_t>(handle);
+            }
+        }
+
+        uint32_t intern(std::vector<uint64_t>& table, const uint64_t handle)
+        {
+            const auto it = std::ranges::find(table, handle);
+            if (it != table.end())
+            {
+                return static_cast<uint32_t>(std::distance(table.begin(), it));
+            }
+
+            table.push_back(handle);
+            return static_cast<uint32_t>(table.size() - 1);
+        }
+    }
+
+    void RenderQueue::build(
+        const std::span<const RenderObject> objects,
+        const std::span<const uint32_t> visibleIndices,
+        const RenderQueueOrder order)
+    {
+        m_items.clear();
+        m_pushConstants.clear();
+        m_pipelines.clear();
+        m_descriptorSets.clear();
+        m_meshBuffers.clear();
+        m_items.reserve(visibleIndices.size());
+
+        for (const uint32_t objectIndex : visibleIndices)
+        {
+            const RenderObject& object = objects[objectIndex];
+            if (object.mesh == nullptr || object.material == nullptr ||
+                !object.mesh->_isActive.load(std::memory_order::acquire))
+            {
+                continue;
+            }
+
+            const Material& material = *object.material;
+            // Every frame slot's sets belong to the same material, so slot 0 is enough to tell materials apart.
+            const std::vector<VkDescriptorSet>& descriptorSets = material.descriptorSets.front();
+            const VkDescriptorSet descriptorSet = descriptorSets.empty() ? VK_NULL_HANDLE : descriptorSets.front();
+            const VkBuffer meshBuffer = object.mesh->_allocation.vertexBuffer;
+
+            m_items.push_back(RenderQueueItem{
+                .sortKey = make_render_sort_key(
+                    intern(m_pipelines, handle_bits(material.pipeline)),
+                    intern(m_descriptorSets, handle_bits(descriptorSet)),
+                    intern(m_meshBuffers, handle_bits(meshBuffer))),
+                .objectIndex = objectIndex
+            });
+        }
+
+        if (order == RenderQueueOrder::StateSorted)
+        {
+            std::ranges::stable_sort(m_items, {}, &RenderQueueItem::sortKey);
+        }
+
+        m_pushConstants.reserve(m_items.size());
+        for (const RenderQueueItem& item : m_items)
+        {
+            m_pushConstants.push_back(make_object_push_constants(objects[item.objectIndex]));
+        }
+    }
+}
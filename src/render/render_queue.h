@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render_primitives.h"
+
+namespace render
+{
+    enum class RenderQueueOrder : uint8_t
+    {
+        // Keep the caller's order (blended passes rely on it).
+        Submission,
+        // Sort by pipeline, then descriptor set, then mesh buffer so consecutive draws share state.
+        StateSorted
+    };
+
+    inline constexpr uint32_t SortKeyPipelineBits = 22;
+    inline constexpr uint32_t SortKeyDescriptorSetBits = 22;
+    inline constexpr uint32_t SortKeyMeshBufferBits = 20;
+
+    [[nodiscard]] constexpr uint64_t make_render_sort_key(const uint32_t pipelineId, const uint32_t descriptorSetId, const uint32_t meshBufferId) noexcept
+    {
+        constexpr uint64_t pipelineMask = (uint64_t{1} << SortKeyPipelineBits) - 1;
+        constexpr uint64_t descriptorSetMask = (uint64_t{1} << SortKeyDescriptorSetBits) - 1;
+        constexpr uint64_t meshBufferMask = (uint64_t{1} << SortKeyMeshBufferBits) - 1;
+        return ((pipelineId & pipelineMask) << (SortKeyDescriptorSetBits + SortKeyMeshBufferBits)) |
+            ((descriptorSetId & descriptorSetMask) << SortKeyMeshBufferBits) |
+            (meshBufferId & meshBufferMask);
+    }
+
+    struct RenderQueueItem
+    {
+        uint64_t sortKey{0};
+        uint32_t objectIndex{0};
+    };
+
+    struct DrawCounters
+    {
+        uint32_t pipelineBinds{0};
+        uint32_t descriptorSetBinds{0};
+        uint32_t vertexBufferBinds{0};
+        uint32_t indexBufferBinds{0};
+        uint32_t pushConstantUpdates{0};
+        uint32_t drawCalls{0};
+        uint32_t indirectDrawCalls{0};
+    };
+
+    // Per-frame list of drawable objects with their push-constant blocks precomputed in a flat array
+    // parallel to items(), so recording never calls back into scene code.
+    class RenderQueue
+    {
+    public:
+        void build(std::span<const RenderObject> objects, std::span<const uint32_t> visibleIndices, RenderQueueOrder order);
+
+        [[nodiscard]] const std::vector<RenderQueueItem>& items() const noexcept { return m_items; }
+        [[nodiscard]] const std::vector<ObjectPushConstants>& push_constants() const noexcept { return m_pushConstants; }
+
+    private:
+        std::vector<RenderQueueItem> m_items{};
+        std::vector<ObjectPushConstants> m_pushConstants{};
+        // Handles seen this frame; an id is the handle's position, so keys stay small and dense.
+        std::vector<uint64_t> m_pipelines{};
+        std::vector<uint64_t> m_descriptorSets{};
+        std::vector<uint64_t> m_meshBuffers{};
+    };
+}
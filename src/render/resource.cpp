@@ -4,6 +4,17 @@
 
 #include "resource.h"
 
+#include <cstring>
+
+#include "constants.h"
+#include "vk_util.h"
+
+namespace
+{
+    // The largest minUniformBufferOffsetAlignment the spec allows, so the stride is valid on every device.
+    constexpr VkDeviceSize UniformOffsetAlignment = 256;
+}
+
 Resource::Resource(const ResourceBackendContext backend, const Type type, ResourceValue&& value): type(type), backend(backend)
 {
     switch (type) {
@@ -16,7 +27,7 @@ Resource::Resource(const ResourceBackendContext backend, const Type type, Resour
     }
 }
 
-Resource::Resource(Resource&& other) noexcept: type(other.type), backend(other.backend), value(other.value)
+Resource::Resource(Resource&& other) noexcept: type(other.type), backend(other.backend), value(other.value), frameStride(other.frameStride)
 {
     switch (type) {
     case BUFFER:
@@ -56,3 +67,24 @@ Resource::~Resource()
         break;
     }
 }
+
+std::shared_ptr<Resource> Resource::create_frame_uniform(const ResourceBackendContext backend, const VkDeviceSize size)
+{
+    const VkDeviceSize stride = (size + UniformOffsetAlignment - 1) / UniformOffsetAlignment * UniformOffsetAlignment;
+    const AllocatedBuffer buffer = vkutil::create_buffer(
+        backend.allocator,
+        stride * FRAME_OVERLAP,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+        VMA_MEMORY_USAGE_CPU_TO_GPU);
+    auto resource = std::make_shared<Resource>(backend, BUFFER, ResourceValue(buffer));
+    resource->frameStride = stride;
+    return resource;
+}
+
+void Resource::write_frame_uniform(const uint32_t frameSlot, const void* data, const size_t size) const
+{
+    void* mapped = nullptr;
+    vmaMapMemory(backend.allocator, value.buffer._allocation, &mapped);
+    std::memcpy(static_cast<std::byte*>(mapped) + frameStride * (frameSlot % FRAME_OVERLAP), data, size);
+    vmaUnmapMemory(backend.allocator, value.buffer._allocation);
+}
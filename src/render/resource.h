@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+
 #include "vk_types.h"
 
 struct ResourceBackendContext
@@ -24,12 +26,19 @@ struct Resource {
         explicit ResourceValue(const ImageResource& image) : image(image) {}
     } value;
 
+    // Non-zero for per-frame uniform buffers: the buffer holds FRAME_OVERLAP blocks this far apart and
+    // materials bind the block of the frame slot being recorded, so the CPU never writes a block in use.
+    VkDeviceSize frameStride{0};
+
     Resource(ResourceBackendContext backend, Type type, ResourceValue&& value);
     // Move Constructor
     Resource(Resource&& other) noexcept;
 
     ~Resource();
 
+    [[nodiscard]] static std::shared_ptr<Resource> create_frame_uniform(ResourceBackendContext backend, VkDeviceSize size);
+    void write_frame_uniform(uint32_t frameSlot, const void* data, size_t size) const;
+
     //Delete copy constructor and copy assignment
     Resource(const Resource&) = delete;
     Resource& operator=(const Resource&) = delete;
@@ -1,10 +1,48 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include "collections/spare_set.h"
+#include "frustum_culling.h"
+#include "indirect_draw_builder.h"
+#include "instanced_draw_builder.h"
+#include "occlusion_culling.h"
 #include "render_primitives.h"
+#include "render_queue.h"
+#include "transparent_sort.h"
+
+namespace render
+{
+    class IndirectDrawBuffers;
+    class InstanceDataBuffer;
+}
 
 struct SceneRenderState
 {
     dev_collections::sparse_set<RenderObject> opaqueObjects{};
     dev_collections::sparse_set<RenderObject> transparentObjects{};
+    // Scenes that set this get bounded objects outside the frustum skipped before recording.
+    std::optional<glm::mat4> cullViewProjection{};
+    render::CullStats lastCullStats{};
+    // Solid boxes rasterized into a CPU depth buffer each frame; frustum survivors hidden behind them
+    // are dropped too. Only used together with cullViewProjection.
+    dev_collections::sparse_set<render::OccluderBox> occluders{};
+    render::OcclusionStats lastOcclusionStats{};
+    // Scenes that set this get visible transparent objects drawn back to front. With
+    // transparentIndirectDraws also set, far objects with an indirect material are merged into
+    // indirect draws ahead of the rest of the far band.
+    std::optional<render::TransparentSortView> transparentSort{};
+    std::shared_ptr<render::IndirectDrawBuffers> transparentIndirectDraws{};
+    render::TransparentSortStats lastTransparentSortStats{};
+    // When present (and the device supports multi-draw indirect), opaque objects with an indirect
+    // material are drawn from these buffers instead of one draw call each.
+    std::shared_ptr<render::IndirectDrawBuffers> indirectDraws{};
+    render::IndirectDrawStats lastIndirectDrawStats{};
+    render::DrawCounters lastDrawCounters{};
+    // Opaque meshes repeated many times (chunk decorations). With instanceData set, visible groups are
+    // drawn as one instanced draw per mesh; without it they are not drawn.
+    dev_collections::sparse_set<render::InstanceGroup> instanceGroups{};
+    std::shared_ptr<render::InstanceDataBuffer> instanceData{};
+    render::InstancedDrawStats lastInstancedDrawStats{};
 };
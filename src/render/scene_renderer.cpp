@@ -1,6 +1,9 @@
 #include "scene_renderer.h"
 #include "material.h"
 #include "material_manager.h"
+#include "indirect_draw_buffers.h"
+#include "instance_data_buffer.h"
+#include "quad_index_buffer.h"
 #include <tracy/Tracy.hpp>
 #include <vk_initializers.h>
 #include <scenes/game_scene.h>
@@ -17,10 +20,17 @@ void SceneRenderer::init(const SceneServices& sceneServices)
     _scenes["voxel_assembly"] = std::make_shared<VoxelAssemblyScene>(sceneServices);
     _currentSceneName = "voxel_editor";
 	_currentScene = _scenes["voxel_editor"];
+
+    // Scenes build their pipelines on construction.
+    for (const auto& name : _scenes | std::views::keys)
+    {
+        m_scenePipelineGenerations[name] = m_pipelineGeneration;
+    }
 }
 
 void SceneRenderer::cleanup()
 {
+    wait_for_pipeline_prebuild();
 	_scenes.clear();
 	_currentScene = nullptr;
 }
@@ -33,15 +43,75 @@ void SceneRenderer::set_current_scene(const std::string& name)
         {
             return;
         }
+        wait_for_pipeline_prebuild();
         _currentScene = it->second;
         _currentSceneName = name;
-        _currentScene->rebuild_pipelines();
+        _currentScene->resize_viewport();
+        if (m_scenePipelineGenerations[name] != m_pipelineGeneration)
+        {
+            rebuild_pipelines(name, *_currentScene);
+        }
+    }
+}
+
+void SceneRenderer::handle_swapchain_resized()
+{
+    ZoneScopedN("Scene Pipelines Resize");
+    wait_for_pipeline_prebuild();
+    ++m_pipelineGeneration;
+    _currentScene->resize_viewport();
+    rebuild_pipelines(_currentSceneName, *_currentScene);
+
+    // Inactive scenes are not drawn and the device was idled for the resize, so replacing their
+    // materials off-thread cannot race a command buffer.
+    std::vector<std::shared_ptr<Scene>> staleScenes;
+    for (const auto& [name, scene] : _scenes)
+    {
+        if (scene != _currentScene)
+        {
+            staleScenes.push_back(scene);
+            m_prebuildingScenes.push_back(name);
+        }
+    }
+
+    m_pipelinePrebuild = std::async(std::launch::async, [staleScenes = std::move(staleScenes)]
+    {
+        ZoneScopedN("Scene Pipelines Prebuild");
+        for (const std::shared_ptr<Scene>& scene : staleScenes)
+        {
+            scene->build_pipelines();
+        }
+    });
+}
+
+void SceneRenderer::rebuild_pipelines(const std::string& name, Scene& scene)
+{
+    ZoneScopedN("Scene Pipelines Rebuild");
+    scene.build_pipelines();
+    m_scenePipelineGenerations[name] = m_pipelineGeneration;
+}
+
+void SceneRenderer::wait_for_pipeline_prebuild()
+{
+    if (!m_pipelinePrebuild.valid())
+    {
+        return;
+    }
+
+    const std::vector<std::string> prebuiltScenes = std::exchange(m_prebuildingScenes, {});
+    // get() rethrows a failed build here rather than losing it on the worker.
+    m_pipelinePrebuild.get();
+    for (const std::string& name : prebuiltScenes)
+    {
+        m_scenePipelineGenerations[name] = m_pipelineGeneration;
     }
 }
 
 void SceneRenderer::render_scene(VkCommandBuffer cmd, const FrameRenderContext& frameContext)
 {
 	ZoneScopedN("Render Scene");
+    m_quadIndexBuffer = frameContext.quadIndexBuffer;
+    m_frameSlot = frameContext.frameSlot;
     _currentScene->update_buffers();
     SceneRenderState& renderState = _currentScene->get_render_state();
 
@@ -50,6 +120,20 @@ void SceneRenderer::render_scene(VkCommandBuffer cmd, const FrameRenderContext&
 		_currentScene->draw_imgui();
 	}
 
+    {
+        ZoneScopedN("Render Scene Frustum Cull");
+        const render::CullStats opaqueStats = build_visible_list(renderState, renderState.opaqueObjects.data(), m_visibleOpaque);
+        const render::CullStats transparentStats = build_visible_list(renderState, renderState.transparentObjects.data(), m_visibleTransparent);
+        renderState.lastCullStats = render::CullStats{
+            .visible = opaqueStats.visible + transparentStats.visible,
+            .culled = opaqueStats.culled + transparentStats.culled
+        };
+        TracyPlot("Render Objects Visible", static_cast<int64_t>(renderState.lastCullStats.visible));
+        TracyPlot("Render Objects Culled", static_cast<int64_t>(renderState.lastCullStats.culled));
+    }
+    occlusion_cull(renderState);
+    sort_transparent(renderState);
+
     VkRenderPassBeginInfo rpOffscreenInfo = vkinit::render_pass_begin_info(
         frameContext.offscreenPass,
         frameContext.windowExtent,
@@ -57,8 +141,11 @@ void SceneRenderer::render_scene(VkCommandBuffer cmd, const FrameRenderContext&
         frameContext.offscreenClearValues,
         frameContext.offscreenClearValueCount);
 
+    m_drawCounters = {};
     vkCmdBeginRenderPass(cmd, &rpOffscreenInfo, VK_SUBPASS_CONTENTS_INLINE);
-    draw_objects(cmd, renderState.opaqueObjects.data());
+    reset_bound_state();
+    draw_opaque_objects(cmd, frameContext, renderState);
+    draw_instanced(cmd, frameContext, renderState);
 
     vkCmdEndRenderPass(cmd);
 
@@ -73,10 +160,16 @@ void SceneRenderer::render_scene(VkCommandBuffer cmd, const FrameRenderContext&
 
 	vkCmdBeginRenderPass(cmd, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-    draw_fullscreen(cmd, frameContext.materialManager->get_material(_currentSceneName, "present"));
+    draw_fullscreen(cmd, frameContext.materialManager->get_material(_currentSceneName, "present"), frameContext.frameSlot);
 
     //Draw transparent
-    draw_objects(cmd, renderState.transparentObjects.data());
+    reset_bound_state();
+    draw_transparent_objects(cmd, frameContext, renderState);
+
+    renderState.lastDrawCounters = m_drawCounters;
+    TracyPlot("Render Pipeline Binds", static_cast<int64_t>(m_drawCounters.pipelineBinds));
+    TracyPlot("Render Descriptor Set Binds", static_cast<int64_t>(m_drawCounters.descriptorSetBinds));
+    TracyPlot("Render Draw Calls", static_cast<int64_t>(m_drawCounters.drawCalls + m_drawCounters.indirectDrawCalls));
 
 	if (USE_IMGUI)
 	{
@@ -141,9 +234,9 @@ void SceneRenderer::run_compute(VkCommandBuffer cmd, const FrameRenderContext& f
         cmd,
         VK_PIPELINE_BIND_POINT_COMPUTE,
         computeMaterial->pipelineLayout,
-        0, computeMaterial->descriptorSets.size(),
+        0, computeMaterial->descriptorSets[frameContext.frameSlot].size(),
 
-        computeMaterial->descriptorSets.data(),
+        computeMaterial->descriptorSets[frameContext.frameSlot].data(),
         0, nullptr
     );
 
@@ -173,116 +266,332 @@ void SceneRenderer::run_compute(VkCommandBuffer cmd, const FrameRenderContext& f
 	}
 }
 
-void SceneRenderer::draw_fullscreen(const VkCommandBuffer cmd, const std::shared_ptr<Material>& presentMaterial)
+void SceneRenderer::draw_fullscreen(const VkCommandBuffer cmd, const std::shared_ptr<Material>& presentMaterial, const uint32_t frameSlot)
 {
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, presentMaterial->pipeline);
 	vkCmdBindDescriptorSets(
 		cmd,
 		VK_PIPELINE_BIND_POINT_GRAPHICS,
 		presentMaterial->pipelineLayout,
-		0, presentMaterial->descriptorSets.size(),
-		presentMaterial->descriptorSets.data(),
+		0, presentMaterial->descriptorSets[frameSlot].size(),
+		presentMaterial->descriptorSets[frameSlot].data(),
 		0, nullptr
 	);
 
 	vkCmdDraw(cmd, 3, 1, 0, 0);
 }
 
-void SceneRenderer::draw_object(const VkCommandBuffer cmd, const RenderObject& object)
+void SceneRenderer::reset_bound_state()
+{
+	m_boundState = {};
+}
+
+void SceneRenderer::bind_material(const VkCommandBuffer cmd, const Material& material)
 {
-	if(object.mesh == nullptr) return;
-	if(!object.mesh->_isActive.load(std::memory_order::acquire))
+	if (material.pipeline != m_boundState.pipeline)
 	{
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, material.pipeline);
+		m_boundState.pipeline = material.pipeline;
+		++m_drawCounters.pipelineBinds;
+	}
+
+	// Every material owns its layout and sets, so the first set identifies the whole group.
+	const std::vector<VkDescriptorSet>& descriptorSets = material.descriptorSets[m_frameSlot];
+	const VkDescriptorSet firstSet = descriptorSets.empty() ? VK_NULL_HANDLE : descriptorSets.front();
+	if (material.pipelineLayout != m_boundState.pipelineLayout || firstSet != m_boundState.firstDescriptorSet)
+	{
+		if (!descriptorSets.empty())
+		{
+			vkCmdBindDescriptorSets(cmd,
+				VK_PIPELINE_BIND_POINT_GRAPHICS,
+				material.pipelineLayout,
+				0,
+				descriptorSets.size(),
+				descriptorSets.data(),
+				0,
+				nullptr);
+			++m_drawCounters.descriptorSetBinds;
+		}
+		m_boundState.pipelineLayout = material.pipelineLayout;
+		m_boundState.firstDescriptorSet = firstSet;
+	}
+}
+
+void SceneRenderer::bind_vertex_buffer(const VkCommandBuffer cmd, const VkBuffer buffer, const VkDeviceSize offset)
+{
+	if (buffer == m_boundState.vertexBuffer && offset == m_boundState.vertexBufferOffset)
+	{
+		return;
+	}
+
+	vkCmdBindVertexBuffers(cmd, 0, 1, &buffer, &offset);
+	m_boundState.vertexBuffer = buffer;
+	m_boundState.vertexBufferOffset = offset;
+	++m_drawCounters.vertexBufferBinds;
+}
+
+void SceneRenderer::bind_index_buffer(const VkCommandBuffer cmd, const VkBuffer buffer, const VkIndexType indexType)
+{
+	if (buffer == m_boundState.indexBuffer && indexType == m_boundState.indexType)
+	{
+		return;
+	}
+
+	vkCmdBindIndexBuffer(cmd, buffer, 0, indexType);
+	m_boundState.indexBuffer = buffer;
+	m_boundState.indexType = indexType;
+	++m_drawCounters.indexBufferBinds;
+}
+
+void SceneRenderer::draw_object(const VkCommandBuffer cmd, const RenderObject& object, const ObjectPushConstants& pushConstants)
+{
+	const Material& material = *object.material;
+	bind_material(cmd, material);
+
+	for (const PushConstant& range : material.pushConstants)
+	{
+		vkCmdPushConstants(cmd, material.pipelineLayout, range.stageFlags, 0, range.size, &pushConstants);
+		++m_drawCounters.pushConstantUpdates;
+	}
+
+	draw_mesh(cmd, *object.mesh, 1, 0);
+}
+
+void SceneRenderer::draw_mesh(const VkCommandBuffer cmd, const Mesh& mesh, const uint32_t instanceCount, const uint32_t firstInstance)
+{
+	// Whole-vertex offsets keep the shared buffer bound at 0 and move the mesh base into vertexOffset,
+	// so consecutive meshes from one allocator page need a single vertex-buffer bind.
+	const MeshAllocation& allocation = mesh._allocation;
+	const bool vertexAligned = allocation.vertexOffset % sizeof(Vertex) == 0;
+	const int32_t baseVertex = vertexAligned ? static_cast<int32_t>(allocation.vertexOffset / sizeof(Vertex)) : 0;
+	bind_vertex_buffer(cmd, allocation.vertexBuffer, vertexAligned ? 0 : allocation.vertexOffset);
+
+	if (mesh.uses_shared_quad_indices())
+	{
+		// The shared 16-bit pattern only spans 65536 vertices, so larger meshes draw in batches offset by vertexOffset.
+		bind_index_buffer(cmd, m_quadIndexBuffer, VK_INDEX_TYPE_UINT16);
+		const uint32_t quadCount = allocation.indicesSize / render::IndicesPerQuad;
+		const uint32_t batchCount = render::quad_draw_batch_count(quadCount);
+		for (uint32_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+		{
+			const render::QuadDrawBatch batch = render::quad_draw_batch(quadCount, batchIndex);
+			vkCmdDrawIndexed(cmd, batch.indexCount, instanceCount, 0, baseVertex + batch.vertexOffset, firstInstance);
+			++m_drawCounters.drawCalls;
+		}
 		return;
+	}
+
+	bind_index_buffer(cmd, allocation.indexBuffer, VK_INDEX_TYPE_UINT32);
+	const auto firstIndex = static_cast<uint32_t>(allocation.indexOffset / sizeof(uint32_t));
+	vkCmdDrawIndexed(cmd, allocation.indicesSize, instanceCount, firstIndex, baseVertex, firstInstance);
+	++m_drawCounters.drawCalls;
+}
+
+render::CullStats SceneRenderer::build_visible_list(
+	const SceneRenderState& renderState,
+	const std::vector<RenderObject>& objects,
+	std::vector<uint32_t>& visibleIndices)
+{
+	if (!renderState.cullViewProjection.has_value())
+	{
+		visibleIndices.clear();
+		for (uint32_t index = 0; index < objects.size(); ++index)
+		{
+			if (!objects[index].hidden)
+			{
+				visibleIndices.push_back(index);
+			}
+		}
+		const auto visible = static_cast<uint32_t>(visibleIndices.size());
+		return render::CullStats{ .visible = visible, .culled = static_cast<uint32_t>(objects.size()) - visible };
+	}
+
+	return m_frustumCuller.cull(render::extract_frustum(renderState.cullViewProjection.value()), objects, visibleIndices);
+}
+
+void SceneRenderer::occlusion_cull(SceneRenderState& renderState)
+{
+	renderState.lastOcclusionStats = {};
+	if (!renderState.cullViewProjection.has_value() || renderState.occluders.data().empty())
+	{
+		return;
+	}
+
+	ZoneScopedN("Render Scene Occlusion Cull");
+	m_occlusionCuller.rasterize(renderState.cullViewProjection.value(), renderState.occluders.data());
+	const render::OcclusionStats opaqueStats = m_occlusionCuller.cull(renderState.opaqueObjects.data(), m_visibleOpaque);
+	const render::OcclusionStats transparentStats = m_occlusionCuller.cull(renderState.transparentObjects.data(), m_visibleTransparent);
+	renderState.lastOcclusionStats = render::OcclusionStats{
+		.occluders = opaqueStats.occluders,
+		.tested = opaqueStats.tested + transparentStats.tested,
+		.occluded = opaqueStats.occluded + transparentStats.occluded
 	};
+	TracyPlot("Render Occluders", static_cast<int64_t>(renderState.lastOcclusionStats.occluders));
+	TracyPlot("Render Objects Occluded", static_cast<int64_t>(renderState.lastOcclusionStats.occluded));
+}
 
-	//only bind the pipeline if it doesn't match with the already bound one
-	// if (object.material->key != m_lastMaterialKey) {
-	// 	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, object.material->pipeline);
-	// 	m_lastMaterialKey = object.material->key;
-	//
-	// 	vkCmdBindDescriptorSets(cmd,
-	// 	VK_PIPELINE_BIND_POINT_GRAPHICS,
-	// 	object.material->pipelineLayout,
-	// 	0,
-	// 	object.material->descriptorSets.size(),
-	// 	object.material->descriptorSets.data(),
-	// 	0,
-	// 	nullptr);
-	// }
-
-	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, object.material->pipeline);
-	m_lastMaterialKey = object.material->key;
-
-	vkCmdBindDescriptorSets(cmd,
-	VK_PIPELINE_BIND_POINT_GRAPHICS,
-	object.material->pipelineLayout,
-	0,
-	object.material->descriptorSets.size(),
-	object.material->descriptorSets.data(),
-	0,
-	nullptr);
-
-
-    for(const auto& pConstant : object.material->pushConstants)
-    {
-    	ObjectPushConstants data = pConstant.build_constant(object);
-        vkCmdPushConstants(cmd, object.material->pipelineLayout, pConstant.stageFlags, 0, pConstant.size, &data);
-    }
+void SceneRenderer::sort_transparent(SceneRenderState& renderState)
+{
+	m_farTransparentCount = 0;
+	if (!renderState.transparentSort.has_value())
+	{
+		m_transparentSorter.invalidate();
+		renderState.lastTransparentSortStats = {};
+		return;
+	}
 
-	//We only need to rebind these when the allocator changes.
-	// if (m_last_allocator == nullptr || m_last_allocator != object.mesh->_vertexAllocation.allocator)
-	// {
-	// 	vkCmdBindVertexBuffers(
-	// 		cmd,
-	// 		0,
-	// 		1,
-	// 		&object.mesh->_vertexAllocation.allocator->m_vertexBuffer._buffer,
-	// 		(VkDeviceSize[]){0}
-	// 	);
-	// 	vkCmdBindIndexBuffer(
-	// 		cmd,
-	// 		object.mesh->_vertexAllocation.allocator->m_indexBuffer._buffer,
-	// 		0,
-	// 		VK_INDEX_TYPE_UINT32
-	// 	);
-	//
-	// 	m_last_allocator = object.mesh->_vertexAllocation.allocator;
-	// }
-	//
-	// uint32_t firstIndex   = (uint32_t)(object.mesh->_indexAllocation.slot.index_offset  / sizeof(uint32_t));
-	// int32_t  baseVertex   = (int32_t) (object.mesh->_vertexAllocation.slot.vertex_offset / sizeof(Vertex));
-	//
-	// // Sanity: offsets must be aligned
-	// assert(object.mesh->_indexAllocation.slot.index_offset  % sizeof(uint32_t) == 0);
-	// assert(object.mesh->_vertexAllocation.slot.vertex_offset % sizeof(Vertex)   == 0);
-	//
-	// //we can now draw
-	// //question: how does draw Indexed work? How does it know index count of my vertices, is this computed based on the indices?
-	// vkCmdDrawIndexed(
-	// 	cmd,
-	// 	static_cast<uint32_t>(object.mesh->_indices.size()),
-	// 	1,
-	// 	firstIndex,
-	// 	baseVertex,
-	// 	0
-	// );
-
-	VkDeviceSize vbOff = object.mesh->_allocation.vertexOffset;
-	VkDeviceSize ibOff = object.mesh->_allocation.indexOffset;
-    const VkBuffer vertexBuffer = object.mesh->_allocation.allocator->vertex_buffer_handle();
-    const VkBuffer indexBuffer = object.mesh->_allocation.allocator->index_buffer_handle();
-
-	vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer, &vbOff);
-	vkCmdBindIndexBuffer(cmd, indexBuffer, ibOff, VK_INDEX_TYPE_UINT32);
-
-	vkCmdDrawIndexed(cmd, object.mesh->_allocation.indicesSize, 1, 0, 0, 0);
+	ZoneScopedN("Render Scene Transparent Sort");
+	m_farTransparentCount = m_transparentSorter.sort(
+		renderState.transparentObjects.data(),
+		renderState.transparentSort.value(),
+		m_visibleTransparent);
+	renderState.lastTransparentSortStats = render::TransparentSortStats{
+		.sorted = static_cast<uint32_t>(m_visibleTransparent.size()),
+		.farObjects = m_farTransparentCount,
+		.resorted = m_transparentSorter.last_sort_resorted()
+	};
+	TracyPlot("Transparent Resorts", static_cast<int64_t>(renderState.lastTransparentSortStats.resorted ? 1 : 0));
+}
+
+void SceneRenderer::draw_objects(
+	VkCommandBuffer cmd,
+	const std::vector<RenderObject>& objects,
+	const std::span<const uint32_t> visibleIndices,
+	const render::RenderQueueOrder order)
+{
+	{
+		ZoneScopedN("Build Render Queue");
+		m_renderQueue.build(objects, visibleIndices, order);
+	}
+
+	const std::vector<render::RenderQueueItem>& items = m_renderQueue.items();
+	const std::vector<ObjectPushConstants>& pushConstants = m_renderQueue.push_constants();
+	for (size_t index = 0; index < items.size(); ++index)
+	{
+		draw_object(cmd, objects[items[index].objectIndex], pushConstants[index]);
+	}
 }
 
-void SceneRenderer::draw_objects(VkCommandBuffer cmd, const std::vector<RenderObject>& objects)
+void SceneRenderer::draw_opaque_objects(const VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState)
 {
-	for(const auto & object : objects)
+	const std::vector<RenderObject>& objects = renderState.opaqueObjects.data();
+	if (!frameContext.multiDrawIndirect || renderState.indirectDraws == nullptr)
 	{
-		draw_object(cmd, object);
+		renderState.lastIndirectDrawStats = render::IndirectDrawStats{ .fallbackObjects = static_cast<uint32_t>(m_visibleOpaque.size()) };
+		draw_objects(cmd, objects, m_visibleOpaque, render::RenderQueueOrder::StateSorted);
+		return;
+	}
+
+	{
+		ZoneScopedN("Build Indirect Draws");
+		m_indirectDrawBuilder.build(
+			objects,
+			m_visibleOpaque,
+			renderState.indirectDraws->limits_for_slot(frameContext.frameSlot),
+			m_indirectDrawList);
+		renderState.indirectDraws->write(frameContext.frameSlot, m_indirectDrawList);
+	}
+
+	draw_indirect(cmd, m_indirectDrawList, *renderState.indirectDraws, frameContext.frameSlot);
+	draw_objects(cmd, objects, m_indirectDrawList.fallbackIndices, render::RenderQueueOrder::StateSorted);
+
+	renderState.lastIndirectDrawStats = m_indirectDrawList.stats();
+	TracyPlot("Indirect Draw Commands", static_cast<int64_t>(renderState.lastIndirectDrawStats.commands));
+	TracyPlot("Indirect Draw Calls", static_cast<int64_t>(renderState.lastIndirectDrawStats.indirectCalls));
+	TracyPlot("Indirect Fallback Objects", static_cast<int64_t>(renderState.lastIndirectDrawStats.fallbackObjects));
+}
+
+void SceneRenderer::draw_transparent_objects(const VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState)
+{
+	const std::vector<RenderObject>& objects = renderState.transparentObjects.data();
+	const std::span<const uint32_t> visible(m_visibleTransparent);
+	if (!frameContext.multiDrawIndirect || renderState.transparentIndirectDraws == nullptr || m_farTransparentCount == 0)
+	{
+		draw_objects(cmd, objects, visible, render::RenderQueueOrder::Submission);
+		return;
+	}
+
+	// Far objects are all behind the near ones, so merging them keeps the near band correctly ordered.
+	// Inside the far band the merged draws go first (still back to front among themselves) and the
+	// remaining far objects follow in sorted order; at that distance fog hides the difference.
+	const std::span<const uint32_t> far = visible.first(m_farTransparentCount);
+	{
+		ZoneScopedN("Build Transparent Indirect Draws");
+		m_indirectDrawBuilder.build(
+			objects,
+			far,
+			renderState.transparentIndirectDraws->limits_for_slot(frameContext.frameSlot),
+			m_transparentIndirectDrawList);
+		renderState.transparentIndirectDraws->write(frameContext.frameSlot, m_transparentIndirectDrawList);
+	}
+
+	draw_indirect(cmd, m_transparentIndirectDrawList, *renderState.transparentIndirectDraws, frameContext.frameSlot);
+	draw_objects(cmd, objects, m_transparentIndirectDrawList.fallbackIndices, render::RenderQueueOrder::Submission);
+	draw_objects(cmd, objects, visible.subspan(m_farTransparentCount), render::RenderQueueOrder::Submission);
+
+	const render::IndirectDrawStats mergedStats = m_transparentIndirectDrawList.stats();
+	renderState.lastTransparentSortStats.mergedObjects = mergedStats.batchedObjects;
+	renderState.lastTransparentSortStats.mergedCalls = mergedStats.indirectCalls;
+	TracyPlot("Transparent Merged Objects", static_cast<int64_t>(mergedStats.batchedObjects));
+}
+
+void SceneRenderer::draw_instanced(const VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState)
+{
+	if (renderState.instanceData == nullptr)
+	{
+		renderState.lastInstancedDrawStats = {};
+		return;
+	}
+
+	{
+		ZoneScopedN("Build Instanced Draws");
+		const std::optional<render::Frustum> frustum = renderState.cullViewProjection.has_value()
+			? std::optional(render::extract_frustum(renderState.cullViewProjection.value()))
+			: std::nullopt;
+		m_instancedDrawBuilder.build(
+			renderState.instanceGroups.data(),
+			frustum,
+			renderState.instanceData->capacity(),
+			renderState.instanceData->first_instance_for_slot(frameContext.frameSlot),
+			m_instancedDrawList);
+		renderState.instanceData->write(frameContext.frameSlot, m_instancedDrawList);
+	}
+
+	for (const render::InstancedDrawBatch& batch : m_instancedDrawList.batches)
+	{
+		bind_material(cmd, *batch.material);
+		draw_mesh(cmd, *batch.mesh, batch.instanceCount, batch.firstInstance);
+	}
+
+	renderState.lastInstancedDrawStats = m_instancedDrawList.stats;
+	TracyPlot("Instanced Draw Batches", static_cast<int64_t>(renderState.lastInstancedDrawStats.batches));
+	TracyPlot("Instanced Draw Instances", static_cast<int64_t>(renderState.lastInstancedDrawStats.instances));
+}
+
+void SceneRenderer::draw_indirect(
+	const VkCommandBuffer cmd,
+	const render::IndirectDrawList& list,
+	const render::IndirectDrawBuffers& buffers,
+	const uint32_t frameSlot)
+{
+	if (list.runs.empty())
+	{
+		return;
+	}
+
+	// Every batched mesh shares the allocator's vertex buffer and the quad index buffer, so both bind once.
+	bind_vertex_buffer(cmd, list.vertexBuffer, 0);
+	bind_index_buffer(cmd, m_quadIndexBuffer, VK_INDEX_TYPE_UINT16);
+
+	for (const render::IndirectDrawRun& run : list.runs)
+	{
+		bind_material(cmd, *run.material);
+		vkCmdDrawIndexedIndirect(
+			cmd,
+			buffers.command_buffer(),
+			buffers.command_offset(frameSlot, run.firstCommand),
+			run.commandCount,
+			sizeof(VkDrawIndexedIndirectCommand));
+		++m_drawCounters.indirectDrawCalls;
 	}
 }
@@ -5,6 +5,12 @@
 #include <render/scene_render_state.h>
 #include <vk_types.h>
 #include <render/render_primitives.h>
+#include <render/frustum_culling.h>
+#include <render/occlusion_culling.h>
+#include <render/indirect_draw_builder.h>
+#include <render/instanced_draw_builder.h>
+#include <render/render_queue.h>
+#include <render/transparent_sort.h>
 
 class SceneRenderer {
 public:
@@ -12,20 +18,73 @@ public:
     void init(const SceneServices& sceneServices);
     void cleanup();
     void set_current_scene(const std::string& name);
+    // Rebuilds the current scene's pipelines now and the other scenes' on a worker, so a later
+    // switch finds them ready instead of compiling on the spot.
+    void handle_swapchain_resized();
 
     void render_scene(VkCommandBuffer cmd, const FrameRenderContext& frameContext);
 
     std::shared_ptr<Scene> get_current_scene() const;
 private:
+    void rebuild_pipelines(const std::string& name, Scene& scene);
+    void wait_for_pipeline_prebuild();
+
     static void run_compute(VkCommandBuffer cmd, const FrameRenderContext& frameContext, const std::shared_ptr<Material>& computeMaterial);
-    static void draw_fullscreen(VkCommandBuffer cmd, const std::shared_ptr<Material>& presentMaterial);
+    static void draw_fullscreen(VkCommandBuffer cmd, const std::shared_ptr<Material>& presentMaterial, uint32_t frameSlot);
+
+    render::CullStats build_visible_list(const SceneRenderState& renderState, const std::vector<RenderObject>& objects, std::vector<uint32_t>& visibleIndices);
+    void occlusion_cull(SceneRenderState& renderState);
+    void sort_transparent(SceneRenderState& renderState);
+    void draw_objects(VkCommandBuffer cmd, const std::vector<RenderObject>& objects, std::span<const uint32_t> visibleIndices, render::RenderQueueOrder order);
+    void draw_opaque_objects(VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState);
+    void draw_transparent_objects(VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState);
+    void draw_indirect(VkCommandBuffer cmd, const render::IndirectDrawList& list, const render::IndirectDrawBuffers& buffers, uint32_t frameSlot);
+    void draw_instanced(VkCommandBuffer cmd, const FrameRenderContext& frameContext, SceneRenderState& renderState);
+    void draw_object(VkCommandBuffer cmd, const RenderObject& object, const ObjectPushConstants& pushConstants);
+    void draw_mesh(VkCommandBuffer cmd, const Mesh& mesh, uint32_t instanceCount, uint32_t firstInstance);
 
-    void draw_objects(VkCommandBuffer cmd, const std::vector<RenderObject>& chunks);
-    void draw_object(VkCommandBuffer cmd, const RenderObject& object);
+    // Binds are skipped when the requested state is already bound in the current render pass.
+    void reset_bound_state();
+    void bind_material(VkCommandBuffer cmd, const Material& material);
+    void bind_vertex_buffer(VkCommandBuffer cmd, VkBuffer buffer, VkDeviceSize offset);
+    void bind_index_buffer(VkCommandBuffer cmd, VkBuffer buffer, VkIndexType indexType);
     
 	std::unordered_map<std::string, std::shared_ptr<Scene>> _scenes;
     std::shared_ptr<Scene> _currentScene = nullptr;
     std::string _currentSceneName{};
 
-    std::string m_lastMaterialKey;
+    // Bumped on every swapchain resize; a scene whose pipelines predate it must rebuild before drawing.
+    uint32_t m_pipelineGeneration{0};
+    std::unordered_map<std::string, uint32_t> m_scenePipelineGenerations{};
+    std::future<void> m_pipelinePrebuild{};
+    std::vector<std::string> m_prebuildingScenes{};
+
+    struct BoundState
+    {
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+        VkDescriptorSet firstDescriptorSet{VK_NULL_HANDLE};
+        VkBuffer vertexBuffer{VK_NULL_HANDLE};
+        VkDeviceSize vertexBufferOffset{0};
+        VkBuffer indexBuffer{VK_NULL_HANDLE};
+        VkIndexType indexType{VK_INDEX_TYPE_UINT32};
+    };
+
+    BoundState m_boundState{};
+    render::DrawCounters m_drawCounters{};
+    render::RenderQueue m_renderQueue{};
+    VkBuffer m_quadIndexBuffer{VK_NULL_HANDLE};
+    uint32_t m_frameSlot{0};
+    render::FrustumCuller m_frustumCuller{};
+    render::OcclusionCuller m_occlusionCuller{};
+    std::vector<uint32_t> m_visibleOpaque{};
+    std::vector<uint32_t> m_visibleTransparent{};
+    render::TransparentSorter m_transparentSorter{};
+    // Leading entries of m_visibleTransparent in the far band after sorting.
+    uint32_t m_farTransparentCount{0};
+    render::IndirectDrawBuilder m_indirectDrawBuilder{};
+    render::IndirectDrawList m_indirectDrawList{};
+    render::IndirectDrawList m_transparentIndirectDrawList{};
+    render::InstancedDrawBuilder m_instancedDrawBuilder{};
+    render::InstancedDrawList m_instancedDrawList{};
 };
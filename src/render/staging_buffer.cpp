@@ -4,7 +4,6 @@
 #include <tracy/Tracy.hpp>
 
 StagingBuffer::StagingBuffer(VmaAllocator vmaAllocator, StagingBufferConfig config) :
-    m_write_head(nullptr),
     m_capacity(static_cast<VkDeviceSize>(config.stagingBufferSize)),
     m_allocator(vmaAllocator),
     m_config(std::move(config))
@@ -22,51 +21,66 @@ StagingBuffer::~StagingBuffer()
 void StagingBuffer::begin_recording()
 {
     ZoneScopedN("StagingBuffer::BeginRecording");
-    vmaMapMemory(m_allocator, m_stagingBuffer._allocation, &m_write_head);
+    if (m_recording) { throw std::runtime_error("StagingBuffer::begin_recording: Already recording"); }
+    m_batchBytes = 0;
     m_recording = true;
 }
 
-void StagingBuffer::upload_mesh(std::shared_ptr<Mesh>&& mesh)
+StagingUploadResult StagingBuffer::upload_mesh(const std::shared_ptr<Mesh>& mesh)
 {
     ZoneScopedN("StagingBuffer::UploadMesh");
     if (!m_recording) { throw std::runtime_error("StagingBuffer::upload_mesh: Not recording"); }
+    const bool sharedQuadIndices = mesh->uses_shared_quad_indices();
+    const uint32_t indexCount = mesh->index_count();
     auto v_size = mesh->_vertices.size() * sizeof(Vertex);
-    auto i_size = mesh->_indices.size() * sizeof(uint32_t);
+    // Quad meshes draw from the shared quad index buffer and own no index range.
+    auto i_size = sharedQuadIndices ? size_t{0} : mesh->_indices.size() * sizeof(uint32_t);
 
-    if (v_size == 0 || i_size == 0)
+    if (v_size == 0 || indexCount == 0)
     {
-        return;
+        return StagingUploadResult::Empty;
     }
 
-    const VkDeviceSize needed = m_write_offset + (v_size + i_size);
-
+    const VkDeviceSize needed = v_size + i_size;
     if (needed > m_capacity)
     {
-        throw std::runtime_error("StagingBuffer::upload_mesh: Buffer exhausted");
+        throw std::runtime_error("StagingBuffer::upload_mesh: Mesh is larger than the staging ring");
     }
 
-    auto vertex_offset = m_write_offset;
-    std::memcpy(m_write_head, mesh->_vertices.data(), v_size);
-    m_write_offset += v_size;
-    m_write_head = static_cast<char*>(m_write_head) + v_size;
-    auto index_offset = m_write_offset;
-    std::memcpy(m_write_head, mesh->_indices.data(), i_size);
-    m_write_offset += i_size;
-    m_write_head = static_cast<char*>(m_write_head) + i_size;
+    if (m_batchBytes > 0 && m_batchBytes + needed > m_config.frameUploadBudget)
+    {
+        return StagingUploadResult::Deferred;
+    }
+
+    const std::optional<uint64_t> offset = m_ring.allocate(needed);
+    if (!offset.has_value())
+    {
+        return StagingUploadResult::Deferred;
+    }
+
+    auto* writeHead = static_cast<char*>(m_mapped) + offset.value();
+    auto vertex_offset = static_cast<VkDeviceSize>(offset.value());
+    std::memcpy(writeHead, mesh->_vertices.data(), v_size);
+    auto index_offset = vertex_offset + v_size;
+    if (i_size > 0)
+    {
+        std::memcpy(writeHead + v_size, mesh->_indices.data(), i_size);
+    }
+    m_batchBytes += needed;
 
     auto allocation = m_meshAllocator->acquire(v_size, i_size);
-    TracyPlot("StagingBuffer WriteOffset", static_cast<int64_t>(m_write_offset));
+    TracyPlot("StagingBuffer BatchBytes", static_cast<int64_t>(m_batchBytes));
     TracyPlot("StagingBuffer UploadHandles", static_cast<int64_t>(m_uploadHandles.size() + 1));
 
     m_v_total_count += 1;
     m_v_total_size += v_size;
-    m_i_total_count += 1;
-    m_i_total_size += i_size;
-
-    // std::println("average v size: {}", m_v_total_size / m_v_total_count);
-    // std::println("average i size: {}", m_i_total_size / m_i_total_count);
+    if (i_size > 0)
+    {
+        m_i_total_count += 1;
+        m_i_total_size += i_size;
+    }
 
-    allocation.indicesSize = static_cast<uint32_t>(mesh->_indices.size());
+    allocation.indicesSize = indexCount;
     mesh->_allocation = allocation;
 
     //Clear out mesh memory
@@ -79,52 +93,64 @@ void StagingBuffer::upload_mesh(std::shared_ptr<Mesh>&& mesh)
         v_size,
         index_offset,
         i_size);
-
+    return StagingUploadResult::Uploaded;
 }
 
-std::function<void(VkCommandBuffer cmd)> StagingBuffer::build_submission() const
+void StagingBuffer::record_copies(const VkCommandBuffer cmd) const
 {
-    return [this](VkCommandBuffer cmd)
+    ZoneScopedN("StagingBuffer::RecordCopies");
+    for (const auto& handle : m_uploadHandles)
     {
-        ZoneScopedN("StagingBuffer::BuildSubmission");
-        for (const auto& handle : m_uploadHandles)
+        if (handle.vertexSize > 0)
         {
-            //USE Mesh Allocator
-            if (handle.vertexSize > 0)
-            {
-                VkBufferCopy vertex_copy;
-                vertex_copy.dstOffset = handle.mesh->_allocation.vertexOffset;
-                vertex_copy.srcOffset = handle.vertexOffset;
-                vertex_copy.size = handle.vertexSize;
-                const VkBuffer vertexBuffer = m_meshAllocator->vertex_buffer_handle();
-                vkCmdCopyBuffer(cmd, this->m_stagingBuffer._buffer, vertexBuffer, 1, &vertex_copy);
-            }
-
-            if (handle.indexSize > 0)
-            {
-                VkBufferCopy index_copy;
-                index_copy.dstOffset = handle.mesh->_allocation.indexOffset;
-                index_copy.srcOffset = handle.indexOffset;
-                index_copy.size = handle.indexSize;
-                const VkBuffer indexBuffer = m_meshAllocator->index_buffer_handle();
-                vkCmdCopyBuffer(cmd, this->m_stagingBuffer._buffer, indexBuffer, 1, &index_copy);
-            }
-
-            handle.mesh->_isActive.store(true, std::memory_order::relaxed);
+            VkBufferCopy vertex_copy;
+            vertex_copy.dstOffset = handle.mesh->_allocation.vertexOffset;
+            vertex_copy.srcOffset = handle.vertexOffset;
+            vertex_copy.size = handle.vertexSize;
+            vkCmdCopyBuffer(cmd, m_stagingBuffer._buffer, handle.mesh->_allocation.vertexBuffer, 1, &vertex_copy);
         }
-    };
+
+        if (handle.indexSize > 0)
+        {
+            VkBufferCopy index_copy;
+            index_copy.dstOffset = handle.mesh->_allocation.indexOffset;
+            index_copy.srcOffset = handle.indexOffset;
+            index_copy.size = handle.indexSize;
+            vkCmdCopyBuffer(cmd, m_stagingBuffer._buffer, handle.mesh->_allocation.indexBuffer, 1, &index_copy);
+        }
+    }
 }
 
-void StagingBuffer::end_recording()
+StagingBatch StagingBuffer::end_recording()
 {
     ZoneScopedN("StagingBuffer::EndRecording");
     m_recording = false;
-    vmaUnmapMemory(m_allocator, m_stagingBuffer._allocation);
-    m_uploadHandles.clear();
-    m_write_head = nullptr;
-    m_write_offset = 0;
-    TracyPlot("StagingBuffer WriteOffset", static_cast<int64_t>(m_write_offset));
+    StagingBatch batch{
+        .uploads = std::move(m_uploadHandles),
+        .region = m_ring.close_batch()
+    };
+    m_uploadHandles = {};
+    m_uploadHandles.reserve(32);
+    m_batchBytes = 0;
+    TracyPlot("StagingBuffer BytesInFlight", static_cast<int64_t>(m_ring.used()));
     TracyPlot("StagingBuffer UploadHandles", static_cast<int64_t>(m_uploadHandles.size()));
+    return batch;
+}
+
+void StagingBuffer::release(const render::StagingRegion& region)
+{
+    m_ring.release(region);
+}
+
+VkDeviceSize StagingBuffer::bytes_in_flight() const noexcept
+{
+    return m_ring.used();
+}
+
+VkDeviceSize StagingBuffer::upload_size(const Mesh& mesh) noexcept
+{
+    const VkDeviceSize indexBytes = mesh.uses_shared_quad_indices() ? 0 : mesh._indices.size() * sizeof(uint32_t);
+    return mesh._vertices.size() * sizeof(Vertex) + indexBytes;
 }
 
 void StagingBuffer::reconfigure(StagingBufferConfig config)
@@ -144,7 +170,19 @@ void StagingBuffer::reconfigure(StagingBufferConfig config)
 
 bool StagingBuffer::can_reconfigure() const noexcept
 {
-    return !m_recording && m_uploadHandles.empty() && m_meshAllocator != nullptr && m_meshAllocator->can_reconfigure();
+    return !m_recording && m_uploadHandles.empty() && m_ring.used() == 0 && m_meshAllocator != nullptr && m_meshAllocator->can_reconfigure();
+}
+
+bool StagingBuffer::resize_mesh_allocator(const size_t slotCapacity)
+{
+    ZoneScopedN("StagingBuffer::ResizeMeshAllocator");
+    if (m_meshAllocator == nullptr || !m_meshAllocator->resize(slotCapacity))
+    {
+        return false;
+    }
+
+    m_config.meshAllocatorConfig = m_meshAllocator->config();
+    return true;
 }
 
 const StagingBufferConfig& StagingBuffer::config() const noexcept
@@ -167,6 +205,8 @@ void StagingBuffer::destroy_buffer()
     ZoneScopedN("StagingBuffer::DestroyBuffer");
     if (m_stagingBuffer._buffer != VK_NULL_HANDLE)
     {
+        vmaUnmapMemory(m_allocator, m_stagingBuffer._allocation);
+        m_mapped = nullptr;
         vmaDestroyBuffer(m_allocator, m_stagingBuffer._buffer, m_stagingBuffer._allocation);
         m_stagingBuffer = {};
     }
@@ -180,5 +220,8 @@ void StagingBuffer::create_buffer()
         m_capacity,
         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
         VMA_MEMORY_USAGE_CPU_ONLY);
+    // Kept mapped for its whole lifetime; batches write straight into their ring ranges.
+    vmaMapMemory(m_allocator, m_stagingBuffer._allocation, &m_mapped);
+    m_ring.reset(m_capacity);
     std::println("Staging Buffer created with size: {} bytes", m_capacity);
 }
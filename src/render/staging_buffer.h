@@ -7,25 +7,16 @@
 #include "constants.h"
 #include "mesh.h"
 #include "mesh_allocator.h"
+#include "staging_ring.h"
 
-constexpr size_t approximate_vertex_buffer_size(const int viewDistance)
-{
-    return static_cast<size_t>(viewDistance) * TOTAL_BLOCKS_IN_CHUNK * 8 * sizeof(Vertex);
-}
-
-constexpr size_t approximate_index_buffer_size(const int viewDistance)
-{
-    return static_cast<size_t>(viewDistance) * TOTAL_BLOCKS_IN_CHUNK * 8 * sizeof(uint32_t);
-}
-
-constexpr size_t approximate_staging_buffer_size(const int viewDistance)
-{
-    return approximate_vertex_buffer_size(viewDistance) + approximate_index_buffer_size(viewDistance);
-}
+inline constexpr size_t DefaultFrameUploadBudget = 16ull * 1024 * 1024;
 
 struct StagingBufferConfig
 {
-    size_t stagingBufferSize{approximate_staging_buffer_size(GameConfig::DEFAULT_VIEW_DISTANCE)};
+    // Size of the staging ring; it holds the batch being written plus every batch still being copied.
+    size_t stagingBufferSize{DefaultFrameUploadBudget * 4};
+    // Bytes a single batch may stage. A mesh larger than this still goes through when it is first in its batch.
+    size_t frameUploadBudget{DefaultFrameUploadBudget};
     MeshAllocatorConfig meshAllocatorConfig{};
 };
 
@@ -40,6 +31,21 @@ struct UploadHandle
     VkDeviceSize indexSize = 0;
 };
 
+enum class StagingUploadResult : uint8_t
+{
+    Uploaded,
+    // The mesh has no geometry and was not staged.
+    Empty,
+    // The batch budget or the ring is full; retry in a later batch.
+    Deferred
+};
+
+struct StagingBatch
+{
+    std::vector<UploadHandle> uploads{};
+    render::StagingRegion region{};
+};
+
 class StagingBuffer {
 public:
     explicit StagingBuffer(VmaAllocator vmaAllocator, StagingBufferConfig config = {});
@@ -47,18 +53,25 @@ public:
     ~StagingBuffer();
 
     void begin_recording();
-    void upload_mesh(std::shared_ptr<Mesh>&& mesh);
-    [[nodiscard]] std::function<void(VkCommandBuffer cmd)> build_submission() const;
-    void end_recording();
+    [[nodiscard]] StagingUploadResult upload_mesh(const std::shared_ptr<Mesh>& mesh);
+    void record_copies(VkCommandBuffer cmd) const;
+    // Closes the batch. Its region stays reserved until release() is called after the copies complete.
+    [[nodiscard]] StagingBatch end_recording();
+    void release(const render::StagingRegion& region);
+    [[nodiscard]] VkDeviceSize bytes_in_flight() const noexcept;
+    [[nodiscard]] static VkDeviceSize upload_size(const Mesh& mesh) noexcept;
     void reconfigure(StagingBufferConfig config);
     [[nodiscard]] bool can_reconfigure() const noexcept;
+    // Applies a new mesh slot budget in place, keeping the staging ring and uploaded meshes.
+    [[nodiscard]] bool resize_mesh_allocator(size_t slotCapacity);
     [[nodiscard]] const StagingBufferConfig& config() const noexcept;
 
     IMeshAllocator& mesh_allocator();
     [[nodiscard]] const IMeshAllocator& mesh_allocator() const;
 private:
-    void* m_write_head;
-    VkDeviceSize m_write_offset = 0;
+    void* m_mapped = nullptr;
+    render::StagingRing m_ring{};
+    VkDeviceSize m_batchBytes = 0;
 
     bool m_recording = false;
     VkDeviceSize m_capacity;
@@ -0,0 +1,76 @@
+#include "staging_ring.h"
+
+namespace render
+{
+    StagingRing::StagingRing(const uint64_t capacity) noexcept :
+        m_capacity(capacity)
+    {
+    }
+
+    void StagingRing::reset(const uint64_t capacity) noexcept
+    {
+        *this = StagingRing(capacity);
+    }
+
+    std::optional<uint64_t> StagingRing::allocate(const uint64_t size) noexcept
+    {
+        if (size == 0 || size > m_capacity - m_used)
+        {
+            return std::nullopt;
+        }
+
+        if (m_used == 0)
+        {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        uint64_t offset = m_head;
+        if (m_head >= m_tail)
+        {
+            // Free space is [head, capacity) followed by [0, tail).
+            if (m_capacity - m_head < size)
+            {
+                if (m_tail < size)
+                {
+                    return std::nullopt;
+                }
+
+                const uint64_t skipped = m_capacity - m_head;
+                m_used += skipped;
+                m_batchBytes += skipped;
+                offset = 0;
+            }
+        }
+        else if (m_tail - m_head < size)
+        {
+            return std::nullopt;
+        }
+
+        m_head = offset + size;
+        m_used += size;
+        m_batchBytes += size;
+        return offset;
+    }
+
+    StagingRegion StagingRing::close_batch() noexcept
+    {
+        const StagingRegion region{
+            .end = m_head,
+            .size = m_batchBytes
+        };
+        m_batchBytes = 0;
+        return region;
+    }
+
+    void StagingRing::release(const StagingRegion& region) noexcept
+    {
+        if (region.size == 0)
+        {
+            return;
+        }
+
+        m_used -= region.size;
+        m_tail = region.end;
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace render
+{
+    // Bytes handed out between two close_batch() calls; released as a unit once the batch's copies finish.
+    struct StagingRegion
+    {
+        uint64_t end{0};
+        uint64_t size{0};
+    };
+
+    // Byte ring over a staging buffer. Allocations are contiguous; when the space left before the end of
+    // the buffer is too short the head wraps to 0 and the skipped bytes are charged to the current batch.
+    class StagingRing
+    {
+    public:
+        explicit StagingRing(uint64_t capacity = 0) noexcept;
+
+        void reset(uint64_t capacity) noexcept;
+        [[nodiscard]] std::optional<uint64_t> allocate(uint64_t size) noexcept;
+        [[nodiscard]] StagingRegion close_batch() noexcept;
+        // Batches must be released in the order they were closed.
+        void release(const StagingRegion& region) noexcept;
+
+        [[nodiscard]] uint64_t capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] uint64_t used() const noexcept { return m_used; }
+
+    private:
+        uint64_t m_capacity{0};
+        uint64_t m_head{0};
+        uint64_t m_tail{0};
+        uint64_t m_used{0};
+        uint64_t m_batchBytes{0};
+    };
+}
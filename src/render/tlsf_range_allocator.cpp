@@ -0,0 +1,304 @@
+#include "tlsf_range_allocator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace render
+{
+    namespace
+    {
+        uint64_t align_up(const uint64_t value, const uint64_t alignment) noexcept
+        {
+            // Vertex alignment is sizeof(Vertex), which is not a power of two.
+            return alignment <= 1 ? value : (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    TlsfRangeAllocator::TlsfRangeAllocator(const uint64_t capacity)
+    {
+        reset(capacity);
+    }
+
+    void TlsfRangeAllocator::reset(const uint64_t capacity)
+    {
+        m_capacity = capacity;
+        m_freeBytes = 0;
+        m_liveAllocations = 0;
+        m_freeBlockCount = 0;
+        m_blocks.clear();
+        m_unusedBlocks.clear();
+        m_firstLevelBitmap = 0;
+        m_secondLevelBitmaps.fill(0);
+        for (auto& heads : m_freeHeads)
+        {
+            heads.fill(InvalidBlock);
+        }
+
+        if (capacity > 0)
+        {
+            const uint32_t block = create_block(0, capacity);
+            m_blocks[block].free = true;
+            m_freeBytes = capacity;
+            insert_free(block);
+        }
+    }
+
+    std::optional<RangeAllocation> TlsfRangeAllocator::allocate(const uint64_t size, uint64_t alignment)
+    {
+        if (size == 0)
+        {
+            return RangeAllocation{};
+        }
+
+        alignment = std::max<uint64_t>(alignment, 1);
+        const auto fits = [&](const uint32_t block)
+        {
+            const Block& candidate = m_blocks[block];
+            return candidate.size >= align_up(candidate.offset, alignment) - candidate.offset + size;
+        };
+
+        uint32_t block = find_free_block(size);
+        if (block != InvalidBlock && !fits(block))
+        {
+            block = InvalidBlock;
+        }
+        if (block == InvalidBlock && alignment > 1)
+        {
+            // Any block from the class of size + alignment - 1 holds an aligned range of size.
+            block = find_free_block(size + alignment - 1);
+        }
+        if (block == InvalidBlock)
+        {
+            return std::nullopt;
+        }
+
+        remove_free(block);
+        const uint64_t padding = align_up(m_blocks[block].offset, alignment) - m_blocks[block].offset;
+        if (padding > 0)
+        {
+            const uint32_t aligned = split_after(block, padding);
+            insert_free(block);
+            block = aligned;
+        }
+        if (m_blocks[block].size > size)
+        {
+            insert_free(split_after(block, size));
+        }
+
+        m_blocks[block].free = false;
+        m_freeBytes -= size;
+        ++m_liveAllocations;
+        return RangeAllocation{
+            .offset = m_blocks[block].offset,
+            .size = size,
+            .block = block
+        };
+    }
+
+    void TlsfRangeAllocator::free(const RangeAllocation& allocation)
+    {
+        if (allocation.block == InvalidBlock || allocation.block >= m_blocks.size() || m_blocks[allocation.block].free)
+        {
+            return;
+        }
+
+        uint32_t block = allocation.block;
+        m_blocks[block].free = true;
+        m_freeBytes += m_blocks[block].size;
+        --m_liveAllocations;
+
+        const uint32_t previous = m_blocks[block].prevPhysical;
+        if (previous != InvalidBlock && m_blocks[previous].free)
+        {
+            remove_free(previous);
+            block = merge_with_next(previous);
+        }
+
+        const uint32_t next = m_blocks[block].nextPhysical;
+        if (next != InvalidBlock && m_blocks[next].free)
+        {
+            remove_free(next);
+            block = merge_with_next(block);
+        }
+
+        insert_free(block);
+    }
+
+    RangeAllocatorStats TlsfRangeAllocator::stats() const noexcept
+    {
+        RangeAllocatorStats stats{
+            .capacity = m_capacity,
+            .usedBytes = m_capacity - m_freeBytes,
+            .freeBytes = m_freeBytes,
+            .freeBlocks = m_freeBlockCount,
+            .liveAllocations = m_liveAllocations
+        };
+
+        // The largest block lives in the highest non-empty class; only that list needs scanning.
+        if (m_firstLevelBitmap != 0)
+        {
+            const auto firstLevel = static_cast<uint32_t>(63 - std::countl_zero(m_firstLevelBitmap));
+            const auto secondLevel = static_cast<uint32_t>(31 - std::countl_zero(m_secondLevelBitmaps[firstLevel]));
+            for (uint32_t block = m_freeHeads[firstLevel][secondLevel]; block != InvalidBlock; block = m_blocks[block].nextFree)
+            {
+                stats.largestFreeBlock = std::max(stats.largestFreeBlock, m_blocks[block].size);
+            }
+        }
+
+        return stats;
+    }
+
+    TlsfRangeAllocator::SizeClass TlsfRangeAllocator::size_class(const uint64_t size) noexcept
+    {
+        if (size < SecondLevelCount)
+        {
+            return SizeClass{ .firstLevel = 0, .secondLevel = static_cast<uint32_t>(size) };
+        }
+
+        const auto width = static_cast<uint32_t>(std::bit_width(size));
+        const uint32_t shift = width - 1 - SecondLevelBits;
+        return SizeClass{
+            .firstLevel = width - SecondLevelBits,
+            .secondLevel = static_cast<uint32_t>(size >> shift) - SecondLevelCount
+        };
+    }
+
+    uint64_t TlsfRangeAllocator::round_up_to_class(const uint64_t size) noexcept
+    {
+        if (size < SecondLevelCount)
+        {
+            return size;
+        }
+
+        const uint32_t shift = static_cast<uint32_t>(std::bit_width(size)) - 1 - SecondLevelBits;
+        return size + ((uint64_t{1} << shift) - 1);
+    }
+
+    uint32_t TlsfRangeAllocator::find_free_block(const uint64_t size) const noexcept
+    {
+        // Rounding up to the next class boundary means every block in the found list is large enough.
+        const SizeClass sizeClass = size_class(round_up_to_class(size));
+        if (sizeClass.firstLevel >= FirstLevelCount)
+        {
+            return InvalidBlock;
+        }
+
+        uint32_t firstLevel = sizeClass.firstLevel;
+        uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0u << sizeClass.secondLevel);
+        if (secondLevelMap == 0)
+        {
+            const uint64_t firstLevelMap = firstLevel + 1 < 64 ? m_firstLevelBitmap & (~uint64_t{0} << (firstLevel + 1)) : 0;
+            if (firstLevelMap == 0)
+            {
+                return InvalidBlock;
+            }
+
+            firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+            secondLevelMap = m_secondLevelBitmaps[firstLevel];
+        }
+
+        return m_freeHeads[firstLevel][static_cast<uint32_t>(std::countr_zero(secondLevelMap))];
+    }
+
+    uint32_t TlsfRangeAllocator::create_block(const uint64_t offset, const uint64_t size)
+    {
+        uint32_t block = InvalidBlock;
+        if (!m_unusedBlocks.empty())
+        {
+            block = m_unusedBlocks.back();
+            m_unusedBlocks.pop_back();
+        }
+        else
+        {
+            block = static_cast<uint32_t>(m_blocks.size());
+            m_blocks.emplace_back();
+        }
+
+        m_blocks[block] = Block{ .offset = offset, .size = size };
+        return block;
+    }
+
+    void TlsfRangeAllocator::release_block(const uint32_t block)
+    {
+        m_blocks[block] = Block{};
+        m_unusedBlocks.push_back(block);
+    }
+
+    void TlsfRangeAllocator::insert_free(const uint32_t block)
+    {
+        const SizeClass sizeClass = size_class(m_blocks[block].size);
+        uint32_t& head = m_freeHeads[sizeClass.firstLevel][sizeClass.secondLevel];
+        m_blocks[block].free = true;
+        m_blocks[block].prevFree = InvalidBlock;
+        m_blocks[block].nextFree = head;
+        if (head != InvalidBlock)
+        {
+            m_blocks[head].prevFree = block;
+        }
+        head = block;
+        m_firstLevelBitmap |= uint64_t{1} << sizeClass.firstLevel;
+        m_secondLevelBitmaps[sizeClass.firstLevel] |= 1u << sizeClass.secondLevel;
+        ++m_freeBlockCount;
+    }
+
+    void TlsfRangeAllocator::remove_free(const uint32_t block)
+    {
+        const SizeClass sizeClass = size_class(m_blocks[block].size);
+        const uint32_t previous = m_blocks[block].prevFree;
+        const uint32_t next = m_blocks[block].nextFree;
+        if (previous != InvalidBlock)
+        {
+            m_blocks[previous].nextFree = next;
+        }
+        else
+        {
+            m_freeHeads[sizeClass.firstLevel][sizeClass.secondLevel] = next;
+        }
+        if (next != InvalidBlock)
+        {
+            m_blocks[next].prevFree = previous;
+        }
+
+        if (m_freeHeads[sizeClass.firstLevel][sizeClass.secondLevel] == InvalidBlock)
+        {
+            m_secondLevelBitmaps[sizeClass.firstLevel] &= ~(1u << sizeClass.secondLevel);
+            if (m_secondLevelBitmaps[sizeClass.firstLevel] == 0)
+            {
+                m_firstLevelBitmap &= ~(uint64_t{1} << sizeClass.firstLevel);
+            }
+        }
+
+        m_blocks[block].prevFree = InvalidBlock;
+        m_blocks[block].nextFree = InvalidBlock;
+        --m_freeBlockCount;
+    }
+
+    uint32_t TlsfRangeAllocator::split_after(const uint32_t block, const uint64_t size)
+    {
+        const uint32_t remainder = create_block(m_blocks[block].offset + size, m_blocks[block].size - size);
+        const uint32_t next = m_blocks[block].nextPhysical;
+        m_blocks[remainder].prevPhysical = block;
+        m_blocks[remainder].nextPhysical = next;
+        if (next != InvalidBlock)
+        {
+            m_blocks[next].prevPhysical = remainder;
+        }
+        m_blocks[block].nextPhysical = remainder;
+        m_blocks[block].size = size;
+        return remainder;
+    }
+
+    uint32_t TlsfRangeAllocator::merge_with_next(const uint32_t block)
+    {
+        const uint32_t next = m_blocks[block].nextPhysical;
+        const uint32_t after = m_blocks[next].nextPhysical;
+        m_blocks[block].size += m_blocks[next].size;
+        m_blocks[block].nextPhysical = after;
+        if (after != InvalidBlock)
+        {
+            m_blocks[after].prevPhysical = block;
+        }
+        release_block(next);
+        return block;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace render
+{
+    struct RangeAllocation
+    {
+        uint64_t offset{0};
+        uint64_t size{0};
+        // Internal block index; zero-sized allocations carry InvalidBlock and own nothing.
+        uint32_t block{UINT32_MAX};
+    };
+
+    struct RangeAllocatorStats
+    {
+        uint64_t capacity{0};
+        uint64_t usedBytes{0};
+        uint64_t freeBytes{0};
+        uint64_t largestFreeBlock{0};
+        uint32_t freeBlocks{0};
+        uint32_t liveAllocations{0};
+
+        // 0 when all free space is one block, approaching 1 as it splinters into small holes.
+        [[nodiscard]] float fragmentation() const noexcept
+        {
+            return freeBytes == 0 ? 0.0f : 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeBytes);
+        }
+    };
+
+    // Two-level segregated-fit (TLSF) allocator over a range of offsets. Free blocks are kept in
+    // size-class lists indexed by two bitmaps, so allocate and free are O(1) and neighbours are merged
+    // through physical links rather than by scanning.
+    class TlsfRangeAllocator
+    {
+    public:
+        static constexpr uint32_t InvalidBlock = UINT32_MAX;
+
+        explicit TlsfRangeAllocator(uint64_t capacity = 0);
+
+        void reset(uint64_t capacity);
+        [[nodiscard]] std::optional<RangeAllocation> allocate(uint64_t size, uint64_t alignment = 1);
+        void free(const RangeAllocation& allocation);
+
+        [[nodiscard]] RangeAllocatorStats stats() const noexcept;
+        [[nodiscard]] uint64_t capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] bool empty() const noexcept { return m_liveAllocations == 0; }
+
+    private:
+        static constexpr uint32_t SecondLevelBits = 4;
+        static constexpr uint32_t SecondLevelCount = 1u << SecondLevelBits;
+        static constexpr uint32_t FirstLevelCount = 64 - SecondLevelBits + 1;
+
+        struct Block
+        {
+            uint64_t offset{0};
+            uint64_t size{0};
+            uint32_t prevPhysical{InvalidBlock};
+            uint32_t nextPhysical{InvalidBlock};
+            uint32_t prevFree{InvalidBlock};
+            uint32_t nextFree{InvalidBlock};
+            bool free{false};
+        };
+
+        struct SizeClass
+        {
+            uint32_t firstLevel{0};
+            uint32_t secondLevel{0};
+        };
+
+        uint64_t m_capacity{0};
+        uint64_t m_freeBytes{0};
+        uint32_t m_liveAllocations{0};
+        uint32_t m_freeBlockCount{0};
+        std::vector<Block> m_blocks{};
+        std::vector<uint32_t> m_unusedBlocks{};
+        uint64_t m_firstLevelBitmap{0};
+        std::array<uint32_t, FirstLevelCount> m_secondLevelBitmaps{};
+        std::array<std::array<uint32_t, SecondLevelCount>, FirstLevelCount> m_freeHeads{};
+
+        [[nodiscard]] static SizeClass size_class(uint64_t size) noexcept;
+        [[nodiscard]] static uint64_t round_up_to_class(uint64_t size) noexcept;
+        [[nodiscard]] uint32_t find_free_block(uint64_t size) const noexcept;
+        [[nodiscard]] uint32_t create_block(uint64_t offset, uint64_t size);
+        void release_block(uint32_t block);
+        void insert_free(uint32_t block);
+        void remove_free(uint32_t block);
+        [[nodiscard]] uint32_t split_after(uint32_t block, uint64_t size);
+        [[nodiscard]] uint32_t merge_with_next(uint32_t block);
+    };
+}
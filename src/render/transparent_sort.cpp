@@ -0,0 +1,169 @@
+#include "transparent_sort.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace render
+{
+    namespace
+    {
+        constexpr uint32_t RadixBits = 8;
+        constexpr uint32_t RadixBuckets = 1u << RadixBits;
+        constexpr uint32_t RadixPasses = 32 / RadixBits;
+        // Squared cell distances are clamped here so the key keeps a spare low bit.
+        constexpr uint64_t MaxDistanceSquared = (uint64_t{1} << 30) - 1;
+
+        glm::vec3 object_position(const RenderObject& object) noexcept
+        {
+            if (object.bounds.valid)
+            {
+                return (object.bounds.min + object.bounds.max) * 0.5f;
+            }
+            return glm::vec3(object.transform[3]);
+        }
+
+        uint64_t cell_distance_squared(const glm::ivec2 lhs, const glm::ivec2 rhs) noexcept
+        {
+            const int64_t dx = static_cast<int64_t>(lhs.x) - rhs.x;
+            const int64_t dz = static_cast<int64_t>(lhs.y) - rhs.y;
+            return std::min(static_cast<uint64_t>((dx * dx) + (dz * dz)), MaxDistanceSquared);
+        }
+
+        // Ascending keys run far to near; the low bit puts batchable objects first within a cell.
+        uint32_t sort_key(const uint64_t distanceSquared, const bool batchable) noexcept
+        {
+            return (static_cast<uint32_t>(MaxDistanceSquared - distanceSquared) << 1) | (batchable ? 0u : 1u);
+        }
+
+        // Stable LSD radix sort of order by keys; passes where every key shares the digit are skipped.
+        void radix_sort(std::vector<uint32_t>& order, std::vector<uint32_t>& keys, std::vector<uint32_t>& scratchOrder, std::vector<uint32_t>& scratchKeys)
+        {
+            const size_t count = order.size();
+            scratchOrder.resize(count);
+            scratchKeys.resize(count);
+            for (uint32_t pass = 0; pass < RadixPasses; ++pass)
+            {
+                const uint32_t shift = pass * RadixBits;
+                std::array<uint32_t, RadixBuckets> offsets{};
+                for (const uint32_t key : keys)
+                {
+                    ++offsets[(key >> shift) & (RadixBuckets - 1)];
+                }
+                if (std::ranges::find(offsets, static_cast<uint32_t>(count)) != offsets.end())
+                {
+                    continue;
+                }
+
+                uint32_t running = 0;
+                for (uint32_t& offset : offsets)
+                {
+                    running += std::exchange(offset, running);
+                }
+                for (size_t index = 0; index < count; ++index)
+                {
+                    const uint32_t destination = offsets[(keys[index] >> shift) & (RadixBuckets - 1)]++;
+                    scratchOrder[destination] = order[index];
+                    scratchKeys[destination] = keys[index];
+                }
+                order.swap(scratchOrder);
+                keys.swap(scratchKeys);
+            }
+        }
+    }
+
+    glm::ivec2 transparent_sort_cell(const glm::vec3& position, const float cellSize) noexcept
+    {
+        return glm::ivec2(
+            static_cast<int>(std::floor(position.x / cellSize)),
+            static_cast<int>(std::floor(position.z / cellSize)));
+    }
+
+    uint32_t TransparentSorter::sort(
+        const std::span<const RenderObject> objects,
+        const TransparentSortView& view,
+        std::vector<uint32_t>& visibleIndices)
+    {
+        const glm::ivec2 cameraCell = transparent_sort_cell(view.cameraPosition, view.cellSize);
+        m_resorted = !matches(objects, view, cameraCell);
+        if (m_resorted)
+        {
+            rebuild(objects, view, cameraCell);
+        }
+
+        m_visible.assign(objects.size(), 0);
+        for (const uint32_t objectIndex : visibleIndices)
+        {
+            m_visible[objectIndex] = 1;
+        }
+
+        visibleIndices.clear();
+        uint32_t farCount = 0;
+        for (const uint32_t objectIndex : m_order)
+        {
+            if (m_visible[objectIndex] != 0)
+            {
+                visibleIndices.push_back(objectIndex);
+                farCount += m_far[objectIndex];
+            }
+        }
+        return farCount;
+    }
+
+    bool TransparentSorter::matches(
+        const std::span<const RenderObject> objects,
+        const TransparentSortView& view,
+        const glm::ivec2 cameraCell) const noexcept
+    {
+        if (!m_valid ||
+            cameraCell != m_cameraCell ||
+            view.cellSize != m_cellSize ||
+            view.mergeDistanceCells != m_mergeDistanceCells ||
+            objects.size() != m_meshes.size())
+        {
+            return false;
+        }
+
+        // Sparse-set removal moves the last object into the hole, so comparing meshes slot by slot also
+        // catches objects that changed places.
+        for (size_t index = 0; index < objects.size(); ++index)
+        {
+            if (objects[index].mesh.get() != m_meshes[index])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TransparentSorter::rebuild(
+        const std::span<const RenderObject> objects,
+        const TransparentSortView& view,
+        const glm::ivec2 cameraCell)
+    {
+        m_valid = true;
+        m_cameraCell = cameraCell;
+        m_cellSize = view.cellSize;
+        m_mergeDistanceCells = view.mergeDistanceCells;
+
+        const uint64_t mergeDistanceSquared = static_cast<uint64_t>(view.mergeDistanceCells) * view.mergeDistanceCells;
+        m_meshes.resize(objects.size());
+        m_order.resize(objects.size());
+        m_keys.resize(objects.size());
+        m_far.resize(objects.size());
+        for (uint32_t index = 0; index < objects.size(); ++index)
+        {
+            const RenderObject& object = objects[index];
+            const uint64_t distanceSquared = cell_distance_squared(
+                transparent_sort_cell(object_position(object), view.cellSize),
+                cameraCell);
+            m_meshes[index] = object.mesh.get();
+            m_order[index] = index;
+            m_keys[index] = sort_key(distanceSquared, object.indirectMaterial != nullptr);
+            m_far[index] = view.mergeDistanceCells != 0 && distanceSquared >= mergeDistanceSquared ? 1 : 0;
+        }
+
+        radix_sort(m_order, m_keys, m_scratchOrder, m_scratchKeys);
+    }
+}
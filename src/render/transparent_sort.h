@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "render_primitives.h"
+
+namespace render
+{
+    // Camera placement for ordering blended draws. Objects are bucketed into square cells of cellSize on
+    // the horizontal plane (one chunk column per cell), which is as fine as chunk meshes can be ordered.
+    struct TransparentSortView
+    {
+        glm::vec3 cameraPosition{0.0f};
+        float cellSize{1.0f};
+        // Objects at least this many cells away are drawn first and may be merged into indirect draws.
+        uint32_t mergeDistanceCells{0};
+    };
+
+    struct TransparentSortStats
+    {
+        uint32_t sorted{0};
+        uint32_t farObjects{0};
+        uint32_t mergedObjects{0};
+        uint32_t mergedCalls{0};
+        bool resorted{false};
+    };
+
+    [[nodiscard]] glm::ivec2 transparent_sort_cell(const glm::vec3& position, float cellSize) noexcept;
+
+    // Back-to-front order for blended objects at cell granularity. All objects are radix sorted by cell
+    // distance from the camera and the order is kept until the camera moves to another cell or the object
+    // set changes; in between, a frame only filters the cached order down to its visible objects.
+    // Within a cell, objects with an indirect material come first so far batches stay contiguous.
+    class TransparentSorter
+    {
+    public:
+        // Rewrites visibleIndices back to front and returns how many leading entries are far objects.
+        uint32_t sort(std::span<const RenderObject> objects, const TransparentSortView& view, std::vector<uint32_t>& visibleIndices);
+
+        [[nodiscard]] bool last_sort_resorted() const noexcept { return m_resorted; }
+        void invalidate() noexcept { m_valid = false; }
+
+    private:
+        bool m_valid{false};
+        bool m_resorted{false};
+        glm::ivec2 m_cameraCell{0};
+        float m_cellSize{0.0f};
+        uint32_t m_mergeDistanceCells{0};
+        // Identity of the objects the cached order was built for.
+        std::vector<const Mesh*> m_meshes{};
+        // Every object back to front, and whether each object sits in the far band.
+        std::vector<uint32_t> m_order{};
+        std::vector<uint8_t> m_far{};
+        std::vector<uint32_t> m_keys{};
+        std::vector<uint32_t> m_scratchOrder{};
+        std::vector<uint32_t> m_scratchKeys{};
+        std::vector<uint8_t> m_visible{};
+
+        [[nodiscard]] bool matches(std::span<const RenderObject> objects, const TransparentSortView& view, glm::ivec2 cameraCell) const noexcept;
+        void rebuild(std::span<const RenderObject> objects, const TransparentSortView& view, glm::ivec2 cameraCell);
+    };
+}
@@ -13,7 +13,6 @@
 #include "backends/imgui_impl_sdl2.h"
 #include "backends/imgui_impl_vulkan.h"
 #include "orbit_orientation_gizmo.h"
-#include "render/mesh_release_queue.h"
 #include "components/voxel_model_component.h"
 #include "string_utils.h"
 #include "voxel/voxel_component_render_adapter.h"
@@ -22,6 +21,12 @@
 namespace
 {
     constexpr std::string_view GameSceneMaterialScope = "game";
+    // Enough indirect draws for every chunk at view distance 32; anything beyond falls back to direct draws.
+    constexpr uint32_t IndirectDrawCapacity = static_cast<uint32_t>(maximum_chunks_for_view_distance(32));
+    // Chunks at least this far from the camera draw their water in merged indirect draws.
+    constexpr uint32_t WaterMergeDistanceChunks = 8;
+    // Decoration instances drawn per frame; instances past this are skipped and reported as dropped.
+    constexpr uint32_t DecorationInstanceCapacity = 32768;
 
     bool equal_aabb(const AABB& lhs, const AABB& rhs) noexcept
     {
@@ -353,15 +358,14 @@ GameScene::GameScene(const SceneServices& services):
         .device = _services.device,
         .allocator = _services.allocator
     };
-	auto fogUboBuffer = vkutil::create_buffer(_services.allocator, sizeof(FogUBO),
-	                                          VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-	auto cameraUboBuffer = vkutil::create_buffer(_services.allocator, sizeof(CameraUBO),
-	                                             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-    auto lightingUboBuffer = vkutil::create_buffer(_services.allocator, sizeof(LightingUBO),
-                                                   VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-	_cameraUboResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(cameraUboBuffer));
-	_fogResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(fogUboBuffer));
-    _lightingResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(lightingUboBuffer));
+	_cameraUboResource = Resource::create_frame_uniform(resourceBackend, sizeof(CameraUBO));
+	_fogResource = Resource::create_frame_uniform(resourceBackend, sizeof(FogUBO));
+    _lightingResource = Resource::create_frame_uniform(resourceBackend, sizeof(LightingUBO));
+    _indirectDrawBuffers = std::make_shared<render::IndirectDrawBuffers>(resourceBackend, IndirectDrawCapacity, IndirectDrawCapacity * 2);
+    _renderState.indirectDraws = _indirectDrawBuffers;
+    _waterIndirectDrawBuffers = std::make_shared<render::IndirectDrawBuffers>(resourceBackend, IndirectDrawCapacity, IndirectDrawCapacity * 2);
+    _renderState.transparentIndirectDraws = _waterIndirectDrawBuffers;
+    _renderState.instanceData = std::make_shared<render::InstanceDataBuffer>(resourceBackend, DecorationInstanceCapacity);
 
 	build_pipelines();
 
@@ -412,14 +416,9 @@ GameScene::~GameScene()
     _playerVoxelRenderRegistry.clear(_renderState);
     _voxelRenderRegistry.clear(_renderState);
 	_chunkRenderRegistry.clear(_renderState);
-    if (_chunkBoundaryMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_chunkBoundaryMesh));
-    }
-    if (_targetBlockOutlineMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_targetBlockOutlineMesh));
-    }
+    _horizonRenderRegistry.clear(_renderState);
+    _chunkBoundaryMesh.reset();
+    _targetBlockOutlineMesh.reset();
 	std::println("GameScene::~GameScene");
 }
 
@@ -436,6 +435,15 @@ void GameScene::update_buffers() {
             GameSceneMaterialScope,
 			_renderState);
 	}
+    {
+        ZoneScopedN("GameScene::SyncHorizonRegistry");
+        _horizonRenderRegistry.sync(
+            _game.chunk_manager(),
+            *_services.meshManager,
+            *_services.materialManager,
+            GameSceneMaterialScope,
+            _renderState);
+    }
     const ChunkCoord centerChunk = _game.snapshot().currentChunk.value_or(World::get_chunk_coordinates(_game.snapshot().player.position, _game.world_geometry()));
     {
         ZoneScopedN("GameScene::SyncDecorationRegistry");
@@ -462,6 +470,19 @@ void GameScene::update_buffers() {
     sync_spatial_collider_debug();
     sync_chunk_boundary_debug();
 	update_uniform_buffer();
+    _renderState.cullViewProjection = _camera->_projection * _camera->_view;
+    _chunkRenderRegistry.update_section_visibility(
+        _game.world_geometry(),
+        _camera->_position,
+        render::extract_frustum(_renderState.cullViewProjection.value()),
+        _settings.persistence().world.viewDistance,
+        _sectionCullingEnabled,
+        _renderState);
+    _renderState.transparentSort = render::TransparentSortView{
+        .cameraPosition = _camera->_position,
+        .cellSize = _game.world_geometry().chunk_world_width(),
+        .mergeDistanceCells = WaterMergeDistanceChunks
+    };
     update_lighting_ubo();
 	update_fog_ubo();
 }
@@ -593,35 +614,56 @@ void GameScene::draw_imgui()
 	}
 
     draw_camera_orientation_gizmo();
+    draw_frame_timing_overlay();
 
 	ImGui::Render();
 }
 
+void GameScene::draw_frame_timing_overlay() const
+{
+    if (_services.frameTimings == nullptr)
+    {
+        return;
+    }
+
+    // With several frames in flight, fence wait near zero means the CPU is the bottleneck; a large
+    // wait with a short record time means the GPU is.
+    const FrameTimings& timings = *_services.frameTimings;
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(
+        ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 12.0f, viewport->WorkPos.y + 12.0f),
+        ImGuiCond_Always,
+        ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.45f);
+    constexpr ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_NoInputs;
+    if (ImGui::Begin("Frame Timing", nullptr, flags))
+    {
+        ImGui::Text("Frames in flight: %u", FRAME_OVERLAP);
+        ImGui::Text("Frame:      %6.2f ms", static_cast<double>(timings.frameMs));
+        ImGui::Text("CPU record: %6.2f ms", static_cast<double>(timings.recordMs));
+        ImGui::Text("Fence wait: %6.2f ms", static_cast<double>(timings.fenceWaitMs));
+    }
+    ImGui::End();
+}
+
 void GameScene::draw_camera_orientation_gizmo() const
 {
     glm::mat4 gizmoView = _camera->_view;
     (void)draw_orbit_orientation_gizmo(gizmoView, 4.0f);
 }
 
-void GameScene::rebuild_pipelines()
+void GameScene::resize_viewport()
 {
 	_camera->resize(_services.current_window_extent());
-	build_pipelines();
 }
 
 void GameScene::build_pipelines()
 {
 	auto translate = PushConstant{
 	.stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-	.size = sizeof(ObjectPushConstants),
-	.build_constant = [](const RenderObject& obj) -> ObjectPushConstants
-		{
-			ObjectPushConstants push{};
-			push.modelMatrix = obj.transform;
-            push.sampledLocalLightAndSunlight = glm::vec4(obj.sampledLight.localLight, obj.sampledLight.sunlight);
-            push.sampledDynamicLightAndMode = glm::vec4(obj.sampledLight.dynamicLight, static_cast<float>(obj.lightingMode));
-			return push;
-		}
+	.size = sizeof(ObjectPushConstants)
 	};
 	_services.materialManager->build_graphics_pipeline(
         GameSceneMaterialScope,
@@ -636,6 +678,35 @@ void GameScene::build_pipelines()
 		"defaultmesh"
 	);
 
+	_services.materialManager->build_graphics_pipeline(
+        GameSceneMaterialScope,
+		{
+            MaterialBinding::from_resource(0, 0, _cameraUboResource),
+            MaterialBinding::from_resource(1, 0, _lightingResource),
+            MaterialBinding::from_resource(2, 0, _indirectDrawBuffers->draw_data_resource())
+        },
+		{},
+		{},
+		"tri_mesh_indirect.vert.spv",
+		"tri_mesh.frag.spv",
+		"defaultmesh_indirect"
+	);
+
+	// Same shaders as the indirect path: gl_InstanceIndex walks the per-instance buffer instead of draw data.
+	_services.materialManager->build_graphics_pipeline(
+        GameSceneMaterialScope,
+		{
+            MaterialBinding::from_resource(0, 0, _cameraUboResource),
+            MaterialBinding::from_resource(1, 0, _lightingResource),
+            MaterialBinding::from_resource(2, 0, _renderState.instanceData->resource())
+        },
+		{},
+		{},
+		"tri_mesh_indirect.vert.spv",
+		"tri_mesh.frag.spv",
+		"decorationmesh_instanced"
+	);
+
 	_services.materialManager->build_graphics_pipeline(
         GameSceneMaterialScope,
 		{
@@ -650,6 +721,21 @@ void GameScene::build_pipelines()
 		"watermesh"
 	);
 
+	_services.materialManager->build_graphics_pipeline(
+        GameSceneMaterialScope,
+		{
+            MaterialBinding::from_resource(0, 0, _cameraUboResource),
+            MaterialBinding::from_resource(1, 0, _lightingResource),
+            MaterialBinding::from_resource(2, 0, _fogResource),
+            MaterialBinding::from_resource(3, 0, _waterIndirectDrawBuffers->draw_data_resource())
+        },
+		{},
+		{ .depthTest = true, .depthWrite = false, .compareOp = VK_COMPARE_OP_LESS_OR_EQUAL, .blendMode = BlendMode::Alpha },
+		"water_mesh_indirect.vert.spv",
+		"water_mesh.frag.spv",
+		"watermesh_indirect"
+	);
+
     _services.materialManager->build_graphics_pipeline(
         GameSceneMaterialScope,
         {
@@ -729,6 +815,69 @@ void GameScene::draw_debug_map()
         {
             const VkExtent2D windowExtent = _services.current_window_extent();
             ImGui::Text("Window size: %d x %d", windowExtent.width, windowExtent.height);
+            const ChunkRenderRegistry::SyncStats& chunkUploadStats = _chunkRenderRegistry.last_sync_stats();
+            ImGui::Text("Chunk Uploads This Frame: %u requested, %u skipped (unchanged)",
+                chunkUploadStats.uploadsRequested,
+                chunkUploadStats.uploadsSkipped);
+            ImGui::Text("Objects Last Frame: %u visible, %u frustum culled",
+                _renderState.lastCullStats.visible,
+                _renderState.lastCullStats.culled);
+            ImGui::Text("Occlusion: %u occluders, %u of %u tested objects hidden",
+                _renderState.lastOcclusionStats.occluders,
+                _renderState.lastOcclusionStats.occluded,
+                _renderState.lastOcclusionStats.tested);
+            const SectionVisibilityStats& sectionStats = _chunkRenderRegistry.last_section_visibility_stats();
+            ImGui::Checkbox("Cave Culling", &_sectionCullingEnabled);
+            ImGui::SameLine();
+            ImGui::Text("%u chunks hidden, %u visible, %u sections visited",
+                sectionStats.hiddenChunks,
+                sectionStats.visibleChunks,
+                sectionStats.visitedSections);
+            ImGui::Text("Indirect Draws: %u objects, %u commands in %u calls, %u direct",
+                _renderState.lastIndirectDrawStats.batchedObjects,
+                _renderState.lastIndirectDrawStats.commands,
+                _renderState.lastIndirectDrawStats.indirectCalls,
+                _renderState.lastIndirectDrawStats.fallbackObjects);
+            ImGui::Text("Transparent: %u sorted%s, %u far, %u water merged in %u calls",
+                _renderState.lastTransparentSortStats.sorted,
+                _renderState.lastTransparentSortStats.resorted ? " (re-sorted)" : "",
+                _renderState.lastTransparentSortStats.farObjects,
+                _renderState.lastTransparentSortStats.mergedObjects,
+                _renderState.lastTransparentSortStats.mergedCalls);
+            const HorizonTerrainStats& horizonStats = _game.chunk_manager().horizon_stats();
+            ImGui::Text("Horizon: %u of %u tiles built, %u building, %llu drawn",
+                horizonStats.builtTiles,
+                horizonStats.tiles,
+                horizonStats.jobsInFlight,
+                static_cast<unsigned long long>(_horizonRenderRegistry.tile_count()));
+            ImGui::Text("Binds: %u pipeline, %u descriptor, %u vertex, %u index; %u draws, %u indirect",
+                _renderState.lastDrawCounters.pipelineBinds,
+                _renderState.lastDrawCounters.descriptorSetBinds,
+                _renderState.lastDrawCounters.vertexBufferBinds,
+                _renderState.lastDrawCounters.indexBufferBinds,
+                _renderState.lastDrawCounters.drawCalls,
+                _renderState.lastDrawCounters.indirectDrawCalls);
+
+            const MeshManager::UploadStats& uploadStats = _services.meshManager->upload_stats();
+            ImGui::Text("Uploads: %u submitted (%.2f MiB), %u deferred (%.2f MiB), latency %.1f avg / %u max frames",
+                uploadStats.submittedUploads,
+                static_cast<double>(uploadStats.submittedBytes) / (1024.0 * 1024.0),
+                uploadStats.deferredUploads,
+                static_cast<double>(uploadStats.queuedBytes) / (1024.0 * 1024.0),
+                uploadStats.averageLatencyFrames,
+                uploadStats.maxLatencyFrames);
+            const MeshAllocatorStats allocatorStats = _services.meshManager->allocator_stats();
+            ImGui::Text("Mesh memory: %.1f / %.1f MiB in %u pages, fragmentation %.0f%%, relocated %.2f MiB",
+                static_cast<double>(allocatorStats.vertexUsed + allocatorStats.indexUsed) / (1024.0 * 1024.0),
+                static_cast<double>(allocatorStats.vertexCapacity + allocatorStats.indexCapacity) / (1024.0 * 1024.0),
+                allocatorStats.vertexPages + allocatorStats.indexPages,
+                static_cast<double>(allocatorStats.vertexFragmentation) * 100.0,
+                static_cast<double>(allocatorStats.relocatedBytes) / (1024.0 * 1024.0));
+            const MeshManager::RetirementStats& retirementStats = _services.meshManager->retirement_stats();
+            ImGui::Text("Retired meshes: %u pending (%.2f MiB), %u freed this frame",
+                retirementStats.pendingMeshes,
+                static_cast<double>(retirementStats.pendingBytes) / (1024.0 * 1024.0),
+                retirementStats.freedMeshes);
 
             const GameSnapshot& snapshot = _game.snapshot();
             ChunkCoord playerChunk = snapshot.currentChunk.value_or(World::get_chunk_coordinates(snapshot.player.position, _game.world_geometry()));
@@ -824,6 +973,12 @@ void GameScene::draw_debug_map()
             ImGui::Text("Active Instances: %llu", static_cast<unsigned long long>(_voxelRenderRegistry.instance_count()));
             ImGui::Text("Chunk Decoration Chunks: %llu", static_cast<unsigned long long>(_chunkDecorationRenderRegistry.active_chunk_count()));
             ImGui::Text("Chunk Decoration Instances: %llu", static_cast<unsigned long long>(_chunkDecorationRenderRegistry.active_instance_count()));
+            const render::InstancedDrawStats& instancedStats = _renderState.lastInstancedDrawStats;
+            ImGui::Text("Decoration Draws: %u for %u instances (%u groups culled, %u dropped)",
+                instancedStats.batches,
+                instancedStats.instances,
+                instancedStats.culledGroups,
+                instancedStats.droppedInstances);
             ImGui::Text("Dynamic Lights: %llu", static_cast<unsigned long long>(_dynamicLightRegistry.active_light_count()));
             ImGui::Checkbox("Player Torch Light", &_playerTorchLightEnabled);
             ImGui::SliderFloat("Torch Radius", &_playerTorchRadius, 1.0f, 18.0f, "%.1f");
@@ -872,7 +1027,9 @@ void GameScene::draw_debug_map()
             }
 
             ImGui::SliderInt("View Distance", &_viewDistanceDraft, 1, 20);
-            const bool viewDistanceDirty = _viewDistanceDraft != persistence.world.viewDistance;
+            ImGui::SliderInt("Horizon Distance", &_horizonDistanceDraft, 0, 128);
+            const bool viewDistanceDirty = _viewDistanceDraft != persistence.world.viewDistance ||
+                _horizonDistanceDraft != persistence.world.horizonDistance;
             if (!viewDistanceDirty)
             {
                 ImGui::BeginDisabled();
@@ -880,9 +1037,11 @@ void GameScene::draw_debug_map()
             if (ImGui::Button("Apply View Distance"))
             {
                 const int requestedViewDistance = _viewDistanceDraft;
-                _settings.mutate([requestedViewDistance](settings::GameSettingsPersistence& updated)
+                const int requestedHorizonDistance = _horizonDistanceDraft;
+                _settings.mutate([requestedViewDistance, requestedHorizonDistance](settings::GameSettingsPersistence& updated)
                 {
                     updated.world.viewDistance = requestedViewDistance;
+                    updated.world.horizonDistance = requestedHorizonDistance;
                 });
             }
             if (!viewDistanceDirty)
@@ -897,6 +1056,7 @@ void GameScene::draw_debug_map()
             if (ImGui::Button("Reset View Distance"))
             {
                 _viewDistanceDraft = persistence.world.viewDistance;
+                _horizonDistanceDraft = persistence.world.horizonDistance;
             }
             if (!viewDistanceDirty)
             {
@@ -1299,7 +1459,7 @@ void GameScene::update_fog_ubo() const
 	const VkExtent2D windowExtent = _services.current_window_extent();
 	fogUBO.screenSize = glm::ivec2(windowExtent.width, windowExtent.height);
     fogUBO.fogParams1 = glm::vec4(
-        tuning.fogDistanceRange,
+        tuning.fogDistanceRange + _settings.view_distance_runtime_settings().fogHorizonRange,
         tuning.fogHeightMin,
         tuning.fogHeightMax,
         0.0f);
@@ -1310,10 +1470,7 @@ void GameScene::update_fog_ubo() const
         tuning.waterFogFactorDense);
 	fogUBO.invViewProject = glm::inverse(_camera->_projection * _camera->_view);
 
-	void* data;
-	vmaMapMemory(_services.allocator, _fogResource->value.buffer._allocation, &data);
-	memcpy(data, &fogUBO, sizeof(FogUBO));
-	vmaUnmapMemory(_services.allocator, _fogResource->value.buffer._allocation);
+	_fogResource->write_frame_uniform(_services.current_frame_slot(), &fogUBO, sizeof(FogUBO));
 }
 
 void GameScene::update_lighting_ubo() const
@@ -1350,10 +1507,7 @@ void GameScene::update_lighting_ubo() const
         lighting.dynamicLightMetadata[index] = glm::uvec4(light.affectMask, light.active ? 1u : 0u, 0u, 0u);
     }
 
-    void* data;
-    vmaMapMemory(_services.allocator, _lightingResource->value.buffer._allocation, &data);
-    memcpy(data, &lighting, sizeof(LightingUBO));
-    vmaUnmapMemory(_services.allocator, _lightingResource->value.buffer._allocation);
+    _lightingResource->write_frame_uniform(_services.current_frame_slot(), &lighting, sizeof(LightingUBO));
 }
 
 void GameScene::update_uniform_buffer() const
@@ -1364,10 +1518,7 @@ void GameScene::update_uniform_buffer() const
 	cameraUBO.view = _camera->_view;
 	cameraUBO.viewproject = _camera->_projection * _camera->_view;
 
-	void* data;
-	vmaMapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation, &data);
-	memcpy(data, &cameraUBO, sizeof(CameraUBO));
-	vmaUnmapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation);
+	_cameraUboResource->write_frame_uniform(_services.current_frame_slot(), &cameraUBO, sizeof(CameraUBO));
 }
 void GameScene::create_camera()
 {
@@ -1430,8 +1581,18 @@ void GameScene::sync_player_render_instance()
         return;
     }
 
-    const VoxelComponentRenderBundle renderBundle =
-        build_voxel_component_render_bundle(*player, _game.voxel_assembly_asset_manager(), _game.voxel_asset_manager());
+    const VoxelComponentRenderBundle renderBundle = build_voxel_component_render_bundle(
+        *player,
+        _game.voxel_assembly_asset_manager(),
+        _game.voxel_asset_manager(),
+        VoxelAssetLoadMode::Async);
+    if (renderBundle.is_pending())
+    {
+        // Keep drawing the previous parts until every model of the new assembly is resident.
+        _playerAssemblyStatus = std::format("Loading {} player assembly model(s)...", renderBundle.pendingAssetCount);
+        return;
+    }
+
     std::unordered_set<std::string> activePartIds{};
     activePartIds.reserve(renderBundle.entries.size());
     for (const VoxelComponentRenderEntry& entry : renderBundle.entries)
@@ -1508,11 +1669,6 @@ void GameScene::sync_spatial_collider_debug()
             !cacheEntry.boundsCached ||
             !equal_aabb(cacheEntry.localBounds, snapshot.localBounds))
         {
-            if (cacheEntry.mesh != nullptr)
-            {
-                render::enqueue_mesh_release(std::move(cacheEntry.mesh));
-            }
-
             cacheEntry.mesh = Mesh::create_box_outline_mesh(
                 snapshot.localBounds.min,
                 snapshot.localBounds.max,
@@ -1535,10 +1691,6 @@ void GameScene::sync_spatial_collider_debug()
     {
         if (!activeSnapshotIds.contains(it->first))
         {
-            if (it->second.mesh != nullptr)
-            {
-                render::enqueue_mesh_release(std::move(it->second.mesh));
-            }
             it = _spatialColliderDebugMeshCache.erase(it);
             continue;
         }
@@ -1593,11 +1745,6 @@ void GameScene::sync_target_block_outline()
     const WorldGeometry& geometry = _game.world_geometry();
     const glm::vec3 blockWorldMin = geometry.voxel_to_world(glm::vec3(worldPos));
 
-    if (_targetBlockOutlineMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_targetBlockOutlineMesh));
-    }
-
     _targetBlockOutlineMesh = Mesh::create_block_outline_mesh(blockWorldMin, geometry.block_world_size());
     _services.meshManager->UploadQueue.enqueue(_targetBlockOutlineMesh);
     _outlinedBlockWorldPos = worldPos;
@@ -1753,14 +1900,6 @@ void GameScene::clear_spatial_collider_debug()
 
 void GameScene::release_spatial_collider_debug_meshes()
 {
-    for (auto& [id, cacheEntry] : _spatialColliderDebugMeshCache)
-    {
-        if (cacheEntry.mesh != nullptr)
-        {
-            render::enqueue_mesh_release(std::move(cacheEntry.mesh));
-        }
-    }
-
     _spatialColliderDebugMeshCache.clear();
 }
 
@@ -1783,24 +1922,26 @@ void GameScene::bind_settings()
 void GameScene::apply_view_distance_settings(const settings::ViewDistanceRuntimeSettings& settings)
 {
     _viewDistanceDraft = settings.viewDistance;
+    _horizonDistanceDraft = settings.horizonDistance;
+    _game.chunk_manager().apply_streaming_settings(ChunkStreamingSettings{
+        .viewDistance = settings.viewDistance,
+        .horizonDistance = settings.horizonDistance
+    });
+    if (_services.meshManager->apply_view_distance_settings(settings))
+    {
+        return;
+    }
+
+    // The mesh allocator can only take the new budget once every mesh is released.
     _chunkRenderRegistry.clear(_renderState);
     _chunkDecorationRenderRegistry.clear(_renderState);
+    _horizonRenderRegistry.clear(_renderState);
     clear_chunk_boundary_debug();
     clear_target_block_outline();
     _outlinedBlockWorldPos.reset();
-    if (_chunkBoundaryMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_chunkBoundaryMesh));
-    }
-    if (_targetBlockOutlineMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_targetBlockOutlineMesh));
-    }
-
-    _services.meshManager->apply_view_distance_settings(settings);
-    _game.chunk_manager().apply_streaming_settings(ChunkStreamingSettings{
-        .viewDistance = settings.viewDistance
-    });
+    _chunkBoundaryMesh.reset();
+    _targetBlockOutlineMesh.reset();
+    _game.chunk_manager().invalidate_meshes();
 }
 
 void GameScene::apply_ambient_occlusion_settings(const settings::AmbientOcclusionRuntimeSettings& settings)
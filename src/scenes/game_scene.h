@@ -9,6 +9,9 @@
 #include "scene_services.h"
 #include "render/chunk_render_registry.h"
 #include "render/chunk_decoration_render_registry.h"
+#include "render/horizon_render_registry.h"
+#include "render/indirect_draw_buffers.h"
+#include "render/instance_data_buffer.h"
 #include "render/resource.h"
 #include "render/scene_render_state.h"
 #include "render/mesh.h"
@@ -33,7 +36,7 @@ public:
     void handle_keystate(const Uint8* state) override;
     void clear_input() override;
     void draw_imgui() override;
-    void rebuild_pipelines() override;
+    void resize_viewport() override;
     void build_pipelines() override;
     SceneRenderState& get_render_state() override;
     [[nodiscard]] bool wants_mouse_capture() const override { return true; }
@@ -113,14 +116,18 @@ private:
     void update_lighting_ubo() const;
     void update_uniform_buffer() const;
     void draw_camera_orientation_gizmo() const;
+    void draw_frame_timing_overlay() const;
 
     std::shared_ptr<Resource> _fogResource;
     std::shared_ptr<Resource> _cameraUboResource;
     std::shared_ptr<Resource> _lightingResource;
+    std::shared_ptr<render::IndirectDrawBuffers> _indirectDrawBuffers;
+    std::shared_ptr<render::IndirectDrawBuffers> _waterIndirectDrawBuffers;
     std::shared_ptr<Mesh> _chunkBoundaryMesh;
     std::shared_ptr<Mesh> _targetBlockOutlineMesh;
     ChunkRenderRegistry _chunkRenderRegistry;
     ChunkDecorationRenderRegistry _chunkDecorationRenderRegistry;
+    HorizonRenderRegistry _horizonRenderRegistry;
     VoxelRenderRegistry _playerVoxelRenderRegistry;
     VoxelRenderRegistry _voxelRenderRegistry;
     world_lighting::DynamicLightRegistry _dynamicLightRegistry;
@@ -132,6 +139,7 @@ private:
     std::optional<dev_collections::sparse_set<RenderObject>::Handle> _targetBlockOutlineHandle{};
     settings::SettingsManager _settings{};
     int _viewDistanceDraft{GameConfig::DEFAULT_VIEW_DISTANCE};
+    int _horizonDistanceDraft{GameConfig::DEFAULT_HORIZON_DISTANCE};
     TerrainGeneratorSettings _worldGenDraft{};
     int _worldGenPreviewLayer{0};
     int _worldGenPreviewMaxResolution{72};
@@ -159,6 +167,7 @@ private:
     std::string _playerAssemblyAssetId{};
     std::string _playerAssemblyStatus{"No player assembly selected."};
     bool _showSpatialColliderBounds{false};
+    bool _sectionCullingEnabled{true};
     std::unordered_map<std::string, SpatialColliderDebugMeshCacheEntry> _spatialColliderDebugMeshCache{};
 
     void create_camera();
@@ -13,7 +13,8 @@ public:
     virtual void clear_input() = 0;
     virtual void draw_imgui() = 0;
     virtual void build_pipelines() = 0;
-    virtual void rebuild_pipelines() = 0;
+    // Window extent changed. Pipelines are rebuilt separately by SceneRenderer.
+    virtual void resize_viewport() = 0;
     virtual SceneRenderState& get_render_state() = 0;
     [[nodiscard]] virtual bool wants_mouse_capture() const = 0;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "constants.h"
+#include "frame_clock.h"
 #include "vk_types.h"
 
 class MaterialManager;
@@ -14,9 +16,17 @@ struct SceneServices
     MeshManager* meshManager{};
     MaterialManager* materialManager{};
     config::ConfigService* configService{};
+    const int* frameNumber{};
+    const FrameTimings* frameTimings{};
 
     [[nodiscard]] VkExtent2D current_window_extent() const
     {
         return *windowExtent;
     }
+
+    // Slot of the frame being recorded; per-frame uniforms are written to this slot's block.
+    [[nodiscard]] uint32_t current_frame_slot() const
+    {
+        return static_cast<uint32_t>(*frameNumber) % FRAME_OVERLAP;
+    }
 };
@@ -24,7 +24,6 @@
 #include "orbit_orientation_gizmo.h"
 #include "render/material_manager.h"
 #include "render/mesh_manager.h"
-#include "render/mesh_release_queue.h"
 #include "string_utils.h"
 #include "voxel/voxel_orientation.h"
 #include "voxel/voxel_spatial_bounds.h"
@@ -69,25 +68,9 @@ VoxelAssemblyScene::VoxelAssemblyScene(const SceneServices& services) :
         .allocator = _services.allocator
     };
 
-    const auto cameraBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(CameraUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-    const auto lightingBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(LightingUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-    const auto fogBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(FogUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-    _cameraUboResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(cameraBuffer));
-    _lightingResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(lightingBuffer));
-    _fogResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(fogBuffer));
+    _cameraUboResource = Resource::create_frame_uniform(resourceBackend, sizeof(CameraUBO));
+    _lightingResource = Resource::create_frame_uniform(resourceBackend, sizeof(LightingUBO));
+    _fogResource = Resource::create_frame_uniform(resourceBackend, sizeof(FogUBO));
 
     _camera = std::make_unique<Camera>(glm::vec3(0.0f, 1.5f, -6.0f), _services.current_window_extent());
 
@@ -242,15 +225,7 @@ void VoxelAssemblyScene::build_pipelines()
 {
     const auto translate = PushConstant{
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-        .size = sizeof(ObjectPushConstants),
-        .build_constant = [](const RenderObject& object) -> ObjectPushConstants
-        {
-            ObjectPushConstants push{};
-            push.modelMatrix = object.transform;
-            push.sampledLocalLightAndSunlight = glm::vec4(object.sampledLight.localLight, object.sampledLight.sunlight);
-            push.sampledDynamicLightAndMode = glm::vec4(object.sampledLight.dynamicLight, static_cast<float>(object.lightingMode));
-            return push;
-        }
+        .size = sizeof(ObjectPushConstants)
     };
 
     _services.materialManager->build_graphics_pipeline(
@@ -292,10 +267,9 @@ void VoxelAssemblyScene::build_pipelines()
     _services.materialManager->build_present_pipeline(VoxelAssemblyMaterialScope);
 }
 
-void VoxelAssemblyScene::rebuild_pipelines()
+void VoxelAssemblyScene::resize_viewport()
 {
     _camera->resize(_services.current_window_extent());
-    build_pipelines();
 }
 
 SceneRenderState& VoxelAssemblyScene::get_render_state()
@@ -310,10 +284,7 @@ void VoxelAssemblyScene::update_uniform_buffers() const
     cameraUbo.view = _camera->_view;
     cameraUbo.viewproject = _camera->_projection * _camera->_view;
 
-    void* cameraData = nullptr;
-    vmaMapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation, &cameraData);
-    memcpy(cameraData, &cameraUbo, sizeof(CameraUBO));
-    vmaUnmapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation);
+    _cameraUboResource->write_frame_uniform(_services.current_frame_slot(), &cameraUbo, sizeof(CameraUBO));
 
     LightingUBO lighting{};
     lighting.skyZenithColor = glm::vec4(0.30f, 0.43f, 0.60f, 1.0f);
@@ -329,10 +300,7 @@ void VoxelAssemblyScene::update_uniform_buffers() const
     lighting.params3 = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
     lighting.params4 = glm::vec4(0.0f);
 
-    void* lightingData = nullptr;
-    vmaMapMemory(_services.allocator, _lightingResource->value.buffer._allocation, &lightingData);
-    memcpy(lightingData, &lighting, sizeof(LightingUBO));
-    vmaUnmapMemory(_services.allocator, _lightingResource->value.buffer._allocation);
+    _lightingResource->write_frame_uniform(_services.current_frame_slot(), &lighting, sizeof(LightingUBO));
 
     FogUBO fog{};
     fog.fogColor = EditorFogColor;
@@ -343,10 +311,7 @@ void VoxelAssemblyScene::update_uniform_buffers() const
     fog.screenSize = glm::ivec2(extent.width, extent.height);
     fog.invViewProject = glm::inverse(_camera->_projection * _camera->_view);
 
-    void* fogData = nullptr;
-    vmaMapMemory(_services.allocator, _fogResource->value.buffer._allocation, &fogData);
-    memcpy(fogData, &fog, sizeof(FogUBO));
-    vmaUnmapMemory(_services.allocator, _fogResource->value.buffer._allocation);
+    _fogResource->write_frame_uniform(_services.current_frame_slot(), &fog, sizeof(FogUBO));
 }
 
 void VoxelAssemblyScene::update_camera()
@@ -762,37 +727,12 @@ void VoxelAssemblyScene::clear_preview()
 
 void VoxelAssemblyScene::release_selection_meshes()
 {
-    if (_assemblyBoundsMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_assemblyBoundsMesh));
-    }
-    if (_assemblyRootPivotMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_assemblyRootPivotMesh));
-    }
-    if (_collisionBoundsMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_collisionBoundsMesh));
-    }
-    if (_selectedPartBoundsMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_selectedPartBoundsMesh));
-    }
-    if (_selectedPartPivotMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_selectedPartPivotMesh));
-    }
-    if (_parentAttachmentMarkerMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_parentAttachmentMarkerMesh));
-    }
-    for (std::shared_ptr<Mesh>& mesh : _selectedAttachmentMarkerMeshes)
-    {
-        if (mesh != nullptr)
-        {
-            render::enqueue_mesh_release(std::move(mesh));
-        }
-    }
+    _assemblyBoundsMesh.reset();
+    _assemblyRootPivotMesh.reset();
+    _collisionBoundsMesh.reset();
+    _selectedPartBoundsMesh.reset();
+    _selectedPartPivotMesh.reset();
+    _parentAttachmentMarkerMesh.reset();
     _selectedAttachmentMarkerMeshes.clear();
 }
 
@@ -19,7 +19,6 @@
 #include "orbit_orientation_gizmo.h"
 #include "render/material_manager.h"
 #include "render/mesh_manager.h"
-#include "render/mesh_release_queue.h"
 #include "string_utils.h"
 #include "voxel/voxel_orientation.h"
 #include "voxel/voxel_picking.h"
@@ -112,25 +111,9 @@ VoxelEditorScene::VoxelEditorScene(const SceneServices& services) :
         .allocator = _services.allocator
     };
 
-    const auto cameraBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(CameraUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-    const auto lightingBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(LightingUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-    const auto fogBuffer = vkutil::create_buffer(
-        _services.allocator,
-        sizeof(FogUBO),
-        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-    _cameraUboResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(cameraBuffer));
-    _lightingResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(lightingBuffer));
-    _fogResource = std::make_shared<Resource>(resourceBackend, Resource::BUFFER, Resource::ResourceValue(fogBuffer));
+    _cameraUboResource = Resource::create_frame_uniform(resourceBackend, sizeof(CameraUBO));
+    _lightingResource = Resource::create_frame_uniform(resourceBackend, sizeof(LightingUBO));
+    _fogResource = Resource::create_frame_uniform(resourceBackend, sizeof(FogUBO));
 
     _camera = std::make_unique<Camera>(glm::vec3(0.0f, 1.5f, -4.0f), _services.current_window_extent());
 
@@ -341,15 +324,7 @@ void VoxelEditorScene::build_pipelines()
 {
     const auto translate = PushConstant{
         .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-        .size = sizeof(ObjectPushConstants),
-        .build_constant = [](const RenderObject& object) -> ObjectPushConstants
-        {
-            ObjectPushConstants push{};
-            push.modelMatrix = object.transform;
-            push.sampledLocalLightAndSunlight = glm::vec4(object.sampledLight.localLight, object.sampledLight.sunlight);
-            push.sampledDynamicLightAndMode = glm::vec4(object.sampledLight.dynamicLight, static_cast<float>(object.lightingMode));
-            return push;
-        }
+        .size = sizeof(ObjectPushConstants)
     };
 
     _services.materialManager->build_graphics_pipeline(
@@ -391,10 +366,9 @@ void VoxelEditorScene::build_pipelines()
     _services.materialManager->build_present_pipeline(VoxelEditorMaterialScope);
 }
 
-void VoxelEditorScene::rebuild_pipelines()
+void VoxelEditorScene::resize_viewport()
 {
     _camera->resize(_services.current_window_extent());
-    build_pipelines();
 }
 
 SceneRenderState& VoxelEditorScene::get_render_state()
@@ -409,10 +383,7 @@ void VoxelEditorScene::update_uniform_buffers() const
     cameraUbo.view = _camera->_view;
     cameraUbo.viewproject = _camera->_projection * _camera->_view;
 
-    void* cameraData = nullptr;
-    vmaMapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation, &cameraData);
-    memcpy(cameraData, &cameraUbo, sizeof(CameraUBO));
-    vmaUnmapMemory(_services.allocator, _cameraUboResource->value.buffer._allocation);
+    _cameraUboResource->write_frame_uniform(_services.current_frame_slot(), &cameraUbo, sizeof(CameraUBO));
 
     LightingUBO lighting{};
     lighting.skyZenithColor = glm::vec4(0.30f, 0.43f, 0.60f, 1.0f);
@@ -428,10 +399,7 @@ void VoxelEditorScene::update_uniform_buffers() const
     lighting.params3 = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
     lighting.params4 = glm::vec4(0.0f);
 
-    void* lightingData = nullptr;
-    vmaMapMemory(_services.allocator, _lightingResource->value.buffer._allocation, &lightingData);
-    memcpy(lightingData, &lighting, sizeof(LightingUBO));
-    vmaUnmapMemory(_services.allocator, _lightingResource->value.buffer._allocation);
+    _lightingResource->write_frame_uniform(_services.current_frame_slot(), &lighting, sizeof(LightingUBO));
 
     FogUBO fog{};
     fog.fogColor = EditorFogColor;
@@ -442,10 +410,7 @@ void VoxelEditorScene::update_uniform_buffers() const
     fog.screenSize = glm::ivec2(extent.width, extent.height);
     fog.invViewProject = glm::inverse(_camera->_projection * _camera->_view);
 
-    void* fogData = nullptr;
-    vmaMapMemory(_services.allocator, _fogResource->value.buffer._allocation, &fogData);
-    memcpy(fogData, &fog, sizeof(FogUBO));
-    vmaUnmapMemory(_services.allocator, _fogResource->value.buffer._allocation);
+    _fogResource->write_frame_uniform(_services.current_frame_slot(), &fog, sizeof(FogUBO));
 }
 
 void VoxelEditorScene::sync_model_mesh()
@@ -466,7 +431,7 @@ void VoxelEditorScene::sync_model_mesh()
     release_preview_mesh();
 
     _previewMesh = VoxelMesher::generate_mesh(_model);
-    if (_previewMesh == nullptr || _previewMesh->_indices.empty())
+    if (_previewMesh == nullptr || _previewMesh->_vertices.empty())
     {
         return;
     }
@@ -552,18 +517,12 @@ void VoxelEditorScene::sync_hover_outline()
 
 void VoxelEditorScene::release_preview_mesh()
 {
-    if (_previewMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_previewMesh));
-    }
+    _previewMesh.reset();
 }
 
 void VoxelEditorScene::release_outline_mesh()
 {
-    if (_outlineMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_outlineMesh));
-    }
+    _outlineMesh.reset();
 }
 
 void VoxelEditorScene::sync_marker_overlays()
@@ -727,29 +686,10 @@ void VoxelEditorScene::sync_marker_overlays()
 
 void VoxelEditorScene::release_marker_meshes()
 {
-    if (_pivotMarkerMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_pivotMarkerMesh));
-    }
-    if (_modelBoundsMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_modelBoundsMesh));
-    }
-    if (_pivotVoxelMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_pivotVoxelMesh));
-    }
-    if (_selectedAttachmentVoxelMesh != nullptr)
-    {
-        render::enqueue_mesh_release(std::move(_selectedAttachmentVoxelMesh));
-    }
-    for (std::shared_ptr<Mesh>& mesh : _attachmentMarkerMeshes)
-    {
-        if (mesh != nullptr)
-        {
-            render::enqueue_mesh_release(std::move(mesh));
-        }
-    }
+    _pivotMarkerMesh.reset();
+    _modelBoundsMesh.reset();
+    _pivotVoxelMesh.reset();
+    _selectedAttachmentVoxelMesh.reset();
     _attachmentMarkerMeshes.clear();
 }
 
@@ -31,7 +31,7 @@ public:
     void clear_input() override;
     void draw_imgui() override;
     void build_pipelines() override;
-    void rebuild_pipelines() override;
+    void resize_viewport() override;
     SceneRenderState& get_render_state() override;
     [[nodiscard]] bool wants_mouse_capture() const override { return false; }
 
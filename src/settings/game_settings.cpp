@@ -54,6 +54,7 @@ namespace settings
         bool compare_persistence(const GameSettingsPersistence& lhs, const GameSettingsPersistence& rhs) noexcept
         {
             return lhs.world.viewDistance == rhs.world.viewDistance &&
+                lhs.world.horizonDistance == rhs.world.horizonDistance &&
                 lhs.world.ambientOcclusionEnabled == rhs.world.ambientOcclusionEnabled &&
                 lhs.debug.showChunkBoundaries == rhs.debug.showChunkBoundaries &&
                 lhs.dayNight.paused == rhs.dayNight.paused &&
@@ -144,6 +145,7 @@ namespace settings
     void SettingsManager::normalize(GameSettingsPersistence& persistence)
     {
         persistence.world.viewDistance = std::max(1, persistence.world.viewDistance);
+        persistence.world.horizonDistance = std::max(0, persistence.world.horizonDistance);
         persistence.dayNight.timeOfDay = std::clamp(persistence.dayNight.timeOfDay, 0.0f, 1.0f);
         persistence.dayNight.tuning.cycleDurationSeconds = std::max(1.0f, persistence.dayNight.tuning.cycleDurationSeconds);
         persistence.dayNight.tuning.fogDistanceRange = std::max(1.0f, persistence.dayNight.tuning.fogDistanceRange);
@@ -163,12 +165,16 @@ namespace settings
     ViewDistanceRuntimeSettings SettingsManager::make_view_distance_runtime(const GameSettingsPersistence& persistence) const noexcept
     {
         const int viewDistance = std::max(1, persistence.world.viewDistance);
+        const int horizonDistance = std::max(0, persistence.world.horizonDistance);
         return ViewDistanceRuntimeSettings{
             .viewDistance = viewDistance,
             .maximumResidentChunks = maximum_chunks_for_view_distance(viewDistance),
+            .horizonDistance = horizonDistance,
+            .maximumHorizonTiles = maximum_horizon_tiles(viewDistance, horizonDistance),
             .fogRadius = std::max(
                 0.0f,
-                (_chunkWorldWidth * static_cast<float>(viewDistance)) + persistence.dayNight.tuning.fogDistanceOffset)
+                (_chunkWorldWidth * static_cast<float>(viewDistance)) + persistence.dayNight.tuning.fogDistanceOffset),
+            .fogHorizonRange = _chunkWorldWidth * static_cast<float>(horizonDistance)
         };
     }
 
@@ -194,7 +200,8 @@ namespace settings
 
     void SettingsManager::dispatch_changes(const GameSettingsPersistence& previous, const GameSettingsPersistence& current)
     {
-        if (previous.world.viewDistance != current.world.viewDistance)
+        if (previous.world.viewDistance != current.world.viewDistance ||
+            previous.world.horizonDistance != current.world.horizonDistance)
         {
             const ViewDistanceRuntimeSettings runtime = make_view_distance_runtime(current);
             for (const ViewDistanceHandler& handler : _viewDistanceHandlers)
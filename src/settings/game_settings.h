@@ -53,6 +53,7 @@ namespace settings
     struct WorldSettingsPersistence
     {
         int viewDistance{GameConfig::DEFAULT_VIEW_DISTANCE};
+        int horizonDistance{GameConfig::DEFAULT_HORIZON_DISTANCE};
         bool ambientOcclusionEnabled{false};
     };
 
@@ -91,9 +92,13 @@ namespace settings
     {
         int viewDistance{GameConfig::DEFAULT_VIEW_DISTANCE};
         int maximumResidentChunks{maximum_chunks_for_view_distance(GameConfig::DEFAULT_VIEW_DISTANCE)};
+        int horizonDistance{GameConfig::DEFAULT_HORIZON_DISTANCE};
+        int maximumHorizonTiles{maximum_horizon_tiles(GameConfig::DEFAULT_VIEW_DISTANCE, GameConfig::DEFAULT_HORIZON_DISTANCE)};
         float fogRadius{
             (CHUNK_SIZE * static_cast<float>(GameConfig::DEFAULT_VIEW_DISTANCE)) - 60.0f
         };
+        // Added to the fog distance range so the fog only closes at the far edge of the horizon.
+        float fogHorizonRange{CHUNK_SIZE * static_cast<float>(GameConfig::DEFAULT_HORIZON_DISTANCE)};
     };
 
     struct AmbientOcclusionRuntimeSettings
@@ -0,0 +1,150 @@
+#include "mapped_file.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Zero-length files cannot be mapped; point empty mappings at a static byte instead.
+    constexpr std::byte EmptyFileByte{0};
+}
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+    MappedFile file{};
+
+#if defined(_WIN32)
+    const HANDLE fileHandle = CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return std::nullopt;
+    }
+    file._fileHandle = fileHandle;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(fileHandle, &size))
+    {
+        return std::nullopt;
+    }
+    file._size = static_cast<size_t>(size.QuadPart);
+    if (file._size == 0)
+    {
+        file._data = &EmptyFileByte;
+        return file;
+    }
+
+    file._mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file._mappingHandle == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    file._data = MapViewOfFile(file._mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (file._data == nullptr)
+    {
+        return std::nullopt;
+    }
+#else
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return std::nullopt;
+    }
+
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0)
+    {
+        ::close(descriptor);
+        return std::nullopt;
+    }
+
+    file._size = static_cast<size_t>(status.st_size);
+    if (file._size == 0)
+    {
+        ::close(descriptor);
+        file._data = &EmptyFileByte;
+        return file;
+    }
+
+    void* const mapped = mmap(nullptr, file._size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(descriptor);
+    if (mapped == MAP_FAILED)
+    {
+        file._size = 0;
+        return std::nullopt;
+    }
+    file._data = mapped;
+#endif
+
+    return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    _data(std::exchange(other._data, nullptr)),
+    _size(std::exchange(other._size, 0))
+#if defined(_WIN32)
+    , _fileHandle(std::exchange(other._fileHandle, nullptr))
+    , _mappingHandle(std::exchange(other._mappingHandle, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+#if defined(_WIN32)
+        _fileHandle = std::exchange(other._fileHandle, nullptr);
+        _mappingHandle = std::exchange(other._mappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+void MappedFile::release() noexcept
+{
+    const bool mapped = _data != nullptr && _data != &EmptyFileByte;
+#if defined(_WIN32)
+    if (mapped)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != nullptr)
+    {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle != nullptr)
+    {
+        CloseHandle(_fileHandle);
+    }
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+#else
+    if (mapped)
+    {
+        munmap(const_cast<void*>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+}
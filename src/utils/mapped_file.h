@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+// Read-only memory mapping of a whole file. Move-only; unmaps on destruction.
+class MappedFile
+{
+public:
+    [[nodiscard]] static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return { static_cast<const std::byte*>(_data), _size };
+    }
+
+private:
+    MappedFile() = default;
+    void release() noexcept;
+
+    const void* _data{nullptr};
+    size_t _size{0};
+#if defined(_WIN32)
+    void* _fileHandle{nullptr};
+    void* _mappingHandle{nullptr};
+#endif
+};
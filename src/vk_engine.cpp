@@ -13,6 +13,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include <game/cube_engine.h>
+#include <config/config_paths.h>
 
 #include "VkBootstrap.h"
 #include "vk_types.h"
@@ -76,14 +77,18 @@ void VulkanEngine::init()
 
 	_meshManager.init(_device, _allocator, { ._queue = _transferQueue, ._queueFamily = _transferQueueFamily });
 
+	const auto pipelineBuildStart = std::chrono::steady_clock::now();
 	_sceneRenderer.init(SceneServices{
 		.allocator = _allocator,
 		.device = _device,
 		.windowExtent = &_windowExtent,
 		.meshManager = &_meshManager,
 		.materialManager = &_materialManager,
-        .configService = &_configService
+        .configService = &_configService,
+        .frameNumber = &_frameNumber,
+        .frameTimings = &_frameClock.timings()
 	});
+	report_startup_pipeline_builds(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pipelineBuildStart).count());
 
 	_isInitialized = true;
 }
@@ -97,6 +102,7 @@ void VulkanEngine::cleanup()
 		_sceneRenderer.cleanup();
 		_meshManager.cleanup();
 		_materialManager.cleanup();
+		_pipelineCache.cleanup();
 
 		if (USE_IMGUI)
 		{
@@ -186,8 +192,12 @@ uint32_t VulkanEngine::advance_frame()
 {
 	{
 		ZoneScopedN("Wait for GPU");
+		const TimePoint waitStart = Clock::now();
 		VK_CHECK(vkWaitForFences(_device, 1, &get_current_frame()._renderFence, true, 1000000000));
 		VK_CHECK(vkResetFences(_device, 1, &get_current_frame()._renderFence));
+		const std::chrono::duration<float> waited = Clock::now() - waitStart;
+		_frameClock.report_fence_wait(waited.count());
+		TracyPlot("Frame Fence Wait ms", waited.count() * 1000.0f);
 	}
 
 	//request image from the swapchain, one second timeout
@@ -236,6 +246,7 @@ void VulkanEngine::draw()
 	ZoneScopedN("RenderFrame");
 
 	uint32_t swapchainImageIndex = advance_frame();
+	const TimePoint recordStart = Clock::now();
 	_meshManager.unload_garbage();
 	_meshManager.handle_transfers();
 	VkCommandBuffer cmd = begin_recording();
@@ -252,10 +263,16 @@ void VulkanEngine::draw()
 		.presentClearValueCount = static_cast<uint32_t>(_clearColorOnly.size()),
 		.fullscreenImage = _fullscreenImage,
 		.depthImage = _depthImage,
+		.quadIndexBuffer = _meshManager.quad_index_buffer(),
+		.frameSlot = static_cast<uint32_t>(_frameNumber % FRAME_OVERLAP),
+		.multiDrawIndirect = _supportsMultiDrawIndirect,
 		.materialManager = &_materialManager
 	});
 
 	VK_CHECK(vkEndCommandBuffer(cmd));
+	const std::chrono::duration<float> recorded = Clock::now() - recordStart;
+	_frameClock.report_record(recorded.count());
+	TracyPlot("Frame Record ms", recorded.count() * 1000.0f);
 	submit_queue_present(cmd, swapchainImageIndex);
 	//increase the number of frames drawn
 	_frameNumber++;
@@ -335,6 +352,11 @@ void VulkanEngine::run()
 
 			draw();
 			FrameMark;
+
+			if (_frameLimit > 0 && _frameNumber >= _frameLimit)
+			{
+				bQuit = true;
+			}
 		}
 		catch (const std::exception& ex)
 		{
@@ -387,6 +409,13 @@ void VulkanEngine::init_vulkan()
 		.select();
 	vkb::PhysicalDevice physicalDevice = take_vkb_result(std::move(physicalDeviceResult), "Physical device selection");
 
+	// Batched chunk drawing needs several commands per indirect call and a per-command firstInstance.
+	_supportsMultiDrawIndirect = physicalDevice.enable_features_if_present(VkPhysicalDeviceFeatures{
+		.multiDrawIndirect = VK_TRUE,
+		.drawIndirectFirstInstance = VK_TRUE
+	});
+	std::println("Multi-draw indirect supported? {}", _supportsMultiDrawIndirect);
+
 
 	std::println("Has dedicated transfer queue? {}", physicalDevice.has_dedicated_transfer_queue());
 
@@ -439,6 +468,7 @@ void VulkanEngine::init_vulkan()
 
 	_descriptorAllocator.init(_device);
 	_descriptorLayoutCache.init(_device);
+	_pipelineCache.init(_device, _gpuProperties, config::ConfigPaths::pipeline_cache());
 	_materialManager.init(MaterialBackendContext{
 		.device = _device,
 		.windowExtent = &_windowExtent,
@@ -448,7 +478,8 @@ void VulkanEngine::init_vulkan()
 		.fullscreenImage = &_fullscreenImage,
 		.depthImage = &_depthImage,
 		.descriptorAllocator = &_descriptorAllocator,
-		.descriptorLayoutCache = &_descriptorLayoutCache
+		.descriptorLayoutCache = &_descriptorLayoutCache,
+		.pipelineCache = _pipelineCache.handle()
 	});
 }
 
@@ -637,18 +668,20 @@ void VulkanEngine::init_offscreen_renderpass()
 	subpass.pColorAttachments = &color_attachment_ref;
 	subpass.pDepthStencilAttachment = &depth_attachment_ref;
 
+	// With several frames in flight the previous frame's fog compute and present pass may still be
+	// using these images, so the next offscreen pass waits for them as well as for attachment writes.
 	VkSubpassDependency dependency = {};
 	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
 	dependency.dstSubpass = 0;
-	dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependency.srcAccessMask = 0;
+	dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	dependency.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
 	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
 	VkSubpassDependency depth_dependency = {};
 	depth_dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
 	depth_dependency.dstSubpass = 0;
-	depth_dependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	depth_dependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 	depth_dependency.srcAccessMask = 0;
 	depth_dependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 	depth_dependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
@@ -893,7 +926,7 @@ void VulkanEngine::init_imgui()
 	init_info.QueueFamily = _graphicsQueueFamily;
 	init_info.Queue = _graphicsQueue;
 	init_info.DescriptorPool = _descriptorAllocator.grab_pool();
-	init_info.PipelineCache = VK_NULL_HANDLE;
+	init_info.PipelineCache = _pipelineCache.handle();
 	init_info.RenderPass = _renderPass;
 	init_info.ApiVersion = VK_API_VERSION_1_1;
 	init_info.MinImageCount = _swapchainImages.size();
@@ -953,12 +986,28 @@ void VulkanEngine::resize_swapchain()
 	init_framebuffers();
 	init_offscreen_framebuffers();
 
-	_sceneRenderer.get_current_scene()->rebuild_pipelines();
+	_sceneRenderer.handle_swapchain_resized();
 
 	bResizeRequest = false;
 }
 
 
+void VulkanEngine::report_startup_pipeline_builds(const double sceneInitMs)
+{
+	const render::PipelineCacheStats& cacheStats = _pipelineCache.stats();
+	const PipelineBuildStats buildStats = _materialManager.pipeline_build_stats();
+	std::println("Pipeline cache {} ({}, {} bytes loaded): {} pipelines compiled in {:.1f} ms, scene init {:.1f} ms",
+		_pipelineCache.warm() ? "warm" : "cold",
+		render::pipeline_cache_blob_status_name(cacheStats.loadStatus),
+		cacheStats.loadedBytes,
+		buildStats.pipelines,
+		buildStats.compileMs,
+		sceneInitMs);
+
+	// Persist now so a crash later in the session still leaves the next launch warm.
+	_pipelineCache.save();
+}
+
 FrameData &VulkanEngine::get_current_frame()
 {
 	return _frames[_frameNumber % FRAME_OVERLAP];
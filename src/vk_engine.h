@@ -9,6 +9,7 @@
 #include <render/mesh_manager.h>
 #include <render/material_manager.h>
 #include <render/scene_renderer.h>
+#include <render/pipeline_cache.h>
 #include <window_system.h>
 #include <frame_clock.h>
 #include <config/config_service.h>
@@ -45,6 +46,8 @@ public:
 	int _frameNumber {0};
 
 	bool bQuit = false;
+	// When positive the main loop quits after this many frames (game --frames <count>).
+	int _frameLimit{0};
 	bool bUseValidationLayers = USE_VALIDATION_LAYERS;
 	bool bResizeRequest = false;
 	
@@ -54,6 +57,7 @@ public:
 	VkDevice _device;
 	VkSurfaceKHR _surface;
 	VkPhysicalDeviceProperties _gpuProperties;
+	bool _supportsMultiDrawIndirect{false};
 
 	VkSwapchainKHR _swapchain;
 	VkFormat _swapchainImageFormat;
@@ -69,6 +73,7 @@ public:
 
 	MeshManager _meshManager;
 	MaterialManager _materialManager;
+	render::PipelineCache _pipelineCache;
     config::ConfigService _configService;
 
 	VkRenderPass _renderPass;
@@ -144,6 +149,7 @@ private:
 	void init_imgui();
 
 	void resize_swapchain();
+	void report_startup_pipeline_builds(double sceneInitMs);
 	void destroy_image_render_finished_semaphores();
 	void destroy_swapchain_resources();
 	void destroy_swapchain();
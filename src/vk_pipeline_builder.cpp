@@ -1,6 +1,6 @@
 #include "vk_pipeline_builder.h"
 
-VkPipeline PipelineBuilder::build_pipeline(VkDevice device, VkRenderPass pass)
+VkPipeline PipelineBuilder::build_pipeline(VkDevice device, VkRenderPass pass, VkPipelineCache cache)
 {
 	//make viewport state from our stored viewport and scissor.
 	//at the moment we won't support multiple viewports or scissors
@@ -52,7 +52,7 @@ VkPipeline PipelineBuilder::build_pipeline(VkDevice device, VkRenderPass pass)
 	VkPipeline newPipeline;
 
 	const VkResult result = vkCreateGraphicsPipelines(
-		device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &newPipeline);
+		device, cache, 1, &pipelineInfo, nullptr, &newPipeline);
 	if (result != VK_SUCCESS) {
 		throw std::runtime_error(std::format(
 			"Failed to create graphics pipeline. VkResult={}, topology={}, stageCount={}",
@@ -15,5 +15,5 @@ public:
 	VkPipelineMultisampleStateCreateInfo _multisampling;
 	VkPipelineLayout _pipelineLayout;
 
-	VkPipeline build_pipeline(VkDevice device, VkRenderPass pass);
+	VkPipeline build_pipeline(VkDevice device, VkRenderPass pass, VkPipelineCache cache = VK_NULL_HANDLE);
 };
\ No newline at end of file
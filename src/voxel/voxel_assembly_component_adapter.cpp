@@ -67,7 +67,8 @@ namespace
 VoxelAssemblyLocalBundle build_voxel_assembly_local_bundle(
     const VoxelAssemblyComponent& component,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager)
+    VoxelAssetManager& assetManager,
+    const VoxelAssetLoadMode loadMode)
 {
     VoxelAssemblyLocalBundle bundle{};
     if (!component.visible || component.assetId.empty())
@@ -118,7 +119,14 @@ VoxelAssemblyLocalBundle build_voxel_assembly_local_bundle(
         const std::string modelAssetId = resolve_model_asset_id(part, component);
         if (!modelAssetId.empty())
         {
-            localInstance.asset = assetManager.load_or_get(modelAssetId);
+            localInstance.asset = assetManager.acquire(modelAssetId, loadMode);
+        }
+
+        if (localInstance.asset == nullptr && assetManager.is_loading(modelAssetId))
+        {
+            ++bundle.pendingAssetCount;
+            visiting.erase(part.partId);
+            return false;
         }
 
         if (localInstance.asset == nullptr)
@@ -205,6 +213,12 @@ VoxelAssemblyLocalBundle build_voxel_assembly_local_bundle(
         });
     }
 
+    // Render the assembly as a whole once every part model is resident, never half-built.
+    if (bundle.is_pending())
+    {
+        return bundle;
+    }
+
     const glm::vec3 placementAnchor = resolve_voxel_assembly_placement_anchor(
         resolvedInstances,
         assembly->rootPartId,
@@ -235,14 +249,16 @@ VoxelAssemblyLocalBundle build_voxel_assembly_local_bundle(
 VoxelAssemblyRenderBundle build_voxel_assembly_render_bundle(
     const VoxelAssemblyComponent& component,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager)
+    VoxelAssetManager& assetManager,
+    const VoxelAssetLoadMode loadMode)
 {
     const VoxelAssemblyLocalBundle localBundle =
-        build_voxel_assembly_local_bundle(component, assemblyAssetManager, assetManager);
+        build_voxel_assembly_local_bundle(component, assemblyAssetManager, assetManager, loadMode);
 
     VoxelAssemblyRenderBundle bundle{};
     bundle.assemblyAssetId = localBundle.assemblyAssetId;
     bundle.diagnostic = localBundle.diagnostic;
+    bundle.pendingAssetCount = localBundle.pendingAssetCount;
     bundle.parts.reserve(localBundle.parts.size());
     for (const VoxelAssemblyResolvedPart& localPart : localBundle.parts)
     {
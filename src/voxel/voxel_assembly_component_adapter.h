@@ -19,11 +19,18 @@ struct VoxelAssemblyLocalBundle
     std::string assemblyAssetId{};
     std::vector<VoxelAssemblyResolvedPart> parts{};
     std::string diagnostic{};
+    // Part models still loading in the background; parts stay empty until this reaches zero.
+    size_t pendingAssetCount{0};
 
     [[nodiscard]] bool has_error() const noexcept
     {
         return !diagnostic.empty();
     }
+
+    [[nodiscard]] bool is_pending() const noexcept
+    {
+        return pendingAssetCount > 0;
+    }
 };
 
 struct VoxelAssemblyRenderBundle
@@ -31,19 +38,28 @@ struct VoxelAssemblyRenderBundle
     std::string assemblyAssetId{};
     std::vector<VoxelAssemblyResolvedPart> parts{};
     std::string diagnostic{};
+    // Part models still loading in the background; parts stay empty until this reaches zero.
+    size_t pendingAssetCount{0};
 
     [[nodiscard]] bool has_error() const noexcept
     {
         return !diagnostic.empty();
     }
+
+    [[nodiscard]] bool is_pending() const noexcept
+    {
+        return pendingAssetCount > 0;
+    }
 };
 
 [[nodiscard]] VoxelAssemblyLocalBundle build_voxel_assembly_local_bundle(
     const VoxelAssemblyComponent& component,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager);
+    VoxelAssetManager& assetManager,
+    VoxelAssetLoadMode loadMode = VoxelAssetLoadMode::Blocking);
 
 [[nodiscard]] VoxelAssemblyRenderBundle build_voxel_assembly_render_bundle(
     const VoxelAssemblyComponent& component,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager);
+    VoxelAssetManager& assetManager,
+    VoxelAssetLoadMode loadMode = VoxelAssetLoadMode::Blocking);
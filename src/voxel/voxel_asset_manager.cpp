@@ -2,6 +2,8 @@
 
 #include <cctype>
 
+#include <tracy/Tracy.hpp>
+
 #include "voxel_mesher.h"
 
 namespace
@@ -32,6 +34,26 @@ namespace
     }
 }
 
+VoxelAssetLoadStatus VoxelAssetHandle::status() const noexcept
+{
+    return _request != nullptr
+        ? _request->status.load(std::memory_order::acquire)
+        : VoxelAssetLoadStatus::Failed;
+}
+
+std::shared_ptr<VoxelRuntimeAsset> VoxelAssetHandle::asset() const noexcept
+{
+    return ready() ? _request->asset : nullptr;
+}
+
+void VoxelAssetHandle::wait() const noexcept
+{
+    if (_request != nullptr)
+    {
+        _request->status.wait(VoxelAssetLoadStatus::Loading, std::memory_order::acquire);
+    }
+}
+
 VoxelAssetManager::VoxelAssetManager(const VoxelModelRepository& repository) :
     _repository(repository)
 {
@@ -45,6 +67,14 @@ std::shared_ptr<VoxelRuntimeAsset> VoxelAssetManager::load_or_get(const std::str
         return it->second;
     }
 
+    if (const auto pendingIt = _pendingRequests.find(normalizedId); pendingIt != _pendingRequests.end())
+    {
+        VoxelAssetHandle(pendingIt->second).wait();
+        adopt_request(normalizedId);
+        const auto loadedIt = _loadedAssets.find(normalizedId);
+        return loadedIt != _loadedAssets.end() ? loadedIt->second : nullptr;
+    }
+
     const std::optional<VoxelModel> loaded = _repository.load(normalizedId);
     if (!loaded.has_value())
     {
@@ -53,9 +83,79 @@ std::shared_ptr<VoxelRuntimeAsset> VoxelAssetManager::load_or_get(const std::str
 
     std::shared_ptr<VoxelRuntimeAsset> runtimeAsset = build_runtime_asset(loaded.value());
     _loadedAssets.insert_or_assign(normalizedId, runtimeAsset);
+    _failedAssetIds.erase(normalizedId);
     return runtimeAsset;
 }
 
+VoxelAssetHandle VoxelAssetManager::request(const std::string_view assetId)
+{
+    const std::string normalizedId = normalize_asset_id(assetId);
+    if (const auto it = _loadedAssets.find(normalizedId); it != _loadedAssets.end())
+    {
+        auto request = std::make_shared<Request>();
+        request->asset = it->second;
+        request->status.store(VoxelAssetLoadStatus::Ready, std::memory_order::release);
+        return VoxelAssetHandle(std::move(request));
+    }
+
+    if (const auto pendingIt = _pendingRequests.find(normalizedId); pendingIt != _pendingRequests.end())
+    {
+        VoxelAssetHandle handle(pendingIt->second);
+        adopt_request(normalizedId);
+        return handle;
+    }
+
+    auto request = std::make_shared<Request>();
+    if (_failedAssetIds.contains(normalizedId))
+    {
+        request->status.store(VoxelAssetLoadStatus::Failed, std::memory_order::release);
+        return VoxelAssetHandle(std::move(request));
+    }
+
+    _pendingRequests.insert_or_assign(normalizedId, request);
+    _loadThreadPool.post([this, request, normalizedId]()
+    {
+        ZoneScopedN("VoxelAssetManager::LoadAsync");
+        std::optional<VoxelModel> loaded{};
+        try
+        {
+            loaded = _repository.load(normalizedId);
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (loaded.has_value())
+        {
+            request->asset = build_runtime_asset(loaded.value());
+        }
+
+        request->status.store(
+            request->asset != nullptr ? VoxelAssetLoadStatus::Ready : VoxelAssetLoadStatus::Failed,
+            std::memory_order::release);
+        request->status.notify_all();
+    });
+
+    return VoxelAssetHandle(std::move(request));
+}
+
+std::shared_ptr<VoxelRuntimeAsset> VoxelAssetManager::acquire(const std::string_view assetId, const VoxelAssetLoadMode mode)
+{
+    if (mode == VoxelAssetLoadMode::Blocking)
+    {
+        return load_or_get(assetId);
+    }
+
+    return request(assetId).asset();
+}
+
+bool VoxelAssetManager::is_loading(const std::string_view assetId) const
+{
+    const auto it = _pendingRequests.find(normalize_asset_id(assetId));
+    return it != _pendingRequests.end() &&
+        it->second->status.load(std::memory_order::acquire) == VoxelAssetLoadStatus::Loading;
+}
+
 std::shared_ptr<const VoxelRuntimeAsset> VoxelAssetManager::find_loaded(const std::string_view assetId) const
 {
     const std::string normalizedId = normalize_asset_id(assetId);
@@ -64,6 +164,11 @@ std::shared_ptr<const VoxelRuntimeAsset> VoxelAssetManager::find_loaded(const st
         return it->second;
     }
 
+    if (const auto pendingIt = _pendingRequests.find(normalizedId); pendingIt != _pendingRequests.end())
+    {
+        return VoxelAssetHandle(pendingIt->second).asset();
+    }
+
     return nullptr;
 }
 
@@ -72,9 +177,41 @@ size_t VoxelAssetManager::loaded_asset_count() const noexcept
     return _loadedAssets.size();
 }
 
+size_t VoxelAssetManager::pending_request_count() const noexcept
+{
+    return _pendingRequests.size();
+}
+
 void VoxelAssetManager::clear()
 {
+    // In-flight jobs keep their request alive and simply finish into a handle nobody adopts.
     _loadedAssets.clear();
+    _pendingRequests.clear();
+    _failedAssetIds.clear();
+}
+
+bool VoxelAssetManager::adopt_request(const std::string& normalizedId)
+{
+    const auto it = _pendingRequests.find(normalizedId);
+    if (it == _pendingRequests.end())
+    {
+        return false;
+    }
+
+    switch (it->second->status.load(std::memory_order::acquire))
+    {
+    case VoxelAssetLoadStatus::Loading:
+        return false;
+    case VoxelAssetLoadStatus::Ready:
+        _loadedAssets.insert_or_assign(normalizedId, it->second->asset);
+        break;
+    case VoxelAssetLoadStatus::Failed:
+        _failedAssetIds.insert(normalizedId);
+        break;
+    }
+
+    _pendingRequests.erase(it);
+    return true;
 }
 
 std::string VoxelAssetManager::normalize_asset_id(const std::string_view assetId)
@@ -82,7 +219,7 @@ std::string VoxelAssetManager::normalize_asset_id(const std::string_view assetId
     return sanitize_asset_id(assetId);
 }
 
-std::shared_ptr<VoxelRuntimeAsset> VoxelAssetManager::build_runtime_asset(const VoxelModel& model) const
+std::shared_ptr<VoxelRuntimeAsset> VoxelAssetManager::build_runtime_asset(const VoxelModel& model)
 {
     auto runtimeAsset = std::make_shared<VoxelRuntimeAsset>();
     runtimeAsset->assetId = normalize_asset_id(model.assetId);
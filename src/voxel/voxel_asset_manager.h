@@ -1,13 +1,59 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "voxel_model_repository.h"
 #include "voxel_runtime_asset.h"
+#include "world/thread_pool.h"
+
+enum class VoxelAssetLoadMode : uint8_t
+{
+    // Load and mesh on the calling thread when the asset is not resident yet.
+    Blocking = 0,
+    // Queue load + mesh on the asset worker and return nothing until the asset is ready.
+    Async = 1
+};
+
+enum class VoxelAssetLoadStatus : uint8_t
+{
+    Loading = 0,
+    Ready = 1,
+    Failed = 2
+};
+
+class VoxelAssetHandle
+{
+public:
+    VoxelAssetHandle() = default;
+
+    [[nodiscard]] bool valid() const noexcept { return _request != nullptr; }
+    [[nodiscard]] VoxelAssetLoadStatus status() const noexcept;
+    [[nodiscard]] bool ready() const noexcept { return status() == VoxelAssetLoadStatus::Ready; }
+    [[nodiscard]] bool loading() const noexcept { return valid() && status() == VoxelAssetLoadStatus::Loading; }
+    // Null until ready.
+    [[nodiscard]] std::shared_ptr<VoxelRuntimeAsset> asset() const noexcept;
+    void wait() const noexcept;
+
+private:
+    friend class VoxelAssetManager;
+
+    struct Request
+    {
+        std::atomic<VoxelAssetLoadStatus> status{VoxelAssetLoadStatus::Loading};
+        // Written by the worker before status is released as Ready.
+        std::shared_ptr<VoxelRuntimeAsset> asset{};
+    };
+
+    explicit VoxelAssetHandle(std::shared_ptr<Request> request) : _request(std::move(request)) {}
+
+    std::shared_ptr<Request> _request{};
+};
 
 class VoxelAssetManager
 {
@@ -15,14 +61,28 @@ public:
     explicit VoxelAssetManager(const VoxelModelRepository& repository);
 
     [[nodiscard]] std::shared_ptr<VoxelRuntimeAsset> load_or_get(std::string_view assetId);
+    // Starts (or joins) a background load; concurrent requests for one asset share a single job.
+    [[nodiscard]] VoxelAssetHandle request(std::string_view assetId);
+    [[nodiscard]] std::shared_ptr<VoxelRuntimeAsset> acquire(std::string_view assetId, VoxelAssetLoadMode mode);
+    [[nodiscard]] bool is_loading(std::string_view assetId) const;
     [[nodiscard]] std::shared_ptr<const VoxelRuntimeAsset> find_loaded(std::string_view assetId) const;
     [[nodiscard]] size_t loaded_asset_count() const noexcept;
+    [[nodiscard]] size_t pending_request_count() const noexcept;
     void clear();
 
 private:
+    using Request = VoxelAssetHandle::Request;
+
     [[nodiscard]] static std::string normalize_asset_id(std::string_view assetId);
-    [[nodiscard]] std::shared_ptr<VoxelRuntimeAsset> build_runtime_asset(const VoxelModel& model) const;
+    [[nodiscard]] static std::shared_ptr<VoxelRuntimeAsset> build_runtime_asset(const VoxelModel& model);
+    // Moves a finished request into the resident set; returns false while it is still loading.
+    bool adopt_request(const std::string& normalizedId);
 
     const VoxelModelRepository& _repository;
     std::unordered_map<std::string, std::shared_ptr<VoxelRuntimeAsset>> _loadedAssets{};
+    std::unordered_map<std::string, std::shared_ptr<Request>> _pendingRequests{};
+    // Async lookups of missing assets are not retried every frame; clear() forgets them.
+    std::unordered_set<std::string> _failedAssetIds{};
+    // Declared last so queued jobs finish before the maps above are torn down.
+    ThreadPool _loadThreadPool{1};
 };
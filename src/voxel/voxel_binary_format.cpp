@@ -0,0 +1,302 @@
+#include "voxel_binary_format.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <tracy/Tracy.hpp>
+
+#include "utils/mapped_file.h"
+
+static_assert(std::endian::native == std::endian::little, "voxel binary assets are little-endian");
+
+namespace
+{
+    using namespace voxel::binary;
+
+    constexpr size_t BrickAlignment = 8;
+    constexpr size_t BrickRecordSize = (sizeof(int32_t) * 3) + sizeof(uint32_t) + (sizeof(uint64_t) * VoxelBrick::CellCount / VoxelBrick::WordBits);
+
+    class Writer
+    {
+    public:
+        template <typename T>
+        void write(const T& value)
+        {
+            write_bytes(&value, sizeof(T));
+        }
+
+        void write_bytes(const void* data, const size_t size)
+        {
+            const auto* bytes = static_cast<const std::byte*>(data);
+            _bytes.insert(_bytes.end(), bytes, bytes + size);
+        }
+
+        void write_string(const std::string& value)
+        {
+            write(static_cast<uint32_t>(value.size()));
+            write_bytes(value.data(), value.size());
+        }
+
+        void write_vec3(const glm::vec3& value)
+        {
+            write(value.x);
+            write(value.y);
+            write(value.z);
+        }
+
+        void align(const size_t alignment)
+        {
+            _bytes.resize((_bytes.size() + alignment - 1) / alignment * alignment, std::byte{0});
+        }
+
+        [[nodiscard]] std::vector<std::byte> take() { return std::move(_bytes); }
+
+    private:
+        std::vector<std::byte> _bytes{};
+    };
+
+    class Reader
+    {
+    public:
+        explicit Reader(const std::span<const std::byte> bytes) : _bytes(bytes) {}
+
+        template <typename T>
+        [[nodiscard]] T read()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+            return value;
+        }
+
+        [[nodiscard]] std::span<const std::byte> take(const size_t size)
+        {
+            if (size > _bytes.size() - _offset)
+            {
+                throw std::runtime_error("voxel::binary::decode: truncated asset");
+            }
+
+            const std::span<const std::byte> result = _bytes.subspan(_offset, size);
+            _offset += size;
+            return result;
+        }
+
+        [[nodiscard]] std::string read_string()
+        {
+            const auto size = read<uint32_t>();
+            const std::span<const std::byte> bytes = take(size);
+            return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+        }
+
+        [[nodiscard]] glm::vec3 read_vec3()
+        {
+            const auto x = read<float>();
+            const auto y = read<float>();
+            const auto z = read<float>();
+            return { x, y, z };
+        }
+
+        void seek(const size_t offset)
+        {
+            if (offset > _bytes.size())
+            {
+                throw std::runtime_error("voxel::binary::decode: truncated asset");
+            }
+            _offset = offset;
+        }
+
+        void align(const size_t alignment)
+        {
+            seek((_offset + alignment - 1) / alignment * alignment);
+        }
+
+    private:
+        std::span<const std::byte> _bytes;
+        size_t _offset{0};
+    };
+}
+
+namespace voxel::binary
+{
+    std::vector<std::byte> encode(const VoxelModel& model)
+    {
+        ZoneScopedN("VoxelBinary::Encode");
+
+        // Sort bricks so identical models always produce identical files.
+        std::vector<const VoxelModel::Storage::value_type*> bricks{};
+        bricks.reserve(model.bricks().size());
+        for (const auto& entry : model.bricks())
+        {
+            bricks.push_back(&entry);
+        }
+        std::ranges::sort(bricks, {}, [](const auto* entry) { return entry->first; });
+
+        const VoxelBounds bounds = model.bounds();
+        Header header{};
+        header.voxelSize = model.voxelSize;
+        header.pivot[0] = model.pivot.x;
+        header.pivot[1] = model.pivot.y;
+        header.pivot[2] = model.pivot.z;
+        header.boundsMin[0] = bounds.min.x;
+        header.boundsMin[1] = bounds.min.y;
+        header.boundsMin[2] = bounds.min.z;
+        header.boundsMax[0] = bounds.max.x;
+        header.boundsMax[1] = bounds.max.y;
+        header.boundsMax[2] = bounds.max.z;
+        header.voxelCount = static_cast<uint32_t>(model.voxel_count());
+        header.brickCount = static_cast<uint32_t>(bricks.size());
+        header.attachmentCount = static_cast<uint32_t>(model.attachments.size());
+
+        Writer writer{};
+        writer.write(header);
+        writer.write_string(model.assetId);
+        writer.write_string(model.displayName);
+        for (const VoxelAttachment& attachment : model.attachments)
+        {
+            writer.write_string(attachment.name);
+            writer.write_vec3(attachment.position);
+            writer.write_vec3(attachment.forward);
+            writer.write_vec3(attachment.up);
+        }
+
+        writer.align(BrickAlignment);
+        for (const auto* entry : bricks)
+        {
+            const auto& [coord, brick] = *entry;
+            writer.write(static_cast<int32_t>(coord.x));
+            writer.write(static_cast<int32_t>(coord.y));
+            writer.write(static_cast<int32_t>(coord.z));
+            writer.write(static_cast<uint32_t>(brick.count));
+            writer.write_bytes(brick.occupancy.data(), sizeof(brick.occupancy));
+            for (int cell = brick.next_occupied(0); cell < VoxelBrick::CellCount; cell = brick.next_occupied(cell + 1))
+            {
+                writer.write(brick.colors[cell]);
+            }
+            writer.align(BrickAlignment);
+        }
+
+        return writer.take();
+    }
+
+    Header decode_header(const std::span<const std::byte> bytes)
+    {
+        Reader reader(bytes);
+        const auto header = reader.read<Header>();
+        if (header.magic != Magic)
+        {
+            throw std::runtime_error("voxel::binary::decode: not a voxel binary asset");
+        }
+        if (header.version != FormatVersion)
+        {
+            throw std::runtime_error(std::format("voxel::binary::decode: unsupported version {}", header.version));
+        }
+        if (header.headerSize < sizeof(Header))
+        {
+            throw std::runtime_error("voxel::binary::decode: invalid header size");
+        }
+
+        return header;
+    }
+
+    VoxelModel decode(const std::span<const std::byte> bytes)
+    {
+        ZoneScopedN("VoxelBinary::Decode");
+
+        const Header header = decode_header(bytes);
+        Reader reader(bytes);
+        reader.seek(header.headerSize);
+
+        VoxelModel model{};
+        model.voxelSize = header.voxelSize;
+        model.pivot = glm::vec3(header.pivot[0], header.pivot[1], header.pivot[2]);
+        model.assetId = reader.read_string();
+        model.displayName = reader.read_string();
+
+        model.attachments.reserve(header.attachmentCount);
+        for (uint32_t index = 0; index < header.attachmentCount; ++index)
+        {
+            VoxelAttachment attachment{};
+            attachment.name = reader.read_string();
+            attachment.position = reader.read_vec3();
+            attachment.forward = reader.read_vec3();
+            attachment.up = reader.read_vec3();
+            model.attachments.push_back(std::move(attachment));
+        }
+
+        reader.align(BrickAlignment);
+        for (uint32_t index = 0; index < header.brickCount; ++index)
+        {
+            const std::span<const std::byte> record = reader.take(BrickRecordSize);
+            int32_t coord[3];
+            uint32_t colorCount = 0;
+            std::memcpy(coord, record.data(), sizeof(coord));
+            std::memcpy(&colorCount, record.data() + sizeof(coord), sizeof(colorCount));
+
+            VoxelBrick brick{};
+            std::memcpy(brick.occupancy.data(), record.data() + sizeof(coord) + sizeof(colorCount), sizeof(brick.occupancy));
+
+            int occupied = 0;
+            for (const uint64_t word : brick.occupancy)
+            {
+                occupied += std::popcount(word);
+            }
+            if (static_cast<uint32_t>(occupied) != colorCount)
+            {
+                throw std::runtime_error("voxel::binary::decode: brick color count does not match occupancy");
+            }
+
+            // Colors are read straight out of the source bytes into their dense cells.
+            const std::span<const std::byte> colors = reader.take(colorCount * sizeof(VoxelColor));
+            size_t colorOffset = 0;
+            for (int cell = brick.next_occupied(0); cell < VoxelBrick::CellCount; cell = brick.next_occupied(cell + 1))
+            {
+                std::memcpy(&brick.colors[cell], colors.data() + colorOffset, sizeof(VoxelColor));
+                colorOffset += sizeof(VoxelColor);
+            }
+            brick.count = static_cast<uint16_t>(colorCount);
+            reader.align(BrickAlignment);
+
+            model.set_brick(VoxelCoord{ .x = coord[0], .y = coord[1], .z = coord[2] }, brick);
+        }
+
+        if (model.voxel_count() != header.voxelCount)
+        {
+            throw std::runtime_error("voxel::binary::decode: voxel count does not match header");
+        }
+
+        return model;
+    }
+
+    std::optional<VoxelModel> load_file(const std::filesystem::path& path)
+    {
+        ZoneScopedN("VoxelBinary::LoadFile");
+        const std::optional<MappedFile> file = MappedFile::open(path);
+        if (!file.has_value())
+        {
+            return std::nullopt;
+        }
+
+        return decode(file->bytes());
+    }
+
+    void save_file(const std::filesystem::path& path, const VoxelModel& model)
+    {
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        const std::vector<std::byte> bytes = encode(model);
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            throw std::runtime_error(std::format("voxel::binary::save_file: failed to open {}", path.string()));
+        }
+
+        output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "voxel_model.h"
+
+// Compact runtime encoding of VoxelModel (".vxm"). JSON (".vxm.json") stays the authoring format.
+//
+// Layout, little-endian:
+//   Header       magic "VXMB", version, header size, voxel size, pivot, bounds, voxel/brick/attachment counts
+//   Strings      assetId, displayName (u32 length + UTF-8 bytes)
+//   Attachments  name, position, forward, up
+//   Bricks       8-byte aligned; per brick: coord, color count, 512-bit occupancy, RGBA per occupied cell
+//                in ascending cell order
+namespace voxel::binary
+{
+    inline constexpr std::array<char, 4> Magic{ 'V', 'X', 'M', 'B' };
+    inline constexpr uint16_t FormatVersion = 1;
+
+    struct Header
+    {
+        std::array<char, 4> magic{Magic};
+        uint16_t version{FormatVersion};
+        uint16_t headerSize{sizeof(Header)};
+        float voxelSize{0.0f};
+        float pivot[3]{};
+        int32_t boundsMin[3]{};
+        int32_t boundsMax[3]{};
+        uint32_t voxelCount{0};
+        uint32_t brickCount{0};
+        uint32_t attachmentCount{0};
+        uint32_t reserved{0};
+    };
+    static_assert(sizeof(Header) == 64);
+
+    [[nodiscard]] std::vector<std::byte> encode(const VoxelModel& model);
+    // Throws std::runtime_error on a bad magic, unsupported version or truncated payload.
+    [[nodiscard]] VoxelModel decode(std::span<const std::byte> bytes);
+    // Reads only the fixed header, e.g. to inspect bounds without decoding voxels.
+    [[nodiscard]] Header decode_header(std::span<const std::byte> bytes);
+
+    [[nodiscard]] std::optional<VoxelModel> load_file(const std::filesystem::path& path);
+    void save_file(const std::filesystem::path& path, const VoxelModel& model);
+}
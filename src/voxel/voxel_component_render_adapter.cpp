@@ -8,7 +8,8 @@
 VoxelComponentRenderBundle build_voxel_component_render_bundle(
     const GameObject& object,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager)
+    VoxelAssetManager& assetManager,
+    const VoxelAssetLoadMode loadMode)
 {
     VoxelComponentRenderBundle bundle{};
 
@@ -18,9 +19,10 @@ VoxelComponentRenderBundle build_voxel_component_render_bundle(
         if (!component.assetId.empty())
         {
             const VoxelAssemblyRenderBundle assemblyBundle =
-                build_voxel_assembly_render_bundle(component, assemblyAssetManager, assetManager);
+                build_voxel_assembly_render_bundle(component, assemblyAssetManager, assetManager, loadMode);
             bundle.assetId = assemblyBundle.assemblyAssetId;
             bundle.diagnostic = assemblyBundle.diagnostic;
+            bundle.pendingAssetCount = assemblyBundle.pendingAssetCount;
             bundle.entries.reserve(assemblyBundle.parts.size());
             for (const VoxelAssemblyResolvedPart& part : assemblyBundle.parts)
             {
@@ -38,7 +40,7 @@ VoxelComponentRenderBundle build_voxel_component_render_bundle(
         const VoxelModelComponent& component = object.Get<VoxelModelComponent>();
         bundle.assetId = component.assetId;
         if (const std::optional<VoxelRenderInstance> renderInstance =
-            build_voxel_render_instance(component, assetManager);
+            build_voxel_render_instance(component, assetManager, loadMode);
             renderInstance.has_value())
         {
             bundle.entries.push_back(VoxelComponentRenderEntry{
@@ -46,6 +48,10 @@ VoxelComponentRenderBundle build_voxel_component_render_bundle(
                 .renderInstance = renderInstance.value()
             });
         }
+        else if (assetManager.is_loading(component.assetId))
+        {
+            bundle.pendingAssetCount = 1;
+        }
     }
 
     return bundle;
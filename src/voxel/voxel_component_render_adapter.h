@@ -19,14 +19,21 @@ struct VoxelComponentRenderBundle
     std::string assetId{};
     std::vector<VoxelComponentRenderEntry> entries{};
     std::string diagnostic{};
+    size_t pendingAssetCount{0};
 
     [[nodiscard]] bool has_error() const noexcept
     {
         return !diagnostic.empty();
     }
+
+    [[nodiscard]] bool is_pending() const noexcept
+    {
+        return pendingAssetCount > 0;
+    }
 };
 
 [[nodiscard]] VoxelComponentRenderBundle build_voxel_component_render_bundle(
     const GameObject& object,
     VoxelAssemblyAssetManager& assemblyAssetManager,
-    VoxelAssetManager& assetManager);
+    VoxelAssetManager& assetManager,
+    VoxelAssetLoadMode loadMode = VoxelAssetLoadMode::Blocking);
@@ -1,10 +1,117 @@
 #include "voxel_mesher.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <tracy/Tracy.hpp>
+
 #include "game/block.h"
 
-std::shared_ptr<Mesh> VoxelMesher::generate_mesh(const VoxelModel& model)
+namespace
+{
+    // Axis that each face direction points along, and the two in-plane axes the greedy sweep walks.
+    constexpr int FaceNormalAxis[6] = { 2, 2, 0, 0, 1, 1 };
+    constexpr int FaceUAxis[6] = { 0, 0, 2, 2, 0, 0 };
+    constexpr int FaceVAxis[6] = { 1, 1, 1, 1, 2, 2 };
+
+    constexpr uint64_t EmptyCell = 0;
+
+    [[nodiscard]] uint64_t pack_color(const VoxelColor& color) noexcept
+    {
+        return (uint64_t{1} << 32) |
+            (static_cast<uint64_t>(color.r) << 24) |
+            (static_cast<uint64_t>(color.g) << 16) |
+            (static_cast<uint64_t>(color.b) << 8) |
+            static_cast<uint64_t>(color.a);
+    }
+
+    [[nodiscard]] VoxelColor unpack_color(const uint64_t packed) noexcept
+    {
+        return VoxelColor{
+            .r = static_cast<uint8_t>(packed >> 24),
+            .g = static_cast<uint8_t>(packed >> 16),
+            .b = static_cast<uint8_t>(packed >> 8),
+            .a = static_cast<uint8_t>(packed)
+        };
+    }
+
+    // Packed colors over the model bounds plus one empty cell of padding on every side,
+    // so neighbor tests never need a bounds check or a hash lookup.
+    class DenseVoxelGrid
+    {
+    public:
+        explicit DenseVoxelGrid(const VoxelModel& model)
+        {
+            const VoxelBounds bounds = model.bounds();
+            _origin = glm::ivec3(bounds.min.x, bounds.min.y, bounds.min.z) - glm::ivec3(1);
+            _size = bounds.dimensions() + glm::ivec3(2);
+            _cells.assign(static_cast<size_t>(_size.x) * _size.y * _size.z, EmptyCell);
+
+            for (const auto& [brickCoord, brick] : model.bricks())
+            {
+                for (int cell = brick.next_occupied(0); cell < VoxelBrick::CellCount; cell = brick.next_occupied(cell + 1))
+                {
+                    const VoxelCoord coord = VoxelBrick::voxel_coord(brickCoord, cell);
+                    _cells[index(glm::ivec3(coord.x, coord.y, coord.z) - _origin)] = pack_color(brick.colors[cell]);
+                }
+            }
+        }
+
+        [[nodiscard]] const glm::ivec3& origin() const noexcept { return _origin; }
+        [[nodiscard]] const glm::ivec3& size() const noexcept { return _size; }
+
+        [[nodiscard]] uint64_t at(const glm::ivec3& local) const noexcept
+        {
+            return _cells[index(local)];
+        }
+
+    private:
+        [[nodiscard]] size_t index(const glm::ivec3& local) const noexcept
+        {
+            return (static_cast<size_t>(local.y) * _size.z + local.z) * _size.x + local.x;
+        }
+
+        glm::ivec3 _origin{0};
+        glm::ivec3 _size{0};
+        std::vector<uint64_t> _cells{};
+    };
+
+    void emit_quad(
+        Mesh& mesh,
+        const VoxelModel& model,
+        const FaceDirection face,
+        const glm::vec3& minCorner,
+        const glm::vec3& extent,
+        const VoxelColor& color)
+    {
+        const glm::vec3 normal = faceNormals[face];
+        const glm::vec3 vertexColor = color.to_vec3();
+        for (int vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+        {
+            const glm::vec3 faceVertex = glm::vec3(faceVertices[face][vertexIndex]) * extent;
+            const glm::vec3 position = ((minCorner + faceVertex) * model.voxelSize) - model.pivot;
+            mesh._vertices.push_back(Vertex{
+                position,
+                normal,
+                vertexColor,
+                glm::vec2(1.0f, 1.0f),
+                glm::vec3(0.0f)
+            });
+        }
+    }
+}
+
+std::shared_ptr<Mesh> VoxelMesher::generate_mesh(const VoxelModel& model, const VoxelMeshingMode mode)
+{
+    return mode == VoxelMeshingMode::Greedy
+        ? generate_greedy_mesh(model)
+        : generate_per_face_mesh(model);
+}
+
+std::shared_ptr<Mesh> VoxelMesher::generate_per_face_mesh(const VoxelModel& model)
 {
-    auto mesh = std::make_shared<Mesh>();
+    ZoneScopedN("VoxelMesher::PerFace");
+    auto mesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
 
     for (const auto& [coord, color] : model.voxels())
     {
@@ -20,33 +127,114 @@ std::shared_ptr<Mesh> VoxelMesher::generate_mesh(const VoxelModel& model)
                 continue;
             }
 
-            const uint32_t baseIndex = static_cast<uint32_t>(mesh->_vertices.size());
             const glm::vec3 basePos = glm::vec3(
                 static_cast<float>(coord.x),
                 static_cast<float>(coord.y),
-                static_cast<float>(coord.z)) * model.voxelSize;
-            const glm::vec3 normal = faceNormals[face];
-            const glm::vec3 vertexColor = color.to_vec3();
+                static_cast<float>(coord.z));
+            emit_quad(*mesh, model, face, basePos, glm::vec3(1.0f), color);
+        }
+    }
+
+    return mesh;
+}
+
+std::shared_ptr<Mesh> VoxelMesher::generate_greedy_mesh(const VoxelModel& model)
+{
+    ZoneScopedN("VoxelMesher::Greedy");
+    auto mesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    if (model.voxel_count() == 0)
+    {
+        return mesh;
+    }
+
+    const DenseVoxelGrid grid(model);
+    const glm::ivec3 size = grid.size();
+    std::vector<uint64_t> mask{};
 
-            for (int vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+    for (const auto face : faceDirections)
+    {
+        const int d = FaceNormalAxis[face];
+        const int u = FaceUAxis[face];
+        const int v = FaceVAxis[face];
+        const glm::ivec3 step(faceOffsetX[face], faceOffsetY[face], faceOffsetZ[face]);
+        const int width = size[u];
+        const int height = size[v];
+        mask.assign(static_cast<size_t>(width) * height, EmptyCell);
+
+        // Padding slices are always empty, so only interior slices can own an exposed face.
+        for (int slice = 1; slice < size[d] - 1; ++slice)
+        {
+            bool anyFace = false;
+            for (int j = 1; j < height - 1; ++j)
+            {
+                for (int i = 1; i < width - 1; ++i)
+                {
+                    glm::ivec3 cell(0);
+                    cell[d] = slice;
+                    cell[u] = i;
+                    cell[v] = j;
+
+                    const uint64_t packed = grid.at(cell);
+                    const bool exposed = packed != EmptyCell && grid.at(cell + step) == EmptyCell;
+                    mask[static_cast<size_t>(j) * width + i] = exposed ? packed : EmptyCell;
+                    anyFace |= exposed;
+                }
+            }
+
+            if (!anyFace)
             {
-                const glm::vec3 faceVertex = glm::vec3(faceVertices[face][vertexIndex]) * model.voxelSize;
-                const glm::vec3 position = (basePos + faceVertex) - model.pivot;
-                mesh->_vertices.push_back(Vertex{
-                    position,
-                    normal,
-                    vertexColor,
-                    glm::vec2(1.0f, 1.0f),
-                    glm::vec3(0.0f)
-                });
+                continue;
             }
 
-            mesh->_indices.push_back(baseIndex + 0);
-            mesh->_indices.push_back(baseIndex + 1);
-            mesh->_indices.push_back(baseIndex + 2);
-            mesh->_indices.push_back(baseIndex + 2);
-            mesh->_indices.push_back(baseIndex + 3);
-            mesh->_indices.push_back(baseIndex + 0);
+            for (int j = 1; j < height - 1; ++j)
+            {
+                for (int i = 1; i < width - 1;)
+                {
+                    const uint64_t packed = mask[static_cast<size_t>(j) * width + i];
+                    if (packed == EmptyCell)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    int runWidth = 1;
+                    while (i + runWidth < width - 1 && mask[static_cast<size_t>(j) * width + i + runWidth] == packed)
+                    {
+                        ++runWidth;
+                    }
+
+                    int runHeight = 1;
+                    for (; j + runHeight < height - 1; ++runHeight)
+                    {
+                        const uint64_t* row = &mask[static_cast<size_t>(j + runHeight) * width + i];
+                        bool rowMatches = true;
+                        for (int k = 0; k < runWidth && rowMatches; ++k)
+                        {
+                            rowMatches = row[k] == packed;
+                        }
+                        if (!rowMatches)
+                        {
+                            break;
+                        }
+                    }
+
+                    for (int rowIndex = 0; rowIndex < runHeight; ++rowIndex)
+                    {
+                        std::fill_n(&mask[static_cast<size_t>(j + rowIndex) * width + i], runWidth, EmptyCell);
+                    }
+
+                    glm::ivec3 minCell(0);
+                    minCell[d] = slice;
+                    minCell[u] = i;
+                    minCell[v] = j;
+                    glm::vec3 extent(1.0f);
+                    extent[u] = static_cast<float>(runWidth);
+                    extent[v] = static_cast<float>(runHeight);
+
+                    emit_quad(*mesh, model, face, glm::vec3(minCell + grid.origin()), extent, unpack_color(packed));
+                    i += runWidth;
+                }
+            }
         }
     }
 
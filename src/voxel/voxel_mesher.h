@@ -5,8 +5,22 @@
 #include "render/mesh.h"
 #include "voxel_model.h"
 
+enum class VoxelMeshingMode : uint8_t
+{
+    // One quad per exposed voxel face.
+    PerFace = 0,
+    // Merges coplanar exposed faces of the same color into larger quads.
+    Greedy = 1
+};
+
 class VoxelMesher
 {
 public:
-    [[nodiscard]] static std::shared_ptr<Mesh> generate_mesh(const VoxelModel& model);
+    [[nodiscard]] static std::shared_ptr<Mesh> generate_mesh(
+        const VoxelModel& model,
+        VoxelMeshingMode mode = VoxelMeshingMode::Greedy);
+
+private:
+    [[nodiscard]] static std::shared_ptr<Mesh> generate_per_face_mesh(const VoxelModel& model);
+    [[nodiscard]] static std::shared_ptr<Mesh> generate_greedy_mesh(const VoxelModel& model);
 };
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <ranges>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <glm/vec3.hpp>
@@ -54,6 +58,88 @@ struct VoxelCoordHash
     }
 };
 
+// Dense 8x8x8 block of voxels. Occupancy lives in a bitset so empty cells never need a color compare.
+struct VoxelBrick
+{
+    static constexpr int Shift = 3;
+    static constexpr int Size = 1 << Shift;
+    static constexpr int Mask = Size - 1;
+    static constexpr int CellCount = Size * Size * Size;
+    static constexpr int WordBits = 64;
+
+    std::array<uint64_t, CellCount / WordBits> occupancy{};
+    std::array<VoxelColor, CellCount> colors{};
+    uint16_t count{0};
+
+    [[nodiscard]] static constexpr VoxelCoord brick_coord(const VoxelCoord& coord) noexcept
+    {
+        return VoxelCoord{ .x = coord.x >> Shift, .y = coord.y >> Shift, .z = coord.z >> Shift };
+    }
+
+    [[nodiscard]] static constexpr int cell_index(const VoxelCoord& coord) noexcept
+    {
+        return ((coord.y & Mask) * Size + (coord.z & Mask)) * Size + (coord.x & Mask);
+    }
+
+    [[nodiscard]] static constexpr VoxelCoord voxel_coord(const VoxelCoord& brickCoord, const int cellIndex) noexcept
+    {
+        return VoxelCoord{
+            .x = (brickCoord.x << Shift) + (cellIndex & Mask),
+            .y = (brickCoord.y << Shift) + (cellIndex >> (Shift * 2)),
+            .z = (brickCoord.z << Shift) + ((cellIndex >> Shift) & Mask)
+        };
+    }
+
+    [[nodiscard]] bool test(const int cellIndex) const noexcept
+    {
+        return (occupancy[cellIndex / WordBits] >> (cellIndex % WordBits)) & 1u;
+    }
+
+    // Returns the first occupied cell at or after cellIndex, or CellCount.
+    [[nodiscard]] int next_occupied(const int cellIndex) const noexcept
+    {
+        for (int word = cellIndex / WordBits; word < static_cast<int>(occupancy.size()); ++word)
+        {
+            uint64_t bits = occupancy[word];
+            if (word == cellIndex / WordBits)
+            {
+                bits &= ~uint64_t{0} << (cellIndex % WordBits);
+            }
+            if (bits != 0)
+            {
+                return (word * WordBits) + std::countr_zero(bits);
+            }
+        }
+
+        return CellCount;
+    }
+
+    void set(const int cellIndex, const VoxelColor& color) noexcept
+    {
+        if (!test(cellIndex))
+        {
+            occupancy[cellIndex / WordBits] |= uint64_t{1} << (cellIndex % WordBits);
+            ++count;
+        }
+        colors[cellIndex] = color;
+    }
+
+    bool reset(const int cellIndex) noexcept
+    {
+        if (!test(cellIndex))
+        {
+            return false;
+        }
+
+        occupancy[cellIndex / WordBits] &= ~(uint64_t{1} << (cellIndex % WordBits));
+        colors[cellIndex] = VoxelColor{};
+        --count;
+        return true;
+    }
+
+    bool operator==(const VoxelBrick&) const = default;
+};
+
 struct VoxelBounds
 {
     bool valid{false};
@@ -100,7 +186,80 @@ struct VoxelAttachment
 class VoxelModel
 {
 public:
-    using Storage = std::unordered_map<VoxelCoord, VoxelColor, VoxelCoordHash>;
+    using Storage = std::unordered_map<VoxelCoord, VoxelBrick, VoxelCoordHash>;
+
+    // Forward range over occupied voxels yielding (coord, color) pairs by value.
+    class VoxelRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<VoxelCoord, VoxelColor>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            iterator(const Storage::const_iterator brick, const Storage::const_iterator end) :
+                _brick(brick), _end(end)
+            {
+                seek(0);
+            }
+
+            [[nodiscard]] value_type operator*() const
+            {
+                return { VoxelBrick::voxel_coord(_brick->first, _cell), _brick->second.colors[_cell] };
+            }
+
+            iterator& operator++()
+            {
+                seek(_cell + 1);
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator previous = *this;
+                ++(*this);
+                return previous;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& other) const
+            {
+                return _brick == other._brick && (_brick == _end || _cell == other._cell);
+            }
+
+        private:
+            void seek(int cell)
+            {
+                while (_brick != _end)
+                {
+                    _cell = _brick->second.next_occupied(cell);
+                    if (_cell < VoxelBrick::CellCount)
+                    {
+                        return;
+                    }
+
+                    ++_brick;
+                    cell = 0;
+                }
+                _cell = 0;
+            }
+
+            Storage::const_iterator _brick{};
+            Storage::const_iterator _end{};
+            int _cell{0};
+        };
+
+        explicit VoxelRange(const Storage& bricks) : _bricks(&bricks) {}
+
+        [[nodiscard]] iterator begin() const { return iterator(_bricks->begin(), _bricks->end()); }
+        [[nodiscard]] iterator end() const { return iterator(_bricks->end(), _bricks->end()); }
+
+    private:
+        const Storage* _bricks;
+    };
 
     std::string assetId{"untitled"};
     std::string displayName{"Untitled"};
@@ -110,14 +269,17 @@ public:
 
     [[nodiscard]] bool contains(const VoxelCoord& coord) const
     {
-        return _voxels.contains(coord);
+        const VoxelBrick* const brick = find_brick(coord);
+        return brick != nullptr && brick->test(VoxelBrick::cell_index(coord));
     }
 
     [[nodiscard]] const VoxelColor* try_get(const VoxelCoord& coord) const
     {
-        if (const auto it = _voxels.find(coord); it != _voxels.end())
+        const VoxelBrick* const brick = find_brick(coord);
+        const int cellIndex = VoxelBrick::cell_index(coord);
+        if (brick != nullptr && brick->test(cellIndex))
         {
-            return &it->second;
+            return &brick->colors[cellIndex];
         }
 
         return nullptr;
@@ -125,33 +287,70 @@ public:
 
     void set_voxel(const VoxelCoord& coord, const VoxelColor& color)
     {
-        _voxels.insert_or_assign(coord, color);
+        VoxelBrick& brick = _bricks[VoxelBrick::brick_coord(coord)];
+        const uint16_t previousCount = brick.count;
+        brick.set(VoxelBrick::cell_index(coord), color);
+        _voxelCount += brick.count - previousCount;
     }
 
     bool remove_voxel(const VoxelCoord& coord)
     {
-        return _voxels.erase(coord) > 0;
+        const auto it = _bricks.find(VoxelBrick::brick_coord(coord));
+        if (it == _bricks.end() || !it->second.reset(VoxelBrick::cell_index(coord)))
+        {
+            return false;
+        }
+
+        --_voxelCount;
+        if (it->second.count == 0)
+        {
+            _bricks.erase(it);
+        }
+        return true;
+    }
+
+    // Replaces a whole brick; used by bulk loaders that already hold dense brick data.
+    void set_brick(const VoxelCoord& brickCoord, const VoxelBrick& brick)
+    {
+        const auto it = _bricks.find(brickCoord);
+        if (it != _bricks.end())
+        {
+            _voxelCount -= it->second.count;
+            _bricks.erase(it);
+        }
+
+        if (brick.count > 0)
+        {
+            _bricks.insert_or_assign(brickCoord, brick);
+            _voxelCount += brick.count;
+        }
     }
 
     void clear()
     {
-        _voxels.clear();
+        _bricks.clear();
+        _voxelCount = 0;
     }
 
     [[nodiscard]] size_t voxel_count() const noexcept
     {
-        return _voxels.size();
+        return _voxelCount;
+    }
+
+    [[nodiscard]] VoxelRange voxels() const noexcept
+    {
+        return VoxelRange(_bricks);
     }
 
-    [[nodiscard]] const Storage& voxels() const noexcept
+    [[nodiscard]] const Storage& bricks() const noexcept
     {
-        return _voxels;
+        return _bricks;
     }
 
     [[nodiscard]] VoxelBounds bounds() const
     {
         VoxelBounds result{};
-        if (_voxels.empty())
+        if (_bricks.empty())
         {
             return result;
         }
@@ -168,7 +367,7 @@ public:
             .z = std::numeric_limits<int>::min()
         };
 
-        for (const auto& [coord, color] : _voxels)
+        for (const auto& [coord, color] : voxels())
         {
             (void)color;
             result.min.x = std::min(result.min.x, coord.x);
@@ -194,5 +393,12 @@ public:
     [[nodiscard]] bool operator==(const VoxelModel& other) const = default;
 
 private:
-    Storage _voxels{};
+    [[nodiscard]] const VoxelBrick* find_brick(const VoxelCoord& coord) const
+    {
+        const auto it = _bricks.find(VoxelBrick::brick_coord(coord));
+        return it != _bricks.end() ? &it->second : nullptr;
+    }
+
+    Storage _bricks{};
+    size_t _voxelCount{0};
 };
@@ -4,14 +4,15 @@
 
 std::optional<VoxelRenderInstance> build_voxel_render_instance(
     const VoxelModelComponent& component,
-    VoxelAssetManager& assetManager)
+    VoxelAssetManager& assetManager,
+    const VoxelAssetLoadMode loadMode)
 {
     if (!component.visible)
     {
         return std::nullopt;
     }
 
-    const std::shared_ptr<VoxelRuntimeAsset> asset = assetManager.load_or_get(component.assetId);
+    const std::shared_ptr<VoxelRuntimeAsset> asset = assetManager.acquire(component.assetId, loadMode);
     if (asset == nullptr)
     {
         return std::nullopt;
@@ -6,6 +6,9 @@
 #include "voxel_asset_manager.h"
 #include "voxel_render_instance.h"
 
+// With VoxelAssetLoadMode::Async this returns nullopt while the asset is still loading;
+// check VoxelAssetManager::is_loading to tell that apart from a missing asset.
 [[nodiscard]] std::optional<VoxelRenderInstance> build_voxel_render_instance(
     const VoxelModelComponent& component,
-    VoxelAssetManager& assetManager);
+    VoxelAssetManager& assetManager,
+    VoxelAssetLoadMode loadMode = VoxelAssetLoadMode::Blocking);
@@ -5,10 +5,13 @@
 #include <format>
 #include <stdexcept>
 
+#include "voxel_binary_format.h"
+
 namespace
 {
     constexpr int VoxelModelVersion = 2;
     constexpr std::string_view VoxelModelFileSuffix = ".vxm.json";
+    constexpr std::string_view VoxelBinaryFileSuffix = ".vxm";
 
     std::string sanitize_asset_id(std::string_view rawAssetId)
     {
@@ -196,6 +199,16 @@ VoxelModelRepository::VoxelModelRepository(
 }
 
 std::optional<VoxelModel> VoxelModelRepository::load(const std::string_view assetId) const
+{
+    if (std::optional<VoxelModel> model = load_binary(assetId); model.has_value())
+    {
+        return model;
+    }
+
+    return load_json(assetId);
+}
+
+std::optional<VoxelModel> VoxelModelRepository::load_json(const std::string_view assetId) const
 {
     try
     {
@@ -211,6 +224,37 @@ std::optional<VoxelModel> VoxelModelRepository::load(const std::string_view asse
     return std::nullopt;
 }
 
+std::optional<VoxelModel> VoxelModelRepository::load_binary(const std::string_view assetId) const
+{
+    try
+    {
+        const std::filesystem::path binaryPath = resolve_binary_path(assetId);
+        if (!std::filesystem::exists(binaryPath))
+        {
+            return std::nullopt;
+        }
+
+        // A hand-edited or re-saved JSON source wins over an older binary export.
+        const std::filesystem::path jsonPath = resolve_path(assetId);
+        if (std::filesystem::exists(jsonPath) &&
+            std::filesystem::last_write_time(jsonPath) > std::filesystem::last_write_time(binaryPath))
+        {
+            return std::nullopt;
+        }
+
+        if (std::optional<VoxelModel> model = voxel::binary::load_file(binaryPath); model.has_value())
+        {
+            model->assetId = sanitize_asset_id(model->assetId);
+            return model;
+        }
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    return std::nullopt;
+}
+
 std::vector<std::string> VoxelModelRepository::list_asset_ids() const
 {
     std::vector<std::string> assetIds{};
@@ -230,17 +274,22 @@ std::vector<std::string> VoxelModelRepository::list_asset_ids() const
             }
 
             const std::string filename = entry.path().filename().string();
-            if (!filename.ends_with(VoxelModelFileSuffix))
+            const std::string_view suffix = filename.ends_with(VoxelModelFileSuffix)
+                ? VoxelModelFileSuffix
+                : (filename.ends_with(VoxelBinaryFileSuffix) ? VoxelBinaryFileSuffix : std::string_view{});
+            if (suffix.empty())
             {
                 continue;
             }
 
             const std::string_view filenameView{filename};
-            const std::string_view assetIdView = filenameView.substr(0, filenameView.size() - VoxelModelFileSuffix.size());
+            const std::string_view assetIdView = filenameView.substr(0, filenameView.size() - suffix.size());
             assetIds.push_back(std::string(assetIdView));
         }
 
         std::ranges::sort(assetIds);
+        const auto duplicates = std::ranges::unique(assetIds);
+        assetIds.erase(duplicates.begin(), duplicates.end());
     }
     catch (const std::exception&)
     {
@@ -250,6 +299,54 @@ std::vector<std::string> VoxelModelRepository::list_asset_ids() const
 }
 
 void VoxelModelRepository::save(const VoxelModel& model) const
+{
+    const VoxelModel normalized = normalize(model);
+    _documentStore.save(resolve_path(normalized.assetId), serialize(normalized));
+
+    if (std::filesystem::exists(resolve_binary_path(normalized.assetId)))
+    {
+        voxel::binary::save_file(resolve_binary_path(normalized.assetId), normalized);
+    }
+}
+
+void VoxelModelRepository::save_binary(const VoxelModel& model) const
+{
+    const VoxelModel normalized = normalize(model);
+    voxel::binary::save_file(resolve_binary_path(normalized.assetId), normalized);
+}
+
+size_t VoxelModelRepository::convert_to_binary() const
+{
+    size_t converted = 0;
+    for (const std::string& assetId : list_asset_ids())
+    {
+        if (const std::optional<VoxelModel> model = load_json(assetId); model.has_value())
+        {
+            save_binary(model.value());
+            ++converted;
+        }
+    }
+
+    return converted;
+}
+
+size_t VoxelModelRepository::convert_to_json() const
+{
+    size_t converted = 0;
+    for (const std::string& assetId : list_asset_ids())
+    {
+        if (const std::optional<VoxelModel> model = load_binary(assetId); model.has_value())
+        {
+            const VoxelModel normalized = normalize(model.value());
+            _documentStore.save(resolve_path(normalized.assetId), serialize(normalized));
+            ++converted;
+        }
+    }
+
+    return converted;
+}
+
+VoxelModel VoxelModelRepository::normalize(const VoxelModel& model) const
 {
     if (model.voxelSize <= 0.0f)
     {
@@ -263,7 +360,7 @@ void VoxelModelRepository::save(const VoxelModel& model) const
         normalized.displayName = normalized.assetId;
     }
 
-    _documentStore.save(resolve_path(normalized.assetId), serialize(normalized));
+    return normalized;
 }
 
 std::filesystem::path VoxelModelRepository::resolve_path(const std::string_view assetId) const
@@ -271,6 +368,11 @@ std::filesystem::path VoxelModelRepository::resolve_path(const std::string_view
     return _rootPath / std::format("{}.vxm.json", sanitize_asset_id(assetId));
 }
 
+std::filesystem::path VoxelModelRepository::resolve_binary_path(const std::string_view assetId) const
+{
+    return _rootPath / std::format("{}{}", sanitize_asset_id(assetId), VoxelBinaryFileSuffix);
+}
+
 const std::filesystem::path& VoxelModelRepository::root_path() const noexcept
 {
     return _rootPath;
@@ -16,13 +16,24 @@ public:
         const config::IJsonDocumentStore& documentStore,
         std::filesystem::path rootPath = std::filesystem::path("models") / "voxels");
 
+    // Prefers the binary (.vxm) asset when it is at least as new as the JSON source.
     [[nodiscard]] std::optional<VoxelModel> load(std::string_view assetId) const;
     [[nodiscard]] std::vector<std::string> list_asset_ids() const;
+    // Writes JSON, and refreshes the binary asset if one has been exported.
     void save(const VoxelModel& model) const;
+    void save_binary(const VoxelModel& model) const;
+    // Converters between the JSON authoring format and the binary runtime format; return assets written.
+    size_t convert_to_binary() const;
+    size_t convert_to_json() const;
     [[nodiscard]] std::filesystem::path resolve_path(std::string_view assetId) const;
+    [[nodiscard]] std::filesystem::path resolve_binary_path(std::string_view assetId) const;
     [[nodiscard]] const std::filesystem::path& root_path() const noexcept;
 
 private:
+    [[nodiscard]] std::optional<VoxelModel> load_json(std::string_view assetId) const;
+    [[nodiscard]] std::optional<VoxelModel> load_binary(std::string_view assetId) const;
+    [[nodiscard]] VoxelModel normalize(const VoxelModel& model) const;
+
     const config::IJsonDocumentStore& _documentStore;
     std::filesystem::path _rootPath{};
 };
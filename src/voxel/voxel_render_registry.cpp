@@ -4,6 +4,7 @@
 
 #include "render/material_manager.h"
 #include "render/mesh_manager.h"
+#include "voxel_spatial_bounds.h"
 #include "world/world_light_sampler.h"
 
 VoxelRenderRegistry::InstanceId VoxelRenderRegistry::add_instance(const VoxelRenderInstance& instance)
@@ -116,6 +117,15 @@ void VoxelRenderRegistry::sync(
             remove_render_object(entry, renderState);
         }
 
+        const VoxelSpatialBounds worldBounds = transform_bounds(
+            evaluate_voxel_asset_local_bounds(*entry.instance.asset),
+            entry.instance.model_matrix());
+        const RenderBounds renderBounds{
+            .valid = worldBounds.valid,
+            .min = worldBounds.min,
+            .max = worldBounds.max
+        };
+
         if (!entry.renderHandle.has_value())
         {
             entry.renderHandle = render_bucket(renderState, entry.instance.layer).insert(RenderObject{
@@ -124,7 +134,8 @@ void VoxelRenderRegistry::sync(
                 .transform = entry.instance.model_matrix(),
                 .layer = entry.instance.layer,
                 .lightingMode = entry.instance.lightingMode,
-                .sampledLight = entry.instance.sampledLight
+                .sampledLight = entry.instance.sampledLight,
+                .bounds = renderBounds
             });
             entry.submittedLayer = entry.instance.layer;
             continue;
@@ -144,6 +155,7 @@ void VoxelRenderRegistry::sync(
         renderObject->layer = entry.instance.layer;
         renderObject->lightingMode = entry.instance.lightingMode;
         renderObject->sampledLight = entry.instance.sampledLight;
+        renderObject->bounds = renderBounds;
     }
 }
 
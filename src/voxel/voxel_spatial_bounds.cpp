@@ -24,25 +24,37 @@ VoxelSpatialBounds union_bounds(const VoxelSpatialBounds& lhs, const VoxelSpatia
     };
 }
 
-VoxelSpatialBounds evaluate_voxel_model_local_bounds(const VoxelModel& model)
+namespace
 {
-    const VoxelBounds bounds = model.bounds();
-    if (!bounds.valid)
+    VoxelSpatialBounds local_bounds_from_voxel_bounds(const VoxelModel& model, const VoxelBounds& bounds)
     {
-        return {};
+        if (!bounds.valid)
+        {
+            return {};
+        }
+
+        return VoxelSpatialBounds{
+            .valid = true,
+            .min = (glm::vec3(
+                static_cast<float>(bounds.min.x),
+                static_cast<float>(bounds.min.y),
+                static_cast<float>(bounds.min.z)) * model.voxelSize) - model.pivot,
+            .max = (glm::vec3(
+                static_cast<float>(bounds.max.x + 1),
+                static_cast<float>(bounds.max.y + 1),
+                static_cast<float>(bounds.max.z + 1)) * model.voxelSize) - model.pivot
+        };
     }
+}
 
-    return VoxelSpatialBounds{
-        .valid = true,
-        .min = (glm::vec3(
-            static_cast<float>(bounds.min.x),
-            static_cast<float>(bounds.min.y),
-            static_cast<float>(bounds.min.z)) * model.voxelSize) - model.pivot,
-        .max = (glm::vec3(
-            static_cast<float>(bounds.max.x + 1),
-            static_cast<float>(bounds.max.y + 1),
-            static_cast<float>(bounds.max.z + 1)) * model.voxelSize) - model.pivot
-    };
+VoxelSpatialBounds evaluate_voxel_model_local_bounds(const VoxelModel& model)
+{
+    return local_bounds_from_voxel_bounds(model, model.bounds());
+}
+
+VoxelSpatialBounds evaluate_voxel_asset_local_bounds(const VoxelRuntimeAsset& asset)
+{
+    return local_bounds_from_voxel_bounds(asset.model, asset.bounds);
 }
 
 VoxelSpatialBounds transform_bounds(const VoxelSpatialBounds& bounds, const glm::mat4& transform)
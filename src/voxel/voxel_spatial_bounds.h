@@ -27,6 +27,8 @@ struct VoxelSpatialBounds
 
 [[nodiscard]] VoxelSpatialBounds union_bounds(const VoxelSpatialBounds& lhs, const VoxelSpatialBounds& rhs);
 [[nodiscard]] VoxelSpatialBounds evaluate_voxel_model_local_bounds(const VoxelModel& model);
+// Uses the bounds cached on the runtime asset instead of rescanning the model's voxels.
+[[nodiscard]] VoxelSpatialBounds evaluate_voxel_asset_local_bounds(const VoxelRuntimeAsset& asset);
 [[nodiscard]] VoxelSpatialBounds transform_bounds(const VoxelSpatialBounds& bounds, const glm::mat4& transform);
 [[nodiscard]] VoxelSpatialBounds evaluate_voxel_render_instance_bounds(const VoxelRenderInstance& instance);
 [[nodiscard]] VoxelSpatialBounds evaluate_voxel_render_instances_bounds(const std::vector<VoxelRenderInstance>& instances);
@@ -4,6 +4,8 @@
 
 #include "chunk_cache.h"
 
+#include <algorithm>
+
 #include <tracy/Tracy.hpp>
 
 
@@ -13,8 +15,8 @@ ChunkCache::get_chunk_index_unlocked(const ChunkCoord coord) const
     const int rx = coord.x - m_origin.x;
     const int rz = coord.z - m_origin.z;
 
-    // outside the ring?
-    if (std::abs(rx) > m_radius || std::abs(rz) > m_radius)
+    // outside the ring, or in one of its corners?
+    if (std::abs(rx) > m_radius || std::abs(rz) > m_radius || !is_chunk_offset_resident(rx, rz, m_radius))
         return std::nullopt;
 
     // map relative offset into ring buffer indices
@@ -166,6 +168,12 @@ Chunk* ChunkCache::get_chunk(const ChunkCoord coord) const
     return nullptr;
 }
 
+bool ChunkCache::is_resident(const ChunkCoord coord) const
+{
+    std::shared_lock lock(m_mutex);
+    return is_chunk_offset_resident(coord.x - m_origin.x, coord.z - m_origin.z, m_radius);
+}
+
 //we can only slide in 1 direction at a time, so that is 4 directions.
 //
 std::vector<Chunk*> ChunkCache::slide(const ChunkCoord delta)
@@ -194,3 +202,130 @@ std::vector<Chunk*> ChunkCache::slide(const ChunkCoord delta)
 
     return chunks;
 }
+
+std::vector<Chunk*> ChunkCache::recenter(const ChunkCoord origin)
+{
+    ZoneScopedN("ChunkCache::recenter");
+    std::unique_lock lock(m_mutex);
+    std::vector<Chunk*> chunks;
+
+    // A coordinate always lives in slot (coord + radius) mod width, so each slot has exactly one
+    // coordinate in the new ring; only slots holding something else need a reset.
+    for (auto buf_x = 0; buf_x < m_width; ++buf_x)
+    {
+        for (auto buf_z = 0; buf_z < m_width; ++buf_z)
+        {
+            auto chunk = m_chunks[buf_z + (buf_x * m_width)].get();
+            if (chunk == nullptr)
+            {
+                continue;
+            }
+
+            const ChunkCoord coord{
+                origin.x - m_radius + wrap(buf_x - origin.x, m_width),
+                origin.z - m_radius + wrap(buf_z - origin.z, m_width)
+            };
+            if (chunk->_data->coord == coord)
+            {
+                continue;
+            }
+
+            chunk->reset(coord, m_chunkVoxelWidth, m_chunkVoxelHeight);
+            chunks.push_back(chunk);
+        }
+    }
+
+    m_origin = origin;
+    m_origin_buf_x = wrap(origin.x + m_radius, m_width);
+    m_origin_buf_z = wrap(origin.z + m_radius, m_width);
+
+    sort_nearest_first(chunks, origin);
+    return chunks;
+}
+
+ChunkCacheResize ChunkCache::resize(const int view_distance)
+{
+    ZoneScopedN("ChunkCache::resize");
+    std::unique_lock lock(m_mutex);
+    ChunkCacheResize result;
+    if (view_distance == m_radius || view_distance <= 0)
+    {
+        return result;
+    }
+
+    const int radius = view_distance;
+    const int width = (radius * 2) + 1;
+    std::vector<std::unique_ptr<Chunk>> chunks(static_cast<std::size_t>(width) * static_cast<std::size_t>(width));
+
+    // Slots are addressed by (coord + radius) mod width, so every chunk that survives the resize moves
+    // straight to its slot in the new ring.
+    for (auto& chunk : m_chunks)
+    {
+        if (chunk == nullptr)
+        {
+            continue;
+        }
+
+        const ChunkCoord coord = chunk->_data->coord;
+        if (std::abs(coord.x - m_origin.x) > radius || std::abs(coord.z - m_origin.z) > radius)
+        {
+            chunk->reset(coord, m_chunkVoxelWidth, m_chunkVoxelHeight);
+            result.removed.push_back(chunk.get());
+            m_spareChunks.push_back(std::move(chunk));
+            continue;
+        }
+
+        const int buf_x = wrap(coord.x + radius, width);
+        const int buf_z = wrap(coord.z + radius, width);
+        chunks[buf_z + (buf_x * width)] = std::move(chunk);
+    }
+
+    for (auto buf_x = 0; buf_x < width; ++buf_x)
+    {
+        for (auto buf_z = 0; buf_z < width; ++buf_z)
+        {
+            auto& slot = chunks[buf_z + (buf_x * width)];
+            if (slot != nullptr)
+            {
+                continue;
+            }
+
+            const ChunkCoord coord{
+                m_origin.x - radius + wrap(buf_x - m_origin.x, width),
+                m_origin.z - radius + wrap(buf_z - m_origin.z, width)
+            };
+            if (!m_spareChunks.empty())
+            {
+                slot = std::move(m_spareChunks.back());
+                m_spareChunks.pop_back();
+                slot->reset(coord, m_chunkVoxelWidth, m_chunkVoxelHeight);
+            }
+            else
+            {
+                slot = std::make_unique<Chunk>(coord, m_chunkVoxelWidth, m_chunkVoxelHeight);
+            }
+            result.added.push_back(slot.get());
+        }
+    }
+
+    m_chunks = std::move(chunks);
+    m_radius = radius;
+    m_width = width;
+    m_origin_buf_x = wrap(m_origin.x + m_radius, m_width);
+    m_origin_buf_z = wrap(m_origin.z + m_radius, m_width);
+
+    sort_nearest_first(result.added, m_origin);
+    return result;
+}
+
+void ChunkCache::sort_nearest_first(std::vector<Chunk*>& chunks, const ChunkCoord origin)
+{
+    std::ranges::sort(chunks, [origin](const Chunk* lhs, const Chunk* rhs)
+    {
+        const int lhsX = lhs->_data->coord.x - origin.x;
+        const int lhsZ = lhs->_data->coord.z - origin.z;
+        const int rhsX = rhs->_data->coord.x - origin.x;
+        const int rhsZ = rhs->_data->coord.z - origin.z;
+        return (lhsX * lhsX) + (lhsZ * lhsZ) < (rhsX * rhsX) + (rhsZ * rhsZ);
+    });
+}
@@ -7,12 +7,24 @@
 #include "game/chunk.h"
 
 
+struct ChunkCacheResize
+{
+    // Chunks reset to coordinates the old ring did not cover, nearest-first.
+    std::vector<Chunk*> added{};
+    // Chunks that fell outside the new ring. They stay allocated (see ChunkCache::resize) but are no
+    // longer returned by get_chunk.
+    std::vector<Chunk*> removed{};
+};
+
 class ChunkCache {
     int m_radius{};
     int m_width{};
     int m_chunkVoxelWidth{static_cast<int>(CHUNK_SIZE)};
     int m_chunkVoxelHeight{static_cast<int>(CHUNK_HEIGHT)};
     mutable std::shared_mutex m_mutex{};
+    // Chunks a shrink dropped from the ring. Render state and in-flight jobs may still point at them,
+    // so they are kept for the next grow instead of being freed.
+    std::vector<std::unique_ptr<Chunk>> m_spareChunks{};
 
     [[nodiscard]] std::optional<std::size_t> get_chunk_index_unlocked(ChunkCoord coord) const;
 
@@ -21,6 +33,8 @@ class ChunkCache {
     std::vector<Chunk*> slide_north();
     std::vector<Chunk*> slide_south();
 
+    static void sort_nearest_first(std::vector<Chunk*>& chunks, ChunkCoord origin);
+
     //@brief confines v to the range of [0, n - 1] even when v is negative....
     static int wrap(int v, int n)
     {
@@ -43,8 +57,18 @@ public:
     ChunkCache(const ChunkCache&) = delete;
     ChunkCache& operator=(const ChunkCache&) = delete;
 
+    // Only chunks inside the residency disc (see is_chunk_offset_resident) are returned; the ring's
+    // corner slots hold placeholders that are never generated.
     [[nodiscard]] Chunk* get_chunk(ChunkCoord coord) const;
+    [[nodiscard]] bool is_resident(ChunkCoord coord) const;
     std::vector<Chunk*> slide(ChunkCoord delta);
+    // Moves the ring to any origin in one pass: chunks inside both the old and new ring stay where they
+    // are, every other slot is reset to its new coordinate. Returns the reset chunks nearest-first.
+    std::vector<Chunk*> recenter(ChunkCoord origin);
+    // Changes the view distance around the current origin. Chunks inside both the old and new ring keep
+    // their data; only the rows gained or lost are touched.
+    ChunkCacheResize resize(int view_distance);
+    [[nodiscard]] int radius() const noexcept { return m_radius; }
 };
 
 
@@ -63,6 +63,36 @@ namespace
             z >= 0 && z < domainSize;
     }
 
+    // Rows above every occupied cell in the neighborhood are open sky; the solve only needs one of them,
+    // plus enough headroom for local light to rise out of the topmost emitter.
+    [[nodiscard]] int light_domain_height(const ChunkNeighborhood& neighborhood, const int chunkVoxelHeight, const bool hasEmitters)
+    {
+        int topOccupiedY = -1;
+        for (int offsetX = -1; offsetX <= 1; ++offsetX)
+        {
+            for (int offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                const ChunkData* const chunk = (offsetX == 0 && offsetZ == 0) ?
+                    neighborhood.center.get() :
+                    neighborhood.get_by_offset(offsetX, offsetZ);
+                if (chunk == nullptr || !chunk->has_block_storage())
+                {
+                    continue;
+                }
+
+                if (!chunk->heightmap.valid())
+                {
+                    return chunkVoxelHeight;
+                }
+
+                topOccupiedY = std::max(topOccupiedY, chunk->heightmap.maxOccupiedY);
+            }
+        }
+
+        const int headroom = hasEmitters ? MAX_LIGHT_LEVEL + 1 : 1;
+        return std::clamp(topOccupiedY + 1 + headroom, 1, chunkVoxelHeight);
+    }
+
     [[nodiscard]] constexpr uint8_t sunlight_attenuation(const bool water, const int y, const int seaLevel, const bool downward) noexcept
     {
         if (water && y <= seaLevel)
@@ -87,10 +117,8 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
     const int chunkVoxelHeight = neighborhood.center->voxelHeight;
     const int lightHalo = std::min<int>(chunkVoxelWidth, MAX_LIGHT_LEVEL);
     const int lightDomainSize = chunkVoxelWidth + (lightHalo * 2);
-    const int lightDomainHeight = chunkVoxelHeight;
     const int centerOffset = lightHalo;
     const size_t lightDomainPlaneSize = static_cast<size_t>(lightDomainSize) * static_cast<size_t>(lightDomainSize);
-    const size_t lightDomainCellCount = lightDomainPlaneSize * static_cast<size_t>(lightDomainHeight);
 
     const ChunkData* const centerChunk = neighborhood.center.get();
     const ChunkData* const negXChunk = neighborhood.get_by_offset(-1, 0);
@@ -111,6 +139,9 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
         (posXNegZChunk != nullptr && posXNegZChunk->has_emissive_blocks()) ||
         (negXPosZChunk != nullptr && negXPosZChunk->has_emissive_blocks()) ||
         (posXPosZChunk != nullptr && posXPosZChunk->has_emissive_blocks());
+    const int lightDomainHeight = light_domain_height(neighborhood, chunkVoxelHeight, neighborhoodHasEmitters);
+    const size_t lightDomainCellCount = lightDomainPlaneSize * static_cast<size_t>(lightDomainHeight);
+    TracyPlot("ChunkLighting Domain Height", static_cast<int64_t>(lightDomainHeight));
 
     auto& domain = g_lightingScratch.domain;
     domain.assign(lightDomainCellCount, LightCell{});
@@ -124,7 +155,10 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
     skylightFrontier.clear();
     skylightFrontier.reserve(static_cast<size_t>(lightDomainSize) * static_cast<size_t>(lightDomainSize));
     auto& columnSkylightInfo = g_lightingScratch.columnSkylightInfo;
-    columnSkylightInfo.assign(static_cast<size_t>(lightDomainSize) * static_cast<size_t>(lightDomainSize), ColumnSkylightInfo{});
+    // Columns without a loaded source chunk stay solid from top to bottom.
+    columnSkylightInfo.assign(
+        static_cast<size_t>(lightDomainSize) * static_cast<size_t>(lightDomainSize),
+        ColumnSkylightInfo{ .highestSolidY = static_cast<int16_t>(lightDomainHeight - 1) });
 
     {
         ZoneScopedN("ChunkLighting::BuildDomain");
@@ -149,9 +183,12 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
                 {
                     const int dstZ = dstZStart + localZ;
                     const int srcZ = srcZStart + localZ;
-                    size_t cellIndex =
+                    const size_t columnIndex =
                         static_cast<size_t>(dstX) +
                         (static_cast<size_t>(dstZ) * static_cast<size_t>(lightDomainSize));
+                    ColumnSkylightInfo& columnInfo = columnSkylightInfo[columnIndex];
+                    columnInfo.highestSolidY = -1;
+                    size_t cellIndex = columnIndex;
                     for (int y = 0; y < lightDomainHeight; ++y)
                     {
                         const size_t currentCellIndex = cellIndex;
@@ -159,6 +196,10 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
 
                         LightCell& cell = domain[currentCellIndex];
                         const Block& block = sourceChunk->blocks[srcX][y][srcZ];
+                        if (block._solid)
+                        {
+                            columnInfo.highestSolidY = static_cast<int16_t>(y);
+                        }
                         cell.solid = block._solid;
                         cell.water = block._type == BlockType::WATER;
                         cell.directSky = false;
@@ -218,7 +259,8 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
                     static_cast<size_t>(x) +
                     (static_cast<size_t>(z) * static_cast<size_t>(lightDomainSize)) +
                     (static_cast<size_t>(lightDomainHeight - 1) * lightDomainPlaneSize);
-                for (int y = lightDomainHeight - 1; y >= 0; --y)
+                // Everything at and below the highest solid cell was already cleared to darkness when the domain was filled.
+                for (int y = lightDomainHeight - 1; y > columnInfo.highestSolidY; --y)
                 {
                     const size_t currentCellIndex = cellIndex;
                     if (y > 0)
@@ -227,18 +269,6 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
                     }
 
                     LightCell& cell = domain[currentCellIndex];
-                    if (cell.solid)
-                    {
-                        if (columnInfo.highestSolidY < 0)
-                        {
-                            columnInfo.highestSolidY = static_cast<int16_t>(y);
-                        }
-                        sunlight = 0;
-                        cell.directSky = false;
-                        cell.sunlight = 0;
-                        continue;
-                    }
-
                     cell.sunlight = sunlight;
                     cell.directSky = sunlight == MAX_LIGHT_LEVEL;
                     if (sunlight > 0 && cell.water && y <= seaLevel)
@@ -533,6 +563,12 @@ std::shared_ptr<ChunkData> ChunkLighting::solve_skylight(const ChunkNeighborhood
                     };
                     cellIndex += lightDomainPlaneSize;
                 }
+
+                for (int y = lightDomainHeight; y < chunkVoxelHeight; ++y)
+                {
+                    litChunk->blocks[x][y][z]._sunlight = MAX_LIGHT_LEVEL;
+                    litChunk->blocks[x][y][z]._localLight = LocalLight{};
+                }
             }
         }
 
@@ -6,6 +6,7 @@
 #include "chunk_mesher.h"
 #include "tracy/Tracy.hpp"
 #include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <thread>
 
@@ -62,7 +63,7 @@ ChunkManager::ChunkManager() :
 
 ChunkManager::~ChunkManager() = default;
 
-void ChunkManager::update_player_position(const glm::vec3& position)
+void ChunkManager::update_player_position(const glm::vec3& position, const glm::vec3& velocity)
 {
     ZoneScopedN("ChunkManager::update_player_position");
     const ChunkCoord playerChunk = World::get_chunk_coordinates(position, _geometry);
@@ -83,6 +84,13 @@ void ChunkManager::update_player_position(const glm::vec3& position)
         else
         {
             std::vector<Chunk*> new_chunks{};
+            if (std::abs(changeX) > 1 || std::abs(changeZ) > 1)
+            {
+                // Teleports and respawns move the ring in one pass instead of sliding it row by row.
+                ZoneScopedN("ChunkManager::RecenterChunkCache");
+                new_chunks = m_chunkCache->recenter(playerChunk);
+            }
+            else
             {
                 ZoneScopedN("ChunkManager::SlideChunkCache");
                 new_chunks = m_chunkCache->slide({ changeX, changeZ });
@@ -100,10 +108,12 @@ void ChunkManager::update_player_position(const glm::vec3& position)
                 }
             }
 
+            update_residency();
         }
     }
 
     drain_generate_results();
+    drain_prefetch_results();
     {
         ZoneScopedN("ChunkManager::ApplyPendingWorldEdits");
         apply_pending_world_edits();
@@ -111,6 +121,8 @@ void ChunkManager::update_player_position(const glm::vec3& position)
     drain_light_results();
     drain_mesh_results();
     run_scheduler();
+    queue_prefetch(position, velocity);
+    _horizonTerrain.update(_lastPlayerChunk, _viewDistance);
 }
 
 Chunk* ChunkManager::get_chunk(const ChunkCoord coord) const
@@ -157,6 +169,7 @@ void ChunkManager::initialize_map(const MapRange mapRange)
         _geometry.chunk_voxel_width(),
         _geometry.chunk_voxel_height());
     _runtimeByChunk.clear();
+    reset_prefetch();
 
     for (auto& chunk : m_chunkCache->m_chunks)
     {
@@ -200,6 +213,8 @@ void ChunkManager::apply_mesh_settings(const ChunkMeshSettings& settings)
 
 void ChunkManager::regenerate_world()
 {
+    _horizonTerrain.reset();
+    reset_prefetch();
     if (m_chunkCache == nullptr)
     {
         return;
@@ -232,13 +247,67 @@ void ChunkManager::apply_streaming_settings(const ChunkStreamingSettings& settin
 {
     const int viewDistance = settings.viewDistance;
     const int clampedViewDistance = std::max(1, viewDistance);
+    const int horizonDistance = std::max(0, settings.horizonDistance);
+    if (_viewDistance == clampedViewDistance && _horizonTerrain.horizon_distance() == horizonDistance)
+    {
+        return;
+    }
+
+    // The horizon re-plans against the new distances on the next update and only rebuilds tiles whose
+    // spec changed.
+    _horizonTerrain.set_horizon_distance(horizonDistance);
     if (_viewDistance == clampedViewDistance)
     {
         return;
     }
 
     _viewDistance = clampedViewDistance;
-    initialize_map(MapRange(_lastPlayerChunk, _viewDistance));
+    if (m_chunkCache == nullptr)
+    {
+        return;
+    }
+
+    ZoneScopedN("ChunkManager::ResizeChunkCache");
+    const ChunkCacheResize resized = m_chunkCache->resize(_viewDistance);
+    for (Chunk* const chunk : resized.removed)
+    {
+        _runtimeByChunk.erase(chunk);
+        _renderResetEvents.enqueue(ChunkRenderResetEvent{
+            .chunk = chunk,
+            .generation = chunk->_gen.load(std::memory_order::acquire)
+        });
+    }
+    for (Chunk* const chunk : resized.added)
+    {
+        reset_chunk_runtime(chunk);
+        _renderResetEvents.enqueue(ChunkRenderResetEvent{
+            .chunk = chunk,
+            .generation = chunk->_gen.load(std::memory_order::acquire)
+        });
+    }
+    update_residency();
+
+    TracyPlot("Chunk Resize Added", static_cast<int64_t>(resized.added.size()));
+    TracyPlot("Chunk Resize Removed", static_cast<int64_t>(resized.removed.size()));
+}
+
+void ChunkManager::invalidate_meshes()
+{
+    _horizonTerrain.reset();
+    for (auto& [chunk, runtime] : _runtimeByChunk)
+    {
+        ChunkRecord& record = runtime.record;
+        if (chunk == nullptr || record.data == nullptr)
+        {
+            continue;
+        }
+
+        record.meshState = MeshState::Stale;
+        record.uploadPending = false;
+        record.meshedAgainstSignature = 0;
+        record.uploadedSignature = 0;
+        chunk->_state.store(ChunkState::Generated, std::memory_order::release);
+    }
 }
 
 int ChunkManager::view_distance() const noexcept
@@ -253,12 +322,15 @@ void ChunkManager::set_world_geometry(const WorldGeometrySettings& settings) noe
         _geometry.chunk_voxel_width(),
         _geometry.chunk_voxel_height(),
         _geometry.block_world_size());
+    _horizonTerrain.set_world_geometry(_geometry);
+    reset_prefetch();
 }
 
 void ChunkManager::notify_chunk_uploaded(
     Chunk* chunk,
     const uint32_t generationId,
-    const uint64_t neighborhoodSignature)
+    const uint64_t neighborhoodSignature,
+    const std::shared_ptr<ChunkMeshData>& uploadedMesh)
 {
     if (chunk == nullptr)
     {
@@ -273,6 +345,8 @@ void ChunkManager::notify_chunk_uploaded(
     if (ChunkRuntime* const runtime = runtime_for(chunk))
     {
         ChunkRecord& record = runtime->record;
+        // The renderer draws this mesh from now on even when a newer build already replaced it.
+        record.drawnMesh = uploadedMesh;
         if (record.meshedAgainstSignature != neighborhoodSignature)
         {
             return;
@@ -285,6 +359,33 @@ void ChunkManager::notify_chunk_uploaded(
     }
 }
 
+void ChunkManager::notify_chunk_upload_skipped(
+    Chunk* chunk,
+    const uint32_t generationId,
+    const uint64_t neighborhoodSignature,
+    std::shared_ptr<ChunkMeshData> uploadedMesh)
+{
+    if (chunk == nullptr || uploadedMesh == nullptr)
+    {
+        return;
+    }
+
+    if (chunk->_gen.load(std::memory_order::acquire) != generationId)
+    {
+        return;
+    }
+
+    ChunkRuntime* const runtime = runtime_for(chunk);
+    if (runtime == nullptr || runtime->record.meshedAgainstSignature != neighborhoodSignature)
+    {
+        return;
+    }
+
+    runtime->record.mesh = std::move(uploadedMesh);
+    chunk->_meshData = runtime->record.mesh;
+    notify_chunk_uploaded(chunk, generationId, neighborhoodSignature, runtime->record.mesh);
+}
+
 void ChunkManager::drain_generate_results()
 {
     ZoneScopedN("ChunkManager::DrainGenerateResults");
@@ -304,21 +405,47 @@ void ChunkManager::drain_generate_results()
 
         ChunkRecord& record = runtime->record;
         record.generationJobInFlight = false;
-        record.data = std::move(result.data);
-        result.chunk->_data = record.data;
-        record.dataState = DataState::Ready;
-        record.dataVersion += 1;
-        record.lightVersion = 0;
-        record.litAgainstSignature = 0;
-        record.lightState = LightState::Missing;
-        record.meshState = MeshState::Missing;
-        record.meshedAgainstSignature = 0;
-        record.uploadedSignature = 0;
-        record.uploadPending = false;
-        result.chunk->_state.store(ChunkState::Generated, std::memory_order::release);
+        apply_generated_data(result.chunk, record, std::move(result.data));
     }
 }
 
+void ChunkManager::drain_prefetch_results()
+{
+    ZoneScopedN("ChunkManager::DrainPrefetchResults");
+    ChunkPrefetchResult result;
+    while (_prefetchResults.try_dequeue(result))
+    {
+        --_prefetchJobsInFlight;
+        if (result.epoch != _prefetchEpoch)
+        {
+            continue;
+        }
+
+        // Entries evicted while their job ran are simply dropped.
+        if (const auto it = _prefetchedChunks.find(result.coord); it != _prefetchedChunks.end())
+        {
+            it->second.jobInFlight = false;
+            it->second.data = std::move(result.data);
+        }
+    }
+}
+
+void ChunkManager::apply_generated_data(Chunk* const chunk, ChunkRecord& record, std::shared_ptr<ChunkData> data)
+{
+    record.data = std::move(data);
+    chunk->_data = record.data;
+    record.dataState = DataState::Ready;
+    record.dataVersion += 1;
+    record.lightVersion = 0;
+    record.litAgainstSignature = 0;
+    record.lightState = LightState::Missing;
+    record.meshState = MeshState::Missing;
+    record.meshedAgainstSignature = 0;
+    record.uploadedSignature = 0;
+    record.uploadPending = false;
+    chunk->_state.store(ChunkState::Generated, std::memory_order::release);
+}
+
 void ChunkManager::drain_light_results()
 {
     ZoneScopedN("ChunkManager::DrainLightResults");
@@ -402,6 +529,7 @@ void ChunkManager::drain_mesh_results()
         record.mesh = std::move(result.meshData);
         result.chunk->_meshData = record.mesh;
         record.meshedAgainstSignature = result.neighborhoodSignature;
+        record.meshLodScale = static_cast<uint8_t>(result.lodScale);
         record.meshState = MeshState::MeshReady;
     }
 }
@@ -448,6 +576,20 @@ void ChunkManager::apply_pending_world_edits()
         updatedBlock._sunlight = 0;
         updatedBlock._localLight = {};
         existingBlock = updatedBlock;
+        ownerRecord.data->update_heightmap(localPos);
+        if (opacityChanged)
+        {
+            // The drawn mesh keeps its old faces until the remesh lands, but a dug tunnel must not
+            // stay culled in the meantime. A newer build may not be uploaded yet, so clear both.
+            if (ownerRecord.mesh != nullptr)
+            {
+                ownerRecord.mesh->connectivity.reset();
+            }
+            if (const std::shared_ptr<ChunkMeshData> drawnMesh = ownerRecord.drawnMesh.lock())
+            {
+                drawnMesh->connectivity.reset();
+            }
+        }
         if (ownerRecord.data != nullptr)
         {
             if (get_block_emission(updatedBlock._type).emits)
@@ -482,7 +624,11 @@ void ChunkManager::run_scheduler()
     prioritizedChunks.reserve(m_chunkCache->m_chunks.size());
     for (const auto& chunkPtr : m_chunkCache->m_chunks)
     {
-        prioritizedChunks.push_back(chunkPtr.get());
+        const ChunkRuntime* const runtime = runtime_for(chunkPtr.get());
+        if (runtime != nullptr && runtime->record.residency == ChunkResidencyState::Resident)
+        {
+            prioritizedChunks.push_back(chunkPtr.get());
+        }
     }
 
     std::ranges::sort(prioritizedChunks, [this](const Chunk* lhs, const Chunk* rhs)
@@ -495,6 +641,8 @@ void ChunkManager::run_scheduler()
     int generateJobsQueued = 0;
     int lightJobsQueued = 0;
     int meshJobsQueued = 0;
+    int prefetchedChunksAdopted = 0;
+    int prefetchWaits = 0;
     int generateJobsInFlight = 0;
     int lightJobsInFlight = 0;
     int meshJobsInFlight = 0;
@@ -525,6 +673,18 @@ void ChunkManager::run_scheduler()
         ChunkRecord& record = runtime->record;
         if (_scheduler.should_generate(record))
         {
+            if (take_prefetched_chunk(chunk, record))
+            {
+                if (record.dataState == DataState::Empty)
+                {
+                    ++prefetchWaits;
+                }
+                else
+                {
+                    ++prefetchedChunksAdopted;
+                }
+                continue;
+            }
             queue_generate(chunk);
             ++generateJobsQueued;
             continue;
@@ -562,6 +722,8 @@ void ChunkManager::run_scheduler()
     TracyPlot("Chunk Jobs Queued Generate", static_cast<int64_t>(generateJobsQueued));
     TracyPlot("Chunk Jobs Queued Light", static_cast<int64_t>(lightJobsQueued));
     TracyPlot("Chunk Jobs Queued Mesh", static_cast<int64_t>(meshJobsQueued));
+    TracyPlot("Chunk Prefetch Adopted", static_cast<int64_t>(prefetchedChunksAdopted));
+    _ringGenerateBacklog = generateJobsInFlight + generateJobsQueued + prefetchWaits;
 }
 
 void ChunkManager::reset_chunk_runtime(Chunk* chunk)
@@ -582,7 +744,7 @@ void ChunkManager::reset_chunk_runtime(Chunk* chunk)
         .litAgainstSignature = 0,
         .meshedAgainstSignature = 0,
         .uploadedSignature = 0,
-        .residency = ChunkResidencyState::Resident,
+        .residency = m_chunkCache->is_resident(chunk->_data->coord) ? ChunkResidencyState::Resident : ChunkResidencyState::Absent,
         .dataState = DataState::Empty,
         .lightState = LightState::Missing,
         .meshState = MeshState::Missing,
@@ -594,6 +756,42 @@ void ChunkManager::reset_chunk_runtime(Chunk* chunk)
     chunk->_state.store(ChunkState::Uninitialized, std::memory_order::release);
 }
 
+void ChunkManager::update_residency()
+{
+    ZoneScopedN("ChunkManager::UpdateResidency");
+    int droppedChunks = 0;
+    for (const auto& chunkPtr : m_chunkCache->m_chunks)
+    {
+        Chunk* const chunk = chunkPtr.get();
+        ChunkRuntime* const runtime = runtime_for(chunk);
+        if (runtime == nullptr)
+        {
+            continue;
+        }
+
+        ChunkRecord& record = runtime->record;
+        const bool resident = m_chunkCache->is_resident(record.coord);
+        if (resident && record.residency == ChunkResidencyState::Absent)
+        {
+            // Placeholders that rotated into the disc were reset when they entered the ring; the
+            // scheduler generates them from here.
+            record.residency = ChunkResidencyState::Resident;
+        }
+        else if (!resident && record.residency == ChunkResidencyState::Resident)
+        {
+            chunk->reset(record.coord, _geometry.chunk_voxel_width(), _geometry.chunk_voxel_height());
+            reset_chunk_runtime(chunk);
+            _renderResetEvents.enqueue(ChunkRenderResetEvent{
+                .chunk = chunk,
+                .generation = chunk->_gen.load(std::memory_order::acquire)
+            });
+            ++droppedChunks;
+        }
+    }
+
+    TracyPlot("Chunk Residency Dropped", static_cast<int64_t>(droppedChunks));
+}
+
 void ChunkManager::mark_chunk_dirty(Chunk* chunk, const bool dataChanged, const bool lightingInvalidated)
 {
     ChunkRuntime* const runtime = runtime_for(chunk);
@@ -661,6 +859,91 @@ void ChunkManager::queue_generate(Chunk* const chunk)
     });
 }
 
+void ChunkManager::queue_prefetch(const glm::vec3& position, const glm::vec3& velocity)
+{
+    ZoneScopedN("ChunkManager::QueuePrefetch");
+    const int keepRadius = _viewDistance + (ChunkPrefetchBandChunks * 2);
+    std::erase_if(_prefetchedChunks, [this, keepRadius](const auto& entry)
+    {
+        return !is_chunk_offset_resident(entry.first.x - _lastPlayerChunk.x, entry.first.z - _lastPlayerChunk.z, keepRadius);
+    });
+    TracyPlot("Chunk Prefetch Held", static_cast<int64_t>(_prefetchedChunks.size()));
+
+    // Prefetch is the lowest priority generation work: it only runs once the ring itself is caught up.
+    const glm::vec2 heading{velocity.x, velocity.z};
+    if (m_chunkCache == nullptr || _ringGenerateBacklog > 0 || glm::length(heading) < ChunkPrefetchMinSpeed)
+    {
+        return;
+    }
+
+    const size_t maxHeldChunks = static_cast<size_t>(4 * ((2 * _viewDistance) + 1));
+    const int maxJobsInFlight = std::max(1, _generateWorkerCount);
+    if (_prefetchJobsInFlight >= maxJobsInFlight || _prefetchedChunks.size() >= maxHeldChunks)
+    {
+        return;
+    }
+
+    const glm::vec3 predictedPosition = position + (glm::vec3(velocity.x, 0.0f, velocity.z) * ChunkPrefetchLookaheadSeconds);
+    const ChunkCoord predictedChunk = World::get_chunk_coordinates(predictedPosition, _geometry);
+    for (const ChunkCoord coord : plan_chunk_prefetch(_lastPlayerChunk, predictedChunk, heading, _viewDistance))
+    {
+        if (_prefetchJobsInFlight >= maxJobsInFlight || _prefetchedChunks.size() >= maxHeldChunks)
+        {
+            break;
+        }
+        if (_prefetchedChunks.contains(coord))
+        {
+            continue;
+        }
+
+        _prefetchedChunks.emplace(coord, PrefetchedChunk{ .jobInFlight = true });
+        ++_prefetchJobsInFlight;
+        const uint32_t epoch = _prefetchEpoch;
+        const glm::ivec2 voxelOrigin(coord.x * _geometry.chunk_voxel_width(), coord.z * _geometry.chunk_voxel_width());
+        _generateThreadPool.post([this, coord, epoch, voxelOrigin]() noexcept
+        {
+            auto generated = std::make_shared<ChunkData>(
+                coord,
+                voxelOrigin,
+                _geometry.chunk_voxel_width(),
+                _geometry.chunk_voxel_height());
+            generated->generate();
+
+            _prefetchResults.enqueue(ChunkPrefetchResult{
+                .coord = coord,
+                .epoch = epoch,
+                .data = std::move(generated)
+            });
+        });
+    }
+}
+
+void ChunkManager::reset_prefetch()
+{
+    // Jobs still running finish into the old epoch and are discarded.
+    _prefetchedChunks.clear();
+    ++_prefetchEpoch;
+}
+
+bool ChunkManager::take_prefetched_chunk(Chunk* const chunk, ChunkRecord& record)
+{
+    const auto it = _prefetchedChunks.find(record.coord);
+    if (it == _prefetchedChunks.end())
+    {
+        return false;
+    }
+
+    if (it->second.jobInFlight)
+    {
+        // Its prefetch is already being generated; generating it again would only race it.
+        return true;
+    }
+
+    apply_generated_data(chunk, record, std::move(it->second.data));
+    _prefetchedChunks.erase(it);
+    return true;
+}
+
 void ChunkManager::queue_light(Chunk* const chunk, const uint64_t neighborhoodSignature, const ChunkNeighborhood& neighborhood)
 {
     ZoneScopedN("ChunkManager::QueueLight");
@@ -709,11 +992,13 @@ void ChunkManager::queue_mesh(
     const uint32_t generationId = record.chunkGenerationId;
     const uint32_t dataVersion = record.dataVersion;
     const WorldGeometry geometry = _geometry;
+    const int lodScale = desired_mesh_lod(record);
 
-    _meshThreadPool.post([this, chunk, generationId, dataVersion, neighborhoodSignature, neighborhood, geometry]() noexcept
+    _meshThreadPool.post([this, chunk, generationId, dataVersion, neighborhoodSignature, neighborhood, geometry, lodScale]() noexcept
     {
-        ChunkMesher mesher{ neighborhood, geometry, _ambientOcclusionEnabled };
+        ChunkMesher mesher{ neighborhood, geometry, _ambientOcclusionEnabled, lodScale };
         auto meshData = mesher.generate_mesh();
+        meshData->hash_contents();
 
         _meshResults.enqueue(ChunkMeshBuildResult{
             .chunk = chunk,
@@ -721,6 +1006,7 @@ void ChunkManager::queue_mesh(
             .generationId = generationId,
             .dataVersion = dataVersion,
             .neighborhoodSignature = neighborhoodSignature,
+            .lodScale = lodScale,
             .meshData = std::move(meshData)
         });
     });
@@ -771,6 +1057,11 @@ bool ChunkManager::try_dequeue_render_ready(ChunkRenderReadyEvent& event)
     return _renderReadyEvents.try_dequeue(event);
 }
 
+bool ChunkManager::try_dequeue_horizon_tile(HorizonTileEvent& event)
+{
+    return _horizonTerrain.try_dequeue_event(event);
+}
+
 std::optional<ChunkNeighborhood> ChunkManager::build_neighborhood(const ChunkCoord coord) const
 {
     if (m_chunkCache == nullptr)
@@ -897,6 +1188,14 @@ uint64_t ChunkManager::compute_light_signature(const ChunkNeighborhood& neighbor
     return signature;
 }
 
+int ChunkManager::desired_mesh_lod(const ChunkRecord& record) const noexcept
+{
+    const int ringDistance = std::max(
+        std::abs(record.coord.x - _lastPlayerChunk.x),
+        std::abs(record.coord.z - _lastPlayerChunk.z));
+    return select_chunk_mesh_lod(ringDistance, record.meshLodScale);
+}
+
 uint64_t ChunkManager::compute_mesh_signature(const ChunkNeighborhood& neighborhood) const
 {
     auto mix = [](const uint64_t seed, const uint64_t value)
@@ -912,6 +1211,8 @@ uint64_t ChunkManager::compute_mesh_signature(const ChunkNeighborhood& neighborh
             signature = mix(signature, centerRuntime->record.dataVersion);
             signature = mix(signature, centerRuntime->record.lightVersion);
             signature = mix(signature, _ambientOcclusionEnabled ? 1ULL : 0ULL);
+            // Crossing into a finer LOD band changes the signature, so the chunk remeshes in more detail.
+            signature = mix(signature, static_cast<uint64_t>(desired_mesh_lod(centerRuntime->record)));
         }
     }
 
@@ -6,8 +6,10 @@
 #include "chunk_dirty_tracker.h"
 #include "chunk_lighting.h"
 #include "chunk_neighborhood.h"
+#include "chunk_prefetch.h"
 #include "chunk_record.h"
 #include "chunk_scheduler.h"
+#include "horizon_terrain.h"
 #include "thread_pool.h"
 #include "world_geometry.h"
 #include "world_edit_queue.h"
@@ -47,6 +49,8 @@ struct MapRange
 struct ChunkStreamingSettings
 {
     int viewDistance{GameConfig::DEFAULT_VIEW_DISTANCE};
+    // Chunks of low-detail heightfield drawn past viewDistance.
+    int horizonDistance{0};
 };
 
 struct ChunkMeshSettings
@@ -94,21 +98,38 @@ public:
     ChunkManager();
     ~ChunkManager();
 
-    void update_player_position(const glm::vec3& position);
+    // velocity (world units per second) drives the prefetch of chunks ahead of the ring.
+    void update_player_position(const glm::vec3& position, const glm::vec3& velocity = glm::vec3(0.0f));
     void enqueue_block_edit(const BlockEdit& edit);
-    void notify_chunk_uploaded(Chunk* chunk, uint32_t generationId, uint64_t neighborhoodSignature);
+    void notify_chunk_uploaded(
+        Chunk* chunk,
+        uint32_t generationId,
+        uint64_t neighborhoodSignature,
+        const std::shared_ptr<ChunkMeshData>& uploadedMesh);
+    // The rebuilt mesh matched what is already on the GPU; keep the uploaded mesh as the chunk's mesh.
+    void notify_chunk_upload_skipped(
+        Chunk* chunk,
+        uint32_t generationId,
+        uint64_t neighborhoodSignature,
+        std::shared_ptr<ChunkMeshData> uploadedMesh);
     Chunk* get_chunk(ChunkCoord coord) const;
     std::optional<ChunkDebugState> debug_state(ChunkCoord coord) const;
     std::optional<ChunkNeighborhood> build_neighborhood(ChunkCoord coord) const;
     void apply_mesh_settings(const ChunkMeshSettings& settings);
     void regenerate_world();
     [[nodiscard]] bool ambient_occlusion_enabled() const noexcept;
+    // Grows or shrinks the chunk ring in place; chunks that stay inside it keep their data and meshes.
     void apply_streaming_settings(const ChunkStreamingSettings& settings);
+    // Remeshes every chunk and horizon tile after the renderer dropped its uploaded meshes.
+    void invalidate_meshes();
     [[nodiscard]] int view_distance() const noexcept;
+    [[nodiscard]] ChunkCoord player_chunk() const noexcept { return _lastPlayerChunk; }
     void set_world_geometry(const WorldGeometrySettings& settings) noexcept;
     [[nodiscard]] const WorldGeometry& geometry() const noexcept { return _geometry; }
     bool try_dequeue_render_reset(ChunkRenderResetEvent& event);
     bool try_dequeue_render_ready(ChunkRenderReadyEvent& event);
+    bool try_dequeue_horizon_tile(HorizonTileEvent& event);
+    [[nodiscard]] const HorizonTerrainStats& horizon_stats() const noexcept { return _horizonTerrain.stats(); }
 
 private:
     struct ChunkGenerateResult
@@ -125,6 +146,7 @@ private:
         uint32_t generationId{};
         uint32_t dataVersion{};
         uint64_t neighborhoodSignature{};
+        int lodScale{1};
         std::shared_ptr<ChunkMeshData> meshData{};
     };
 
@@ -138,6 +160,20 @@ private:
         std::shared_ptr<ChunkData> litData{};
     };
 
+    struct ChunkPrefetchResult
+    {
+        ChunkCoord coord{};
+        uint32_t epoch{};
+        std::shared_ptr<ChunkData> data{};
+    };
+
+    // Generated ahead of the ring and held until the ring slides onto it.
+    struct PrefetchedChunk
+    {
+        std::shared_ptr<ChunkData> data{};
+        bool jobInFlight{false};
+    };
+
     struct ChunkRuntime
     {
         ChunkRecord record{};
@@ -147,11 +183,17 @@ private:
     void drain_generate_results();
     void drain_light_results();
     void drain_mesh_results();
+    void drain_prefetch_results();
     void apply_pending_world_edits();
     void run_scheduler();
     void reset_chunk_runtime(Chunk* chunk);
+    void update_residency();
     void mark_chunk_dirty(Chunk* chunk, bool dataChanged, bool lightingInvalidated);
     void queue_generate(Chunk* chunk);
+    void queue_prefetch(const glm::vec3& position, const glm::vec3& velocity);
+    void reset_prefetch();
+    [[nodiscard]] bool take_prefetched_chunk(Chunk* chunk, ChunkRecord& record);
+    void apply_generated_data(Chunk* chunk, ChunkRecord& record, std::shared_ptr<ChunkData> data);
     void queue_light(Chunk* chunk, uint64_t neighborhoodSignature, const ChunkNeighborhood& neighborhood);
     void queue_mesh(Chunk* chunk, uint64_t neighborhoodSignature, const ChunkNeighborhood& neighborhood);
     [[nodiscard]] bool try_queue_light_for_chunk(Chunk* chunk);
@@ -160,6 +202,7 @@ private:
     [[nodiscard]] std::optional<ChunkNeighborhood> build_light_neighborhood(ChunkCoord coord) const;
     [[nodiscard]] uint64_t compute_light_signature(const ChunkNeighborhood& neighborhood) const;
     [[nodiscard]] uint64_t compute_mesh_signature(const ChunkNeighborhood& neighborhood) const;
+    [[nodiscard]] int desired_mesh_lod(const ChunkRecord& record) const noexcept;
     [[nodiscard]] bool required_neighbors_have_data(ChunkCoord coord, uint64_t& signature, ChunkNeighborhood& neighborhood) const;
     [[nodiscard]] bool required_neighbors_have_lighting(ChunkCoord coord, uint64_t& signature, ChunkNeighborhood& neighborhood) const;
 
@@ -169,19 +212,26 @@ private:
     int _generateWorkerCount{1};
     int _lightWorkerCount{1};
     int _meshWorkerCount{2};
+    // Ring chunks waiting on generation after the last scheduler pass; prefetching waits for zero.
+    int _ringGenerateBacklog{0};
+    int _prefetchJobsInFlight{0};
+    uint32_t _prefetchEpoch{0};
     ChunkCoord _lastPlayerChunk = {0, 0};
     WorldGeometry _geometry{};
 
     std::unordered_map<Chunk*, ChunkRuntime> _runtimeByChunk;
+    std::unordered_map<ChunkCoord, PrefetchedChunk> _prefetchedChunks;
     moodycamel::BlockingConcurrentQueue<ChunkRenderResetEvent> _renderResetEvents;
     moodycamel::BlockingConcurrentQueue<ChunkRenderReadyEvent> _renderReadyEvents;
     moodycamel::BlockingConcurrentQueue<ChunkGenerateResult> _generateResults;
     moodycamel::BlockingConcurrentQueue<ChunkLightBuildResult> _lightResults;
     moodycamel::BlockingConcurrentQueue<ChunkMeshBuildResult> _meshResults;
+    moodycamel::BlockingConcurrentQueue<ChunkPrefetchResult> _prefetchResults;
 
     ThreadPool _generateThreadPool;
     ThreadPool _lightThreadPool;
     ThreadPool _meshThreadPool;
+    HorizonTerrain _horizonTerrain{1};
     ChunkScheduler _scheduler{};
     ChunkDirtyTracker _dirtyTracker{};
     WorldEditQueue _worldEditQueue{};
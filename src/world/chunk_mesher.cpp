@@ -1,6 +1,12 @@
 
 #include "chunk_mesher.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "../game/block.h"
+#include "section_visibility.h"
 #include "terrain_gen.h"
 #include "tracy/Tracy.hpp"
 #include <game/world.h>
@@ -24,6 +30,70 @@ namespace
         const float tint = glm::mix(0.96f, 1.04f, noise);
         return glm::clamp(baseColor * tint, glm::vec3(0.0f), glm::vec3(1.0f));
     }
+
+    int target_chunk_mesh_lod(const int ringDistance) noexcept
+    {
+        if (ringDistance <= ChunkMeshFullDetailRings)
+        {
+            return 1;
+        }
+        return ringDistance <= ChunkMeshHalfDetailRings ? 2 : 4;
+    }
+
+    // Visits the full-resolution voxels just outside one face of the scale^3 cell at cellOrigin until
+    // the visitor returns true.
+    template <typename Visitor>
+    bool any_face_layer_voxel(const glm::ivec3& cellOrigin, const int scale, const FaceDirection face, Visitor&& visitor)
+    {
+        const glm::ivec3 offset{ faceOffsetX[face], faceOffsetY[face], faceOffsetZ[face] };
+        glm::ivec3 begin{};
+        glm::ivec3 end{};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (offset[axis] == 0)
+            {
+                begin[axis] = cellOrigin[axis];
+                end[axis] = cellOrigin[axis] + scale;
+            }
+            else
+            {
+                begin[axis] = offset[axis] > 0 ? cellOrigin[axis] + scale : cellOrigin[axis] - 1;
+                end[axis] = begin[axis] + 1;
+            }
+        }
+
+        for (int x = begin.x; x < end.x; ++x)
+        {
+            for (int y = begin.y; y < end.y; ++y)
+            {
+                for (int z = begin.z; z < end.z; ++z)
+                {
+                    if (visitor(glm::ivec3{ x, y, z }))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    enum class LodCellKind : uint8_t
+    {
+        Air = 0,
+        Solid = 1,
+        Water = 2
+    };
+}
+
+int select_chunk_mesh_lod(const int ringDistance, const int currentLodScale) noexcept
+{
+    const int target = target_chunk_mesh_lod(ringDistance);
+    if (currentLodScale <= 0 || target <= currentLodScale)
+    {
+        return target;
+    }
+    return std::max(currentLodScale, target_chunk_mesh_lod(ringDistance - 1));
 }
 
 std::shared_ptr<ChunkMeshData> ChunkMesher::generate_mesh()
@@ -40,9 +110,26 @@ std::shared_ptr<ChunkMeshData> ChunkMesher::generate_mesh()
     _seaLevel = TerrainGenerator::sea_level();
     const int chunkVoxelWidth = chunk->voxelWidth;
     const int chunkVoxelHeight = chunk->voxelHeight;
+    const int meshFloorY = mesh_floor_y();
+    const int meshCeilingY = chunk->heightmap.valid() ?
+        std::min(chunkVoxelHeight, chunk->heightmap.maxOccupiedY + 1) :
+        chunkVoxelHeight;
+    TracyPlot("ChunkMesher Scanned Rows", static_cast<int64_t>(std::max(0, meshCeilingY - meshFloorY)));
+
+    int lodScale = std::max(1, _lodScale);
+    while (lodScale > 1 && (chunkVoxelWidth % lodScale != 0 || chunkVoxelHeight % lodScale != 0))
+    {
+        lodScale /= 2;
+    }
+    if (lodScale > 1)
+    {
+        generate_lod_mesh(*chunkMeshData, lodScale, meshFloorY, meshCeilingY);
+        chunkMeshData->connectivity = std::make_shared<const ChunkConnectivity>(compute_chunk_connectivity(*chunk));
+        return chunkMeshData;
+    }
 
     for (int x = 0; x < chunkVoxelWidth; ++x) {
-        for (int y = 0; y < chunkVoxelHeight; ++y) {
+        for (int y = meshFloorY; y < meshCeilingY; ++y) {
             for (int z = 0; z < chunkVoxelWidth; ++z) {
                 const Block& block = chunk->blocks[x][y][z];
                 const BlockEmissionDef emission = get_block_emission(block._type);
@@ -72,9 +159,194 @@ std::shared_ptr<ChunkMeshData> ChunkMesher::generate_mesh()
         }
     }
 
+    chunkMeshData->connectivity = std::make_shared<const ChunkConnectivity>(compute_chunk_connectivity(*chunk));
     return chunkMeshData;
 }
 
+void ChunkMesher::generate_lod_mesh(ChunkMeshData& meshData, const int scale, const int meshFloorY, const int meshCeilingY)
+{
+    ZoneScopedN("Generate Chunk LOD Mesh");
+
+    // Each scale^3 cell is solid when any of its voxels is (so silhouettes never shrink) and takes the
+    // colour of its most common solid block; cells with only water and air become water.
+    const ChunkData& chunk = *_neighborhood.center;
+    const int cellsXZ = chunk.voxelWidth / scale;
+    const int cellsY = chunk.voxelHeight / scale;
+    const int firstCellY = meshFloorY / scale;
+    const int endCellY = std::min(cellsY, (meshCeilingY + scale - 1) / scale);
+    if (firstCellY >= endCellY)
+    {
+        return;
+    }
+
+    const int rows = endCellY - firstCellY;
+    const auto cell_index = [&](const int cx, const int cy, const int cz)
+    {
+        return (static_cast<size_t>(cx) * rows + static_cast<size_t>(cy - firstCellY)) * cellsXZ + static_cast<size_t>(cz);
+    };
+    std::vector<LodCellKind> kinds(static_cast<size_t>(cellsXZ) * rows * cellsXZ, LodCellKind::Air);
+    std::vector<glm::ivec3> representatives(kinds.size(), glm::ivec3(0));
+
+    for (int cx = 0; cx < cellsXZ; ++cx)
+    {
+        for (int cy = firstCellY; cy < endCellY; ++cy)
+        {
+            for (int cz = 0; cz < cellsXZ; ++cz)
+            {
+                const glm::ivec3 origin{ cx * scale, cy * scale, cz * scale };
+                std::array<int, std::size(blockColor)> solidCounts{};
+                std::array<glm::ivec3, std::size(blockColor)> highest{};
+                bool hasWater = false;
+                for (int x = origin.x; x < origin.x + scale; ++x)
+                {
+                    for (int y = origin.y; y < origin.y + scale; ++y)
+                    {
+                        for (int z = origin.z; z < origin.z + scale; ++z)
+                        {
+                            const Block& block = chunk.blocks[x][y][z];
+                            const BlockEmissionDef emission = get_block_emission(block._type);
+                            if (emission.hasGlow)
+                            {
+                                add_glow_to_mesh(x, y, z, emission, meshData.glowMesh);
+                            }
+                            if (block._solid)
+                            {
+                                ++solidCounts[block._type];
+                                highest[block._type] = glm::ivec3{ x, y, z };
+                            }
+                            else if (block._type == BlockType::WATER)
+                            {
+                                hasWater = true;
+                            }
+                        }
+                    }
+                }
+
+                const auto majority = std::ranges::max_element(solidCounts);
+                const size_t index = cell_index(cx, cy, cz);
+                if (*majority > 0)
+                {
+                    kinds[index] = LodCellKind::Solid;
+                    representatives[index] = highest[static_cast<size_t>(majority - solidCounts.begin())];
+                }
+                else if (hasWater)
+                {
+                    kinds[index] = LodCellKind::Water;
+                }
+            }
+        }
+    }
+
+    const auto neighbor_kind = [&](const int cx, const int cy, const int cz)
+    {
+        if (cy < firstCellY)
+        {
+            // Everything under the mesh floor is enclosed solid.
+            return LodCellKind::Solid;
+        }
+        if (cy >= endCellY)
+        {
+            return cy >= cellsY ? LodCellKind::Solid : LodCellKind::Air;
+        }
+        return kinds[cell_index(cx, cy, cz)];
+    };
+
+    uint32_t faces = 0;
+    for (int cx = 0; cx < cellsXZ; ++cx)
+    {
+        for (int cy = firstCellY; cy < endCellY; ++cy)
+        {
+            for (int cz = 0; cz < cellsXZ; ++cz)
+            {
+                const size_t index = cell_index(cx, cy, cz);
+                const LodCellKind kind = kinds[index];
+                if (kind == LodCellKind::Air)
+                {
+                    continue;
+                }
+
+                const bool water = kind == LodCellKind::Water;
+                const glm::ivec3 origin{ cx * scale, cy * scale, cz * scale };
+                const glm::ivec3 representative = representatives[index];
+                for (const auto face : faceDirections)
+                {
+                    const int nx = cx + faceOffsetX[face];
+                    const int nz = cz + faceOffsetZ[face];
+                    bool visible = false;
+                    if (nx < 0 || nx >= cellsXZ || nz < 0 || nz >= cellsXZ)
+                    {
+                        // The neighbour chunk may be meshed at another resolution, so border faces are
+                        // tested against its real voxels; that keeps LOD seams closed from both sides.
+                        visible = is_lod_border_face_open(origin, scale, face, water);
+                    }
+                    else
+                    {
+                        const LodCellKind neighbor = neighbor_kind(nx, cy + faceOffsetY[face], nz);
+                        visible = water ? neighbor == LodCellKind::Air : neighbor != LodCellKind::Solid;
+                    }
+                    if (!visible)
+                    {
+                        continue;
+                    }
+
+                    const glm::vec3 color = water ?
+                        static_cast<glm::vec3>(blockColor[BlockType::WATER]) :
+                        opaque_block_color(representative, chunk.blocks[representative.x][representative.y][representative.z]);
+                    add_lod_face(origin, scale, face, color, water ? meshData.waterMesh : meshData.mesh);
+                    ++faces;
+                }
+            }
+        }
+    }
+
+    TracyPlot("ChunkMesher LOD Faces", static_cast<int64_t>(faces));
+}
+
+bool ChunkMesher::is_lod_border_face_open(const glm::ivec3& cellOrigin, const int scale, const FaceDirection face, const bool water) const
+{
+    return any_face_layer_voxel(cellOrigin, scale, face, [&](const glm::ivec3& voxel)
+    {
+        if (water)
+        {
+            const auto sample = sample_block(_neighborhood, voxel.x, voxel.y, voxel.z);
+            return sample.has_value() && sample->block._type == BlockType::AIR;
+        }
+        return !is_position_solid(voxel);
+    });
+}
+
+void ChunkMesher::add_lod_face(
+    const glm::ivec3& cellOrigin,
+    const int scale,
+    const FaceDirection face,
+    const glm::vec3& color,
+    const std::shared_ptr<Mesh>& mesh) const
+{
+    // Coarse faces skip AO and take the brightest light next to them; at LOD distances that reads the
+    // same as the smoothed full-resolution lighting and never darkens a face that is partly open.
+    uint8_t sunLight = 0;
+    glm::vec3 localLight{0.0f};
+    any_face_layer_voxel(cellOrigin, scale, face, [&](const glm::ivec3& voxel)
+    {
+        sunLight = std::max(sunLight, sample_sunlight(voxel));
+        localLight = glm::max(localLight, sample_local_light(voxel));
+        return false;
+    });
+
+    const glm::vec2 lighting{ static_cast<float>(sunLight) / static_cast<float>(MAX_LIGHT_LEVEL), 1.0f };
+    for (int i = 0; i < 4; ++i)
+    {
+        const glm::ivec3 position = cellOrigin + faceVertices[face][i] * scale;
+        mesh->_vertices.push_back({
+            _geometry.voxel_to_world(glm::vec3(position)),
+            faceNormals[face],
+            color,
+            lighting,
+            localLight
+        });
+    }
+}
+
 void ChunkMesher::add_glow_to_mesh(const int x, const int y, const int z, const BlockEmissionDef& emission, const std::shared_ptr<Mesh>& mesh) const
 {
     const glm::vec3 center = _geometry.voxel_to_world(glm::vec3(
@@ -101,14 +373,59 @@ void ChunkMesher::add_glow_to_mesh(const int x, const int y, const int z, const
             glm::vec3(0.0f)
         });
     }
+}
+
+int ChunkMesher::mesh_floor_y() const
+{
+    // A solid block only produces faces when a face neighbor is non-solid, so rows below the lowest
+    // open cell of this chunk and its edge neighbors are fully enclosed. Glow quads ignore exposure.
+    const ChunkData& chunk = *_neighborhood.center;
+    if (!chunk.heightmap.valid() || chunk.has_emissive_blocks())
+    {
+        return 0;
+    }
+
+    const int chunkVoxelWidth = chunk.voxelWidth;
+    int floorY = chunk.voxelHeight;
+    for (int x = 0; x < chunkVoxelWidth; ++x)
+    {
+        for (int z = 0; z < chunkVoxelWidth; ++z)
+        {
+            floorY = std::min(floorY, chunk.lowest_non_solid_y(x, z) - 1);
+        }
+    }
 
-    const uint32_t index = static_cast<uint32_t>(mesh->_vertices.size() - 4);
-    mesh->_indices.push_back(index + 0);
-    mesh->_indices.push_back(index + 1);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 3);
-    mesh->_indices.push_back(index + 0);
+    constexpr std::array<glm::ivec2, 4> EdgeNeighborOffsets{{
+        { -1, 0 },
+        { 1, 0 },
+        { 0, -1 },
+        { 0, 1 }
+    }};
+    for (const glm::ivec2 offset : EdgeNeighborOffsets)
+    {
+        const ChunkData* const neighbor = _neighborhood.get_by_offset(offset.x, offset.y);
+        if (neighbor == nullptr || !neighbor->has_block_storage())
+        {
+            // Missing neighbors sample as solid and never expose a face.
+            continue;
+        }
+
+        if (!neighbor->heightmap.valid())
+        {
+            return 0;
+        }
+
+        const int borderX = offset.x < 0 ? chunkVoxelWidth - 1 : 0;
+        const int borderZ = offset.y < 0 ? chunkVoxelWidth - 1 : 0;
+        for (int i = 0; i < chunkVoxelWidth; ++i)
+        {
+            const int x = offset.x != 0 ? borderX : i;
+            const int z = offset.y != 0 ? borderZ : i;
+            floorY = std::min(floorY, neighbor->lowest_non_solid_y(x, z));
+        }
+    }
+
+    return std::max(0, floorY);
 }
 
 std::optional<const Block> ChunkMesher::get_face_neighbor(const int x, const int y, const int z, const FaceDirection face) const
@@ -271,16 +588,13 @@ glm::vec3 ChunkMesher::sample_local_light(const glm::ivec3& localPos) const
         static_cast<float>(sample->block._localLight.b)) / static_cast<float>(MAX_LIGHT_LEVEL);
 }
 
-//note: a block's position is the back-bottom-right of the cube.
-void ChunkMesher::add_face_to_opaque_mesh(const int x, const int y, const int z, const FaceDirection face, const std::shared_ptr<Mesh>& mesh)
+glm::vec3 ChunkMesher::opaque_block_color(const glm::ivec3& blockPos, const Block& block) const
 {
-    const glm::ivec3 blockPos{x,y,z};
-    const Block block = _neighborhood.center->blocks[x][y][z];
     glm::vec3 color = static_cast<glm::vec3>(blockColor[block._type]);
     if (_neighborhood.center->terrainAppearance != nullptr &&
         (block._type == BlockType::GROUND || block._type == BlockType::STONE || block._type == BlockType::SAND))
     {
-        const uint32_t packedColor = _neighborhood.center->terrainAppearance->packed_color(x, y, z);
+        const uint32_t packedColor = _neighborhood.center->terrainAppearance->packed_color(blockPos.x, blockPos.y, blockPos.z);
         if (packedColor != 0u)
         {
             color = unpack_appearance_color(packedColor);
@@ -289,13 +603,21 @@ void ChunkMesher::add_face_to_opaque_mesh(const int x, const int y, const int z,
 
     if (block._type == BlockType::GROUND || block._type == BlockType::LEAVES)
     {
-        const float heightFactor = std::clamp((static_cast<float>(y) - static_cast<float>(_seaLevel)) / 96.0f, 0.0f, 1.0f);
+        const float heightFactor = std::clamp((static_cast<float>(blockPos.y) - static_cast<float>(_seaLevel)) / 96.0f, 0.0f, 1.0f);
         color *= glm::mix(0.97f, 1.04f, heightFactor);
     }
     else if (block._type == BlockType::CLOUD)
     {
         color = tint_cloud_color(color, blockPos, _neighborhood.center->position);
     }
+    return color;
+}
+
+//note: a block's position is the back-bottom-right of the cube.
+void ChunkMesher::add_face_to_opaque_mesh(const int x, const int y, const int z, const FaceDirection face, const std::shared_ptr<Mesh>& mesh)
+{
+    const glm::ivec3 blockPos{x,y,z};
+    const glm::vec3 color = opaque_block_color(blockPos, _neighborhood.center->blocks[x][y][z]);
 
     for (int i = 0; i < 4; ++i) {
         glm::ivec3 position = blockPos + faceVertices[face][i];
@@ -312,15 +634,6 @@ void ChunkMesher::add_face_to_opaque_mesh(const int x, const int y, const int z,
             localLight
         });
     }
-
-    // Add indices for the face (two triangles)
-    const uint32_t index = mesh->_vertices.size() - 4;
-    mesh->_indices.push_back(index + 0);
-    mesh->_indices.push_back(index + 1);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 3);
-    mesh->_indices.push_back(index + 0);
 }
 
 void ChunkMesher::add_face_to_water_mesh(const int x, const int y, const int z, const FaceDirection face, const std::shared_ptr<Mesh>& mesh) const
@@ -342,12 +655,4 @@ void ChunkMesher::add_face_to_water_mesh(const int x, const int y, const int z,
             localLight
         });
     }
-
-    uint32_t index = mesh->_vertices.size() - 4;
-    mesh->_indices.push_back(index + 0);
-    mesh->_indices.push_back(index + 1);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 2);
-    mesh->_indices.push_back(index + 3);
-    mesh->_indices.push_back(index + 0);
 }
@@ -4,15 +4,26 @@
 #include "chunk_neighborhood.h"
 #include "world_geometry.h"
 
+// Chunks within this many rings of the player mesh at full resolution, the next band at half.
+inline constexpr int ChunkMeshFullDetailRings = 6;
+inline constexpr int ChunkMeshHalfDetailRings = 10;
+
+// Voxels per LOD cell edge (1, 2 or 4) for a chunk ringDistance chunks from the player. Finer levels
+// apply at once; a coarser level waits until it would still apply one ring closer, so walking along
+// a band edge does not remesh the same chunks back and forth. currentLodScale 0 means not meshed yet.
+[[nodiscard]] int select_chunk_mesh_lod(int ringDistance, int currentLodScale) noexcept;
+
 class ChunkMesher {
 public:
     explicit ChunkMesher(
         ChunkNeighborhood neighborhood,
         WorldGeometry geometry = WorldGeometry{},
-        const bool ambientOcclusionEnabled = true) :
+        const bool ambientOcclusionEnabled = true,
+        const int lodScale = 1) :
         _neighborhood(std::move(neighborhood)),
         _geometry(std::move(geometry)),
-        _ambientOcclusionEnabled(ambientOcclusionEnabled) {}
+        _ambientOcclusionEnabled(ambientOcclusionEnabled),
+        _lodScale(lodScale) {}
 
     std::shared_ptr<ChunkMeshData> generate_mesh();
 
@@ -20,11 +31,17 @@ private:
     ChunkNeighborhood _neighborhood;
     WorldGeometry _geometry{};
     bool _ambientOcclusionEnabled{true};
+    int _lodScale{1};
     int _seaLevel{0};
 
+    [[nodiscard]] int mesh_floor_y() const;
     std::optional<const Block> get_face_neighbor(int x, int y, int z, FaceDirection face) const;
     bool is_face_visible(int x, int y, int z, FaceDirection face);
     bool is_face_visible_water(int x, int y, int z, FaceDirection face);
+    void generate_lod_mesh(ChunkMeshData& meshData, int scale, int meshFloorY, int meshCeilingY);
+    [[nodiscard]] bool is_lod_border_face_open(const glm::ivec3& cellOrigin, int scale, FaceDirection face, bool water) const;
+    void add_lod_face(const glm::ivec3& cellOrigin, int scale, FaceDirection face, const glm::vec3& color, const std::shared_ptr<Mesh>& mesh) const;
+    [[nodiscard]] glm::vec3 opaque_block_color(const glm::ivec3& blockPos, const Block& block) const;
     void add_face_to_opaque_mesh(int x, int y, int z, FaceDirection face, const std::shared_ptr<Mesh>& mesh);
     void add_face_to_water_mesh(int x, int y, int z, FaceDirection face, const std::shared_ptr<Mesh>& mesh) const;
     void add_glow_to_mesh(int x, int y, int z, const BlockEmissionDef& emission, const std::shared_ptr<Mesh>& mesh) const;
@@ -0,0 +1,48 @@
+#include "chunk_prefetch.h"
+
+#include <algorithm>
+
+std::vector<ChunkCoord> plan_chunk_prefetch(
+    const ChunkCoord current,
+    const ChunkCoord predicted,
+    const glm::vec2 heading,
+    const int viewDistance)
+{
+    std::vector<ChunkCoord> coords{};
+    if (heading == glm::vec2(0.0f))
+    {
+        return coords;
+    }
+
+    const int radius = viewDistance + ChunkPrefetchBandChunks;
+    for (int x = predicted.x - radius; x <= predicted.x + radius; ++x)
+    {
+        for (int z = predicted.z - radius; z <= predicted.z + radius; ++z)
+        {
+            const int offsetX = x - current.x;
+            const int offsetZ = z - current.z;
+            if (!is_chunk_offset_resident(x - predicted.x, z - predicted.z, radius) ||
+                is_chunk_offset_resident(offsetX, offsetZ, viewDistance))
+            {
+                continue;
+            }
+
+            if ((static_cast<float>(offsetX) * heading.x) + (static_cast<float>(offsetZ) * heading.y) <= 0.0f)
+            {
+                continue;
+            }
+
+            coords.push_back(ChunkCoord{x, z});
+        }
+    }
+
+    std::ranges::sort(coords, [current](const ChunkCoord& lhs, const ChunkCoord& rhs)
+    {
+        const int lhsX = lhs.x - current.x;
+        const int lhsZ = lhs.z - current.z;
+        const int rhsX = rhs.x - current.x;
+        const int rhsZ = rhs.z - current.z;
+        return (lhsX * lhsX) + (lhsZ * lhsZ) < (rhsX * rhsX) + (rhsZ * rhsZ);
+    });
+    return coords;
+}
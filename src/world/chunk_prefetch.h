@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include "game/chunk.h"
+
+// How far ahead of the player's velocity chunks are generated before the ring reaches them.
+inline constexpr float ChunkPrefetchLookaheadSeconds = 1.5f;
+// Prefetching also covers this many chunks past the view distance around the predicted position.
+inline constexpr int ChunkPrefetchBandChunks = 2;
+// Below this horizontal speed (world units per second) nothing is prefetched.
+inline constexpr float ChunkPrefetchMinSpeed = 1.0f;
+
+// Chunks outside the current residency disc that will be inside the disc (widened by the prefetch band)
+// around the predicted chunk and lie ahead of the heading, nearest to the current chunk first.
+[[nodiscard]] std::vector<ChunkCoord> plan_chunk_prefetch(
+    ChunkCoord current,
+    ChunkCoord predicted,
+    glm::vec2 heading,
+    int viewDistance);
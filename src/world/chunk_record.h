@@ -44,6 +44,8 @@ struct ChunkRecord
     ChunkCoord coord{0, 0};
     std::shared_ptr<ChunkData> data{};
     std::shared_ptr<ChunkMeshData> mesh{};
+    // The mesh the renderer is drawing. It lags `mesh` while a newer build waits for its upload.
+    std::weak_ptr<ChunkMeshData> drawnMesh{};
 
     uint32_t chunkGenerationId{1};
     uint32_t dataVersion{0};
@@ -61,4 +63,6 @@ struct ChunkRecord
     bool lightJobInFlight{false};
     bool meshJobInFlight{false};
     bool uploadPending{false};
+    // Voxels per mesh cell edge of the current mesh (see select_chunk_mesh_lod); 0 before the first mesh.
+    uint8_t meshLodScale{0};
 };
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 #include <tracy/Tracy.hpp>
 
 namespace
@@ -294,6 +295,77 @@ void terrain_generation::fill_column_scaffold(
     }
 }
 
+void terrain_generation::fill_height_grid(
+    const FastNoise::SmartNode<>& continentalNoise,
+    const FastNoise::SmartNode<>& erosionNoise,
+    const FastNoise::SmartNode<>& peaksNoise,
+    const TerrainGeneratorSettings& settings,
+    const glm::ivec2& origin,
+    const int step,
+    const int samplesPerSide,
+    const int chunkVoxelHeight,
+    const float blockWorldSize,
+    std::vector<int>& heights)
+{
+    ZoneScopedN("terrain_generation::fill_height_grid");
+    if (step <= 0 || origin.x % step != 0 || origin.y % step != 0)
+    {
+        throw std::runtime_error("Height grid origin must be a multiple of a positive step");
+    }
+
+    // Sampling lattice point (origin / step + i) at frequency * step lands on voxel origin + i * step.
+    const int startX = origin.x / step;
+    const int startZ = origin.y / step;
+    const float stride = static_cast<float>(step) * blockWorldSize;
+    const size_t sampleCount = static_cast<size_t>(samplesPerSide) * static_cast<size_t>(samplesPerSide);
+    std::vector<float> continentalMap(sampleCount);
+    std::vector<float> erosionMap(sampleCount);
+    std::vector<float> peaksMap(sampleCount);
+    continentalNoise->GenUniformGrid2D(
+        continentalMap.data(),
+        startX,
+        startZ,
+        samplesPerSide,
+        samplesPerSide,
+        settings.shape.continental.frequency * stride,
+        settings.seed);
+    erosionNoise->GenUniformGrid2D(
+        erosionMap.data(),
+        startX,
+        startZ,
+        samplesPerSide,
+        samplesPerSide,
+        settings.shape.erosion.frequency * stride,
+        settings.seed);
+    peaksNoise->GenUniformGrid2D(
+        peaksMap.data(),
+        startX,
+        startZ,
+        samplesPerSide,
+        samplesPerSide,
+        settings.shape.peaks.frequency * stride,
+        settings.seed + 101);
+
+    heights.resize(sampleCount);
+    for (size_t index = 0; index < sampleCount; ++index)
+    {
+        const TerrainNoiseSample noise{
+            .continentalness = continentalMap[index],
+            .erosion = erosionMap[index],
+            .peaksValleys = peaksMap[index]
+        };
+        heights[index] = clamp_surface_height(compute_surface_height(
+            noise,
+            settings.shape,
+            settings.erosionSplines,
+            settings.peakSplines,
+            settings.continentalSplines,
+            chunkVoxelHeight,
+            blockWorldSize),
+            chunkVoxelHeight);
+    }
+}
+
 void terrain_generation::fill_density_volume(
     const TerrainColumnScaffold2D& columnScaffold,
     const FastNoise::SmartNode<>& densityNoise,
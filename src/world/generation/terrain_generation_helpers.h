@@ -29,6 +29,20 @@ namespace terrain_generation
         float blockWorldSize,
         TerrainColumnScaffold2D& scaffold);
 
+    // Surface heights of the columns at origin + (i * step) on each axis, row-major by z; origin must
+    // be a multiple of step so the strided grid lines up with the per-chunk noise lattice.
+    void fill_height_grid(
+        const FastNoise::SmartNode<>& continentalNoise,
+        const FastNoise::SmartNode<>& erosionNoise,
+        const FastNoise::SmartNode<>& peaksNoise,
+        const TerrainGeneratorSettings& settings,
+        const glm::ivec2& origin,
+        int step,
+        int samplesPerSide,
+        int chunkVoxelHeight,
+        float blockWorldSize,
+        std::vector<int>& heights);
+
     void fill_density_volume(
         const TerrainColumnScaffold2D& columnScaffold,
         const FastNoise::SmartNode<>& densityNoise,
@@ -0,0 +1,486 @@
+#include "horizon_terrain.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <tracy/Tracy.hpp>
+
+#include "game/block.h"
+#include "render/mesh.h"
+#include "terrain_gen.h"
+
+namespace
+{
+    int floor_divide(const int value, const int divisor) noexcept
+    {
+        const int quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    int axis_distance(const int value, const int min, const int max) noexcept
+    {
+        return std::max({min - value, value - max, 0});
+    }
+
+    class HorizonTileMeshBuilder
+    {
+    public:
+        HorizonTileMeshBuilder(
+            const HorizonTileSpec& spec,
+            const std::span<const int> heights,
+            const WorldGeometry& geometry,
+            const int seaLevel) :
+            _spec(spec),
+            _heights(heights),
+            _geometry(geometry),
+            _seaLevel(seaLevel),
+            _chunkWidth(geometry.chunk_voxel_width()),
+            _samples(horizon_tile_samples_per_side(spec, geometry.chunk_voxel_width())),
+            _skirtDepth(std::max(4, spec.lodStep * 2))
+        {
+            if (_heights.size() != static_cast<size_t>((_samples + 1) * (_samples + 1)))
+            {
+                throw std::runtime_error("Horizon tile heights do not match its sample grid");
+            }
+        }
+
+        std::shared_ptr<Mesh> build(RenderBounds& bounds)
+        {
+            auto mesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+            _mesh = mesh.get();
+            for (int cellZ = 0; cellZ < _samples; ++cellZ)
+            {
+                for (int cellX = 0; cellX < _samples; ++cellX)
+                {
+                    if (!covered(cellX, cellZ))
+                    {
+                        continue;
+                    }
+
+                    add_quad(
+                        top_vertex(cellX + 1, cellZ),
+                        top_vertex(cellX, cellZ),
+                        top_vertex(cellX, cellZ + 1),
+                        top_vertex(cellX + 1, cellZ + 1));
+
+                    if (!covered(cellX, cellZ - 1)) add_skirt(cellX, cellZ, cellX + 1, cellZ);
+                    if (!covered(cellX, cellZ + 1)) add_skirt(cellX, cellZ + 1, cellX + 1, cellZ + 1);
+                    if (!covered(cellX - 1, cellZ)) add_skirt(cellX, cellZ, cellX, cellZ + 1);
+                    if (!covered(cellX + 1, cellZ)) add_skirt(cellX + 1, cellZ, cellX + 1, cellZ + 1);
+                }
+            }
+
+            bounds = _bounds;
+            return mesh;
+        }
+
+    private:
+        const HorizonTileSpec& _spec;
+        std::span<const int> _heights;
+        const WorldGeometry& _geometry;
+        int _seaLevel;
+        int _chunkWidth;
+        int _samples;
+        int _skirtDepth;
+        Mesh* _mesh{nullptr};
+        RenderBounds _bounds{};
+
+        [[nodiscard]] int height(const int sampleX, const int sampleZ) const noexcept
+        {
+            return _heights[static_cast<size_t>(sampleZ * (_samples + 1) + sampleX)];
+        }
+
+        // Voxel height of the top of the column, with the sea filled in flat.
+        [[nodiscard]] int surface(const int sampleX, const int sampleZ) const noexcept
+        {
+            return std::max(height(sampleX, sampleZ), _seaLevel) + 1;
+        }
+
+        [[nodiscard]] bool covered(const int cellX, const int cellZ) const noexcept
+        {
+            if (cellX < 0 || cellZ < 0 || cellX >= _samples || cellZ >= _samples)
+            {
+                return false;
+            }
+
+            const int chunkX = (cellX * _spec.lodStep) / _chunkWidth;
+            const int chunkZ = (cellZ * _spec.lodStep) / _chunkWidth;
+            return (_spec.chunkMask & (1u << (chunkZ * HorizonTileChunks + chunkX))) != 0;
+        }
+
+        [[nodiscard]] glm::vec3 normal(const int sampleX, const int sampleZ) const noexcept
+        {
+            const int left = surface(std::max(sampleX - 1, 0), sampleZ);
+            const int right = surface(std::min(sampleX + 1, _samples), sampleZ);
+            const int back = surface(sampleX, std::max(sampleZ - 1, 0));
+            const int front = surface(sampleX, std::min(sampleZ + 1, _samples));
+            return glm::normalize(glm::vec3(
+                static_cast<float>(left - right),
+                static_cast<float>(2 * _spec.lodStep),
+                static_cast<float>(back - front)));
+        }
+
+        [[nodiscard]] Vertex vertex(const int sampleX, const int sampleZ, const int voxelY) const
+        {
+            const bool underwater = height(sampleX, sampleZ) < _seaLevel;
+            return Vertex{
+                _geometry.voxel_to_world(glm::vec3(
+                    static_cast<float>(sampleX * _spec.lodStep),
+                    static_cast<float>(voxelY),
+                    static_cast<float>(sampleZ * _spec.lodStep))),
+                underwater ? glm::vec3(0.0f, 1.0f, 0.0f) : normal(sampleX, sampleZ),
+                static_cast<glm::vec3>(blockColor[underwater ? BlockType::WATER : BlockType::STONE]),
+                glm::vec2(1.0f, 1.0f),
+                glm::vec3(0.0f)
+            };
+        }
+
+        [[nodiscard]] Vertex top_vertex(const int sampleX, const int sampleZ) const
+        {
+            return vertex(sampleX, sampleZ, surface(sampleX, sampleZ));
+        }
+
+        [[nodiscard]] Vertex bottom_vertex(const int sampleX, const int sampleZ) const
+        {
+            return vertex(sampleX, sampleZ, std::max(surface(sampleX, sampleZ) - _skirtDepth, 0));
+        }
+
+        void add_quad(const Vertex& a, const Vertex& b, const Vertex& c, const Vertex& d)
+        {
+            for (const Vertex* corner : {&a, &b, &c, &d})
+            {
+                _mesh->_vertices.push_back(*corner);
+                if (!_bounds.valid)
+                {
+                    _bounds = RenderBounds{.valid = true, .min = corner->position, .max = corner->position};
+                }
+                _bounds.min = glm::min(_bounds.min, corner->position);
+                _bounds.max = glm::max(_bounds.max, corner->position);
+            }
+        }
+
+        // Both windings, since which side faces the camera depends on where the neighbouring terrain is.
+        void add_skirt(const int aX, const int aZ, const int bX, const int bZ)
+        {
+            const Vertex aTop = top_vertex(aX, aZ);
+            const Vertex bTop = top_vertex(bX, bZ);
+            const Vertex aBottom = bottom_vertex(aX, aZ);
+            const Vertex bBottom = bottom_vertex(bX, bZ);
+            add_quad(aTop, bTop, bBottom, aBottom);
+            add_quad(bTop, aTop, aBottom, bBottom);
+        }
+    };
+}
+
+size_t HorizonTileCoordHash::operator()(const HorizonTileCoord& coord) const noexcept
+{
+    size_t seed = std::hash<int>()(coord.x);
+    seed ^= std::hash<int>()(coord.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+int horizon_lod_step(const int ringDistance) noexcept
+{
+    if (ringDistance < 8)
+    {
+        return 2;
+    }
+    return ringDistance < 24 ? 4 : 8;
+}
+
+std::vector<HorizonTilePlan> plan_horizon_tiles(
+    const ChunkCoord center,
+    const int viewDistance,
+    const int horizonDistance,
+    const int chunkVoxelWidth)
+{
+    std::vector<HorizonTilePlan> plans{};
+    if (horizonDistance <= 0)
+    {
+        return plans;
+    }
+
+    const int outerRadius = std::max(viewDistance, 0) + horizonDistance;
+    const int tileVoxels = HorizonTileChunks * chunkVoxelWidth;
+    const int minTileX = floor_divide(center.x - outerRadius, HorizonTileChunks);
+    const int maxTileX = floor_divide(center.x + outerRadius, HorizonTileChunks);
+    const int minTileZ = floor_divide(center.z - outerRadius, HorizonTileChunks);
+    const int maxTileZ = floor_divide(center.z + outerRadius, HorizonTileChunks);
+    for (int tileZ = minTileZ; tileZ <= maxTileZ; ++tileZ)
+    {
+        for (int tileX = minTileX; tileX <= maxTileX; ++tileX)
+        {
+            const int firstChunkX = tileX * HorizonTileChunks;
+            const int firstChunkZ = tileZ * HorizonTileChunks;
+            const int chunkDistance = std::max(
+                axis_distance(center.x, firstChunkX, firstChunkX + HorizonTileChunks - 1),
+                axis_distance(center.z, firstChunkZ, firstChunkZ + HorizonTileChunks - 1));
+            if (chunkDistance > outerRadius)
+            {
+                continue;
+            }
+
+            uint16_t chunkMask = 0;
+            for (int localZ = 0; localZ < HorizonTileChunks; ++localZ)
+            {
+                for (int localX = 0; localX < HorizonTileChunks; ++localX)
+                {
+                    const int offsetX = firstChunkX + localX - center.x;
+                    const int offsetZ = firstChunkZ + localZ - center.z;
+                    if (!is_chunk_offset_meshable(offsetX, offsetZ, viewDistance))
+                    {
+                        chunkMask |= static_cast<uint16_t>(1u << (localZ * HorizonTileChunks + localX));
+                    }
+                }
+            }
+            if (chunkMask == 0)
+            {
+                continue;
+            }
+
+            int lodStep = horizon_lod_step(std::max(chunkDistance - viewDistance, 0));
+            while (lodStep > 1 && tileVoxels % lodStep != 0)
+            {
+                lodStep /= 2;
+            }
+
+            plans.push_back(HorizonTilePlan{
+                .spec = HorizonTileSpec{
+                    .coord = HorizonTileCoord{tileX, tileZ},
+                    .lodStep = lodStep,
+                    .chunkMask = chunkMask
+                },
+                .chunkDistance = chunkDistance
+            });
+        }
+    }
+    return plans;
+}
+
+glm::ivec2 horizon_tile_voxel_origin(const HorizonTileCoord coord, const int chunkVoxelWidth) noexcept
+{
+    return glm::ivec2(coord.x, coord.z) * (HorizonTileChunks * chunkVoxelWidth);
+}
+
+int horizon_tile_samples_per_side(const HorizonTileSpec& spec, const int chunkVoxelWidth) noexcept
+{
+    return (HorizonTileChunks * chunkVoxelWidth) / spec.lodStep;
+}
+
+std::shared_ptr<Mesh> build_horizon_tile_mesh(
+    const HorizonTileSpec& spec,
+    const std::span<const int> heights,
+    const WorldGeometry& geometry,
+    const int seaLevel,
+    RenderBounds& bounds)
+{
+    ZoneScopedN("HorizonTerrain::BuildMesh");
+    HorizonTileMeshBuilder builder(spec, heights, geometry, seaLevel);
+    return builder.build(bounds);
+}
+
+HorizonTerrain::HorizonTerrain(const int workerCount) :
+    _maxJobsInFlight(std::max(workerCount, 1) * 2),
+    _threadPool(workerCount)
+{
+}
+
+void HorizonTerrain::set_world_geometry(const WorldGeometry& geometry)
+{
+    _geometry = geometry;
+    reset();
+}
+
+void HorizonTerrain::reset()
+{
+    ++_epoch;
+    // Builds not yet picked up for tiles still tracked would show stale terrain, so they are dropped and
+    // the removals below cover those tiles. Removals plan() queued for tiles it already erased must stay,
+    // or the scene keeps drawing those tiles.
+    std::erase_if(_events, [this](const HorizonTileEvent& event)
+    {
+        return event.mesh != nullptr && _tiles.contains(event.coord);
+    });
+    for (const auto& [coord, tile] : _tiles)
+    {
+        if (tile.hasBuilt)
+        {
+            _events.push_back(HorizonTileEvent{.coord = coord});
+        }
+    }
+    _tiles.clear();
+    _planned = false;
+}
+
+void HorizonTerrain::set_horizon_distance(const int horizonDistance)
+{
+    const int clamped = std::max(horizonDistance, 0);
+    if (clamped == _horizonDistance)
+    {
+        return;
+    }
+
+    _horizonDistance = clamped;
+    _planned = false;
+}
+
+void HorizonTerrain::update(const ChunkCoord center, const int viewDistance)
+{
+    ZoneScopedN("HorizonTerrain::Update");
+    if (!_planned || center != _center || viewDistance != _viewDistance)
+    {
+        plan(center, viewDistance);
+    }
+
+    drain_results();
+    queue_builds();
+
+    _stats.tiles = static_cast<uint32_t>(_tiles.size());
+    _stats.builtTiles = static_cast<uint32_t>(std::ranges::count_if(_tiles, [](const auto& entry)
+    {
+        return entry.second.hasBuilt;
+    }));
+    _stats.jobsInFlight = static_cast<uint32_t>(_jobsInFlight);
+    TracyPlot("Horizon Tiles", static_cast<int64_t>(_stats.tiles));
+    TracyPlot("Horizon Tile Jobs", static_cast<int64_t>(_stats.jobsInFlight));
+}
+
+bool HorizonTerrain::try_dequeue_event(HorizonTileEvent& event)
+{
+    if (_events.empty())
+    {
+        return false;
+    }
+
+    event = std::move(_events.front());
+    _events.pop_front();
+    return true;
+}
+
+void HorizonTerrain::plan(const ChunkCoord center, const int viewDistance)
+{
+    ZoneScopedN("HorizonTerrain::Plan");
+    _planned = true;
+    _center = center;
+    _viewDistance = viewDistance;
+    ++_planGeneration;
+
+    for (const HorizonTilePlan& plan : plan_horizon_tiles(center, viewDistance, _horizonDistance, _geometry.chunk_voxel_width()))
+    {
+        TileState& tile = _tiles[plan.spec.coord];
+        tile.wanted = plan.spec;
+        tile.chunkDistance = plan.chunkDistance;
+        tile.planGeneration = _planGeneration;
+    }
+
+    std::erase_if(_tiles, [this](const auto& entry)
+    {
+        if (entry.second.planGeneration == _planGeneration)
+        {
+            return false;
+        }
+        if (entry.second.hasBuilt)
+        {
+            _events.push_back(HorizonTileEvent{.coord = entry.first});
+        }
+        return true;
+    });
+}
+
+void HorizonTerrain::drain_results()
+{
+    BuildResult result{};
+    while (_results.try_dequeue(result))
+    {
+        --_jobsInFlight;
+        if (result.epoch != _epoch)
+        {
+            continue;
+        }
+
+        const auto it = _tiles.find(result.spec.coord);
+        if (it == _tiles.end())
+        {
+            continue;
+        }
+
+        TileState& tile = it->second;
+        tile.jobInFlight = false;
+        if (result.spec != tile.wanted)
+        {
+            continue;
+        }
+
+        tile.built = result.spec;
+        tile.hasBuilt = true;
+        _events.push_back(HorizonTileEvent{
+            .coord = result.spec.coord,
+            .worldOrigin = result.worldOrigin,
+            .bounds = result.bounds,
+            .mesh = std::move(result.mesh)
+        });
+    }
+}
+
+void HorizonTerrain::queue_builds()
+{
+    if (_jobsInFlight >= _maxJobsInFlight)
+    {
+        return;
+    }
+
+    std::vector<TileState*> pending{};
+    for (auto& [coord, tile] : _tiles)
+    {
+        if (!tile.jobInFlight && (!tile.hasBuilt || tile.built != tile.wanted))
+        {
+            pending.push_back(&tile);
+        }
+    }
+    std::ranges::sort(pending, {}, [](const TileState* tile)
+    {
+        return tile->chunkDistance;
+    });
+
+    // The generator's settings are only read on the main thread.
+    const int seaLevel = TerrainGenerator::sea_level();
+    for (TileState* tile : pending)
+    {
+        if (_jobsInFlight >= _maxJobsInFlight)
+        {
+            break;
+        }
+
+        tile->jobInFlight = true;
+        ++_jobsInFlight;
+        const HorizonTileSpec spec = tile->wanted;
+        const uint32_t epoch = _epoch;
+        const uint32_t uploadPriority = static_cast<uint32_t>(tile->chunkDistance * tile->chunkDistance);
+        _threadPool.post([this, spec, epoch, uploadPriority, seaLevel, geometry = _geometry]
+        {
+            ZoneScopedN("HorizonTerrain::BuildTile");
+            const int chunkWidth = geometry.chunk_voxel_width();
+            const glm::ivec2 origin = horizon_tile_voxel_origin(spec.coord, chunkWidth);
+            const int samples = horizon_tile_samples_per_side(spec, chunkWidth);
+            const std::vector<int> heights = TerrainGenerator::instance().SampleHeightGrid(
+                origin.x,
+                origin.y,
+                spec.lodStep,
+                samples + 1);
+
+            BuildResult result{
+                .spec = spec,
+                .epoch = epoch,
+                .worldOrigin = geometry.chunk_world_origin(ChunkCoord{
+                    spec.coord.x * HorizonTileChunks,
+                    spec.coord.z * HorizonTileChunks
+                })
+            };
+            result.mesh = build_horizon_tile_mesh(spec, heights, geometry, seaLevel, result.bounds);
+            result.bounds.min += result.worldOrigin;
+            result.bounds.max += result.worldOrigin;
+            result.mesh->_uploadPriority = uploadPriority;
+            _results.enqueue(std::move(result));
+        });
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "game/chunk.h"
+#include "render/render_primitives.h"
+#include "thread_pool.h"
+#include "utils/blockingconcurrentqueue.h"
+#include "world_geometry.h"
+
+struct Mesh;
+
+// Far terrain is drawn as square heightfield tiles of HorizonTileChunks x HorizonTileChunks chunks.
+inline constexpr int HorizonTileChunks = GameConfig::HORIZON_TILE_CHUNKS;
+
+struct HorizonTileCoord
+{
+    int x{0};
+    int z{0};
+
+    bool operator==(const HorizonTileCoord& other) const noexcept = default;
+};
+
+struct HorizonTileCoordHash
+{
+    [[nodiscard]] size_t operator()(const HorizonTileCoord& coord) const noexcept;
+};
+
+// What a tile should look like: how coarse its samples are and which of its chunks it covers
+// (bit z * HorizonTileChunks + x). Chunks the voxel terrain draws are left out of the mask.
+struct HorizonTileSpec
+{
+    HorizonTileCoord coord{};
+    int lodStep{2};
+    uint16_t chunkMask{0};
+
+    bool operator==(const HorizonTileSpec& other) const noexcept = default;
+};
+
+struct HorizonTilePlan
+{
+    HorizonTileSpec spec{};
+    // Chebyshev chunk distance from the player to the tile's nearest chunk.
+    int chunkDistance{0};
+};
+
+// Voxel columns between heightfield samples for a tile whose nearest chunk lies ringDistance chunks
+// past the view distance: 2 next to the voxel terrain, then 4, then 8.
+[[nodiscard]] int horizon_lod_step(int ringDistance) noexcept;
+
+// Every tile with at least one chunk inside the horizon but outside the chunks the voxel terrain can
+// mesh (see is_chunk_offset_meshable; the edge of the residency disc has no neighbours to mesh against,
+// so the horizon covers it).
+[[nodiscard]] std::vector<HorizonTilePlan> plan_horizon_tiles(
+    ChunkCoord center,
+    int viewDistance,
+    int horizonDistance,
+    int chunkVoxelWidth);
+
+[[nodiscard]] glm::ivec2 horizon_tile_voxel_origin(HorizonTileCoord coord, int chunkVoxelWidth) noexcept;
+[[nodiscard]] int horizon_tile_samples_per_side(const HorizonTileSpec& spec, int chunkVoxelWidth) noexcept;
+
+// Builds a tile mesh from (samples + 1)^2 surface heights, row-major by z. Each covered grid cell
+// becomes one quad (columns under the sea become a flat water quad), and every cell edge that borders
+// an uncovered cell or the tile boundary gets a two-sided skirt hanging below it, which closes the
+// cracks between tiles of different LOD and against the voxel terrain. Positions and bounds are
+// relative to the tile's first chunk.
+[[nodiscard]] std::shared_ptr<Mesh> build_horizon_tile_mesh(
+    const HorizonTileSpec& spec,
+    std::span<const int> heights,
+    const WorldGeometry& geometry,
+    int seaLevel,
+    RenderBounds& bounds);
+
+struct HorizonTileEvent
+{
+    HorizonTileCoord coord{};
+    glm::vec3 worldOrigin{0.0f};
+    // World space.
+    RenderBounds bounds{};
+    // Null when the tile left the horizon and should stop drawing.
+    std::shared_ptr<Mesh> mesh{};
+};
+
+struct HorizonTerrainStats
+{
+    uint32_t tiles{0};
+    uint32_t builtTiles{0};
+    uint32_t jobsInFlight{0};
+};
+
+// Keeps the set of horizon tiles around the player current. Tiles whose spec changes are rebuilt on
+// worker threads from batched height samples; finished tiles and dropped tiles come out as events.
+class HorizonTerrain
+{
+public:
+    explicit HorizonTerrain(int workerCount);
+
+    // Both drop every tile; builds still in flight are discarded when they finish.
+    void set_world_geometry(const WorldGeometry& geometry);
+    void reset();
+    // Chunks of horizon past the view distance; 0 turns the horizon off.
+    void set_horizon_distance(int horizonDistance);
+    void update(ChunkCoord center, int viewDistance);
+    bool try_dequeue_event(HorizonTileEvent& event);
+
+    [[nodiscard]] int horizon_distance() const noexcept { return _horizonDistance; }
+    [[nodiscard]] const HorizonTerrainStats& stats() const noexcept { return _stats; }
+
+private:
+    struct TileState
+    {
+        HorizonTileSpec wanted{};
+        HorizonTileSpec built{};
+        bool hasBuilt{false};
+        bool jobInFlight{false};
+        // Nearer tiles build first.
+        int chunkDistance{0};
+        uint32_t planGeneration{0};
+    };
+
+    struct BuildResult
+    {
+        HorizonTileSpec spec{};
+        uint32_t epoch{0};
+        glm::vec3 worldOrigin{0.0f};
+        RenderBounds bounds{};
+        std::shared_ptr<Mesh> mesh{};
+    };
+
+    void plan(ChunkCoord center, int viewDistance);
+    void drain_results();
+    void queue_builds();
+
+    WorldGeometry _geometry{};
+    int _horizonDistance{0};
+    int _viewDistance{0};
+    ChunkCoord _center{};
+    bool _planned{false};
+    uint32_t _planGeneration{0};
+    uint32_t _epoch{0};
+    int _jobsInFlight{0};
+    int _maxJobsInFlight{2};
+    std::unordered_map<HorizonTileCoord, TileState, HorizonTileCoordHash> _tiles{};
+    std::deque<HorizonTileEvent> _events{};
+    HorizonTerrainStats _stats{};
+    moodycamel::BlockingConcurrentQueue<BuildResult> _results;
+    // Declared last so its workers are joined before the queue they post into is destroyed.
+    ThreadPool _threadPool;
+};
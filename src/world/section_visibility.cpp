@@ -0,0 +1,334 @@
+#include "section_visibility.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <tracy/Tracy.hpp>
+
+namespace
+{
+    constexpr uint8_t NoEntryFace = SectionFaceCount;
+    constexpr uint64_t AllFacePairs = (uint64_t{1} << (SectionFaceCount * SectionFaceCount)) - 1;
+
+    // Step for each SectionFace as (x, section, z); opposite faces differ only in the lowest bit.
+    constexpr std::array<glm::ivec3, SectionFaceCount> FaceSteps{{
+        {-1, 0, 0},
+        {1, 0, 0},
+        {0, -1, 0},
+        {0, 1, 0},
+        {0, 0, -1},
+        {0, 0, 1}
+    }};
+
+    constexpr uint32_t face_bit(const SectionFace face) noexcept
+    {
+        return 1u << static_cast<uint32_t>(face);
+    }
+
+    constexpr uint32_t pack_voxel(const int x, const int y, const int z) noexcept
+    {
+        return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 10) | (static_cast<uint32_t>(z) << 20);
+    }
+
+    // Floods every non-solid region of rows [firstY, endY) and joins the faces each region touches.
+    SectionConnectivity flood_section(
+        const ChunkData& chunk,
+        const int firstY,
+        const int endY,
+        std::vector<uint8_t>& visited,
+        std::vector<uint32_t>& stack)
+    {
+        const int width = chunk.voxelWidth;
+        const int height = endY - firstY;
+        const auto cell = [width, height](const int x, const int localY, const int z)
+        {
+            return (static_cast<size_t>(x) * static_cast<size_t>(height) + static_cast<size_t>(localY)) * static_cast<size_t>(width) +
+                static_cast<size_t>(z);
+        };
+
+        visited.assign(static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(width), 0);
+        SectionConnectivity connectivity{};
+        for (int x = 0; x < width; ++x)
+        {
+            for (int localY = 0; localY < height; ++localY)
+            {
+                for (int z = 0; z < width; ++z)
+                {
+                    if (visited[cell(x, localY, z)] != 0 || chunk.blocks[x][firstY + localY][z]._solid)
+                    {
+                        continue;
+                    }
+
+                    uint32_t faces = 0;
+                    visited[cell(x, localY, z)] = 1;
+                    stack.push_back(pack_voxel(x, localY, z));
+                    while (!stack.empty())
+                    {
+                        const uint32_t packed = stack.back();
+                        stack.pop_back();
+                        const glm::ivec3 voxel(
+                            static_cast<int>(packed & 0x3ffu),
+                            static_cast<int>((packed >> 10) & 0x3ffu),
+                            static_cast<int>(packed >> 20));
+                        faces |= voxel.x == 0 ? face_bit(SectionFace::NegX) : 0u;
+                        faces |= voxel.x == width - 1 ? face_bit(SectionFace::PosX) : 0u;
+                        faces |= voxel.y == 0 ? face_bit(SectionFace::NegY) : 0u;
+                        faces |= voxel.y == height - 1 ? face_bit(SectionFace::PosY) : 0u;
+                        faces |= voxel.z == 0 ? face_bit(SectionFace::NegZ) : 0u;
+                        faces |= voxel.z == width - 1 ? face_bit(SectionFace::PosZ) : 0u;
+
+                        for (const glm::ivec3& step : FaceSteps)
+                        {
+                            const glm::ivec3 next = voxel + step;
+                            if (next.x < 0 || next.x >= width || next.y < 0 || next.y >= height || next.z < 0 || next.z >= width)
+                            {
+                                continue;
+                            }
+
+                            uint8_t& nextVisited = visited[cell(next.x, next.y, next.z)];
+                            if (nextVisited != 0 || chunk.blocks[next.x][firstY + next.y][next.z]._solid)
+                            {
+                                continue;
+                            }
+
+                            nextVisited = 1;
+                            stack.push_back(pack_voxel(next.x, next.y, next.z));
+                        }
+                    }
+
+                    connectivity.connect_faces(faces);
+                    if (connectivity.mask == AllFacePairs)
+                    {
+                        return connectivity;
+                    }
+                }
+            }
+        }
+
+        return connectivity;
+    }
+}
+
+void SectionConnectivity::connect_faces(const uint32_t faceBits) noexcept
+{
+    for (uint32_t from = 0; from < SectionFaceCount; ++from)
+    {
+        if ((faceBits & (1u << from)) == 0)
+        {
+            continue;
+        }
+
+        for (uint32_t to = 0; to < SectionFaceCount; ++to)
+        {
+            if ((faceBits & (1u << to)) != 0)
+            {
+                mask |= uint64_t{1} << ((from * SectionFaceCount) + to);
+            }
+        }
+    }
+}
+
+SectionConnectivity SectionConnectivity::open() noexcept
+{
+    return SectionConnectivity{ .mask = AllFacePairs };
+}
+
+int chunk_section_count(const int chunkVoxelHeight) noexcept
+{
+    return (std::max(chunkVoxelHeight, 0) + ChunkSectionHeight - 1) / ChunkSectionHeight;
+}
+
+ChunkConnectivity compute_chunk_connectivity(const ChunkData& chunk)
+{
+    ZoneScopedN("ComputeChunkConnectivity");
+    ChunkConnectivity connectivity{};
+    const int sectionCount = chunk_section_count(chunk.voxelHeight);
+    if (!chunk.has_block_storage())
+    {
+        connectivity.sections.assign(static_cast<size_t>(sectionCount), SectionConnectivity::open());
+        return connectivity;
+    }
+
+    // Sections below every column's first gap are solid and sections above every column's top solid
+    // block are open, which settles most of a chunk without flooding it.
+    int solidBelowY = 0;
+    int openAboveY = -1;
+    if (chunk.heightmap.valid())
+    {
+        solidBelowY = *std::ranges::min_element(chunk.heightmap.lowestNonSolidY);
+        openAboveY = *std::ranges::max_element(chunk.heightmap.highestSolidY);
+    }
+    else
+    {
+        openAboveY = chunk.voxelHeight - 1;
+    }
+
+    std::vector<uint8_t> visited{};
+    std::vector<uint32_t> stack{};
+    connectivity.sections.reserve(static_cast<size_t>(sectionCount));
+    for (int section = 0; section < sectionCount; ++section)
+    {
+        const int firstY = section * ChunkSectionHeight;
+        const int endY = std::min(chunk.voxelHeight, firstY + ChunkSectionHeight);
+        if (endY <= solidBelowY)
+        {
+            connectivity.sections.push_back(SectionConnectivity{});
+        }
+        else if (firstY > openAboveY)
+        {
+            connectivity.sections.push_back(SectionConnectivity::open());
+        }
+        else
+        {
+            connectivity.sections.push_back(flood_section(chunk, firstY, endY, visited, stack));
+        }
+    }
+
+    return connectivity;
+}
+
+SectionVisibilityStats SectionVisibilityGraph::update(
+    const WorldGeometry& geometry,
+    const glm::vec3& cameraPosition,
+    const std::optional<render::Frustum>& frustum,
+    const int chunkRadius,
+    const std::span<const SectionVisibilityChunk> chunks)
+{
+    ZoneScopedN("SectionVisibilityGraph::Update");
+    m_center = geometry.world_to_chunk(cameraPosition);
+    m_radius = std::max(chunkRadius, 0);
+    m_side = (m_radius * 2) + 1;
+    m_sectionCount = std::max(chunk_section_count(geometry.chunk_voxel_height()), 1);
+
+    const auto chunkCount = static_cast<size_t>(m_side) * static_cast<size_t>(m_side);
+    m_connectivity.assign(chunkCount, nullptr);
+    m_visibleChunks.assign(chunkCount, 0);
+    m_visitedSections.assign(chunkCount * static_cast<size_t>(m_sectionCount), 0);
+    m_queue.clear();
+
+    SectionVisibilityStats stats{};
+    for (const SectionVisibilityChunk& chunk : chunks)
+    {
+        const int gridX = chunk.coord.x - m_center.x + m_radius;
+        const int gridZ = chunk.coord.z - m_center.z + m_radius;
+        if (gridX >= 0 && gridX < m_side && gridZ >= 0 && gridZ < m_side)
+        {
+            m_connectivity[(static_cast<size_t>(gridZ) * static_cast<size_t>(m_side)) + static_cast<size_t>(gridX)] = chunk.connectivity;
+        }
+    }
+
+    // A camera above or below the world starts from the nearest section in its column.
+    const float cameraVoxelY = geometry.world_to_voxel(cameraPosition).y;
+    const int cameraSection = std::clamp(
+        static_cast<int>(std::floor(cameraVoxelY / static_cast<float>(ChunkSectionHeight))),
+        0,
+        m_sectionCount - 1);
+    const uint32_t startChunk = (static_cast<uint32_t>(m_radius) * static_cast<uint32_t>(m_side)) + static_cast<uint32_t>(m_radius);
+    const uint32_t start = (startChunk * static_cast<uint32_t>(m_sectionCount)) + static_cast<uint32_t>(cameraSection);
+    m_visitedSections[start] = 1;
+    m_queue.push_back(PendingSection{ .index = start, .entryFace = NoEntryFace, .directions = 0 });
+
+    const int chunkVoxelWidth = geometry.chunk_voxel_width();
+    const int chunkVoxelHeight = geometry.chunk_voxel_height();
+    for (size_t head = 0; head < m_queue.size(); ++head)
+    {
+        const PendingSection current = m_queue[head];
+        const uint32_t chunkIndex = current.index / static_cast<uint32_t>(m_sectionCount);
+        const int sectionY = static_cast<int>(current.index % static_cast<uint32_t>(m_sectionCount));
+        const int gridX = static_cast<int>(chunkIndex % static_cast<uint32_t>(m_side));
+        const int gridZ = static_cast<int>(chunkIndex / static_cast<uint32_t>(m_side));
+        m_visibleChunks[chunkIndex] = 1;
+
+        const ChunkConnectivity* chunkConnectivity = m_connectivity[chunkIndex];
+        const SectionConnectivity section = chunkConnectivity != nullptr && static_cast<size_t>(sectionY) < chunkConnectivity->sections.size()
+            ? chunkConnectivity->sections[static_cast<size_t>(sectionY)]
+            : SectionConnectivity::open();
+
+        for (uint32_t face = 0; face < SectionFaceCount; ++face)
+        {
+            const uint32_t oppositeFace = face ^ 1u;
+            if ((current.directions & (1u << oppositeFace)) != 0)
+            {
+                continue;
+            }
+            if (current.entryFace != NoEntryFace &&
+                !section.connects(static_cast<SectionFace>(current.entryFace), static_cast<SectionFace>(face)))
+            {
+                continue;
+            }
+
+            const glm::ivec3& step = FaceSteps[face];
+            const int nextX = gridX + step.x;
+            const int nextSection = sectionY + step.y;
+            const int nextZ = gridZ + step.z;
+            if (nextX < 0 || nextX >= m_side || nextZ < 0 || nextZ >= m_side || nextSection < 0 || nextSection >= m_sectionCount)
+            {
+                continue;
+            }
+
+            const uint32_t nextChunk = (static_cast<uint32_t>(nextZ) * static_cast<uint32_t>(m_side)) + static_cast<uint32_t>(nextX);
+            const uint32_t next = (nextChunk * static_cast<uint32_t>(m_sectionCount)) + static_cast<uint32_t>(nextSection);
+            if (m_visitedSections[next] != 0)
+            {
+                continue;
+            }
+            m_visitedSections[next] = 1;
+
+            if (frustum.has_value())
+            {
+                const glm::ivec3 origin = geometry.chunk_voxel_origin(ChunkCoord{
+                    m_center.x + nextX - m_radius,
+                    m_center.z + nextZ - m_radius
+                });
+                const int firstY = nextSection * ChunkSectionHeight;
+                const RenderBounds bounds{
+                    .valid = true,
+                    .min = geometry.voxel_to_world(glm::vec3(origin.x, firstY, origin.z)),
+                    .max = geometry.voxel_to_world(glm::vec3(
+                        origin.x + chunkVoxelWidth,
+                        std::min(firstY + ChunkSectionHeight, chunkVoxelHeight),
+                        origin.z + chunkVoxelWidth))
+                };
+                if (!render::intersects(frustum.value(), bounds))
+                {
+                    continue;
+                }
+            }
+
+            m_queue.push_back(PendingSection{
+                .index = next,
+                .entryFace = static_cast<uint8_t>(oppositeFace),
+                .directions = static_cast<uint8_t>(current.directions | (1u << face))
+            });
+        }
+    }
+
+    stats.visitedSections = static_cast<uint32_t>(m_queue.size());
+    for (const SectionVisibilityChunk& chunk : chunks)
+    {
+        if (is_chunk_visible(chunk.coord))
+        {
+            ++stats.visibleChunks;
+        }
+        else
+        {
+            ++stats.hiddenChunks;
+        }
+    }
+
+    TracyPlot("Section Visibility Visited Sections", static_cast<int64_t>(stats.visitedSections));
+    return stats;
+}
+
+bool SectionVisibilityGraph::is_chunk_visible(const ChunkCoord coord) const noexcept
+{
+    const int gridX = coord.x - m_center.x + m_radius;
+    const int gridZ = coord.z - m_center.z + m_radius;
+    if (m_radius < 0 || gridX < 0 || gridX >= m_side || gridZ < 0 || gridZ >= m_side)
+    {
+        return true;
+    }
+
+    return m_visibleChunks[(static_cast<size_t>(gridZ) * static_cast<size_t>(m_side)) + static_cast<size_t>(gridX)] != 0;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "game/chunk.h"
+#include "render/frustum_culling.h"
+#include "world_geometry.h"
+
+// A section is a 16-voxel-tall slice of a chunk with the chunk's full footprint.
+inline constexpr int ChunkSectionHeight = 16;
+
+enum class SectionFace : uint8_t
+{
+    NegX = 0,
+    PosX = 1,
+    NegY = 2,
+    PosY = 3,
+    NegZ = 4,
+    PosZ = 5
+};
+
+inline constexpr uint32_t SectionFaceCount = 6;
+
+// Pairs of section faces joined by a path through non-solid voxels; bit (from * 6 + to) is set for
+// both orders of every joined pair.
+struct SectionConnectivity
+{
+    uint64_t mask{0};
+
+    [[nodiscard]] bool connects(SectionFace from, SectionFace to) const noexcept
+    {
+        return (mask & (uint64_t{1} << ((static_cast<uint32_t>(from) * SectionFaceCount) + static_cast<uint32_t>(to)))) != 0;
+    }
+
+    // Joins every pair of faces in faceBits (bit i is SectionFace i).
+    void connect_faces(uint32_t faceBits) noexcept;
+
+    [[nodiscard]] static SectionConnectivity open() noexcept;
+};
+
+// Connectivity of a chunk's sections from bottom to top, computed when the chunk is meshed.
+struct ChunkConnectivity
+{
+    std::vector<SectionConnectivity> sections{};
+};
+
+[[nodiscard]] int chunk_section_count(int chunkVoxelHeight) noexcept;
+
+// Flood-fills the non-solid voxels of each section and records which faces each region touches.
+[[nodiscard]] ChunkConnectivity compute_chunk_connectivity(const ChunkData& chunk);
+
+struct SectionVisibilityChunk
+{
+    ChunkCoord coord{};
+    // Null while unknown (not meshed yet, or edited since); such chunks are treated as open.
+    const ChunkConnectivity* connectivity{nullptr};
+};
+
+struct SectionVisibilityStats
+{
+    uint32_t visitedSections{0};
+    uint32_t visibleChunks{0};
+    uint32_t hiddenChunks{0};
+};
+
+// Per-frame search for the chunks the camera can see into. Starting from the camera's section it
+// walks to neighbouring sections inside the frustum, entering a section through one face and leaving
+// through another only when the two are connected, and never stepping back against a direction it
+// already moved in. Chunks that no walk reaches are hidden by rock on every path from the camera.
+class SectionVisibilityGraph
+{
+public:
+    SectionVisibilityStats update(
+        const WorldGeometry& geometry,
+        const glm::vec3& cameraPosition,
+        const std::optional<render::Frustum>& frustum,
+        int chunkRadius,
+        std::span<const SectionVisibilityChunk> chunks);
+
+    // Chunks outside the searched radius are always reported visible.
+    [[nodiscard]] bool is_chunk_visible(ChunkCoord coord) const noexcept;
+
+private:
+    struct PendingSection
+    {
+        uint32_t index{0};
+        uint8_t entryFace{0};
+        uint8_t directions{0};
+    };
+
+    ChunkCoord m_center{};
+    int m_radius{-1};
+    int m_side{0};
+    int m_sectionCount{0};
+    std::vector<const ChunkConnectivity*> m_connectivity{};
+    std::vector<uint8_t> m_visitedSections{};
+    std::vector<uint8_t> m_visibleChunks{};
+    std::vector<PendingSection> m_queue{};
+};
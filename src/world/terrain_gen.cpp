@@ -353,6 +353,24 @@ float TerrainGenerator::SampleHeight(const int worldX, const int worldZ) const
     return static_cast<float>(SampleColumn(worldX, worldZ).surfaceHeight);
 }
 
+std::vector<int> TerrainGenerator::SampleHeightGrid(const int originX, const int originZ, const int step, const int samplesPerSide) const
+{
+    ZoneScopedN("TerrainGenerator::SampleHeightGrid");
+    std::vector<int> heights;
+    terrain_generation::fill_height_grid(
+        _continental,
+        _erosion,
+        _peaks,
+        _settings,
+        {originX, originZ},
+        step,
+        samplesPerSide,
+        _chunkVoxelHeight,
+        _blockWorldSize,
+        heights);
+    return heights;
+}
+
 float TerrainGenerator::NormalizeHeight(std::vector<float>& map, const int yScale, const int xScale, const int x, const int y) const
 {
     const float height = map[(y * xScale) + x];
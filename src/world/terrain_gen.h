@@ -320,6 +320,8 @@ public:
     [[nodiscard]] std::vector<float> GenerateHeightMap(int chunkX, int chunkZ) const;
     [[nodiscard]] TerrainColumnSample SampleColumn(int worldX, int worldZ) const;
     [[nodiscard]] float SampleHeight(int worldX, int worldZ) const;
+    // Batched surface heights for a strided grid of columns; bypasses the per-chunk caches.
+    [[nodiscard]] std::vector<int> SampleHeightGrid(int originX, int originZ, int step, int samplesPerSide) const;
     [[nodiscard]] float NormalizeHeight(std::vector<float>& map, int yScale, int xScale, int x, int y) const;
     [[nodiscard]] TerrainGeneratorSettings settings() const;
     [[nodiscard]] static TerrainGeneratorSettings default_settings();
@@ -124,6 +124,31 @@ TEST(DecorationPlacementTest, SurfaceDecorationRequiresGroundAndAirClearance)
     EXPECT_FALSE(decoration::can_place_surface_decoration(chunk, forestColumn, glm::ivec3(2, 10, 3), 2));
 }
 
+TEST(DecorationPlacementTest, InternsAssetIdsAndStoresPlacementsAsColumns)
+{
+    const DecorationAssetHandle flower = decoration::intern_asset_id("flower");
+    EXPECT_NE(flower, NoDecorationAsset);
+    EXPECT_EQ(decoration::intern_asset_id("flower"), flower);
+    EXPECT_NE(decoration::intern_asset_id("mushroom"), flower);
+    EXPECT_EQ(decoration::asset_id(flower), "flower");
+    EXPECT_EQ(decoration::intern_asset_id(""), NoDecorationAsset);
+    EXPECT_TRUE(decoration::asset_id(NoDecorationAsset).empty());
+
+    VoxelDecorationPlacements placements{};
+    placements.push_back(VoxelDecorationPlacement{ .asset = flower, .worldPosition = glm::vec3(1.0f, 2.0f, 3.0f), .scale = 1.1f });
+    placements.push_back(VoxelDecorationPlacement{
+        .asset = flower,
+        .worldPosition = glm::vec3(4.0f, 5.0f, 6.0f),
+        .placementPolicy = VoxelPlacementPolicy::BottomCenter
+    });
+
+    ASSERT_EQ(placements.size(), 2u);
+    EXPECT_EQ(placements.worldPositions[1], glm::vec3(4.0f, 5.0f, 6.0f));
+    EXPECT_FLOAT_EQ(placements[0].scale, 1.1f);
+    EXPECT_EQ(placements[1].placementPolicy, VoxelPlacementPolicy::BottomCenter);
+    EXPECT_EQ(placements[1].asset, flower);
+}
+
 TEST(ChunkDecorationRenderRegistryTest, RebuildsWhenGeneratedChunkDataReplacesPlaceholderData)
 {
     Chunk chunk{ ChunkCoord{0, 0} };
@@ -140,7 +165,7 @@ TEST(ChunkDecorationRenderRegistryTest, RebuildsWhenGeneratedChunkDataReplacesPl
 
     auto generatedData = std::make_shared<ChunkData>(ChunkCoord{0, 0}, glm::ivec2(0, 0));
     generatedData->voxelDecorations.push_back(VoxelDecorationPlacement{
-        .assetId = "flower",
+        .asset = decoration::intern_asset_id("flower"),
         .worldPosition = glm::vec3(0.5f, 8.0f, 0.5f),
         .rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
         .scale = 1.0f
@@ -12,6 +12,7 @@ TEST(GameSettingsConfigRepositoryTest, SavesAndLoadsSettingsRoundTrip)
 {
     settings::GameSettingsPersistence persistence{};
     persistence.world.viewDistance = 14;
+    persistence.world.horizonDistance = 20;
     persistence.world.ambientOcclusionEnabled = true;
     persistence.debug.showChunkBoundaries = true;
     persistence.player.moveSpeed = 7.5f;
@@ -47,6 +48,7 @@ TEST(GameSettingsConfigRepositoryTest, SavesAndLoadsSettingsRoundTrip)
     std::filesystem::remove_all(tempRoot);
 
     EXPECT_EQ(loaded.world.viewDistance, persistence.world.viewDistance);
+    EXPECT_EQ(loaded.world.horizonDistance, persistence.world.horizonDistance);
     EXPECT_EQ(loaded.world.ambientOcclusionEnabled, persistence.world.ambientOcclusionEnabled);
     EXPECT_EQ(loaded.debug.showChunkBoundaries, persistence.debug.showChunkBoundaries);
     EXPECT_FLOAT_EQ(loaded.player.moveSpeed, persistence.player.moveSpeed);
@@ -110,6 +112,15 @@ TEST(SettingsManagerTest, ViewDistanceHandlersReceiveDerivedRuntimeValues)
     manager.set_chunk_world_width(24.0f);
     EXPECT_EQ(notifications, 3);
     EXPECT_FLOAT_EQ(last.fogRadius, (24.0f * 18.0f) - 96.0f);
+
+    manager.mutate([](settings::GameSettingsPersistence& persistence)
+    {
+        persistence.world.horizonDistance = 8;
+    });
+    EXPECT_EQ(notifications, 4);
+    EXPECT_EQ(last.horizonDistance, 8);
+    EXPECT_EQ(last.maximumHorizonTiles, maximum_horizon_tiles(18, 8));
+    EXPECT_FLOAT_EQ(last.fogHorizonRange, 24.0f * 8.0f);
 }
 
 TEST(SettingsManagerTest, AmbientOcclusionUpdatesOnlyRelevantSubscribers)
@@ -10,6 +10,7 @@
 #include "voxel/voxel_assembly_asset_manager.h"
 #include "voxel/voxel_assembly_repository.h"
 #include "voxel/voxel_asset_manager.h"
+#include "voxel/voxel_binary_format.h"
 #include "voxel/voxel_component_render_adapter.h"
 #include "voxel/voxel_model_component_adapter.h"
 #include "voxel/voxel_model_repository.h"
@@ -113,6 +114,81 @@ TEST(VoxelModelRepositoryTest, SavesAndLoadsVoxelAssetRoundTrip)
     EXPECT_EQ(secondColor->b, 56);
 }
 
+TEST(VoxelBinaryFormatTest, EncodeDecodeRoundTripsShippedAssets)
+{
+    const config::JsonFileDocumentStore documentStore;
+    const VoxelModelRepository repository(documentStore, std::filesystem::path(ENGINE_TEST_ASSET_ROOT) / "voxels");
+    const std::vector<std::string> assetIds = repository.list_asset_ids();
+    ASSERT_FALSE(assetIds.empty());
+
+    for (const std::string& assetId : assetIds)
+    {
+        const std::optional<VoxelModel> model = repository.load(assetId);
+        ASSERT_TRUE(model.has_value()) << assetId;
+
+        const std::vector<std::byte> bytes = voxel::binary::encode(*model);
+        const VoxelModel decoded = voxel::binary::decode(bytes);
+        EXPECT_EQ(decoded, *model) << assetId;
+        EXPECT_EQ(voxel::binary::encode(decoded), bytes) << assetId;
+
+        const voxel::binary::Header header = voxel::binary::decode_header(bytes);
+        EXPECT_EQ(header.voxelCount, model->voxel_count());
+        EXPECT_EQ(header.boundsMin[1], model->bounds().min.y);
+        EXPECT_EQ(header.boundsMax[0], model->bounds().max.x);
+    }
+}
+
+TEST(VoxelBinaryFormatTest, RejectsForeignAndTruncatedData)
+{
+    VoxelModel model{};
+    model.set_voxel(VoxelCoord{ 1, 2, 3 }, VoxelColor{ 1, 2, 3, 4 });
+    std::vector<std::byte> bytes = voxel::binary::encode(model);
+
+    EXPECT_THROW((void)voxel::binary::decode(std::span(bytes).first(bytes.size() - 1)), std::runtime_error);
+    EXPECT_THROW((void)voxel::binary::decode(std::span(bytes).first(sizeof(voxel::binary::Header) - 1)), std::runtime_error);
+
+    bytes[0] = std::byte{'J'};
+    EXPECT_THROW((void)voxel::binary::decode(bytes), std::runtime_error);
+}
+
+TEST(VoxelModelRepositoryTest, ConvertsBetweenJsonAndMappedBinaryAssets)
+{
+    VoxelModel model{};
+    model.assetId = "crate";
+    model.displayName = "Crate";
+    model.pivot = glm::vec3(0.25f, 0.0f, 0.25f);
+    model.attachments.push_back(VoxelAttachment{ .name = "lid", .position = glm::vec3(0.0f, 4.0f, 0.0f) });
+    for (int x = -9; x < 9; ++x)
+    {
+        model.set_voxel(VoxelCoord{ x, x & 3, -x }, VoxelColor{ static_cast<uint8_t>(x + 9), 40, 80, 255 });
+    }
+
+    const std::filesystem::path tempRoot = std::filesystem::temp_directory_path() / "voxel_enginevk_voxel_binary_convert_test";
+    std::filesystem::remove_all(tempRoot);
+    const config::JsonFileDocumentStore documentStore;
+    const VoxelModelRepository repository(documentStore, tempRoot / "assets");
+
+    repository.save(model);
+    EXPECT_FALSE(std::filesystem::exists(repository.resolve_binary_path("crate")));
+    EXPECT_EQ(repository.convert_to_binary(), 1u);
+    ASSERT_TRUE(std::filesystem::exists(repository.resolve_binary_path("crate")));
+
+    // Loads through the binary asset once the JSON source is gone.
+    std::filesystem::remove(repository.resolve_path("crate"));
+    EXPECT_EQ(repository.list_asset_ids(), (std::vector<std::string>{ "crate" }));
+    const std::optional<VoxelModel> fromBinary = repository.load("crate");
+    ASSERT_TRUE(fromBinary.has_value());
+    EXPECT_EQ(*fromBinary, model);
+
+    EXPECT_EQ(repository.convert_to_json(), 1u);
+    std::filesystem::remove(repository.resolve_binary_path("crate"));
+    const std::optional<VoxelModel> fromJson = repository.load("crate");
+    std::filesystem::remove_all(tempRoot);
+
+    ASSERT_TRUE(fromJson.has_value());
+    EXPECT_EQ(*fromJson, model);
+}
+
 TEST(VoxelAssetManagerTest, LoadsAndCachesRuntimeAssets)
 {
     const std::filesystem::path tempRoot = std::filesystem::temp_directory_path() / "voxel_enginevk_runtime_asset_manager_test";
@@ -147,12 +223,51 @@ TEST(VoxelAssetManagerTest, LoadsAndCachesRuntimeAssets)
     EXPECT_EQ(firstLoad->assetId, "sword");
     ASSERT_TRUE(firstLoad->bounds.valid);
     ASSERT_NE(firstLoad->mesh, nullptr);
-    EXPECT_FALSE(firstLoad->mesh->_indices.empty());
+    EXPECT_FALSE(firstLoad->mesh->_vertices.empty());
+    EXPECT_TRUE(firstLoad->mesh->uses_shared_quad_indices());
     ASSERT_EQ(firstLoad->attachments.size(), 1u);
     EXPECT_TRUE(firstLoad->attachments.contains("grip"));
     EXPECT_FLOAT_EQ(firstLoad->attachments.at("grip").position.y, 1.0f);
 }
 
+TEST(VoxelAssetManagerTest, AsyncRequestsShareOneLoadAndBecomeReady)
+{
+    const std::filesystem::path tempRoot = std::filesystem::temp_directory_path() / "voxel_enginevk_async_asset_manager_test";
+    std::filesystem::remove_all(tempRoot);
+    const TestJsonDocumentStore documentStore(tempRoot);
+    const VoxelModelRepository repository(documentStore, "assets");
+
+    VoxelModel model{};
+    model.assetId = "lantern";
+    model.set_voxel(VoxelCoord{ 0, 0, 0 }, VoxelColor{ 255, 200, 80, 255 });
+    repository.save(model);
+
+    VoxelAssetManager manager(repository);
+    const VoxelAssetHandle first = manager.request("Lantern");
+    const VoxelAssetHandle second = manager.request("lantern");
+    const VoxelAssetHandle missing = manager.request("does_not_exist");
+    EXPECT_LE(manager.pending_request_count(), 2u);
+
+    first.wait();
+    second.wait();
+    missing.wait();
+
+    ASSERT_TRUE(first.ready());
+    ASSERT_TRUE(second.ready());
+    EXPECT_EQ(first.asset().get(), second.asset().get());
+    EXPECT_EQ(missing.status(), VoxelAssetLoadStatus::Failed);
+    EXPECT_EQ(missing.asset(), nullptr);
+
+    // Once adopted, async and blocking lookups resolve to the same resident asset.
+    EXPECT_EQ(manager.acquire("lantern", VoxelAssetLoadMode::Async).get(), first.asset().get());
+    EXPECT_EQ(manager.load_or_get("lantern").get(), first.asset().get());
+    EXPECT_EQ(manager.acquire("does_not_exist", VoxelAssetLoadMode::Async), nullptr);
+    EXPECT_FALSE(manager.is_loading("does_not_exist"));
+    EXPECT_EQ(manager.pending_request_count(), 0u);
+    EXPECT_EQ(manager.loaded_asset_count(), 1u);
+    std::filesystem::remove_all(tempRoot);
+}
+
 TEST(VoxelAssemblyRepositoryTest, SavesAndLoadsAssemblyAssetRoundTrip)
 {
     VoxelAssemblyAsset asset{};
@@ -1,11 +1,35 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <random>
 
 #include <gtest/gtest.h>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_transform.hpp>
 
+#include "config/json_document_store.h"
 #include "editing/document_command_history.h"
+#include "game/chunk.h"
+#include "render/frustum_culling.h"
+#include "render/indirect_draw_builder.h"
+#include "render/instanced_draw_builder.h"
+#include "render/material.h"
+#include "render/mesh.h"
+#include "render/mesh_content_hash.h"
+#include "render/mesh_page_allocator.h"
+#include "render/mesh_release_queue.h"
+#include "render/occlusion_culling.h"
+#include "render/pending_uploads.h"
+#include "render/pipeline_cache_blob.h"
+#include "render/quad_index_buffer.h"
 #include "render/render_primitives.h"
+#include "render/render_queue.h"
+#include "render/staging_ring.h"
+#include "render/tlsf_range_allocator.h"
+#include "render/transparent_sort.h"
 #include "voxel/voxel_mesher.h"
 #include "voxel/voxel_picking.h"
 #include "voxel/voxel_model_repository.h"
@@ -17,12 +41,907 @@ TEST(VoxelMesherTest, GeneratesOnlyExteriorFacesForAdjacentVoxels)
     model.set_voxel(VoxelCoord{ 0, 0, 0 }, VoxelColor{ 255, 255, 255, 255 });
     model.set_voxel(VoxelCoord{ 1, 0, 0 }, VoxelColor{ 255, 255, 255, 255 });
 
-    const std::shared_ptr<Mesh> mesh = VoxelMesher::generate_mesh(model);
+    const std::shared_ptr<Mesh> mesh = VoxelMesher::generate_mesh(model, VoxelMeshingMode::PerFace);
     ASSERT_NE(mesh, nullptr);
 
     constexpr uint32_t expectedVisibleFaces = 10;
     EXPECT_EQ(mesh->_vertices.size(), expectedVisibleFaces * 4);
-    EXPECT_EQ(mesh->_indices.size(), expectedVisibleFaces * 6);
+    EXPECT_TRUE(mesh->_indices.empty());
+    EXPECT_TRUE(mesh->uses_shared_quad_indices());
+    EXPECT_EQ(mesh->index_count(), expectedVisibleFaces * 6);
+}
+
+namespace
+{
+    // Sum of quad areas per face normal, in voxel units; greedy merging must preserve it exactly.
+    std::array<double, 6> face_area_by_normal(const Mesh& mesh, const float voxelSize)
+    {
+        std::array<double, 6> areas{};
+        for (size_t base = 0; base + 3 < mesh._vertices.size(); base += render::VerticesPerQuad)
+        {
+            const glm::vec3 edgeA = (mesh._vertices[base + 1].position - mesh._vertices[base].position) / voxelSize;
+            const glm::vec3 edgeB = (mesh._vertices[base + 3].position - mesh._vertices[base].position) / voxelSize;
+            const glm::vec3 normal = mesh._vertices[base].normal;
+            const int axis = normal.x != 0.0f ? 0 : (normal.y != 0.0f ? 1 : 2);
+            const int slot = (axis * 2) + (normal[axis] > 0.0f ? 0 : 1);
+            areas[slot] += static_cast<double>(glm::length(glm::cross(edgeA, edgeB)));
+        }
+        return areas;
+    }
+}
+
+TEST(VoxelModelTest, BrickStorageKeepsVoxelApiAcrossBrickBoundariesAndNegativeCoords)
+{
+    VoxelModel model{};
+    const std::array<VoxelCoord, 5> coords{
+        VoxelCoord{ 0, 0, 0 },
+        VoxelCoord{ 7, 7, 7 },
+        VoxelCoord{ 8, 0, 0 },
+        VoxelCoord{ -1, -9, 3 },
+        VoxelCoord{ -8, 15, -16 }
+    };
+    for (size_t index = 0; index < coords.size(); ++index)
+    {
+        model.set_voxel(coords[index], VoxelColor{ static_cast<uint8_t>(index), 10, 20, 255 });
+    }
+    model.set_voxel(coords[0], VoxelColor{ 99, 10, 20, 255 });
+
+    EXPECT_EQ(model.voxel_count(), coords.size());
+    EXPECT_FALSE(model.contains(VoxelCoord{ -1, -9, 4 }));
+    ASSERT_NE(model.try_get(coords[3]), nullptr);
+    EXPECT_EQ(model.try_get(coords[3])->r, 3);
+    EXPECT_EQ(model.try_get(coords[0])->r, 99);
+
+    size_t visited = 0;
+    for (const auto& [coord, color] : model.voxels())
+    {
+        EXPECT_TRUE(model.contains(coord));
+        EXPECT_EQ(*model.try_get(coord), color);
+        ++visited;
+    }
+    EXPECT_EQ(visited, coords.size());
+
+    const VoxelBounds bounds = model.bounds();
+    EXPECT_EQ(bounds.min, (VoxelCoord{ -8, -9, -16 }));
+    EXPECT_EQ(bounds.max, (VoxelCoord{ 8, 15, 7 }));
+
+    VoxelModel rebuilt{};
+    for (auto it = coords.rbegin(); it != coords.rend(); ++it)
+    {
+        rebuilt.set_voxel(*it, *model.try_get(*it));
+    }
+    EXPECT_EQ(rebuilt, model);
+
+    EXPECT_TRUE(model.remove_voxel(coords[2]));
+    EXPECT_FALSE(model.remove_voxel(coords[2]));
+    EXPECT_EQ(model.voxel_count(), coords.size() - 1);
+    rebuilt.remove_voxel(coords[2]);
+    EXPECT_EQ(rebuilt, model);
+}
+
+TEST(VoxelMesherTest, GreedyMergesCoplanarSameColorFacesAndKeepsColorsSeparate)
+{
+    VoxelModel model{};
+    model.voxelSize = 1.0f / 16.0f;
+    for (int x = 0; x < 4; ++x)
+    {
+        for (int z = 0; z < 3; ++z)
+        {
+            model.set_voxel(VoxelCoord{ x, 0, z }, VoxelColor{ 200, 200, 200, 255 });
+        }
+    }
+
+    const std::shared_ptr<Mesh> slab = VoxelMesher::generate_mesh(model, VoxelMeshingMode::Greedy);
+    EXPECT_EQ(slab->_vertices.size(), 6u * render::VerticesPerQuad);
+    EXPECT_EQ(face_area_by_normal(*slab, model.voxelSize),
+        face_area_by_normal(*VoxelMesher::generate_mesh(model, VoxelMeshingMode::PerFace), model.voxelSize));
+
+    model.set_voxel(VoxelCoord{ 3, 0, 2 }, VoxelColor{ 10, 20, 30, 255 });
+    const std::shared_ptr<Mesh> split = VoxelMesher::generate_mesh(model, VoxelMeshingMode::Greedy);
+    EXPECT_GT(split->_vertices.size(), slab->_vertices.size());
+    EXPECT_EQ(face_area_by_normal(*split, model.voxelSize),
+        face_area_by_normal(*VoxelMesher::generate_mesh(model, VoxelMeshingMode::PerFace), model.voxelSize));
+}
+
+TEST(VoxelMesherTest, GreedyReducesTrianglesOnShippedVoxelAssets)
+{
+    const config::JsonFileDocumentStore documentStore;
+    const VoxelModelRepository repository(documentStore, std::filesystem::path(ENGINE_TEST_ASSET_ROOT) / "voxels");
+    const std::vector<std::string> assetIds = repository.list_asset_ids();
+    ASSERT_FALSE(assetIds.empty());
+
+    size_t perFaceTriangles = 0;
+    size_t greedyTriangles = 0;
+    for (const std::string& assetId : assetIds)
+    {
+        const std::optional<VoxelModel> model = repository.load(assetId);
+        ASSERT_TRUE(model.has_value()) << assetId;
+
+        const std::shared_ptr<Mesh> perFace = VoxelMesher::generate_mesh(*model, VoxelMeshingMode::PerFace);
+        const std::shared_ptr<Mesh> greedy = VoxelMesher::generate_mesh(*model, VoxelMeshingMode::Greedy);
+
+        const size_t assetPerFaceTriangles = render::quad_count_for_vertices(perFace->_vertices.size()) * 2u;
+        const size_t assetGreedyTriangles = render::quad_count_for_vertices(greedy->_vertices.size()) * 2u;
+        EXPECT_LE(assetGreedyTriangles, assetPerFaceTriangles) << assetId;
+        EXPECT_EQ(face_area_by_normal(*greedy, model->voxelSize), face_area_by_normal(*perFace, model->voxelSize)) << assetId;
+
+        perFaceTriangles += assetPerFaceTriangles;
+        greedyTriangles += assetGreedyTriangles;
+    }
+
+    EXPECT_LT(greedyTriangles, perFaceTriangles);
+}
+
+TEST(QuadIndexBufferTest, SharedIndicesRepeatQuadPatternAcrossFullSixteenBitRange)
+{
+    const std::vector<uint16_t> indices = render::build_shared_quad_indices();
+    ASSERT_EQ(indices.size(), render::SharedQuadIndexCount);
+
+    const std::vector<uint16_t> firstQuad(indices.begin(), indices.begin() + render::IndicesPerQuad);
+    EXPECT_EQ(firstQuad, (std::vector<uint16_t>{ 0, 1, 2, 2, 3, 0 }));
+
+    const std::vector<uint16_t> lastQuad(indices.end() - render::IndicesPerQuad, indices.end());
+    EXPECT_EQ(lastQuad, (std::vector<uint16_t>{ 65532, 65533, 65534, 65534, 65535, 65532 }));
+}
+
+TEST(QuadIndexBufferTest, DrawBatchesSplitLargeMeshesAtSixteenBitVertexLimit)
+{
+    constexpr uint32_t quadCount = render::MaxQuadsPerIndexBatch + 10;
+    ASSERT_EQ(render::quad_draw_batch_count(quadCount), 2u);
+
+    const render::QuadDrawBatch first = render::quad_draw_batch(quadCount, 0);
+    EXPECT_EQ(first.indexCount, render::SharedQuadIndexCount);
+    EXPECT_EQ(first.vertexOffset, 0);
+
+    const render::QuadDrawBatch second = render::quad_draw_batch(quadCount, 1);
+    EXPECT_EQ(second.indexCount, 10u * render::IndicesPerQuad);
+    EXPECT_EQ(second.vertexOffset, 65536);
+
+    EXPECT_EQ(render::quad_draw_batch_count(0), 0u);
+}
+
+TEST(MeshContentHashTest, IdenticalChunkMeshesCompareEqualAndAnyVertexChangeDiffers)
+{
+    const auto fillQuad = [](Mesh& mesh, const float x)
+    {
+        for (int corner = 0; corner < render::VerticesPerQuad; ++corner)
+        {
+            mesh._vertices.push_back(Vertex{
+                .position = glm::vec3(x + static_cast<float>(corner & 1), static_cast<float>(corner >> 1), 0.0f),
+                .normal = glm::vec3(0.0f, 0.0f, 1.0f),
+                .color = glm::vec3(1.0f),
+                .lighting = glm::vec2(1.0f, 0.0f),
+                .localLight = glm::vec3(0.0f)
+            });
+        }
+    };
+
+    ChunkMeshData uploaded{};
+    ChunkMeshData rebuilt{};
+    fillQuad(*uploaded.mesh, 0.0f);
+    fillQuad(*rebuilt.mesh, 0.0f);
+
+    EXPECT_FALSE(uploaded.same_content(rebuilt));
+
+    uploaded.hash_contents();
+    rebuilt.hash_contents();
+    EXPECT_NE(uploaded.mesh->_contentHash, render::UnhashedMeshContent);
+    EXPECT_NE(uploaded.waterMesh->_contentHash, render::UnhashedMeshContent);
+    EXPECT_TRUE(uploaded.same_content(rebuilt));
+
+    // The upload releases CPU geometry; the stored hash must still identify the content.
+    uploaded.mesh->_vertices = std::vector<Vertex>();
+    EXPECT_TRUE(uploaded.same_content(rebuilt));
+
+    rebuilt.mesh->_vertices.back().lighting.x = 0.5f;
+    rebuilt.hash_contents();
+    EXPECT_FALSE(uploaded.same_content(rebuilt));
+
+    ChunkMeshData withGlow{};
+    fillQuad(*withGlow.mesh, 0.0f);
+    fillQuad(*withGlow.glowMesh, 0.0f);
+    withGlow.hash_contents();
+    ChunkMeshData withoutGlow{};
+    fillQuad(*withoutGlow.mesh, 0.0f);
+    withoutGlow.hash_contents();
+    EXPECT_FALSE(withGlow.same_content(withoutGlow));
+}
+
+TEST(FrustumCullingTest, BatchedCullMatchesScalarTestAndKeepsUnboundedObjects)
+{
+    glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    projection[1][1] *= -1.0f;
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const render::Frustum frustum = render::extract_frustum(projection * view);
+
+    const auto boxAt = [](const glm::vec3& center, const float halfExtent)
+    {
+        return RenderObject{
+            .bounds = RenderBounds{ .valid = true, .min = center - glm::vec3(halfExtent), .max = center + glm::vec3(halfExtent) }
+        };
+    };
+
+    const std::vector<RenderObject> objects{
+        boxAt(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f),
+        boxAt(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f),
+        boxAt(glm::vec3(-100.0f, 0.0f, -10.0f), 1.0f),
+        RenderObject{},
+        boxAt(glm::vec3(0.0f, 0.0f, -2000.0f), 1.0f),
+        boxAt(glm::vec3(0.0f, 0.0f, 0.0f), 0.5f)
+    };
+
+    render::FrustumCuller culler{};
+    std::vector<uint32_t> visible{};
+    const render::CullStats stats = culler.cull(frustum, objects, visible);
+
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 0, 3, 5 }));
+    EXPECT_EQ(stats.visible, 3u);
+    EXPECT_EQ(stats.culled, 3u);
+    for (uint32_t index = 0; index < objects.size(); ++index)
+    {
+        const bool keptByBatch = std::ranges::find(visible, index) != visible.end();
+        EXPECT_EQ(keptByBatch, render::intersects(frustum, objects[index].bounds)) << "object " << index;
+    }
+}
+
+TEST(OcclusionCullingTest, WallHidesBoxesFullyBehindItAndKeepsEverythingElse)
+{
+    glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    projection[1][1] *= -1.0f;
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 viewProjection = projection * view;
+
+    const std::vector<render::OccluderBox> occluders{
+        render::OccluderBox{ .min = glm::vec3(-5.0f, -5.0f, -11.0f), .max = glm::vec3(5.0f, 5.0f, -10.0f) },
+        // Behind the camera: skipped rather than clipped.
+        render::OccluderBox{ .min = glm::vec3(-50.0f, -50.0f, 5.0f), .max = glm::vec3(50.0f, 50.0f, 6.0f) }
+    };
+    render::OcclusionCuller culler{};
+    culler.rasterize(viewProjection, occluders);
+    EXPECT_FALSE(culler.empty());
+
+    // Every stored depth must be at or beyond the wall's front face, or the buffer could hide things in front of it.
+    const glm::vec4 wallClip = viewProjection * glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+    const float wallDepth = wallClip.z / wallClip.w;
+    uint32_t coveredPixels = 0;
+    for (uint32_t y = 0; y < render::OcclusionCuller::Height; ++y)
+    {
+        for (uint32_t x = 0; x < render::OcclusionCuller::Width; ++x)
+        {
+            const float depth = culler.depth_at(x, y);
+            if (depth < std::numeric_limits<float>::max())
+            {
+                EXPECT_GE(depth, wallDepth - 1.0e-6f) << x << ", " << y;
+                ++coveredPixels;
+            }
+        }
+    }
+    EXPECT_GT(coveredPixels, 0u);
+    EXPECT_LT(culler.depth_at(render::OcclusionCuller::Width / 2, render::OcclusionCuller::Height / 2), 1.0f);
+
+    const auto boxAt = [](const glm::vec3& center, const float halfExtent)
+    {
+        return RenderObject{
+            .bounds = RenderBounds{ .valid = true, .min = center - glm::vec3(halfExtent), .max = center + glm::vec3(halfExtent) }
+        };
+    };
+
+    const std::vector<RenderObject> objects{
+        boxAt(glm::vec3(0.0f, 0.0f, -30.0f), 3.0f),
+        boxAt(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f),
+        // Its near face pokes out past the wall's silhouette.
+        boxAt(glm::vec3(12.0f, 0.0f, -30.0f), 3.0f),
+        RenderObject{},
+        boxAt(glm::vec3(0.0f, 0.0f, -200.0f), 10.0f),
+        // Larger on screen than the wall.
+        boxAt(glm::vec3(0.0f, 0.0f, -30.0f), 25.0f),
+        boxAt(glm::vec3(0.0f, 0.0f, 0.0f), 2.0f)
+    };
+
+    std::vector<uint32_t> visible{ 0, 1, 2, 3, 4, 5, 6 };
+    const render::OcclusionStats stats = culler.cull(objects, visible);
+
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 1, 2, 3, 5, 6 }));
+    EXPECT_EQ(stats.occluders, 1u);
+    EXPECT_EQ(stats.tested, 6u);
+    EXPECT_EQ(stats.occluded, 2u);
+
+    culler.rasterize(viewProjection, {});
+    EXPECT_TRUE(culler.empty());
+    EXPECT_FALSE(culler.is_occluded(objects[0].bounds));
+}
+
+namespace
+{
+    class FakeMeshAllocator final : public IMeshAllocator
+    {
+    public:
+        explicit FakeMeshAllocator(const uintptr_t bufferId) :
+            m_vertexBuffer(reinterpret_cast<VkBuffer>(bufferId))
+        {
+        }
+
+        [[nodiscard]] MeshAllocation acquire(VkDeviceSize, VkDeviceSize) override { return {}; }
+        void free(MeshAllocation) override {}
+        void reconfigure(MeshAllocatorConfig config) override { m_config = config; }
+        [[nodiscard]] bool can_reconfigure() const noexcept override { return true; }
+        [[nodiscard]] bool resize(const size_t slotCapacity) override
+        {
+            m_config.slotCapacity = slotCapacity;
+            return true;
+        }
+        [[nodiscard]] const MeshAllocatorConfig& config() const noexcept override { return m_config; }
+        [[nodiscard]] VkBuffer vertex_buffer_handle() const noexcept { return m_vertexBuffer; }
+
+    private:
+        VkBuffer m_vertexBuffer{VK_NULL_HANDLE};
+        MeshAllocatorConfig m_config{};
+    };
+
+    RenderObject uploaded_quad_object(
+        FakeMeshAllocator& allocator,
+        const VkDeviceSize vertexOffset,
+        const uint32_t quadCount,
+        std::shared_ptr<Material> indirectMaterial,
+        const MeshIndexMode indexMode = MeshIndexMode::SharedQuads)
+    {
+        auto mesh = std::make_shared<Mesh>(indexMode);
+        mesh->_allocation = MeshAllocation{
+            .vertexOffset = vertexOffset,
+            .indicesSize = quadCount * render::IndicesPerQuad,
+            .allocator = &allocator,
+            .vertexBuffer = allocator.vertex_buffer_handle()
+        };
+        mesh->_isActive.store(true);
+        return RenderObject{
+            .mesh = std::move(mesh),
+            .transform = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(vertexOffset), 0.0f, 0.0f)),
+            .indirectMaterial = std::move(indirectMaterial)
+        };
+    }
+}
+
+TEST(IndirectDrawBuilderTest, GroupsBatchableObjectsByMaterialAndRoutesTheRestToFallback)
+{
+    FakeMeshAllocator allocator{0x1000};
+    FakeMeshAllocator otherAllocator{0x2000};
+    const auto terrain = std::make_shared<Material>(Material{ .key = "terrain" });
+    const auto foliage = std::make_shared<Material>(Material{ .key = "foliage" });
+
+    std::vector<RenderObject> objects{
+        uploaded_quad_object(allocator, 0, 2, terrain),
+        uploaded_quad_object(allocator, 10 * sizeof(Vertex), render::MaxQuadsPerIndexBatch + 5, foliage),
+        uploaded_quad_object(allocator, 40 * sizeof(Vertex), 1, terrain, MeshIndexMode::Explicit),
+        uploaded_quad_object(allocator, 50 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(allocator, 60 * sizeof(Vertex), 1, terrain),
+        uploaded_quad_object(allocator, 70 * sizeof(Vertex) + 4, 1, terrain),
+        uploaded_quad_object(otherAllocator, 0, 1, terrain),
+        uploaded_quad_object(allocator, 80 * sizeof(Vertex), 3, terrain)
+    };
+    objects[4].mesh->_isActive.store(false);
+    const std::vector<uint32_t> visible{ 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    render::IndirectDrawBuilder builder{};
+    render::IndirectDrawList list{};
+    builder.build(objects, visible, render::IndirectDrawLimits{ .maxDraws = 64, .maxCommands = 64, .firstDrawIndex = 100 }, list);
+
+    EXPECT_EQ(list.vertexBuffer, allocator.vertex_buffer_handle());
+    EXPECT_EQ(list.fallbackIndices, (std::vector<uint32_t>{ 2, 3, 5, 6 }));
+
+    ASSERT_EQ(list.runs.size(), 2u);
+    EXPECT_EQ(list.runs[0].material, terrain);
+    EXPECT_EQ(list.runs[0].firstCommand, 0u);
+    EXPECT_EQ(list.runs[0].commandCount, 2u);
+    EXPECT_EQ(list.runs[1].material, foliage);
+    EXPECT_EQ(list.runs[1].firstCommand, 2u);
+    EXPECT_EQ(list.runs[1].commandCount, 2u);
+
+    ASSERT_EQ(list.commands.size(), 4u);
+    ASSERT_EQ(list.drawData.size(), 3u);
+    EXPECT_EQ(list.commands[0].indexCount, 2 * render::IndicesPerQuad);
+    EXPECT_EQ(list.commands[0].vertexOffset, 0);
+    EXPECT_EQ(list.commands[0].firstInstance, 100u);
+    EXPECT_EQ(list.commands[1].indexCount, 3 * render::IndicesPerQuad);
+    EXPECT_EQ(list.commands[1].vertexOffset, 80);
+    EXPECT_EQ(list.commands[1].firstInstance, 101u);
+    EXPECT_EQ(list.drawData[1].modelMatrix, objects[7].transform);
+
+    // The large mesh splits at the 16-bit limit but both halves read the same draw data.
+    EXPECT_EQ(list.commands[2].indexCount, render::SharedQuadIndexCount);
+    EXPECT_EQ(list.commands[2].vertexOffset, 10);
+    EXPECT_EQ(list.commands[3].indexCount, 5 * render::IndicesPerQuad);
+    EXPECT_EQ(list.commands[3].vertexOffset, 10 + static_cast<int32_t>(render::MaxQuadsPerIndexBatch * render::VerticesPerQuad));
+    EXPECT_EQ(list.commands[2].firstInstance, 102u);
+    EXPECT_EQ(list.commands[3].firstInstance, 102u);
+    EXPECT_EQ(list.commands[2].instanceCount, 1u);
+
+    const render::IndirectDrawStats stats = list.stats();
+    EXPECT_EQ(stats.batchedObjects, 3u);
+    EXPECT_EQ(stats.commands, 4u);
+    EXPECT_EQ(stats.indirectCalls, 2u);
+    EXPECT_EQ(stats.fallbackObjects, 4u);
+
+    builder.build(objects, visible, render::IndirectDrawLimits{ .maxDraws = 1, .maxCommands = 64 }, list);
+    EXPECT_EQ(list.drawData.size(), 1u);
+    ASSERT_EQ(list.runs.size(), 1u);
+    EXPECT_EQ(list.runs[0].material, terrain);
+    EXPECT_EQ(list.fallbackIndices, (std::vector<uint32_t>{ 2, 3, 5, 6, 7, 1 }));
+}
+
+TEST(InstancedDrawBuilderTest, MergesVisibleGroupsOfOneMeshIntoOneBatchAndRespectsCapacity)
+{
+    FakeMeshAllocator allocator{0x1000};
+    const auto material = std::make_shared<Material>(Material{ .key = "decoration" });
+    const std::shared_ptr<Mesh> flower = uploaded_quad_object(allocator, 0, 4, nullptr).mesh;
+    const std::shared_ptr<Mesh> mushroom = uploaded_quad_object(allocator, 16 * sizeof(Vertex), 2, nullptr).mesh;
+    const std::shared_ptr<Mesh> loading = uploaded_quad_object(allocator, 32 * sizeof(Vertex), 2, nullptr).mesh;
+    loading->_isActive.store(false);
+
+    const auto chunk_group = [&material](const std::shared_ptr<Mesh>& mesh, const float chunkX, const uint32_t count)
+    {
+        render::InstanceGroup group{
+            .mesh = mesh,
+            .material = material,
+            .bounds = RenderBounds{ .valid = true, .min = glm::vec3(chunkX, 0.0f, 0.0f), .max = glm::vec3(chunkX + 16.0f, 4.0f, 16.0f) }
+        };
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            group.instances.push_back(ObjectPushConstants{
+                .modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(chunkX + static_cast<float>(index), 0.0f, 0.0f))
+            });
+        }
+        return group;
+    };
+
+    const std::vector<render::InstanceGroup> groups{
+        chunk_group(flower, 0.0f, 3),
+        chunk_group(mushroom, 0.0f, 1),
+        chunk_group(flower, 16.0f, 2),
+        chunk_group(flower, 500.0f, 5),
+        chunk_group(loading, 16.0f, 4),
+        chunk_group(mushroom, 32.0f, 2)
+    };
+
+    // Looking down -Z from x = 24 with a 90 degree frustum; the group at x = 500 is far outside it.
+    const glm::mat4 viewProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) *
+        glm::lookAt(glm::vec3(24.0f, 2.0f, 40.0f), glm::vec3(24.0f, 2.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const std::optional<render::Frustum> frustum = render::extract_frustum(viewProjection);
+
+    render::InstancedDrawBuilder builder{};
+    render::InstancedDrawList list{};
+    builder.build(groups, frustum, 64, 1000, list);
+
+    EXPECT_EQ(list.stats.culledGroups, 1u);
+    EXPECT_EQ(list.stats.visibleGroups, 4u);
+    ASSERT_EQ(list.batches.size(), 2u);
+    const render::InstancedDrawBatch& flowers = list.batches[0].mesh == flower ? list.batches[0] : list.batches[1];
+    const render::InstancedDrawBatch& mushrooms = list.batches[0].mesh == flower ? list.batches[1] : list.batches[0];
+    EXPECT_EQ(flowers.instanceCount, 5u);
+    EXPECT_EQ(mushrooms.instanceCount, 3u);
+    EXPECT_EQ(list.instanceData.size(), 8u);
+    EXPECT_EQ(list.batches[0].firstInstance, 1000u);
+    EXPECT_EQ(list.batches[1].firstInstance, 1000u + list.batches[0].instanceCount);
+
+    // Each batch's instances are contiguous and keep their group's order.
+    const uint32_t flowerBase = flowers.firstInstance - 1000u;
+    EXPECT_EQ(list.instanceData[flowerBase].modelMatrix, groups[0].instances[0].modelMatrix);
+    EXPECT_EQ(list.instanceData[flowerBase + 3].modelMatrix, groups[2].instances[0].modelMatrix);
+
+    builder.build(groups, std::nullopt, 6, 0, list);
+    EXPECT_EQ(list.stats.culledGroups, 0u);
+    EXPECT_EQ(list.stats.instances, 6u);
+    EXPECT_EQ(list.stats.droppedInstances, 7u);
+}
+
+TEST(RenderQueueTest, StateSortGroupsByPipelineThenDescriptorSetThenBufferAndKeepsPushConstantsParallel)
+{
+    static_assert(render::make_render_sort_key(1, 0, 0) > render::make_render_sort_key(0, 0xFFFFF, 0xFFFFF));
+    static_assert(render::make_render_sort_key(0, 1, 0) > render::make_render_sort_key(0, 0, 0xFFFFF));
+
+    FakeMeshAllocator allocator{0x1000};
+    FakeMeshAllocator otherAllocator{0x2000};
+    const auto make_material = [](const uintptr_t pipeline, const uintptr_t descriptorSet)
+    {
+        return std::make_shared<Material>(Material{
+            .pipeline = reinterpret_cast<VkPipeline>(pipeline),
+            .descriptorSets = {{ { reinterpret_cast<VkDescriptorSet>(descriptorSet) } }}
+        });
+    };
+    const auto water = make_material(0x20, 0x200);
+    const auto terrain = make_material(0x10, 0x100);
+    const auto terrainOtherSet = make_material(0x10, 0x300);
+
+    std::vector<RenderObject> objects{
+        uploaded_quad_object(allocator, 0, 1, nullptr),
+        uploaded_quad_object(allocator, 10 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(otherAllocator, 20 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(allocator, 30 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(allocator, 40 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(allocator, 50 * sizeof(Vertex), 1, nullptr),
+        uploaded_quad_object(otherAllocator, 60 * sizeof(Vertex), 1, nullptr)
+    };
+    objects[0].material = water;
+    objects[1].material = terrain;
+    objects[2].material = terrain;
+    objects[3].material = terrainOtherSet;
+    objects[4].material = nullptr;
+    objects[5].material = terrain;
+    objects[5].mesh->_isActive.store(false);
+    objects[6].material = terrain;
+    const std::vector<uint32_t> visible{ 0, 1, 2, 3, 4, 5, 6 };
+
+    const auto object_order = [](const render::RenderQueue& queue)
+    {
+        std::vector<uint32_t> order{};
+        for (const render::RenderQueueItem& item : queue.items())
+        {
+            order.push_back(item.objectIndex);
+        }
+        return order;
+    };
+
+    render::RenderQueue queue{};
+    queue.build(objects, visible, render::RenderQueueOrder::Submission);
+    EXPECT_EQ(object_order(queue), (std::vector<uint32_t>{ 0, 1, 2, 3, 6 }));
+
+    // Ids are assigned in first-seen order, so water's pipeline sorts first; ties keep submission order.
+    queue.build(objects, visible, render::RenderQueueOrder::StateSorted);
+    EXPECT_EQ(object_order(queue), (std::vector<uint32_t>{ 0, 1, 2, 6, 3 }));
+    ASSERT_EQ(queue.push_constants().size(), queue.items().size());
+    for (size_t index = 0; index < queue.items().size(); ++index)
+    {
+        EXPECT_EQ(queue.push_constants()[index].modelMatrix, objects[queue.items()[index].objectIndex].transform);
+    }
+}
+
+TEST(TransparentSortTest, OrdersBackToFrontByChunkCellAndResortsOnlyOnCellChange)
+{
+    const auto water = std::make_shared<Material>(Material{ .key = "water_indirect" });
+    const auto chunk_object = [](const int cellX, const int cellZ, std::shared_ptr<Material> indirectMaterial)
+    {
+        const glm::vec3 origin(static_cast<float>(cellX) * 16.0f, 0.0f, static_cast<float>(cellZ) * 16.0f);
+        return RenderObject{
+            .mesh = std::make_shared<Mesh>(),
+            .bounds = RenderBounds{ .valid = true, .min = origin, .max = origin + glm::vec3(16.0f, 64.0f, 16.0f) },
+            .indirectMaterial = std::move(indirectMaterial)
+        };
+    };
+
+    std::vector<RenderObject> objects{
+        chunk_object(1, 0, water),
+        chunk_object(-5, 0, nullptr),
+        chunk_object(0, 3, water),
+        chunk_object(-5, 0, water),
+        chunk_object(0, 0, nullptr),
+        chunk_object(9, 9, water)
+    };
+    const render::TransparentSortView view{
+        .cameraPosition = glm::vec3(8.0f, 40.0f, 8.0f),
+        .cellSize = 16.0f,
+        .mergeDistanceCells = 5
+    };
+
+    render::TransparentSorter sorter{};
+    std::vector<uint32_t> visible{ 0, 1, 2, 3, 4 };
+    // Same cell distance: the batchable object comes first so far batches stay contiguous.
+    EXPECT_EQ(sorter.sort(objects, view, visible), 2u);
+    EXPECT_TRUE(sorter.last_sort_resorted());
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 3, 1, 2, 0, 4 }));
+
+    // Moving inside the cell, or changing which objects are visible, reuses the cached order.
+    render::TransparentSortView moved = view;
+    moved.cameraPosition = glm::vec3(15.0f, 10.0f, 1.0f);
+    visible = { 5, 4, 0 };
+    EXPECT_EQ(sorter.sort(objects, moved, visible), 1u);
+    EXPECT_FALSE(sorter.last_sort_resorted());
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 5, 0, 4 }));
+
+    // Crossing into the next cell re-sorts; (1, 0) is now the camera's own cell.
+    moved.cameraPosition = glm::vec3(17.0f, 10.0f, 1.0f);
+    visible = { 0, 1, 2, 3, 4 };
+    EXPECT_EQ(sorter.sort(objects, moved, visible), 2u);
+    EXPECT_TRUE(sorter.last_sort_resorted());
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 3, 1, 2, 4, 0 }));
+
+    // Replacing a mesh in place (a remeshed chunk) also re-sorts.
+    objects[2] = chunk_object(20, 0, water);
+    visible = { 0, 2 };
+    EXPECT_EQ(sorter.sort(objects, moved, visible), 1u);
+    EXPECT_TRUE(sorter.last_sort_resorted());
+    EXPECT_EQ(visible, (std::vector<uint32_t>{ 2, 0 }));
+}
+
+TEST(StagingRingTest, WrapsPastTheEndAndFreesBatchesInSubmissionOrder)
+{
+    render::StagingRing ring{100};
+
+    EXPECT_EQ(ring.allocate(40), std::optional<uint64_t>{0});
+    EXPECT_EQ(ring.allocate(30), std::optional<uint64_t>{40});
+    const render::StagingRegion first = ring.close_batch();
+    EXPECT_EQ(first.size, 70u);
+
+    EXPECT_EQ(ring.allocate(20), std::optional<uint64_t>{70});
+    const render::StagingRegion second = ring.close_batch();
+    EXPECT_EQ(ring.used(), 90u);
+
+    // Full until the first batch completes; nothing in flight may be overwritten.
+    EXPECT_FALSE(ring.allocate(20).has_value());
+    ring.release(first);
+    EXPECT_EQ(ring.used(), 20u);
+
+    // Only 10 bytes remain before the end, so the head wraps and the batch pays for the skipped tail.
+    EXPECT_EQ(ring.allocate(50), std::optional<uint64_t>{0});
+    const render::StagingRegion third = ring.close_batch();
+    EXPECT_EQ(third.size, 60u);
+    EXPECT_FALSE(ring.allocate(30).has_value());
+    EXPECT_EQ(ring.allocate(20), std::optional<uint64_t>{50});
+    const render::StagingRegion fourth = ring.close_batch();
+
+    ring.release(second);
+    ring.release(third);
+    ring.release(fourth);
+    EXPECT_EQ(ring.used(), 0u);
+    EXPECT_EQ(ring.allocate(100), std::optional<uint64_t>{0});
+    EXPECT_FALSE(ring.allocate(1).has_value());
+}
+
+namespace
+{
+    void drain_mesh_releases()
+    {
+        MeshAllocation allocation{};
+        while (render::try_dequeue_mesh_release(allocation))
+        {
+        }
+    }
+}
+
+TEST(MeshReleaseTest, MeshReleasedBeforeUploadIsNeverSubmitted)
+{
+    drain_mesh_releases();
+    std::shared_ptr<Mesh> kept = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    std::shared_ptr<Mesh> released = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    std::vector<render::PendingUpload> uploads{
+        render::PendingUpload{ .mesh = kept, .queuedFrame = 1 },
+        render::PendingUpload{ .mesh = released, .queuedFrame = 2 }
+    };
+
+    // The chunk streamed out while its mesh waited for staging space.
+    released.reset();
+    EXPECT_EQ(render::prune_released_uploads(uploads), 1u);
+    ASSERT_EQ(uploads.size(), 1u);
+    EXPECT_EQ(uploads.front().mesh, kept);
+
+    // A mesh that never got GPU ranges has nothing to retire when it goes.
+    uploads.clear();
+    kept.reset();
+    MeshAllocation allocation{};
+    EXPECT_FALSE(render::try_dequeue_mesh_release(allocation));
+}
+
+TEST(MeshReleaseTest, LastOwnerLettingGoRetiresTheUploadedRangesOnce)
+{
+    drain_mesh_releases();
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>(MeshIndexMode::SharedQuads);
+    mesh->_allocation.handle = 7;
+    mesh->_allocation.vertexSize = 4 * sizeof(Vertex);
+
+    // The render object still draws the mesh after its producer lets go.
+    std::shared_ptr<Mesh> renderObjectMesh = mesh;
+    mesh.reset();
+    MeshAllocation allocation{};
+    EXPECT_FALSE(render::try_dequeue_mesh_release(allocation));
+
+    renderObjectMesh.reset();
+    ASSERT_TRUE(render::try_dequeue_mesh_release(allocation));
+    EXPECT_EQ(allocation.handle, 7);
+    EXPECT_EQ(allocation.vertexSize, 4 * sizeof(Vertex));
+    EXPECT_FALSE(render::try_dequeue_mesh_release(allocation));
+}
+
+TEST(TlsfRangeAllocatorTest, RandomAllocateFreeKeepsRangesDisjointAlignedAndFullyCoalesces)
+{
+    constexpr uint64_t Capacity = 64ull * 1024 * 1024;
+    constexpr uint64_t Alignment = sizeof(Vertex);
+    render::TlsfRangeAllocator allocator{Capacity};
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<uint64_t> vertexCount{1, 20000};
+    std::vector<render::RangeAllocation> live{};
+    uint64_t liveBytes = 0;
+    uint32_t failures = 0;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const bool shouldFree = !live.empty() && (random() % 100) < 45;
+        if (shouldFree)
+        {
+            const size_t index = random() % live.size();
+            liveBytes -= live[index].size;
+            allocator.free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            continue;
+        }
+
+        const uint64_t size = vertexCount(random) * Alignment;
+        const std::optional<render::RangeAllocation> allocation = allocator.allocate(size, Alignment);
+        if (!allocation.has_value())
+        {
+            // Good-fit only gives up when no free block reaches the next size class above the request.
+            ASSERT_LT(allocator.stats().largestFreeBlock, size + size / 16 + Alignment);
+            ++failures;
+            continue;
+        }
+
+        ASSERT_EQ(allocation->offset % Alignment, 0u);
+        ASSERT_LE(allocation->offset + allocation->size, Capacity);
+        live.push_back(allocation.value());
+        liveBytes += size;
+    }
+
+    std::vector<render::RangeAllocation> sorted = live;
+    std::ranges::sort(sorted, {}, &render::RangeAllocation::offset);
+    for (size_t index = 1; index < sorted.size(); ++index)
+    {
+        ASSERT_LE(sorted[index - 1].offset + sorted[index - 1].size, sorted[index].offset);
+    }
+
+    const render::RangeAllocatorStats stats = allocator.stats();
+    EXPECT_EQ(stats.usedBytes, liveBytes);
+    EXPECT_EQ(stats.liveAllocations, live.size());
+    EXPECT_LE(stats.largestFreeBlock, stats.freeBytes);
+    EXPECT_GE(stats.fragmentation(), 0.0f);
+    EXPECT_GT(failures, 0u);
+
+    for (const render::RangeAllocation& allocation : live)
+    {
+        allocator.free(allocation);
+    }
+
+    const render::RangeAllocatorStats drained = allocator.stats();
+    EXPECT_TRUE(allocator.empty());
+    EXPECT_EQ(drained.freeBlocks, 1u);
+    EXPECT_EQ(drained.largestFreeBlock, Capacity);
+    EXPECT_EQ(drained.fragmentation(), 0.0f);
+    EXPECT_EQ(allocator.allocate(Capacity)->offset, 0u);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+}
+
+TEST(TlsfRangeAllocatorTest, MergesNeighboursAndSplitsAlignmentPadding)
+{
+    render::TlsfRangeAllocator allocator{1000};
+    const auto first = allocator.allocate(100);
+    const auto second = allocator.allocate(100);
+    const auto third = allocator.allocate(100);
+    ASSERT_TRUE(first && second && third);
+    EXPECT_EQ(allocator.allocate(0)->block, render::TlsfRangeAllocator::InvalidBlock);
+
+    allocator.free(*first);
+    allocator.free(*third);
+    EXPECT_EQ(allocator.stats().freeBlocks, 2u);
+    EXPECT_NEAR(allocator.stats().fragmentation(), 1.0f - 800.0f / 900.0f, 1e-5f);
+
+    // The freed middle block joins both neighbours into one range.
+    allocator.free(*second);
+    EXPECT_EQ(allocator.stats().freeBlocks, 1u);
+
+    const auto unaligned = allocator.allocate(3);
+    const auto aligned = allocator.allocate(56, 56);
+    ASSERT_TRUE(unaligned && aligned);
+    EXPECT_EQ(aligned->offset % 56, 0u);
+    allocator.free(*unaligned);
+    const auto reused = allocator.allocate(3);
+    ASSERT_TRUE(reused);
+    EXPECT_EQ(reused->offset, unaligned->offset);
+}
+
+TEST(MeshPageAllocatorTest, RelocationDrainsTrailingPageAndCollectsItOnlyAfterRetirement)
+{
+    using render::MeshPagePool;
+    constexpr uint64_t MeshSize = 256;
+    render::MeshPageAllocator allocator{
+        render::MeshPagePoolConfig{ .pageSize = 4 * MeshSize, .alignment = 16 },
+        render::MeshPagePoolConfig{ .pageSize = 256, .alignment = 4 }};
+
+    std::vector<render::MeshPageAllocation> meshes{};
+    for (int mesh = 0; mesh < 5; ++mesh)
+    {
+        meshes.push_back(allocator.acquire(MeshSize, 0));
+    }
+
+    // Four meshes fill the first page and the fifth grows the pool.
+    ASSERT_EQ(allocator.page_count(MeshPagePool::Vertex), 2u);
+    EXPECT_EQ(meshes[3].vertex.page, 0u);
+    EXPECT_EQ(meshes[4].vertex.page, 1u);
+    EXPECT_EQ(allocator.page_count(MeshPagePool::Index), 1u);
+    // Both pages are genuinely needed, so there is nothing to compact.
+    EXPECT_FALSE(allocator.needs_compaction(MeshPagePool::Vertex));
+    EXPECT_TRUE(allocator.plan_relocations(UINT64_MAX).empty());
+
+    allocator.free(meshes[0].handle);
+    allocator.free(meshes[2].handle);
+    EXPECT_TRUE(allocator.needs_compaction(MeshPagePool::Vertex));
+
+    // The budget only covers one mesh, and the one on the trailing page moves first.
+    std::vector<render::MeshPageRelocation> relocations = allocator.plan_relocations(MeshSize);
+    ASSERT_EQ(relocations.size(), 1u);
+    EXPECT_EQ(relocations[0].source.handle, meshes[4].handle);
+    EXPECT_EQ(relocations[0].source.vertex.page, 1u);
+    EXPECT_EQ(relocations[0].destination.vertex.page, 0u);
+    EXPECT_EQ(allocator.relocations_in_flight(), 1u);
+    EXPECT_EQ(allocator.pool_stats(MeshPagePool::Vertex).usedBytes, 4 * MeshSize);
+
+    // Cancelling hands the reserved destination back and leaves the mesh where it was.
+    allocator.cancel_relocation(meshes[4].handle);
+    EXPECT_EQ(allocator.relocations_in_flight(), 0u);
+    EXPECT_EQ(allocator.pool_stats(MeshPagePool::Vertex).usedBytes, 3 * MeshSize);
+    EXPECT_EQ(allocator.find(meshes[4].handle)->vertex.page, 1u);
+
+    relocations = allocator.plan_relocations(MeshSize);
+    ASSERT_EQ(relocations.size(), 1u);
+    constexpr uint64_t RetireFrame = 10;
+    allocator.commit_relocation(meshes[4].handle, RetireFrame);
+    EXPECT_EQ(allocator.relocations_in_flight(), 0u);
+    EXPECT_EQ(allocator.relocated_bytes(), MeshSize);
+    EXPECT_EQ(allocator.find(meshes[4].handle)->vertex.page, 0u);
+    EXPECT_EQ(allocator.find(meshes[4].handle)->vertex.range.offset, relocations[0].destination.vertex.range.offset);
+
+    // The source range stays reserved while frames recorded before the commit may still read it.
+    allocator.collect_garbage(RetireFrame + FRAME_OVERLAP - 1);
+    EXPECT_TRUE(allocator.has_retired_ranges());
+    EXPECT_EQ(allocator.page_count(MeshPagePool::Vertex), 2u);
+
+    // Freeing the source empties the trailing page, which then waits out the same number of frames.
+    allocator.collect_garbage(RetireFrame + FRAME_OVERLAP);
+    EXPECT_FALSE(allocator.has_retired_ranges());
+    EXPECT_EQ(allocator.pool_stats(MeshPagePool::Vertex).usedBytes, 3 * MeshSize);
+    EXPECT_EQ(allocator.page_count(MeshPagePool::Vertex), 2u);
+    allocator.collect_garbage(RetireFrame + 2 * FRAME_OVERLAP - 1);
+    EXPECT_EQ(allocator.page_count(MeshPagePool::Vertex), 2u);
+    allocator.collect_garbage(RetireFrame + 2 * FRAME_OVERLAP);
+    EXPECT_EQ(allocator.page_count(MeshPagePool::Vertex), 1u);
+    EXPECT_FALSE(allocator.needs_compaction(MeshPagePool::Vertex));
+
+    for (const int32_t handle : { meshes[1].handle, meshes[3].handle, meshes[4].handle })
+    {
+        allocator.free(handle);
+    }
+    EXPECT_EQ(allocator.live_allocations(), 0u);
+    EXPECT_EQ(allocator.pool_stats(MeshPagePool::Vertex).usedBytes, 0u);
+}
+
+TEST(PipelineCacheBlobTest, AcceptsOnlyVersionOneHeadersFromTheSameDevice)
+{
+    render::PipelineCacheIdentity identity{ .vendorId = 0x10DE, .deviceId = 0x2684 };
+    for (size_t index = 0; index < identity.uuid.size(); ++index)
+    {
+        identity.uuid[index] = static_cast<uint8_t>(index * 7 + 1);
+    }
+
+    const auto make_blob = [](const uint32_t headerSize, const uint32_t version, const render::PipelineCacheIdentity& stamp)
+    {
+        std::vector<std::byte> blob(64, std::byte{0xAB});
+        const std::array<uint32_t, 4> words{ headerSize, version, stamp.vendorId, stamp.deviceId };
+        std::memcpy(blob.data(), words.data(), sizeof(words));
+        std::memcpy(blob.data() + sizeof(words), stamp.uuid.data(), stamp.uuid.size());
+        return blob;
+    };
+
+    using Status = render::PipelineCacheBlobStatus;
+    const std::vector<std::byte> valid = make_blob(32, 1, identity);
+    EXPECT_EQ(render::validate_pipeline_cache_blob(valid, identity), Status::Valid);
+    EXPECT_EQ(render::validate_pipeline_cache_blob({}, identity), Status::Empty);
+    EXPECT_EQ(render::validate_pipeline_cache_blob(std::span(valid).first(20), identity), Status::Truncated);
+    EXPECT_EQ(render::validate_pipeline_cache_blob(make_blob(32, 2, identity), identity), Status::UnsupportedHeader);
+    EXPECT_EQ(render::validate_pipeline_cache_blob(make_blob(16, 1, identity), identity), Status::UnsupportedHeader);
+    EXPECT_EQ(render::validate_pipeline_cache_blob(make_blob(4096, 1, identity), identity), Status::Truncated);
+
+    render::PipelineCacheIdentity otherDriver = identity;
+    otherDriver.uuid.back() ^= 0xFF;
+    EXPECT_EQ(render::validate_pipeline_cache_blob(make_blob(32, 1, otherDriver), identity), Status::DeviceMismatch);
+    render::PipelineCacheIdentity otherDevice = identity;
+    otherDevice.deviceId += 1;
+    EXPECT_EQ(render::validate_pipeline_cache_blob(make_blob(32, 1, otherDevice), identity), Status::DeviceMismatch);
 }
 
 TEST(VoxelPickingTest, FaceFromOutwardNormalMatchesExpectedPlacementFace)
@@ -2,18 +2,28 @@
 #include <array>
 #include <cmath>
 #include <filesystem>
+#include <limits>
 #include <memory>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
 
 #include "test_support.h"
 #include "config/world_gen_config_repository.h"
 #include "game/chunk.h"
 #include "game/world.h"
 #include "game/world_collision.h"
+#include "world/chunk_cache.h"
 #include "world/chunk_lighting.h"
+#include "world/chunk_mesher.h"
+#include "world/chunk_prefetch.h"
 #include "world/dynamic_light_registry.h"
+#include "world/horizon_terrain.h"
+#include "world/section_visibility.h"
 #include "world/terrain_gen.h"
 #include "world/world_light_sampler.h"
 #include "world/world_geometry.h"
@@ -193,6 +203,189 @@ TEST(WorldCollisionTest, IntersectsSolidBlocksRespectsCustomBlockWorldSize)
     }));
 }
 
+TEST(ChunkResidencyTest, CacheDropsDiscCornersAndAdmitsThemAsTheOriginMoves)
+{
+    constexpr int viewDistance = 12;
+    constexpr int squareChunks = (2 * viewDistance + 1) * (2 * viewDistance + 1);
+    EXPECT_LT(maximum_chunks_for_view_distance(viewDistance), squareChunks * 82 / 100);
+    EXPECT_GT(maximum_chunks_for_view_distance(viewDistance), squareChunks * 76 / 100);
+    EXPECT_EQ(maximum_chunks_for_view_distance(1), 9);
+
+    // Meshable chunks never depend on a neighbour outside the disc.
+    for (int x = -viewDistance; x <= viewDistance; ++x)
+    {
+        for (int z = -viewDistance; z <= viewDistance; ++z)
+        {
+            if (!is_chunk_offset_meshable(x, z, viewDistance))
+            {
+                continue;
+            }
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                for (int dz = -1; dz <= 1; ++dz)
+                {
+                    EXPECT_TRUE(is_chunk_offset_resident(x + dx, z + dz, viewDistance)) << x << ", " << z;
+                }
+            }
+        }
+    }
+
+    ChunkCache cache(4, CHUNK_SIZE, CHUNK_HEIGHT);
+    EXPECT_NE(cache.get_chunk({4, 0}), nullptr);
+    EXPECT_NE(cache.get_chunk({-3, 3}), nullptr);
+    EXPECT_EQ(cache.get_chunk({4, 4}), nullptr);
+    EXPECT_EQ(cache.get_chunk({4, 3}), nullptr);
+    EXPECT_FALSE(cache.is_resident({4, 3}));
+
+    const std::vector<Chunk*> recycled = cache.slide({1, 0});
+    EXPECT_EQ(recycled.size(), 9u);
+    EXPECT_TRUE(cache.is_resident({4, 3}));
+    ASSERT_NE(cache.get_chunk({4, 3}), nullptr);
+    EXPECT_EQ(cache.get_chunk({4, 3})->_data->coord, (ChunkCoord{4, 3}));
+    EXPECT_EQ(cache.get_chunk({-3, 3}), nullptr);
+    EXPECT_NE(cache.get_chunk({5, 0}), nullptr);
+}
+
+TEST(ChunkResidencyTest, RecenterResetsOnlyChunksOutsideTheOverlapNearestFirst)
+{
+    constexpr int viewDistance = 8;
+    constexpr int width = (2 * viewDistance) + 1;
+    ChunkCache cache(viewDistance, CHUNK_SIZE, CHUNK_HEIGHT);
+    const auto expect_ring_around = [&](const ChunkCoord origin)
+    {
+        for (int x = origin.x - viewDistance; x <= origin.x + viewDistance; ++x)
+        {
+            for (int z = origin.z - viewDistance; z <= origin.z + viewDistance; ++z)
+            {
+                const Chunk* const chunk = cache.get_chunk({x, z});
+                if (!is_chunk_offset_resident(x - origin.x, z - origin.z, viewDistance))
+                {
+                    EXPECT_EQ(chunk, nullptr) << x << ", " << z;
+                    continue;
+                }
+                ASSERT_NE(chunk, nullptr) << x << ", " << z;
+                EXPECT_EQ(chunk->_data->coord, (ChunkCoord{x, z}));
+            }
+        }
+    };
+
+    const Chunk* const kept = cache.get_chunk({2, 1});
+    ASSERT_NE(kept, nullptr);
+
+    // A short hop only pays for the slots that left the overlap: fewer resets than sliding five rows.
+    const std::vector<Chunk*> hop = cache.recenter({3, -2});
+    EXPECT_EQ(hop.size(), static_cast<size_t>((width * width) - ((width - 3) * (width - 2))));
+    EXPECT_LT(hop.size(), static_cast<size_t>(5 * width));
+    EXPECT_EQ(cache.get_chunk({2, 1}), kept);
+    expect_ring_around({3, -2});
+
+    int previousDistance = 0;
+    for (const Chunk* const chunk : hop)
+    {
+        const int dx = chunk->_data->coord.x - 3;
+        const int dz = chunk->_data->coord.z + 2;
+        EXPECT_GE((dx * dx) + (dz * dz), previousDistance);
+        previousDistance = (dx * dx) + (dz * dz);
+    }
+
+    // A teleport with no overlap resets every slot exactly once, however far it goes.
+    const std::vector<Chunk*> teleport = cache.recenter({-500, 730});
+    EXPECT_EQ(teleport.size(), static_cast<size_t>(width * width));
+    expect_ring_around({-500, 730});
+    EXPECT_TRUE(cache.recenter({-500, 730}).empty());
+
+    // Single steps still go through slide() and agree with recenter's slot layout.
+    EXPECT_EQ(cache.slide({1, 0}).size(), static_cast<size_t>(width));
+    expect_ring_around({-499, 730});
+}
+
+TEST(ChunkResidencyTest, ResizeKeepsChunksInsideBothRingsAndOnlyTouchesTheDifference)
+{
+    ChunkCache cache(4, CHUNK_SIZE, CHUNK_HEIGHT);
+    const auto expect_ring_around = [&](const ChunkCoord origin, const int viewDistance)
+    {
+        for (int x = origin.x - viewDistance - 1; x <= origin.x + viewDistance + 1; ++x)
+        {
+            for (int z = origin.z - viewDistance - 1; z <= origin.z + viewDistance + 1; ++z)
+            {
+                const Chunk* const chunk = cache.get_chunk({x, z});
+                if (std::abs(x - origin.x) > viewDistance || std::abs(z - origin.z) > viewDistance ||
+                    !is_chunk_offset_resident(x - origin.x, z - origin.z, viewDistance))
+                {
+                    EXPECT_EQ(chunk, nullptr) << x << ", " << z;
+                    continue;
+                }
+                ASSERT_NE(chunk, nullptr) << x << ", " << z;
+                EXPECT_EQ(chunk->_data->coord, (ChunkCoord{x, z}));
+            }
+        }
+    };
+
+    // Slide first so the ring's origin slot is not at the buffer's centre.
+    (void)cache.slide({1, 0});
+    (void)cache.slide({0, -1});
+    constexpr ChunkCoord origin{1, -1};
+    const Chunk* const kept = cache.get_chunk({3, 1});
+    ASSERT_NE(kept, nullptr);
+
+    const ChunkCacheResize grown = cache.resize(7);
+    EXPECT_TRUE(grown.removed.empty());
+    EXPECT_EQ(grown.added.size(), static_cast<size_t>((15 * 15) - (9 * 9)));
+    EXPECT_EQ(cache.get_chunk({3, 1}), kept);
+    expect_ring_around(origin, 7);
+
+    const Chunk* const edge = cache.get_chunk({origin.x + 6, origin.z});
+    ASSERT_NE(edge, nullptr);
+    const ChunkCacheResize shrunk = cache.resize(3);
+    EXPECT_TRUE(shrunk.added.empty());
+    EXPECT_EQ(shrunk.removed.size(), static_cast<size_t>((15 * 15) - (7 * 7)));
+    EXPECT_NE(std::ranges::find(shrunk.removed, edge), shrunk.removed.end());
+    EXPECT_EQ(cache.get_chunk({3, 1}), kept);
+    expect_ring_around(origin, 3);
+
+    // The resized ring keeps sliding and recentering like a freshly built one.
+    EXPECT_EQ(cache.slide({0, 1}).size(), static_cast<size_t>(7));
+    expect_ring_around({1, 0}, 3);
+    (void)cache.recenter({40, 12});
+    expect_ring_around({40, 12}, 3);
+    EXPECT_TRUE(cache.resize(3).added.empty());
+}
+
+TEST(ChunkPrefetchTest, PlansChunksAheadOfTheHeadingThatTheRingDoesNotHoldYet)
+{
+    constexpr ChunkCoord current{0, 0};
+    constexpr ChunkCoord predicted{3, 0};
+    constexpr int viewDistance = 6;
+    EXPECT_TRUE(plan_chunk_prefetch(current, predicted, glm::vec2(0.0f), viewDistance).empty());
+
+    const std::vector<ChunkCoord> plan = plan_chunk_prefetch(current, predicted, glm::vec2(1.0f, 0.0f), viewDistance);
+    ASSERT_FALSE(plan.empty());
+
+    int previousDistance = 0;
+    for (const ChunkCoord& coord : plan)
+    {
+        EXPECT_FALSE(is_chunk_offset_resident(coord.x - current.x, coord.z - current.z, viewDistance));
+        EXPECT_TRUE(is_chunk_offset_resident(
+            coord.x - predicted.x,
+            coord.z - predicted.z,
+            viewDistance + ChunkPrefetchBandChunks));
+        EXPECT_GT(coord.x, current.x);
+
+        const int distance = (coord.x * coord.x) + (coord.z * coord.z);
+        EXPECT_GE(distance, previousDistance);
+        previousDistance = distance;
+    }
+
+    const auto planned = [&](const ChunkCoord coord)
+    {
+        return std::ranges::find(plan, coord) != plan.end();
+    };
+    EXPECT_TRUE(planned({7, 0}));
+    EXPECT_TRUE(planned({3 + viewDistance + ChunkPrefetchBandChunks, 0}));
+    EXPECT_FALSE(planned({4 + viewDistance + ChunkPrefetchBandChunks, 0}));
+    EXPECT_FALSE(planned({-7, 0}));
+}
+
 TEST(ChunkLightingTest, SkylightDistinguishesOpenSkyFromRoofedCells)
 {
     auto center = make_empty_chunk({0, 0});
@@ -224,6 +417,305 @@ TEST(ChunkLightingTest, SkylightDistinguishesOpenSkyFromRoofedCells)
     EXPECT_GT(litRoofed->blocks[testX][roofY - 1][testZ]._sunlight, 0);
 }
 
+TEST(ChunkHeightmapTest, RebuildTracksColumnExtentsAndEditsKeepThemCurrent)
+{
+    auto chunk = make_empty_chunk({0, 0});
+    for (int x = 0; x < CHUNK_SIZE; ++x)
+    {
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+        {
+            for (int y = 0; y <= 20; ++y)
+            {
+                chunk->blocks[x][y][z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+            }
+        }
+    }
+    chunk->blocks[4][10][4] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    chunk->blocks[2][21][2] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::WATER };
+
+    EXPECT_FALSE(chunk->heightmap.valid());
+    chunk->rebuild_heightmap();
+    ASSERT_TRUE(chunk->heightmap.valid());
+    EXPECT_EQ(chunk->highest_solid_y(0, 0), 20);
+    EXPECT_EQ(chunk->lowest_non_solid_y(0, 0), 21);
+    EXPECT_EQ(chunk->lowest_non_solid_y(4, 4), 10);
+    EXPECT_EQ(chunk->heightmap.minOccupiedY, 0);
+    EXPECT_EQ(chunk->heightmap.maxOccupiedY, 21);
+
+    const glm::ivec3 pillarTop{4, 40, 4};
+    chunk->blocks[pillarTop.x][pillarTop.y][pillarTop.z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+    chunk->update_heightmap(pillarTop);
+    EXPECT_EQ(chunk->highest_solid_y(4, 4), 40);
+    EXPECT_EQ(chunk->heightmap.maxOccupiedY, 40);
+
+    chunk->blocks[pillarTop.x][pillarTop.y][pillarTop.z] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    chunk->update_heightmap(pillarTop);
+    EXPECT_EQ(chunk->highest_solid_y(4, 4), 20);
+
+    const glm::ivec3 cave{4, 10, 4};
+    chunk->blocks[cave.x][cave.y][cave.z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+    chunk->update_heightmap(cave);
+    EXPECT_EQ(chunk->lowest_non_solid_y(4, 4), 21);
+
+    const glm::ivec3 dug{0, 20, 0};
+    chunk->blocks[dug.x][dug.y][dug.z] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    chunk->update_heightmap(dug);
+    EXPECT_EQ(chunk->highest_solid_y(0, 0), 19);
+    EXPECT_EQ(chunk->lowest_non_solid_y(0, 0), 20);
+}
+
+TEST(SectionConnectivityTest, FloodFillJoinsOnlyTheFacesATunnelReaches)
+{
+    auto chunk = make_empty_chunk({0, 0});
+    for (int x = 0; x < CHUNK_SIZE; ++x)
+    {
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+        {
+            for (int y = 0; y < 40; ++y)
+            {
+                chunk->blocks[x][y][z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+            }
+        }
+    }
+    // A tunnel along x through the first section, and a pocket sealed inside the second.
+    for (int x = 0; x < CHUNK_SIZE; ++x)
+    {
+        chunk->blocks[x][5][8] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    }
+    chunk->blocks[8][20][8] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    chunk->rebuild_heightmap();
+
+    const ChunkConnectivity connectivity = compute_chunk_connectivity(*chunk);
+    ASSERT_EQ(connectivity.sections.size(), CHUNK_HEIGHT / ChunkSectionHeight);
+
+    const SectionConnectivity tunnel = connectivity.sections[0];
+    EXPECT_TRUE(tunnel.connects(SectionFace::NegX, SectionFace::PosX));
+    EXPECT_TRUE(tunnel.connects(SectionFace::PosX, SectionFace::NegX));
+    EXPECT_FALSE(tunnel.connects(SectionFace::NegX, SectionFace::PosY));
+    EXPECT_FALSE(tunnel.connects(SectionFace::NegZ, SectionFace::PosZ));
+
+    EXPECT_EQ(connectivity.sections[1].mask, 0u);
+    // Rows 32..39 are solid, the rest of the third section is open air.
+    EXPECT_TRUE(connectivity.sections[2].connects(SectionFace::NegX, SectionFace::PosY));
+    EXPECT_FALSE(connectivity.sections[2].connects(SectionFace::NegY, SectionFace::PosY));
+    EXPECT_EQ(connectivity.sections[3].mask, SectionConnectivity::open().mask);
+}
+
+TEST(SectionVisibilityTest, SearchStopsAtSolidSectionsAndNeverDoublesBack)
+{
+    const WorldGeometry geometry(default_world_geometry_settings());
+    const auto sectionCount = static_cast<size_t>(chunk_section_count(geometry.chunk_voxel_height()));
+    const ChunkConnectivity solid{ .sections = std::vector<SectionConnectivity>(sectionCount) };
+    const ChunkConnectivity open{ .sections = std::vector<SectionConnectivity>(sectionCount, SectionConnectivity::open()) };
+    ChunkConnectivity tunnel = solid;
+    tunnel.sections[0].connect_faces((1u << static_cast<uint32_t>(SectionFace::NegX)) | (1u << static_cast<uint32_t>(SectionFace::PosX)));
+
+    // The camera sits in an x tunnel in chunk (0, 0); chunk (-1, 0) is open air and everything else is rock.
+    std::vector<SectionVisibilityChunk> chunks{};
+    for (int z = -2; z <= 2; ++z)
+    {
+        for (int x = -2; x <= 2; ++x)
+        {
+            const ChunkConnectivity* connectivity = &solid;
+            if (x == 0 && z == 0)
+            {
+                connectivity = &tunnel;
+            }
+            else if (x == -1 && z == 0)
+            {
+                connectivity = &open;
+            }
+            chunks.push_back(SectionVisibilityChunk{ .coord = ChunkCoord{x, z}, .connectivity = connectivity });
+        }
+    }
+
+    const glm::vec3 camera(8.0f, 5.5f, 8.5f);
+    SectionVisibilityGraph graph{};
+    const SectionVisibilityStats stats = graph.update(geometry, camera, std::nullopt, 2, chunks);
+
+    for (const ChunkCoord coord : { ChunkCoord{0, 0}, ChunkCoord{1, 0}, ChunkCoord{-1, 0}, ChunkCoord{0, 1}, ChunkCoord{-1, -1}, ChunkCoord{-2, 0} })
+    {
+        EXPECT_TRUE(graph.is_chunk_visible(coord)) << coord.x << ", " << coord.z;
+    }
+    // Behind solid rock, or only reachable by turning back toward the camera.
+    for (const ChunkCoord coord : { ChunkCoord{2, 0}, ChunkCoord{1, 1}, ChunkCoord{0, 2}, ChunkCoord{-1, 2}, ChunkCoord{-2, 1} })
+    {
+        EXPECT_FALSE(graph.is_chunk_visible(coord)) << coord.x << ", " << coord.z;
+    }
+    EXPECT_TRUE(graph.is_chunk_visible(ChunkCoord{10, 10}));
+    EXPECT_EQ(stats.visibleChunks + stats.hiddenChunks, chunks.size());
+    EXPECT_GT(stats.hiddenChunks, 0u);
+
+    // Once an edit invalidates the rock chunk (1, 0) it is treated as open, uncovering (2, 0) behind it.
+    chunks[(2 * 5) + 3].connectivity = nullptr;
+    graph.update(geometry, camera, std::nullopt, 2, chunks);
+    EXPECT_TRUE(graph.is_chunk_visible(ChunkCoord{2, 0}));
+
+    // Looking down +x, the open chunk behind the camera is outside the frustum.
+    const glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const glm::mat4 view = glm::lookAt(camera, camera + glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    graph.update(geometry, camera, render::extract_frustum(projection * view), 2, chunks);
+    EXPECT_TRUE(graph.is_chunk_visible(ChunkCoord{1, 0}));
+    EXPECT_FALSE(graph.is_chunk_visible(ChunkCoord{-2, 0}));
+}
+
+TEST(ChunkLightingTest, HeightmapBoundedSolveMatchesFullColumnSolve)
+{
+    std::vector<std::shared_ptr<ChunkData>> chunks{};
+    const auto make_terrain_chunk = [&](const ChunkCoord coord)
+    {
+        auto chunk = make_empty_chunk(coord);
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const int surfaceY = 30 + ((x + z + coord.x * 3) % 7);
+                for (int y = 0; y <= surfaceY; ++y)
+                {
+                    chunk->blocks[x][y][z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+                }
+            }
+        }
+        chunks.push_back(chunk);
+        return chunk;
+    };
+
+    auto center = make_terrain_chunk({0, 0});
+    center->blocks[8][40][8] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::LAMP };
+    for (int y = 20; y <= 36; ++y)
+    {
+        center->blocks[3][y][3] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    }
+
+    const ChunkNeighborhood neighborhood{
+        .center = center,
+        .north = make_terrain_chunk({0, 1}),
+        .south = make_terrain_chunk({0, -1}),
+        .east = make_terrain_chunk({-1, 0}),
+        .west = make_terrain_chunk({1, 0}),
+        .northEast = make_terrain_chunk({-1, 1}),
+        .northWest = make_terrain_chunk({1, 1}),
+        .southEast = make_terrain_chunk({-1, -1}),
+        .southWest = make_terrain_chunk({1, -1})
+    };
+
+    const auto fullSolve = ChunkLighting::solve_skylight(neighborhood);
+    for (const auto& chunk : chunks)
+    {
+        chunk->rebuild_heightmap();
+    }
+    const auto boundedSolve = ChunkLighting::solve_skylight(neighborhood);
+    ASSERT_NE(fullSolve, nullptr);
+    ASSERT_NE(boundedSolve, nullptr);
+
+    for (int x = 0; x < CHUNK_SIZE; ++x)
+    {
+        for (int y = 0; y < CHUNK_HEIGHT; ++y)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const Block& expected = fullSolve->blocks[x][y][z];
+                const Block& actual = boundedSolve->blocks[x][y][z];
+                ASSERT_EQ(expected._sunlight, actual._sunlight) << x << "," << y << "," << z;
+                ASSERT_EQ(expected._localLight.r, actual._localLight.r) << x << "," << y << "," << z;
+                ASSERT_EQ(expected._localLight.g, actual._localLight.g) << x << "," << y << "," << z;
+                ASSERT_EQ(expected._localLight.b, actual._localLight.b) << x << "," << y << "," << z;
+            }
+        }
+    }
+}
+
+TEST(ChunkMeshLodTest, DownsampledMeshesShrinkAndKeepBorderFacesAgainstOpenNeighbourVoxels)
+{
+    const auto make_terrain_chunk = [](const ChunkCoord coord)
+    {
+        auto chunk = make_empty_chunk(coord);
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const int surfaceY = 30 + ((x + z + coord.x * 3) % 7);
+                for (int y = 0; y <= surfaceY; ++y)
+                {
+                    chunk->blocks[x][y][z] = Block{ ._solid = true, ._sunlight = 0, ._type = BlockType::STONE };
+                }
+            }
+        }
+        return chunk;
+    };
+
+    auto center = make_terrain_chunk({0, 0});
+    auto west = make_terrain_chunk({1, 0});
+    const ChunkNeighborhood neighborhood{
+        .center = center,
+        .north = make_terrain_chunk({0, 1}),
+        .south = make_terrain_chunk({0, -1}),
+        .east = make_terrain_chunk({-1, 0}),
+        .west = west,
+        .northEast = make_terrain_chunk({-1, 1}),
+        .northWest = make_terrain_chunk({1, 1}),
+        .southEast = make_terrain_chunk({-1, -1}),
+        .southWest = make_terrain_chunk({1, -1})
+    };
+
+    const auto vertex_count = [&](const int lodScale)
+    {
+        ChunkMesher mesher{ neighborhood, WorldGeometry{}, true, lodScale };
+        return mesher.generate_mesh()->mesh->_vertices.size();
+    };
+    const size_t fullVertices = vertex_count(1);
+    const size_t halfVertices = vertex_count(2);
+    const size_t quarterVertices = vertex_count(4);
+    EXPECT_GT(halfVertices, 0u);
+    EXPECT_LT(halfVertices, fullVertices);
+    EXPECT_LT(quarterVertices, halfVertices);
+
+    // Looks for a +X quad on the chunk's east border that covers voxel (15, 10, 5).
+    const auto has_border_face_at_hole = [&]()
+    {
+        ChunkMesher mesher{ neighborhood, WorldGeometry{}, true, 4 };
+        const auto& vertices = mesher.generate_mesh()->mesh->_vertices;
+        for (size_t quad = 0; quad + 4 <= vertices.size(); quad += 4)
+        {
+            glm::vec3 minCorner{std::numeric_limits<float>::max()};
+            glm::vec3 maxCorner{std::numeric_limits<float>::lowest()};
+            bool facesEast = true;
+            for (size_t i = quad; i < quad + 4; ++i)
+            {
+                facesEast = facesEast && vertices[i].normal == glm::vec3(1.0f, 0.0f, 0.0f);
+                minCorner = glm::min(minCorner, vertices[i].position);
+                maxCorner = glm::max(maxCorner, vertices[i].position);
+            }
+            if (facesEast && minCorner.x == static_cast<float>(CHUNK_SIZE) &&
+                minCorner.y <= 10.0f && maxCorner.y >= 11.0f && minCorner.z <= 5.0f && maxCorner.z >= 6.0f)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    EXPECT_FALSE(has_border_face_at_hole());
+    west->blocks[0][10][5] = Block{ ._solid = false, ._sunlight = 0, ._type = BlockType::AIR };
+    EXPECT_TRUE(has_border_face_at_hole());
+}
+
+TEST(ChunkMeshLodTest, SelectionRefinesImmediatelyAndCoarsensOneRingLate)
+{
+    EXPECT_EQ(select_chunk_mesh_lod(0, 0), 1);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshFullDetailRings + 1, 0), 2);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshHalfDetailRings + 1, 0), 4);
+
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshFullDetailRings, 4), 1);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshHalfDetailRings, 4), 2);
+
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshFullDetailRings + 1, 1), 1);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshFullDetailRings + 2, 1), 2);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshHalfDetailRings + 1, 2), 2);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshHalfDetailRings + 2, 2), 4);
+    EXPECT_EQ(select_chunk_mesh_lod(ChunkMeshHalfDetailRings + 20, 1), 4);
+}
+
 TEST(ChunkLightingTest, LampLocalLightPropagatesAndIsBlockedBySolidWall)
 {
     auto center = make_empty_chunk({0, 0});
@@ -379,6 +871,34 @@ TEST(TerrainGeneratorTest, SampleColumnMatchesChunkDataAndIsDeterministic)
     EXPECT_EQ(first.fillerBlock, BlockType::STONE);
 }
 
+TEST(TerrainGeneratorTest, SampleHeightGridMatchesChunkSurfaceHeights)
+{
+    TerrainGenerator& generator = TerrainGenerator::instance();
+
+    const std::vector<int> fine = generator.SampleHeightGrid(-32, 64, 1, 17);
+    ASSERT_EQ(fine.size(), 17u * 17u);
+    for (int z = 0; z < 17; ++z)
+    {
+        for (int x = 0; x < 17; ++x)
+        {
+            EXPECT_EQ(fine[(z * 17) + x], generator.SampleColumn(-32 + x, 64 + z).surfaceHeight) << x << ", " << z;
+        }
+    }
+
+    // Coarser grids land on the same columns; only float rounding in the noise lattice can differ.
+    const std::vector<int> coarse = generator.SampleHeightGrid(-32, 64, 4, 5);
+    ASSERT_EQ(coarse.size(), 25u);
+    for (int z = 0; z < 5; ++z)
+    {
+        for (int x = 0; x < 5; ++x)
+        {
+            EXPECT_NEAR(coarse[(z * 5) + x], fine[(z * 4 * 17) + (x * 4)], 1) << x << ", " << z;
+        }
+    }
+
+    EXPECT_THROW(static_cast<void>(generator.SampleHeightGrid(-30, 64, 4, 5)), std::runtime_error);
+}
+
 TEST(TerrainGeneratorTest, ApplyingSettingsChangesGeneratedTerrain)
 {
     TerrainGenerator& generator = TerrainGenerator::instance();
@@ -634,6 +1154,98 @@ TEST(TerrainGeneratorTest, ChunkGenerationKeepsDefaultTerrainAppearance)
     EXPECT_EQ(chunkData.terrainAppearance, nullptr);
 }
 
+TEST(HorizonTerrainTest, PlansTilesOverEveryChunkPastTheMeshedArea)
+{
+    constexpr ChunkCoord center{3, -5};
+    constexpr int viewDistance = 4;
+    constexpr int horizonDistance = 12;
+    const std::vector<HorizonTilePlan> plans = plan_horizon_tiles(center, viewDistance, horizonDistance, 16);
+    ASSERT_FALSE(plans.empty());
+
+    std::unordered_map<ChunkCoord, int> coverage{};
+    for (const HorizonTilePlan& plan : plans)
+    {
+        ASSERT_NE(plan.spec.chunkMask, 0u);
+        EXPECT_EQ(plan.spec.lodStep, horizon_lod_step(std::max(plan.chunkDistance - viewDistance, 0)));
+        for (int bit = 0; bit < HorizonTileChunks * HorizonTileChunks; ++bit)
+        {
+            if ((plan.spec.chunkMask & (1u << bit)) != 0)
+            {
+                ++coverage[ChunkCoord{
+                    (plan.spec.coord.x * HorizonTileChunks) + (bit % HorizonTileChunks),
+                    (plan.spec.coord.z * HorizonTileChunks) + (bit / HorizonTileChunks)
+                }];
+            }
+        }
+    }
+
+    // Chunks the voxel terrain meshes are never covered; the rest of the horizon is covered exactly once.
+    for (int z = center.z - viewDistance - horizonDistance; z <= center.z + viewDistance + horizonDistance; ++z)
+    {
+        for (int x = center.x - viewDistance - horizonDistance; x <= center.x + viewDistance + horizonDistance; ++x)
+        {
+            const auto it = coverage.find(ChunkCoord{x, z});
+            const int count = it != coverage.end() ? it->second : 0;
+            EXPECT_EQ(count, is_chunk_offset_meshable(x - center.x, z - center.z, viewDistance) ? 0 : 1) << x << ", " << z;
+        }
+    }
+
+    EXPECT_EQ(horizon_lod_step(0), 2);
+    EXPECT_EQ(horizon_lod_step(8), 4);
+    EXPECT_EQ(horizon_lod_step(24), 8);
+    EXPECT_TRUE(plan_horizon_tiles(center, viewDistance, 0, 16).empty());
+}
+
+TEST(HorizonTerrainTest, TileMeshCoversMaskedCellsAndSkirtsTheirOutline)
+{
+    const WorldGeometry geometry(default_world_geometry_settings());
+    const int chunkWidth = geometry.chunk_voxel_width();
+    constexpr int seaLevel = 62;
+    // Only the tile's first chunk is covered.
+    const HorizonTileSpec spec{
+        .coord = HorizonTileCoord{0, 0},
+        .lodStep = chunkWidth / 2,
+        .chunkMask = 1u
+    };
+    const int samples = horizon_tile_samples_per_side(spec, chunkWidth);
+    ASSERT_EQ(samples, HorizonTileChunks * 2);
+
+    const int side = samples + 1;
+    std::vector<int> heights(static_cast<size_t>(side * side), 70);
+    heights[0] = 40;
+
+    RenderBounds bounds{};
+    const std::shared_ptr<Mesh> mesh = build_horizon_tile_mesh(spec, heights, geometry, seaLevel, bounds);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_EQ(mesh->_indexMode, MeshIndexMode::SharedQuads);
+    // Four top quads and a two-sided skirt along each of the eight outline edges.
+    EXPECT_EQ(mesh->_vertices.size(), (4u + (8u * 2u)) * 4u);
+
+    const float waterTop = geometry.voxel_to_world(glm::vec3(0.0f, static_cast<float>(seaLevel + 1), 0.0f)).y;
+    const float landTop = geometry.voxel_to_world(glm::vec3(0.0f, 71.0f, 0.0f)).y;
+    const float skirtBottom = geometry.voxel_to_world(glm::vec3(0.0f, static_cast<float>(63 - std::max(4, spec.lodStep * 2)), 0.0f)).y;
+    const glm::vec3 waterColor = static_cast<glm::vec3>(blockColor[BlockType::WATER]);
+    const float cellExtent = geometry.voxel_to_world(glm::vec3(static_cast<float>(chunkWidth))).x;
+    bool sawWater = false;
+    for (const Vertex& vertex : mesh->_vertices)
+    {
+        EXPECT_LE(vertex.position.x, cellExtent);
+        EXPECT_LE(vertex.position.z, cellExtent);
+        if (vertex.position.x == 0.0f && vertex.position.z == 0.0f && vertex.position.y == waterTop)
+        {
+            sawWater = true;
+            EXPECT_EQ(vertex.color, waterColor);
+        }
+    }
+    EXPECT_TRUE(sawWater);
+    ASSERT_TRUE(bounds.valid);
+    EXPECT_FLOAT_EQ(bounds.max.y, landTop);
+    EXPECT_FLOAT_EQ(bounds.min.y, skirtBottom);
+
+    heights.pop_back();
+    EXPECT_THROW(static_cast<void>(build_horizon_tile_mesh(spec, heights, geometry, seaLevel, bounds)), std::runtime_error);
+}
+
 TEST(WorldGenConfigRepositoryTest, SavesAndLoadsSettingsRoundTrip)
 {
     TerrainGeneratorSettings settings = TerrainGenerator::default_settings();